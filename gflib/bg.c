@@ -905,6 +905,19 @@ void CopyBgTilemapBufferToVram(u8 bg)
     }
 }
 
+// Copies only rows [firstRow, firstRow + numRows) of a 32x32 text mode tilemap.
+// Any other layout doesn't store rows contiguously, so the whole tilemap is copied.
+void CopyBgTilemapBufferRowsToVram(u8 bg, u8 firstRow, u8 numRows)
+{
+    if (!IsInvalidBg32(bg) && !IsTileMapOutsideWram(bg))
+    {
+        if (GetBgType(bg) != 0 || GetBgMetricTextMode(bg, 0) != 1)
+            CopyBgTilemapBufferToVram(bg);
+        else
+            LoadBgVram(bg, (u16 *)sGpuBgConfigs2[bg].tilemap + firstRow * 32, numRows * 64, firstRow * 64, 2);
+    }
+}
+
 void CopyToBgTilemapBufferRect(u8 bg, const void* src, u8 destX, u8 destY, u8 width, u8 height)
 {
     u16 destX16;
@@ -1,6 +1,7 @@
 #ifndef GUARD_BATTLE_SCRIPT_COMMANDS_H
 #define GUARD_BATTLE_SCRIPT_COMMANDS_H
 
+#include "constants/battle_config.h"
 #include "constants/pokemon.h"
 
 #define WINDOW_CLEAR            0x1
@@ -41,6 +42,17 @@ void StealTargetItem(u8 battlerStealer, u8 battlerItem);
 u8 GetCatchingBattler(void);
 
 extern void (* const gBattleScriptingCommandsTable[])(void);
+
+#if B_PROFILE_BATTLE_SCRIPTS
+#define RUN_BATTLE_SCRIPT_COMMAND() BattleScriptProfiler_RunCommand()
+void BattleScriptProfiler_RunCommand(void);
+#else
+#define RUN_BATTLE_SCRIPT_COMMAND() gBattleScriptingCommandsTable[gBattlescriptCurrInstr[0]]()
+#endif
+
+void BattleScriptProfiler_Reset(void);
+void BattleScriptProfiler_Dump(void);
+
 extern const u8 gBattlePalaceNatureToMoveGroupLikelihood[NUM_NATURES][4];
 extern const struct StatFractions gAccuracyStageRatios[];
 
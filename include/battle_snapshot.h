@@ -0,0 +1,104 @@
+#ifndef GUARD_BATTLE_SNAPSHOT_H
+#define GUARD_BATTLE_SNAPSHOT_H
+
+// Bump whenever a saved structure or the region list changes.
+#define BATTLE_SNAPSHOT_VERSION 2
+
+enum
+{
+    SNAPSHOT_REGION_BATTLE_MONS,
+    SNAPSHOT_REGION_BATTLE_STRUCT,
+    SNAPSHOT_REGION_SIDE_STATUSES,
+    SNAPSHOT_REGION_SIDE_TIMERS,
+    SNAPSHOT_REGION_FIELD_STATUSES,
+    SNAPSHOT_REGION_FIELD_TIMERS,
+    SNAPSHOT_REGION_WEATHER,
+    SNAPSHOT_REGION_STATUSES3,
+    SNAPSHOT_REGION_STATUSES4,
+    SNAPSHOT_REGION_PROTECT_STRUCTS,
+    SNAPSHOT_REGION_DISABLE_STRUCTS,
+    SNAPSHOT_REGION_SPECIAL_STATUSES,
+    SNAPSHOT_REGION_WISH_FUTURE_KNOCK,
+    SNAPSHOT_REGION_LAST_MOVES,
+    SNAPSHOT_REGION_LAST_LANDED_MOVES,
+    SNAPSHOT_REGION_LAST_HIT_BY_TYPE,
+    SNAPSHOT_REGION_LAST_RESULTING_MOVES,
+    SNAPSHOT_REGION_LOCKED_MOVES,
+    SNAPSHOT_REGION_LAST_HIT_BY,
+    SNAPSHOT_REGION_PARTY_INDEXES,
+    SNAPSHOT_REGION_BATTLE_SCRIPTING,
+    SNAPSHOT_REGION_HIT_MARKER,
+    SNAPSHOT_REGION_MOVE_DAMAGE,
+    SNAPSHOT_REGION_BATTLE_COMMUNICATION,
+    SNAPSHOT_REGION_RESOURCE_FLAGS,
+    SNAPSHOT_REGION_SCRIPTS_STACK,
+    SNAPSHOT_REGION_CALLBACKS_STACK,
+    SNAPSHOT_REGION_BATTLE_HISTORY,
+    SNAPSHOT_REGION_PLAYER_PARTY,
+    SNAPSHOT_REGION_ENEMY_PARTY,
+    SNAPSHOT_REGIONS_COUNT
+};
+
+#define SNAPSHOT_ALL_REGIONS ((1 << SNAPSHOT_REGIONS_COUNT) - 1)
+// gBattleStruct and gBattleScripting also hold AI and UI bookkeeping, and gBattleCommunication and the
+// battle history are written by the UI and the AI, none of which run the same way when watching a recorded battle.
+#define SNAPSHOT_REPLAYED_REGIONS (SNAPSHOT_ALL_REGIONS & ~((1 << SNAPSHOT_REGION_BATTLE_STRUCT)        \
+                                                          | (1 << SNAPSHOT_REGION_BATTLE_SCRIPTING)     \
+                                                          | (1 << SNAPSHOT_REGION_BATTLE_COMMUNICATION) \
+                                                          | (1 << SNAPSHOT_REGION_BATTLE_HISTORY)))
+// What the AI writes while simulating moves and has to be rolled back after it has chosen:
+// GetMovePriority sets pranksterElevated.
+#define SNAPSHOT_AI_ROLLBACK_REGIONS (1 << SNAPSHOT_REGION_PROTECT_STRUCTS)
+// The AI's results go to gBattleStruct and what it learns about its foes to the battle history,
+// it must not change anything else.
+#define SNAPSHOT_AI_UNCHANGED_REGIONS (SNAPSHOT_ALL_REGIONS & ~((1 << SNAPSHOT_REGION_BATTLE_STRUCT)  \
+                                                              | (1 << SNAPSHOT_REGION_BATTLE_HISTORY) \
+                                                              | SNAPSHOT_AI_ROLLBACK_REGIONS))
+
+// Copy of the whole mutable battle state, used to simulate turns and roll them back.
+// Too big for the stack, the AI's one is allocated with the battle resources.
+struct BattleSnapshot
+{
+    u16 version;
+    u16 size;
+    struct BattlePokemon battleMons[MAX_BATTLERS_COUNT];
+    struct BattleStruct battleStruct;
+    u32 sideStatuses[2];
+    struct SideTimer sideTimers[2];
+    u32 fieldStatuses;
+    struct FieldTimer fieldTimers;
+    u16 battleWeather;
+    u32 statuses3[MAX_BATTLERS_COUNT];
+    u32 statuses4[MAX_BATTLERS_COUNT];
+    struct ProtectStruct protectStructs[MAX_BATTLERS_COUNT];
+    struct DisableStruct disableStructs[MAX_BATTLERS_COUNT];
+    struct SpecialStatus specialStatuses[MAX_BATTLERS_COUNT];
+    struct WishFutureKnock wishFutureKnock;
+    u16 lastMoves[MAX_BATTLERS_COUNT];
+    u16 lastLandedMoves[MAX_BATTLERS_COUNT];
+    u16 lastHitByType[MAX_BATTLERS_COUNT];
+    u16 lastResultingMoves[MAX_BATTLERS_COUNT];
+    u16 lockedMoves[MAX_BATTLERS_COUNT];
+    u8 lastHitBy[MAX_BATTLERS_COUNT];
+    u16 battlerPartyIndexes[MAX_BATTLERS_COUNT];
+    struct BattleScripting battleScripting;
+    u32 hitMarker;
+    s32 battleMoveDamage;
+    u8 battleCommunication[BATTLE_COMMUNICATION_ENTRIES_COUNT];
+    struct ResourceFlags resourceFlags;
+    struct BattleScriptsStack scriptsStack;
+    struct BattleCallbacksStack callbacksStack;
+    struct BattleHistory battleHistory;
+    struct Pokemon playerParty[PARTY_SIZE];
+    struct Pokemon enemyParty[PARTY_SIZE];
+};
+
+void SaveBattleSnapshotRegions(struct BattleSnapshot *snapshot, u32 regions);
+void SaveBattleSnapshot(struct BattleSnapshot *snapshot);
+bool32 IsBattleSnapshotValid(const struct BattleSnapshot *snapshot);
+u32 GetBattleSnapshotChangedRegions(const struct BattleSnapshot *snapshot, u32 regions);
+void RestoreBattleSnapshotRegions(const struct BattleSnapshot *snapshot, u32 regions);
+void RestoreBattleSnapshot(const struct BattleSnapshot *snapshot);
+u32 CalcBattleStateHash(u32 regions);
+
+#endif // GUARD_BATTLE_SNAPSHOT_H
@@ -50,6 +50,16 @@ struct TypePower
 
 extern const struct TypePower gNaturalGiftTable[];
 
+// Number of possible random damage rolls (85% to 100%).
+#define DMG_ROLLS_COUNT 16
+
+// Every damage roll of a move, sorted from the lowest to the highest.
+struct DamageRange
+{
+    s32 rolls[DMG_ROLLS_COUNT];
+    s32 critRolls[DMG_ROLLS_COUNT];
+};
+
 s32 CountUsablePartyMons(u8 battlerId);
 void HandleAction_ThrowBall(void);
 bool32 IsAffectedByFollowMe(u32 battlerAtk, u32 defSide, u32 move);
@@ -123,6 +133,8 @@ bool32 IsBattlerAlive(u8 battlerId);
 u8 GetBattleMonMoveSlot(struct BattlePokemon *battleMon, u16 move);
 u32 GetBattlerWeight(u8 battlerId);
 s32 CalculateMoveDamage(u16 move, u8 battlerAtk, u8 battlerDef, u8 moveType, s32 fixedBasePower, bool32 isCrit, bool32 randomFactor, bool32 updateFlags);
+void CalculateMoveDamageRange(u16 move, u8 battlerAtk, u8 battlerDef, u8 moveType, s32 fixedBasePower, struct DamageRange *range);
+u32 CountDamageRollsAtLeast(const s32 *rolls, s32 hp);
 u16 CalcTypeEffectivenessMultiplier(u16 move, u8 moveType, u8 battlerAtk, u8 battlerDef, bool32 recordAbilities);
 u16 CalcPartyMonTypeEffectivenessMultiplier(u16 move, u16 speciesDef, u16 abilityDef);
 u16 GetTypeModifier(u8 atkType, u8 defType);
@@ -0,0 +1,6 @@
+#ifndef GUARD_COMPRESS_H
+#define GUARD_COMPRESS_H
+
+u32 LZCompress(const void *src, u32 size, void *dest, u32 destSize);
+
+#endif // GUARD_COMPRESS_H
@@ -150,6 +150,7 @@
 
 // Other
 #define B_DOUBLE_WILD_CHANCE        0     // % chance of encountering two Pokémon in a Wild Encounter.
+#define B_AI_KO_ROLLS               1     // How many of a move's 16 damage rolls have to knock out the target for the AI to count on the KO. 1 counts the highest roll, as before; 9 needs more than half of them.
 
 // Animation Settings
 #define B_NEW_SWORD_PARTICLE            FALSE    // If set to TRUE, it updates Swords Dance's particle.
@@ -169,5 +170,11 @@
 #define B_NEW_SURF_PARTICLE_PALETTE     FALSE    // If set to TRUE, it updates Surf's wave palette.
 
 #define B_ENABLE_DEBUG                  FALSE    // If set to TRUE, enables a debug menu to use in battles by pressing the Select button.
+#define B_PROFILE_BATTLE_SCRIPTS        FALSE    // If set to TRUE, counts executions and CPU cycles of every battle script command and prints them via AGBPrintf at the end of each battle. Requires NDEBUG to be undefined.
+#define B_CHECK_RECORDED_BATTLES        FALSE    // If set to TRUE, hashes the battle state every turn and compares it when the battle is played back, printing mismatches and the slowest turns via AGBPrintf. Requires NDEBUG to be undefined.
+#define B_CHECK_RECORDED_BATTLE_RUNS    1        // With B_CHECK_RECORDED_BATTLES, how many times in a row a recorded battle is played back when watched, so one recording can be checked repeatedly under emulator fast-forward.
+#define B_FUZZ_RECORDED_BATTLES         0        // With B_CHECK_RECORDED_BATTLES, watching a recorded battle instead plays this many battles between random parties and movesets. Each one is played twice, the second time from the choices made in the first, and desyncs and the slowest turn are printed via AGBPrintf.
+#define B_FUZZ_RECORDED_BATTLES_SEED    0        // The seed of the first battle B_FUZZ_RECORDED_BATTLES plays, so a desynced battle can be replayed on its own. If 0, the seed is taken from the frame counter.
+#define B_CHECK_AI_SNAPSHOTS            FALSE    // If set to TRUE, checks that rolling back the battle state after every AI decision restores it exactly and prints which parts the AI changed via AGBPrintf. Requires NDEBUG to be undefined.
 
 #endif // GUARD_CONSTANTS_BATTLE_CONFIG_H
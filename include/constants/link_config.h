@@ -0,0 +1,9 @@
+#ifndef GUARD_CONSTANTS_LINK_CONFIG_H
+#define GUARD_CONSTANTS_LINK_CONFIG_H
+
+// Link protocol config
+#define LINK_PACKED_RECORD_MIXING   TRUE    // If set to TRUE, record mixing sends LZ compressed records when every player in the group supports it, and the original uncompressed records otherwise.
+#define LINK_BATCHED_BLOCKS         TRUE    // If set to TRUE, cable block transfers between players who all support it start sending data with the block header instead of three frames after it.
+#define LINK_BLOCK_SEND_QUEUE_LIMIT 24      // A cable block transfer waits while this many commands are already queued to send, instead of filling the queue and causing a link error when the link lags.
+
+#endif // GUARD_CONSTANTS_LINK_CONFIG_H
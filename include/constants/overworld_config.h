@@ -0,0 +1,7 @@
+#ifndef GUARD_CONSTANTS_OVERWORLD_CONFIG_H
+#define GUARD_CONSTANTS_OVERWORLD_CONFIG_H
+
+// Object event config
+#define OW_PROFILE_OBJECT_EVENT_SPAWNS  FALSE   // If set to TRUE, prints the live object event count and the CPU cycles spent spawning and despawning object events via AGBPrintf on every camera step. Requires NDEBUG to be undefined.
+
+#endif // GUARD_CONSTANTS_OVERWORLD_CONFIG_H
@@ -18,4 +18,8 @@
 #define P_UPDATED_EGG_GROUPS    GEN_8 // Since Gen 8, certain Pokémon have gained new egg groups.
 #define P_SHEDINJA_BALL         GEN_8 // Since Gen 4, Shedinja requires a Poké Ball for its evolution. In Gen 3, Shedinja inherits Nincada's Ball.
 
+// PC storage settings
+#define P_COMPRESSED_PC_STORAGE FALSE // If TRUE, the PC boxes are compressed when saving, which allows more than 14 boxes in the same save sectors. Saving fails if the boxes don't compress enough to fit.
+#define P_PC_BOXES_COUNT        14    // Number of PC boxes. Only up to 14 fit in the save without P_COMPRESSED_PC_STORAGE.
+
 #endif // GUARD_CONSTANTS_POKEMON_CONFIG_H
@@ -0,0 +1,8 @@
+#ifndef GUARD_CONSTANTS_SOUND_CONFIG_H
+#define GUARD_CONSTANTS_SOUND_CONFIG_H
+
+// Sound mixer config
+#define SOUND_MIXER_FREQ            SOUND_MODE_FREQ_13379   // The DirectSound sample rate, one of the SOUND_MODE_FREQ_* rates except 7884 and 15768. Higher rates sound clearer but take more CPU time each frame and more IWRAM for the mixing buffers.
+#define SOUND_MIXER_HALF_RATE_BAND  FALSE                   // If set to TRUE, channels pitched low enough to lose nothing at half the sample rate are mixed at half the rate and added to the mix together, which makes the rates from 26758 up noticeably cheaper. Only used at rates whose frames are a multiple of 16 samples.
+
+#endif // GUARD_CONSTANTS_SOUND_CONFIG_H
@@ -0,0 +1,10 @@
+#ifndef GUARD_FRONTIER_PARTY_H
+#define GUARD_FRONTIER_PARTY_H
+
+// Returned by DrawFrontierPartyMon when no entry of the set fits the party
+#define FRONTIER_MON_NONE 0xFFFF
+
+u16 GetMaxFrontierMonId(u8 level);
+u16 DrawFrontierPartyMon(const u16 *monSet, u16 maxMonId, const u16 *partySpecies, const u16 *partyItems, s32 partyCount);
+
+#endif // GUARD_FRONTIER_PARTY_H
@@ -198,7 +198,8 @@ struct SoundInfo
     u8 c15;          // periodically counts from 14 down to 0 (15 states)
     u8 pcmDmaPeriod; // number of V-blanks per PCM DMA
     u8 maxLines;
-    u8 gap[3];
+    u8 halfRateBand; // mix low pitched channels at half the rate, see SOUND_MIXER_HALF_RATE_BAND
+    u8 gap[2];
     s32 pcmSamplesPerVBlank;
     s32 pcmFreq;
     s32 divFreq;
@@ -1,6 +1,8 @@
 #ifndef GUARD_LINK_H
 #define GUARD_LINK_H
 
+#include "constants/link_config.h"
+
 #define MAX_LINK_PLAYERS 4
 #define MAX_RFU_PLAYERS 5
 #define CMD_LENGTH 8
@@ -70,6 +72,7 @@
 #define LINKCMD_READY_TO_TRADE          0xAABB
 #define LINKCMD_READY_FINISH_TRADE      0xABCD
 #define LINKCMD_INIT_BLOCK              0xBBBB
+#define LINKCMD_INIT_BLOCK_WITH_DATA    0xBBBD
 #define LINKCMD_READY_CANCEL_TRADE      0xBBCC
 #define LINKCMD_SEND_HELD_KEYS          0xCAFE
 #define LINKCMD_SEND_BLOCK_REQ          0xCCCC
@@ -163,7 +166,7 @@ struct LinkPlayer
     /* 0x04 */ u32 trainerId;
     /* 0x08 */ u8 name[PLAYER_NAME_LENGTH + 1];
     /* 0x10 */ u8 progressFlags; // (& 0x0F) is hasNationalDex, (& 0xF0) is hasClearedGame
-    /* 0x11 */ u8 neverRead;
+    /* 0x11 */ u8 features; // LINK_FEATURE_* flags. Always 0 from Ruby/Sapphire and unmodified games.
     /* 0x12 */ u8 progressFlagsCopy;
     /* 0x13 */ u8 gender;
     /* 0x14 */ u32 linkType;
@@ -171,6 +174,11 @@ struct LinkPlayer
     /* 0x1A */ u16 language;
 };
 
+// Protocol extensions a player supports. One is only used if every player in
+// the group supports it.
+#define LINK_FEATURE_PACKED_RECORDS (1 << 0)
+#define LINK_FEATURE_BATCHED_BLOCKS (1 << 1)
+
 struct LinkPlayerBlock
 {
     char magic1[16];
@@ -221,6 +229,19 @@ struct Link
     /* 0x33c */ struct RecvQueue recvQueue;
 };
 
+// Counters for tuning the link. Reset by OpenLink.
+struct LinkQueueStats
+{
+    u8 maxSendQueue;
+    u8 maxRecvQueue;
+    u16 sendQueueFull;
+    u16 recvQueueFull;
+    u16 recvStalls; // frames with nothing received
+    u16 blockSendThrottled; // frames a block waited for the send queue
+    u16 blockResends; // wireless block chunks sent again
+    u16 batchedBlocks;
+};
+
 struct BlockRequest
 {
     void * address;
@@ -328,6 +349,7 @@ extern u16 gLinkTestBlockChecksums[MAX_LINK_PLAYERS];
 extern u8 gBlockRequestType;
 extern u8 gLastSendQueueCount;
 extern u8 gLastRecvQueueCount;
+extern struct LinkQueueStats gLinkQueueStats;
 extern u16 gLinkSavedIme;
 extern u32 gFiller_03003074;
 extern u32 gFiller_03003154;
@@ -339,6 +361,7 @@ extern u32 gFiller_03003080;
 extern struct LinkPlayer gLocalLinkPlayer;
 
 bool32 Link_AnyPartnersPlayingRubyOrSapphire(void);
+bool32 Link_AllPlayersHaveFeatures(u8 features);
 bool32 LinkDummy_Return2(void);
 void SetLocalLinkPlayerId(u8);
 u8 GetSavedPlayerCount(void);
@@ -109,6 +109,25 @@ struct BoxPokemon
     } secure;
 };
 
+// Pointers to the substructs of a decrypted BoxPokemon.
+struct BoxMonSubstructs
+{
+    struct PokemonSubstruct0 *type0;
+    struct PokemonSubstruct1 *type1;
+    struct PokemonSubstruct2 *type2;
+    struct PokemonSubstruct3 *type3;
+};
+
+// Decrypted copy of a BoxPokemon, see DecodeBoxMon.
+struct DecodedBoxMon
+{
+    struct BoxPokemon *src;
+    struct BoxPokemon box;
+    struct BoxMonSubstructs substructs;
+    bool8 isValid;
+    bool8 isModified;
+};
+
 struct Pokemon
 {
     struct BoxPokemon box;
@@ -290,6 +309,7 @@ extern const u16 gLinkPlayerFacilityClasses[];
 extern const struct SpriteTemplate gBattlerSpriteTemplates[];
 extern const s8 gNatureStatTable[][5];
 extern const u16 gSpeciesToNationalPokedexNum[NUM_SPECIES];
+extern const u16 gNationalPokedexNumToSpecies[NATIONAL_DEX_COUNT];
 
 void ZeroBoxMonData(struct BoxPokemon *boxMon);
 void ZeroMonData(struct Pokemon *mon);
@@ -317,6 +337,7 @@ void CalculateMonStats(struct Pokemon *mon);
 void BoxMonToMon(const struct BoxPokemon *src, struct Pokemon *dest);
 u8 GetLevelFromMonExp(struct Pokemon *mon);
 u8 GetLevelFromBoxMonExp(struct BoxPokemon *boxMon);
+u8 GetLevelFromSpeciesAndExp(u16 species, u32 exp);
 u16 GiveMoveToMon(struct Pokemon *mon, u16 move);
 u16 GiveMoveToBoxMon(struct BoxPokemon *boxMon, u16 move);
 u16 GiveMoveToBattleMon(struct BattlePokemon *mon, u16 move);
@@ -355,6 +376,10 @@ u32 GetBoxMonData();
 
 void SetMonData(struct Pokemon *mon, s32 field, const void *dataArg);
 void SetBoxMonData(struct BoxPokemon *boxMon, s32 field, const void *dataArg);
+void DecodeBoxMon(struct DecodedBoxMon *mon, struct BoxPokemon *boxMon);
+u32 GetDecodedBoxMonData(struct DecodedBoxMon *mon, s32 field, u8 *data);
+void SetDecodedBoxMonData(struct DecodedBoxMon *mon, s32 field, const void *data);
+void CommitDecodedBoxMon(struct DecodedBoxMon *mon);
 void CopyMon(void *dest, void *src, size_t size);
 u8 GiveMonToPlayer(struct Pokemon *mon);
 u8 SendMonToPC(struct Pokemon* mon);
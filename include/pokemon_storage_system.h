@@ -1,11 +1,25 @@
 #ifndef GUARD_POKEMON_STORAGE_SYSTEM_H
 #define GUARD_POKEMON_STORAGE_SYSTEM_H
 
-#define TOTAL_BOXES_COUNT       14
+#include "constants/pokemon_config.h"
+
+#if P_PC_BOXES_COUNT > 14 && !P_COMPRESSED_PC_STORAGE
+#error "More than 14 PC boxes require P_COMPRESSED_PC_STORAGE"
+#endif
+
+#define TOTAL_BOXES_COUNT       P_PC_BOXES_COUNT
 #define IN_BOX_ROWS             5 // Number of rows, 6 Pokémon per row
 #define IN_BOX_COLUMNS          6 // Number of columns, 5 Pokémon per column
 #define IN_BOX_COUNT            (IN_BOX_ROWS * IN_BOX_COLUMNS)
 
+// Keys for SortStorageBoxes and SearchStorageMons
+#define STORAGE_SORT_SPECIES    0
+#define STORAGE_SORT_DEX_NUM    1
+#define STORAGE_SORT_LEVEL      2
+#define STORAGE_SORT_TYPE       3
+#define STORAGE_SORT_ITEM       4
+#define STORAGE_SORT_NATURE     5
+
 /* 
             COLUMNS         
 ROWS        0   1   2   3   4   5
@@ -18,7 +32,7 @@ ROWS        0   1   2   3   4   5
 struct PokemonStorage
 {
     /*0x0000*/ u8 currentBox;
-    /*0x0001*/ struct BoxPokemon boxes[TOTAL_BOXES_COUNT][IN_BOX_COUNT];
+    /*0x0004*/ struct BoxPokemon boxes[TOTAL_BOXES_COUNT][IN_BOX_COUNT];
     /*0x8344*/ u8 boxNames[TOTAL_BOXES_COUNT][9];
     /*0x83C2*/ u8 boxWallpapers[TOTAL_BOXES_COUNT];
 };
@@ -27,6 +41,8 @@ extern struct PokemonStorage *gPokemonStoragePtr;
 
 void DrawTextWindowAndBufferTiles(const u8 *string, void *dst, u8 arg2, u8 arg3, s32 bytesToBuffer);
 u8 CountMonsInBox(u8 boxId);
+u16 CountStorageMons(void);
+bool8 CanStorageHoldAnotherMon(void);
 s16 GetFirstFreeBoxSpot(u8 boxId);
 u8 CountPartyAliveNonEggMonsExcept(u8 slotToIgnore);
 u16 CountPartyAliveNonEggMons_IgnoreVar0x8004Slot(void);
@@ -50,6 +66,8 @@ void CreateBoxMonAt(u8 boxId, u8 boxPosition, u16 species, u8 level, u8 fixedIV,
 void ZeroBoxMonAt(u8 boxId, u8 boxPosition);
 void BoxMonAtToMon(u8 boxId, u8 boxPosition, struct Pokemon *dst);
 struct BoxPokemon *GetBoxedMonPtr(u8 boxId, u8 boxPosition);
+void UpdateStorageIndexAt(u8 boxId, u8 boxPosition);
+void InvalidateStorageIndex(void);
 u8 *GetBoxNamePtr(u8 boxId);
 s16 AdvanceStorageMonIndex(struct BoxPokemon *boxMons, u8 currIndex, u8 maxIndex, u8 arg3);
 bool8 CheckFreePokemonStorageSpace(void);
@@ -57,6 +75,8 @@ bool32 CheckBoxMonSanityAt(u32 boxId, u32 boxPosition);
 u32 CountStorageNonEggMons(void);
 u32 CountAllStorageMons(void);
 bool32 AnyStorageMonWithMove(u16 moveId);
+bool32 SortStorageBoxes(u8 firstBox, u8 lastBox, u8 sortBy);
+u16 SearchStorageMons(u8 searchBy, u16 value, u16 *results, u16 maxResults);
 
 void ResetWaldaWallpaper(void);
 void SetWaldaWallpaperLockedOrUnlocked(bool32 unlocked);
@@ -0,0 +1,7 @@
+#ifndef GUARD_PROFILE_H
+#define GUARD_PROFILE_H
+
+void StartProfileTimer(void);
+u32 StopProfileTimer(void);
+
+#endif // GUARD_PROFILE_H
@@ -39,5 +39,7 @@ u8 GetRecordedBattleRecordMixFriendLanguage(void);
 u8 GetRecordedBattleApprenticeLanguage(void);
 void RecordedBattle_SaveBattleOutcome(void);
 u16 *GetRecordedBattleEasyChatSpeech(void);
+void RecordedBattle_CheckTurn(void);
+void RecordedBattle_PrintTurnChecks(void);
 
 #endif // GUARD_RECORDED_BATTLE_H
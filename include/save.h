@@ -34,6 +34,18 @@ struct SaveSectionOffsets
 #define SECTOR_FOOTER_SIZE 128
 #define SECTOR_SIZE (SECTOR_DATA_SIZE + SECTOR_FOOTER_SIZE)
 
+// With P_COMPRESSED_PC_STORAGE, each PC storage sector holds this header and
+// a piece of PokemonStorage encoded by PackStorageData.
+struct PackedStorageSection
+{
+    u16 signature;
+    u16 size;   // Number of bytes of PokemonStorage that data decodes to
+    u32 offset; // Where in PokemonStorage those bytes go
+    u8 data[SECTOR_DATA_SIZE - 8];
+};
+
+#define PACKED_STORAGE_SIGNATURE 0x5043
+
 // Emerald changes this definition to be the sectors per slot.
 #define NUM_SECTORS_PER_SLOT 16
 
@@ -97,8 +109,12 @@ void ClearSaveData(void);
 void Save_ResetSaveCounters(void);
 u8 HandleSavingData(u8 saveType);
 u8 TrySavingData(u8 saveType);
+void TrySavingDataInBackground(u8 saveType, void (*callback)(u8 status));
 bool8 sub_8153380(void);
 bool8 sub_81533AC(void);
+bool8 IsPokemonStorageTooLargeToSave(void);
+bool8 DoesPokemonStorageFitInSave(void);
+bool8 IsStorageMonCountSaveable(u32 monCount);
 bool8 sub_81533E0(void);
 bool8 sub_8153408(void);
 bool8 FullSaveGame(void);
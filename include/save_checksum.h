@@ -0,0 +1,7 @@
+#ifndef GUARD_SAVE_CHECKSUM_H
+#define GUARD_SAVE_CHECKSUM_H
+
+u16 CalculateChecksum(const void *data, u16 size);
+u16 CopySaveSectionData(void *dest, const void *src, u16 size);
+
+#endif // GUARD_SAVE_CHECKSUM_H
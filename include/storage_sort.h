@@ -0,0 +1,22 @@
+#ifndef GUARD_STORAGE_SORT_H
+#define GUARD_STORAGE_SORT_H
+
+// Passed to the move callback of ApplyStorageSortOrder for the spare slot a cycle is rotated through
+#define STORAGE_SORT_TEMP_SLOT 0xFFFF
+
+// Eggs sort after all Pokémon, and empty slots after the Eggs
+#define STORAGE_SORT_KEY_EGG   0xFFFFFFFE
+#define STORAGE_SORT_KEY_EMPTY 0xFFFFFFFF
+
+struct StorageSortEntry
+{
+    u32 key;
+    u16 slot;
+};
+
+u32 GetStorageSortKeyFromValue(u32 value, u8 sortBy);
+void SortStorageEntries(struct StorageSortEntry *entries, u16 count);
+u16 SearchStorageEntries(const struct StorageSortEntry *entries, u16 count, u8 searchBy, u16 value, u16 *results, u16 maxResults);
+void ApplyStorageSortOrder(struct StorageSortEntry *entries, u16 first, u16 count, void (*moveSlot)(u16 dst, u16 src));
+
+#endif // GUARD_STORAGE_SORT_H
@@ -2187,6 +2187,14 @@ extern const u8 gPCText_PolkaDot[];
 extern const u8 gPCText_Pokecenter[];
 extern const u8 gPCText_Machine[];
 extern const u8 gPCText_Simple[];
+extern const u8 gPCText_Sort[];
+extern const u8 gPCText_SortSpecies[];
+extern const u8 gPCText_SortDexNum[];
+extern const u8 gPCText_SortLevel[];
+extern const u8 gPCText_SortType[];
+extern const u8 gPCText_SortItem[];
+extern const u8 gPCText_SortNature[];
+extern const u8 gText_SortBoxByWhat[];
 extern const u8 gText_PartyFull[];
 extern const u8 gText_Box[];
 extern const u8 gText_JustOnePkmn[];
@@ -2306,6 +2314,7 @@ extern const u8 gText_ByeByeVar1[];
 extern const u8 gText_XSentOverY[];
 extern const u8 gText_TakeGoodCareOfX[];
 extern const u8 gText_CommunicationStandby5[];
+extern const u8 gText_BoxesTooFullToSave[];
 
 // match call
 extern const u8 MatchCall_WildBattleText1[];
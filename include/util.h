@@ -6,6 +6,16 @@
 extern const u8 gMiscBlank_Gfx[]; // unused in Emerald
 extern const u32 gBitTable[];
 
+// Spreads the channels of an RGB555 color 10 bits apart, so that all three
+// can be blended with a single multiply. See BlendPalette.
+#define SPREAD_RGB(color)    (((color) & 0x1F) | (((color) & 0x3E0) << 5) | (((color) & 0x7C00) << 10))
+#define UNSPREAD_RGB(spread) (((spread) & 0x1F) | (((spread) >> 5) & 0x3E0) | (((spread) >> 10) & 0x7C00))
+
+// Same result as c + (((blend - c) * coeff) >> 4) for each channel, for coeff 0-16.
+// spreadBlend is SPREAD_RGB(blendColor) * coeff, which is the same for every color.
+#define BLEND_SPREAD_RGB(spreadColor, coeff, spreadBlend) \
+    (((((spreadColor) * (16 - (coeff))) + (spreadBlend)) >> 4) & 0x1F07C1F)
+
 u8 CreateInvisibleSpriteWithCallback(void (*)(struct Sprite *));
 void StoreWordInTwoHalfwords(u16 *, u32);
 void LoadWordFromTwoHalfwords(u16 *, u32 *);
@@ -4,6 +4,7 @@
 #include "battle_anim.h"
 #include "battle_ai_util.h"
 #include "battle_ai_main.h"
+#include "battle_snapshot.h"
 #include "battle_factory.h"
 #include "battle_setup.h"
 #include "data.h"
@@ -149,6 +150,7 @@ void BattleAI_SetupFlags(void)
 void BattleAI_SetupAIData(u8 defaultScoreMoves)
 {
     s32 i, move, dmg;
+    s32 koDmg;
     u8 moveLimitations;
 
     // Clear AI data but preserve the flags.
@@ -185,15 +187,19 @@ void BattleAI_SetupAIData(u8 defaultScoreMoves)
         for (i = 0; i < MAX_MON_MOVES; i++)
         {
             dmg = 0;
+            koDmg = 0;
             move = gBattleMons[sBattler_AI].moves[i];
             if (gBattleMoves[move].power != 0 && !(moveLimitations & gBitTable[i]))
             {
-                dmg = AI_CalcDamage(move, sBattler_AI, gBattlerTarget);
+                dmg = AI_CalcDamageAndKoDamage(move, sBattler_AI, gBattlerTarget, &koDmg);
                 if (dmg == 0)
                     dmg = 1;
+                if (koDmg == 0)
+                    koDmg = 1;
             }
 
             AI_THINKING_STRUCT->simulatedDmg[sBattler_AI][gBattlerTarget][i] = dmg;
+            AI_THINKING_STRUCT->simulatedKoDmg[sBattler_AI][gBattlerTarget][i] = koDmg;
         }
     }
 
@@ -203,17 +209,36 @@ void BattleAI_SetupAIData(u8 defaultScoreMoves)
 u8 BattleAI_ChooseMoveOrAction(void)
 {
     u32 savedCurrentMove = gCurrentMove;
+    struct BattleSnapshot *snapshot = gBattleResources->aiSnapshot;
     u8 ret;
+#if B_CHECK_AI_SNAPSHOTS
+    u32 i, hashes[SNAPSHOT_REGIONS_COUNT];
+
+    for (i = 0; i < SNAPSHOT_REGIONS_COUNT; i++)
+        hashes[i] = CalcBattleStateHash(1 << i);
+#endif
+
+    SaveBattleSnapshotRegions(snapshot, SNAPSHOT_AI_ROLLBACK_REGIONS);
 
     if (!(gBattleTypeFlags & BATTLE_TYPE_DOUBLE))
         ret = ChooseMoveOrAction_Singles();
     else
         ret = ChooseMoveOrAction_Doubles();
-    
-    // Clear protect structures, some flags may be set during AI calcs
-    // e.g. pranksterElevated from GetMovePriority
-    memset(&gProtectStructs[gActiveBattler], 0, sizeof(struct ProtectStruct));
-    
+
+    // Roll back what the AI calcs are known to change, e.g. pranksterElevated from GetMovePriority
+    RestoreBattleSnapshotRegions(snapshot, GetBattleSnapshotChangedRegions(snapshot, SNAPSHOT_AI_ROLLBACK_REGIONS));
+#if B_CHECK_AI_SNAPSHOTS
+    // Anything else the AI changed is a bug to fix in the AI, not to roll back.
+    for (i = 0; i < SNAPSHOT_REGIONS_COUNT; i++)
+    {
+        if (((SNAPSHOT_AI_UNCHANGED_REGIONS | SNAPSHOT_AI_ROLLBACK_REGIONS) & (1 << i)) && CalcBattleStateHash(1 << i) != hashes[i])
+        {
+            AGBPrintf("AI %d changed region %d\n", gActiveBattler, i);
+            AGB_ASSERT(FALSE);
+        }
+    }
+#endif
+
     gCurrentMove = savedCurrentMove;
     return ret;
 }
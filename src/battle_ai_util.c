@@ -20,6 +20,10 @@
 #include "constants/moves.h"
 #include "constants/items.h"
 
+#if B_AI_KO_ROLLS < 1 || B_AI_KO_ROLLS > DMG_ROLLS_COUNT
+#error "B_AI_KO_ROLLS has to be between 1 and DMG_ROLLS_COUNT"
+#endif
+
 // Const Data
 static const s8 sAiAbilityRatings[ABILITIES_COUNT] =
 {
@@ -705,9 +709,19 @@ static bool32 AI_GetIfCrit(u32 move, u8 battlerAtk, u8 battlerDef)
 }
 
 s32 AI_CalcDamage(u16 move, u8 battlerAtk, u8 battlerDef)
+{
+    return AI_CalcDamageAndKoDamage(move, battlerAtk, battlerDef, NULL);
+}
+
+// Like AI_CalcDamage, and also gives the damage of the roll B_AI_KO_ROLLS from the
+// top, which the KO checks use. Crits are weighed the same way as for the damage.
+s32 AI_CalcDamageAndKoDamage(u16 move, u8 battlerAtk, u8 battlerDef, s32 *koDmg)
 {
     s32 dmg, moveType, critDmg, normalDmg;
     s8 critChance;
+    struct DamageRange range;
+    s32 hits = 1;
+    bool32 fixedDmg = FALSE;
 
     SaveBattlerData(battlerAtk);
     SaveBattlerData(battlerDef);
@@ -720,8 +734,9 @@ s32 AI_CalcDamage(u16 move, u8 battlerAtk, u8 battlerDef)
     GET_MOVE_TYPE(move, moveType);
 
     critChance = GetInverseCritChance(battlerAtk, battlerDef, move);
-    normalDmg = CalculateMoveDamage(move, battlerAtk, battlerDef, moveType, 0, FALSE, FALSE, FALSE);
-    critDmg = CalculateMoveDamage(move, battlerAtk, battlerDef, moveType, 0, TRUE, FALSE, FALSE);
+    CalculateMoveDamageRange(move, battlerAtk, battlerDef, moveType, 0, &range);
+    normalDmg = range.rolls[DMG_ROLLS_COUNT - 1];
+    critDmg = range.critRolls[DMG_ROLLS_COUNT - 1];
 
     if(critChance == -1)
         dmg = normalDmg;
@@ -734,38 +749,63 @@ s32 AI_CalcDamage(u16 move, u8 battlerAtk, u8 battlerDef)
     case EFFECT_LEVEL_DAMAGE:
     case EFFECT_PSYWAVE:
         dmg = gBattleMons[battlerAtk].level * (AI_DATA->atkAbility == ABILITY_PARENTAL_BOND ? 2 : 1);
+        fixedDmg = TRUE;
         break;
     case EFFECT_DRAGON_RAGE:
         dmg = 40 * (AI_DATA->atkAbility == ABILITY_PARENTAL_BOND ? 2 : 1);
+        fixedDmg = TRUE;
         break;
     case EFFECT_SONICBOOM:
         dmg = 20 * (AI_DATA->atkAbility == ABILITY_PARENTAL_BOND ? 2 : 1);
+        fixedDmg = TRUE;
         break;
     case EFFECT_MULTI_HIT:
-        dmg *= (AI_DATA->atkAbility == ABILITY_SKILL_LINK ? 5 : 3);
+        hits = (AI_DATA->atkAbility == ABILITY_SKILL_LINK ? 5 : 3);
         break;
     case EFFECT_TRIPLE_KICK:
-        dmg *= (AI_DATA->atkAbility == ABILITY_SKILL_LINK ? 6 : 5);
+        hits = (AI_DATA->atkAbility == ABILITY_SKILL_LINK ? 6 : 5);
         break;
     case EFFECT_ENDEAVOR:
         // If target has less HP than user, Endeavor does no damage
         dmg = max(0, gBattleMons[battlerDef].hp - gBattleMons[battlerAtk].hp);
+        fixedDmg = TRUE;
         break;
     case EFFECT_SUPER_FANG:
         dmg = (AI_DATA->atkAbility == ABILITY_PARENTAL_BOND
             ? max(2, gBattleMons[battlerDef].hp * 3 / 4)
             : max(1, gBattleMons[battlerDef].hp / 2));
+        fixedDmg = TRUE;
         break;
     case EFFECT_FINAL_GAMBIT:
         dmg = gBattleMons[battlerAtk].hp;
+        fixedDmg = TRUE;
         break;
     }
 
     // Handle other multi-strike moves
     if (gBattleMoves[move].flags & FLAG_TWO_STRIKES)
-        dmg *= 2;
+        hits *= 2;
     else if (move == MOVE_SURGING_STRIKES || (move == MOVE_WATER_SHURIKEN && gBattleMons[battlerAtk].species == SPECIES_GRENINJA_ASH))
-        dmg *= 3;
+        hits *= 3;
+
+    if (koDmg != NULL)
+    {
+        if (fixedDmg)
+        {
+            *koDmg = dmg * hits;
+        }
+        else
+        {
+            normalDmg = range.rolls[DMG_ROLLS_COUNT - B_AI_KO_ROLLS];
+            critDmg = range.critRolls[DMG_ROLLS_COUNT - B_AI_KO_ROLLS];
+            if (critChance == -1)
+                *koDmg = normalDmg * hits;
+            else
+                *koDmg = (critDmg + normalDmg * (critChance - 1)) / critChance * hits;
+        }
+    }
+
+    dmg *= hits;
 
     RestoreBattlerData(battlerAtk);
     RestoreBattlerData(battlerDef);
@@ -1056,8 +1096,8 @@ bool32 CanAIFaintTarget(u8 battlerAtk, u8 battlerDef, u8 numHits)
     {
         if (moves[i] != MOVE_NONE && moves[i] != 0xFFFF && !(moveLimitations & gBitTable[i]))
         {
-            // Use the pre-calculated value in simulatedDmg instead of re-calculating it
-            dmg = AI_THINKING_STRUCT->simulatedDmg[battlerAtk][battlerDef][i];
+            // Use the pre-calculated value in simulatedKoDmg instead of re-calculating it
+            dmg = AI_THINKING_STRUCT->simulatedKoDmg[battlerAtk][battlerDef][i];
 
             if (numHits)
                 dmg *= numHits;
@@ -1815,11 +1855,11 @@ bool32 ShouldLowerEvasion(u8 battlerAtk, u8 battlerDef, u16 defAbility)
 
 bool32 CanIndexMoveFaintTarget(u8 battlerAtk, u8 battlerDef, u8 index, u8 numHits)
 {
-    s32 dmg = AI_THINKING_STRUCT->simulatedDmg[battlerAtk][battlerDef][index];
-    
+    s32 dmg = AI_THINKING_STRUCT->simulatedKoDmg[battlerAtk][battlerDef][index];
+
     if (numHits)
         dmg *= numHits;
-    
+
     if (gBattleMons[battlerDef].hp <= dmg)
         return TRUE;
     return FALSE;
@@ -39,6 +39,7 @@ static void GetOpponentMostCommonMonType(void);
 static void GetOpponentBattleStyle(void);
 static void RestorePlayerPartyHeldItems(void);
 static u16 GetFactoryMonId(u8 lvlMode, u8 challengeNum, bool8 useBetterRange);
+static void GetFactoryMonIdRange(u8 lvlMode, u8 challengeNum, bool8 useBetterRange, u16 *firstMonId, u16 *lastMonId);
 static u8 GetMoveBattleStyle(u16 move);
 
 // Number of moves needed on the team to be considered using a certain battle style
@@ -300,12 +301,39 @@ static void SetPerformedRentalSwap(void)
     sPerformedRentalSwap = TRUE;
 }
 
+static bool32 IsFactoryOpponentMonAllowed(u16 monId, u32 lvlMode, const u16 *species, const u16 *heldItems, s32 partyCount)
+{
+    s32 i;
+    u16 heldItem = gBattleFrontierHeldItems[gFacilityTrainerMons[monId].itemTableId];
+
+    if (gFacilityTrainerMons[monId].species == SPECIES_UNOWN)
+        return FALSE;
+    if (lvlMode == FRONTIER_LVL_50 && monId > FRONTIER_MONS_HIGH_TIER)
+        return FALSE;
+
+    for (i = 0; i < PARTY_SIZE; i++)
+    {
+        if (gFacilityTrainerMons[monId].species == gFacilityTrainerMons[gSaveBlock2Ptr->frontier.rentalMons[i].monId].species)
+            return FALSE;
+    }
+
+    for (i = 0; i < partyCount; i++)
+    {
+        if (species[i] == gFacilityTrainerMons[monId].species)
+            return FALSE;
+        if (heldItems[i] != 0 && heldItems[i] == heldItem)
+            return FALSE;
+    }
+
+    return TRUE;
+}
+
 static void GenerateOpponentMons(void)
 {
-    int i, j, k;
+    int i;
     u16 species[FRONTIER_PARTY_SIZE];
     u16 heldItems[FRONTIER_PARTY_SIZE];
-    int firstMonId = 0;
+    u16 firstRangeMonId, lastRangeMonId;
     u16 trainerId = 0;
     u32 lvlMode = gSaveBlock2Ptr->frontier.lvlMode;
     u32 battleMode = VarGet(VAR_FRONTIER_BATTLE_MODE);
@@ -327,44 +355,38 @@ static void GenerateOpponentMons(void)
     if (gSaveBlock2Ptr->frontier.curChallengeBattleNum < 6)
         gSaveBlock2Ptr->frontier.trainerIds[gSaveBlock2Ptr->frontier.curChallengeBattleNum] = trainerId;
 
-    i = 0;
-    while (i != FRONTIER_PARTY_SIZE)
+    // Each mon is drawn directly among the allowed mons of the challenge's range: no Unown, nothing the
+    // player rents, nothing past the level 50 tier and no duplicate species or held items in the party.
+    GetFactoryMonIdRange(lvlMode, challengeNum, FALSE, &firstRangeMonId, &lastRangeMonId);
+    for (i = 0; i < FRONTIER_PARTY_SIZE; i++)
     {
-        u16 monId = GetFactoryMonId(lvlMode, challengeNum, FALSE);
-        if (gFacilityTrainerMons[monId].species == SPECIES_UNOWN)
-            continue;
+        u16 monId;
+        s32 validCount = 0, pick;
 
-        for (j = 0; j < 6; j++)
+        for (monId = firstRangeMonId; monId <= lastRangeMonId; monId++)
         {
-            if (gFacilityTrainerMons[monId].species == gFacilityTrainerMons[gSaveBlock2Ptr->frontier.rentalMons[j].monId].species)
-                break;
+            if (IsFactoryOpponentMonAllowed(monId, lvlMode, species, heldItems, i))
+                validCount++;
         }
-        if (j != 6)
-            continue;
 
-        if (lvlMode == FRONTIER_LVL_50 && monId > FRONTIER_MONS_HIGH_TIER)
-            continue;
-
-        for (k = firstMonId; k < firstMonId + i; k++)
+        if (validCount == 0)
         {
-            if (species[k] == gFacilityTrainerMons[monId].species)
-                break;
+            // Can't happen with the vanilla ranges, which are much bigger than a party.
+            monId = GetFactoryMonId(lvlMode, challengeNum, FALSE);
         }
-        if (k != firstMonId + i)
-            continue;
-
-        for (k = firstMonId; k < firstMonId + i; k++)
+        else
         {
-            if (heldItems[k] != 0 && heldItems[k] == gBattleFrontierHeldItems[gFacilityTrainerMons[monId].itemTableId])
-                break;
+            pick = Random() % validCount;
+            for (monId = firstRangeMonId; monId <= lastRangeMonId; monId++)
+            {
+                if (IsFactoryOpponentMonAllowed(monId, lvlMode, species, heldItems, i) && pick-- == 0)
+                    break;
+            }
         }
-        if (k != firstMonId + i)
-            continue;
 
         species[i] = gFacilityTrainerMons[monId].species;
         heldItems[i] = gBattleFrontierHeldItems[gFacilityTrainerMons[monId].itemTableId];
         gFrontierTempParty[i] = monId;
-        i++;
     }
 }
 
@@ -803,9 +825,9 @@ void FillFactoryBrainParty(void)
     }
 }
 
-static u16 GetFactoryMonId(u8 lvlMode, u8 challengeNum, bool8 useBetterRange)
+static void GetFactoryMonIdRange(u8 lvlMode, u8 challengeNum, bool8 useBetterRange, u16 *firstMonId, u16 *lastMonId)
 {
-    u16 numMons, monId;
+    u16 range;
     u16 adder; // Used to skip past early mons for open level
 
     if (lvlMode == FRONTIER_LVL_50)
@@ -814,32 +836,20 @@ static u16 GetFactoryMonId(u8 lvlMode, u8 challengeNum, bool8 useBetterRange)
         adder = 8;
 
     if (challengeNum < 7)
-    {
-        if (useBetterRange)
-        {
-            numMons = (sInitialRentalMonRanges[adder + challengeNum + 1][1] - sInitialRentalMonRanges[adder + challengeNum + 1][0]) + 1;
-            monId = Random() % numMons;
-            monId += sInitialRentalMonRanges[adder + challengeNum + 1][0];
-        }
-        else
-        {
-            numMons = (sInitialRentalMonRanges[adder + challengeNum][1] - sInitialRentalMonRanges[adder + challengeNum][0]) + 1;
-            monId = Random() % numMons;
-            monId += sInitialRentalMonRanges[adder + challengeNum][0];
-        }
-    }
+        range = adder + challengeNum + (useBetterRange ? 1 : 0);
     else
-    {
-        u16 challenge = challengeNum;
-        if (challenge != 7)
-            challenge = 7; // why bother assigning it above at all
+        range = adder + 7;
 
-        numMons = (sInitialRentalMonRanges[adder + challenge][1] - sInitialRentalMonRanges[adder + challenge][0]) + 1;
-        monId = Random() % numMons;
-        monId += sInitialRentalMonRanges[adder + challenge][0];
-    }
+    *firstMonId = sInitialRentalMonRanges[range][0];
+    *lastMonId = sInitialRentalMonRanges[range][1];
+}
+
+static u16 GetFactoryMonId(u8 lvlMode, u8 challengeNum, bool8 useBetterRange)
+{
+    u16 firstMonId, lastMonId;
 
-    return monId;
+    GetFactoryMonIdRange(lvlMode, challengeNum, useBetterRange, &firstMonId, &lastMonId);
+    return firstMonId + Random() % (lastMonId - firstMonId + 1);
 }
 
 u8 GetNumPastRentalsRank(u8 battleMode, u8 lvlMode)
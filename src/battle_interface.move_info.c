@@ -273,7 +273,9 @@ struct PotentialDamage CalcPotentialDamage(u16 move) {
     u8 moveType;
     GET_MOVE_TYPE(move, moveType);
 
-    u32 dmg = CalculateMoveDamage(move, gActiveBattler, targetId, moveType, 0, FALSE, FALSE, FALSE);
+    struct DamageRange range;
+    CalculateMoveDamageRange(move, gActiveBattler, targetId, moveType, 0, &range);
+    u32 dmg = range.rolls[DMG_ROLLS_COUNT - 1];
     struct Pokemon* target = &gEnemyParty[gBattlerPartyIndexes[targetId]];
 
     u32 atkSpeed = GetBattlerTotalSpeedStat(gActiveBattler);
@@ -287,9 +289,8 @@ struct PotentialDamage CalcPotentialDamage(u16 move) {
     else
         speed = TIE;
 
-    u32 minDmg = dmg * 86 / 100;
+    u32 minDmg = range.rolls[0];
 
-    u32 percentage = dmg * 1000 / target->maxHP;
     struct PotentialDamage ret = {
         .min = minDmg * 1000 / target->maxHP,
         .max = dmg * 1000 / target->maxHP,
@@ -560,6 +560,7 @@ static void CB2_InitBattleInternal(void)
     SetVBlankCallback(NULL);
 
     CpuFill32(0, (void*)(VRAM), VRAM_SIZE);
+    BattleScriptProfiler_Reset();
 
     SetGpuReg(REG_OFFSET_MOSAIC, 0);
     SetGpuReg(REG_OFFSET_WIN0H, DISPLAY_WIDTH);
@@ -3786,6 +3787,8 @@ void BattleTurnPassed(void)
     for (i = 0; i < 5; i++)
         gBattleCommunication[i] = 0;
 
+    RecordedBattle_CheckTurn();
+
     if (gBattleOutcome != 0)
     {
         gCurrentActionFuncId = B_ACTION_FINISHED;
@@ -4314,7 +4317,7 @@ static void HandleTurnActionSelectionState(void)
                 gBattlescriptCurrInstr = gSelectionBattleScripts[gActiveBattler];
                 if (!(gBattleControllerExecFlags & ((gBitTable[gActiveBattler]) | (0xF << 28) | (gBitTable[gActiveBattler] << 4) | (gBitTable[gActiveBattler] << 8) | (gBitTable[gActiveBattler] << 12))))
                 {
-                    gBattleScriptingCommandsTable[gBattlescriptCurrInstr[0]]();
+                    RUN_BATTLE_SCRIPT_COMMAND();
                 }
                 gSelectionBattleScripts[gActiveBattler] = gBattlescriptCurrInstr;
             }
@@ -4346,7 +4349,7 @@ static void HandleTurnActionSelectionState(void)
                 gBattlescriptCurrInstr = gSelectionBattleScripts[gActiveBattler];
                 if (!(gBattleControllerExecFlags & ((gBitTable[gActiveBattler]) | (0xF << 28) | (gBitTable[gActiveBattler] << 4) | (gBitTable[gActiveBattler] << 8) | (gBitTable[gActiveBattler] << 12))))
                 {
-                    gBattleScriptingCommandsTable[gBattlescriptCurrInstr[0]]();
+                    RUN_BATTLE_SCRIPT_COMMAND();
                 }
                 gSelectionBattleScripts[gActiveBattler] = gBattlescriptCurrInstr;
             }
@@ -5166,7 +5169,7 @@ static void HandleEndTurn_FinishBattle(void)
     else
     {
         if (gBattleControllerExecFlags == 0)
-            gBattleScriptingCommandsTable[gBattlescriptCurrInstr[0]]();
+            RUN_BATTLE_SCRIPT_COMMAND();
     }
 }
 
@@ -5174,6 +5177,8 @@ static void FreeResetData_ReturnToOvOrDoEvolutions(void)
 {
     if (!gPaletteFade.active)
     {
+        BattleScriptProfiler_Dump();
+        RecordedBattle_PrintTurnChecks();
         gIsFishingEncounter = FALSE;
         gIsSurfingEncounter = FALSE;
         ResetSpriteData();
@@ -5276,14 +5281,14 @@ void RunBattleScriptCommands_PopCallbacksStack(void)
     else
     {
         if (gBattleControllerExecFlags == 0)
-            gBattleScriptingCommandsTable[gBattlescriptCurrInstr[0]]();
+            RUN_BATTLE_SCRIPT_COMMAND();
     }
 }
 
 void RunBattleScriptCommands(void)
 {
     if (gBattleControllerExecFlags == 0)
-        gBattleScriptingCommandsTable[gBattlescriptCurrInstr[0]]();
+        RUN_BATTLE_SCRIPT_COMMAND();
 }
 
 void SetTypeBeforeUsingMove(u16 move, u8 battlerAtk)
@@ -60,6 +60,7 @@
 #include "data.h"
 #include "constants/party_menu.h"
 #include "battle_util.h"
+#include "profile.h"
 
 extern struct MusicPlayerInfo gMPlayInfo_BGM;
 
@@ -833,6 +834,135 @@ void (* const gBattleScriptingCommandsTable[])(void) =
     Cmd_metalburstdamagecalculator,              //0xFF
 };
 
+#if B_PROFILE_BATTLE_SCRIPTS
+
+#define PROFILED_SCRIPTS_COUNT 128
+
+// The longest single command in asm/macros/battle_script.inc (jumpifword and
+// the jumpifarray commands). A command that leaves gBattlescriptCurrInstr any
+// further away than this did not fall through to the next command.
+#define MAX_BATTLE_SCRIPT_COMMAND_SIZE 14
+
+// Cost is attributed both to the command's opcode and to the address the
+// current run of sequential commands started at, i.e. the jump/call target
+// or return address. Look those up in the .sym file to get script labels.
+struct BattleScriptProfile
+{
+    u32 cmdCount[256];
+    u32 cmdCycles[256];
+    const u8 *scriptStart[PROFILED_SCRIPTS_COUNT];
+    u32 scriptCount[PROFILED_SCRIPTS_COUNT];
+    u32 scriptCycles[PROFILED_SCRIPTS_COUNT];
+    const u8 *currScriptStart;
+    const u8 *nextInstr;
+    u32 droppedScripts;
+};
+
+static EWRAM_DATA struct BattleScriptProfile sBattleScriptProfile = {0};
+
+void BattleScriptProfiler_Reset(void)
+{
+    memset(&sBattleScriptProfile, 0, sizeof(sBattleScriptProfile));
+}
+
+static void RecordScriptCycles(const u8 *scriptStart, u32 cycles)
+{
+    struct BattleScriptProfile *profile = &sBattleScriptProfile;
+    u32 i, id = ((u32)scriptStart >> 1) % PROFILED_SCRIPTS_COUNT;
+
+    for (i = 0; i < PROFILED_SCRIPTS_COUNT; i++, id = (id + 1) % PROFILED_SCRIPTS_COUNT)
+    {
+        if (profile->scriptStart[id] == NULL)
+            profile->scriptStart[id] = scriptStart;
+        if (profile->scriptStart[id] == scriptStart)
+        {
+            profile->scriptCount[id]++;
+            profile->scriptCycles[id] += cycles;
+            return;
+        }
+    }
+    profile->droppedScripts++;
+}
+
+// Whether the command at instr jumped, called or returned to next instead of
+// falling through to the command after it or waiting to run again. A jump to
+// somewhere within MAX_BATTLE_SCRIPT_COMMAND_SIZE is told apart from falling
+// through by the target being one of the command's pointer arguments.
+static bool32 DidScriptControlMove(const u8 *instr, const u8 *next)
+{
+    const u8 *arg;
+
+    if (next == instr)
+        return FALSE;
+    if (next < instr || next > instr + MAX_BATTLE_SCRIPT_COMMAND_SIZE)
+        return TRUE;
+
+    for (arg = instr + 1; arg + 4 <= next; arg++)
+    {
+        if (T1_READ_PTR(arg) == next)
+            return TRUE;
+    }
+    return FALSE;
+}
+
+void BattleScriptProfiler_RunCommand(void)
+{
+    struct BattleScriptProfile *profile = &sBattleScriptProfile;
+    const u8 *instr = gBattlescriptCurrInstr;
+    u8 cmd = instr[0];
+    u32 cycles;
+
+    // The battle engine set a new script since the last command.
+    if (instr != profile->nextInstr)
+        profile->currScriptStart = instr;
+
+    StartProfileTimer();
+    gBattleScriptingCommandsTable[cmd]();
+    cycles = StopProfileTimer();
+
+    profile->cmdCount[cmd]++;
+    profile->cmdCycles[cmd] += cycles;
+    RecordScriptCycles(profile->currScriptStart, cycles);
+
+    if (DidScriptControlMove(instr, gBattlescriptCurrInstr))
+        profile->currScriptStart = gBattlescriptCurrInstr;
+    profile->nextInstr = gBattlescriptCurrInstr;
+}
+
+void BattleScriptProfiler_Dump(void)
+{
+    struct BattleScriptProfile *profile = &sBattleScriptProfile;
+    u32 i;
+
+    AGBPrintf("battle script commands: opcode count cycles\n");
+    for (i = 0; i < ARRAY_COUNT(profile->cmdCount); i++)
+    {
+        if (profile->cmdCount[i] != 0)
+            AGBPrintf("%02X %u %u\n", i, profile->cmdCount[i], profile->cmdCycles[i]);
+    }
+    AGBPrintf("battle scripts: address count cycles\n");
+    for (i = 0; i < PROFILED_SCRIPTS_COUNT; i++)
+    {
+        if (profile->scriptStart[i] != NULL)
+            AGBPrintf("%08X %u %u\n", (u32)profile->scriptStart[i], profile->scriptCount[i], profile->scriptCycles[i]);
+    }
+    if (profile->droppedScripts != 0)
+        AGBPrintf("dropped: %u\n", profile->droppedScripts);
+    AGBPrintFlush();
+}
+
+#else
+
+void BattleScriptProfiler_Reset(void)
+{
+}
+
+void BattleScriptProfiler_Dump(void)
+{
+}
+
+#endif // B_PROFILE_BATTLE_SCRIPTS
+
 const struct StatFractions gAccuracyStageRatios[] =
 {
     { 33, 100}, // -6
@@ -0,0 +1,148 @@
+#include "global.h"
+#include "battle.h"
+#include "battle_snapshot.h"
+#include "util.h"
+
+struct SnapshotRegion
+{
+    u16 offset;
+    u16 size;
+    void *data;
+};
+
+#define REGION(field, var) {offsetof(struct BattleSnapshot, field), sizeof(var), &var}
+
+static const struct SnapshotRegion sSnapshotRegions[SNAPSHOT_REGIONS_COUNT] =
+{
+    [SNAPSHOT_REGION_BATTLE_MONS]          = REGION(battleMons, gBattleMons),
+    // gBattleStruct is allocated per battle, see GetRegionData.
+    [SNAPSHOT_REGION_BATTLE_STRUCT]        = {offsetof(struct BattleSnapshot, battleStruct), sizeof(struct BattleStruct), NULL},
+    [SNAPSHOT_REGION_SIDE_STATUSES]        = REGION(sideStatuses, gSideStatuses),
+    [SNAPSHOT_REGION_SIDE_TIMERS]          = REGION(sideTimers, gSideTimers),
+    [SNAPSHOT_REGION_FIELD_STATUSES]       = REGION(fieldStatuses, gFieldStatuses),
+    [SNAPSHOT_REGION_FIELD_TIMERS]         = REGION(fieldTimers, gFieldTimers),
+    [SNAPSHOT_REGION_WEATHER]              = REGION(battleWeather, gBattleWeather),
+    [SNAPSHOT_REGION_STATUSES3]            = REGION(statuses3, gStatuses3),
+    [SNAPSHOT_REGION_STATUSES4]            = REGION(statuses4, gStatuses4),
+    [SNAPSHOT_REGION_PROTECT_STRUCTS]      = REGION(protectStructs, gProtectStructs),
+    [SNAPSHOT_REGION_DISABLE_STRUCTS]      = REGION(disableStructs, gDisableStructs),
+    [SNAPSHOT_REGION_SPECIAL_STATUSES]     = REGION(specialStatuses, gSpecialStatuses),
+    [SNAPSHOT_REGION_WISH_FUTURE_KNOCK]    = REGION(wishFutureKnock, gWishFutureKnock),
+    [SNAPSHOT_REGION_LAST_MOVES]           = REGION(lastMoves, gLastMoves),
+    [SNAPSHOT_REGION_LAST_LANDED_MOVES]    = REGION(lastLandedMoves, gLastLandedMoves),
+    [SNAPSHOT_REGION_LAST_HIT_BY_TYPE]     = REGION(lastHitByType, gLastHitByType),
+    [SNAPSHOT_REGION_LAST_RESULTING_MOVES] = REGION(lastResultingMoves, gLastResultingMoves),
+    [SNAPSHOT_REGION_LOCKED_MOVES]         = REGION(lockedMoves, gLockedMoves),
+    [SNAPSHOT_REGION_LAST_HIT_BY]          = REGION(lastHitBy, gLastHitBy),
+    [SNAPSHOT_REGION_PARTY_INDEXES]        = REGION(battlerPartyIndexes, gBattlerPartyIndexes),
+    [SNAPSHOT_REGION_BATTLE_SCRIPTING]     = REGION(battleScripting, gBattleScripting),
+    [SNAPSHOT_REGION_HIT_MARKER]           = REGION(hitMarker, gHitMarker),
+    [SNAPSHOT_REGION_MOVE_DAMAGE]          = REGION(battleMoveDamage, gBattleMoveDamage),
+    [SNAPSHOT_REGION_BATTLE_COMMUNICATION] = REGION(battleCommunication, gBattleCommunication),
+    // The gBattleResources structs are allocated per battle too.
+    [SNAPSHOT_REGION_RESOURCE_FLAGS]       = {offsetof(struct BattleSnapshot, resourceFlags), sizeof(struct ResourceFlags), NULL},
+    [SNAPSHOT_REGION_SCRIPTS_STACK]        = {offsetof(struct BattleSnapshot, scriptsStack), sizeof(struct BattleScriptsStack), NULL},
+    [SNAPSHOT_REGION_CALLBACKS_STACK]      = {offsetof(struct BattleSnapshot, callbacksStack), sizeof(struct BattleCallbacksStack), NULL},
+    [SNAPSHOT_REGION_BATTLE_HISTORY]       = {offsetof(struct BattleSnapshot, battleHistory), sizeof(struct BattleHistory), NULL},
+    [SNAPSHOT_REGION_PLAYER_PARTY]         = REGION(playerParty, gPlayerParty),
+    [SNAPSHOT_REGION_ENEMY_PARTY]          = REGION(enemyParty, gEnemyParty),
+};
+
+#undef REGION
+
+static void *GetRegionData(u32 regionId)
+{
+    switch (regionId)
+    {
+    case SNAPSHOT_REGION_BATTLE_STRUCT:
+        return gBattleStruct;
+    case SNAPSHOT_REGION_RESOURCE_FLAGS:
+        return gBattleResources->flags;
+    case SNAPSHOT_REGION_SCRIPTS_STACK:
+        return gBattleResources->battleScriptsStack;
+    case SNAPSHOT_REGION_CALLBACKS_STACK:
+        return gBattleResources->battleCallbackStack;
+    case SNAPSHOT_REGION_BATTLE_HISTORY:
+        return gBattleResources->battleHistory;
+    default:
+        return sSnapshotRegions[regionId].data;
+    }
+}
+
+static const void *GetSnapshotRegion(const struct BattleSnapshot *snapshot, u32 regionId)
+{
+    return (const u8 *)snapshot + sSnapshotRegions[regionId].offset;
+}
+
+// Only copies the given regions, for callers which know what their simulation can touch.
+void SaveBattleSnapshotRegions(struct BattleSnapshot *snapshot, u32 regions)
+{
+    u32 i;
+
+    snapshot->version = BATTLE_SNAPSHOT_VERSION;
+    snapshot->size = sizeof(*snapshot);
+    for (i = 0; i < SNAPSHOT_REGIONS_COUNT; i++)
+    {
+        if (regions & (1 << i))
+            memcpy((u8 *)snapshot + sSnapshotRegions[i].offset, GetRegionData(i), sSnapshotRegions[i].size);
+    }
+}
+
+void SaveBattleSnapshot(struct BattleSnapshot *snapshot)
+{
+    SaveBattleSnapshotRegions(snapshot, SNAPSHOT_ALL_REGIONS);
+}
+
+bool32 IsBattleSnapshotValid(const struct BattleSnapshot *snapshot)
+{
+    return (snapshot->version == BATTLE_SNAPSHOT_VERSION && snapshot->size == sizeof(*snapshot));
+}
+
+// Returns a bitfield of the given SNAPSHOT_REGION_* which differ from the current battle state,
+// so that only those need restoring.
+u32 GetBattleSnapshotChangedRegions(const struct BattleSnapshot *snapshot, u32 regions)
+{
+    u32 i, changed = 0;
+
+    for (i = 0; i < SNAPSHOT_REGIONS_COUNT; i++)
+    {
+        if ((regions & (1 << i)) && memcmp(GetSnapshotRegion(snapshot, i), GetRegionData(i), sSnapshotRegions[i].size) != 0)
+            changed |= 1 << i;
+    }
+
+    return changed;
+}
+
+// Restores the given regions, which have to have been saved.
+void RestoreBattleSnapshotRegions(const struct BattleSnapshot *snapshot, u32 regions)
+{
+    u32 i;
+
+    if (!IsBattleSnapshotValid(snapshot))
+        return;
+
+    for (i = 0; i < SNAPSHOT_REGIONS_COUNT; i++)
+    {
+        if (regions & (1 << i))
+            memcpy(GetRegionData(i), GetSnapshotRegion(snapshot, i), sSnapshotRegions[i].size);
+    }
+}
+
+void RestoreBattleSnapshot(const struct BattleSnapshot *snapshot)
+{
+    RestoreBattleSnapshotRegions(snapshot, SNAPSHOT_ALL_REGIONS);
+}
+
+// Hashes the live state of the given regions, without needing a snapshot buffer.
+u32 CalcBattleStateHash(u32 regions)
+{
+    u32 i, hash = 0;
+
+    for (i = 0; i < SNAPSHOT_REGIONS_COUNT; i++)
+    {
+        if (regions & (1 << i))
+            hash = ((hash << 5) | (hash >> 27)) ^ CalcCRC16WithTable(GetRegionData(i), sSnapshotRegions[i].size);
+    }
+
+    return hash;
+}
@@ -23,6 +23,7 @@
 #include "field_message_box.h"
 #include "tv.h"
 #include "battle_factory.h"
+#include "frontier_party.h"
 #include "constants/apprentice.h"
 #include "constants/battle_dome.h"
 #include "constants/battle_frontier.h"
@@ -80,73 +81,6 @@ static void SetEReaderTrainerChecksum(struct BattleTowerEReaderTrainer *ereaderT
 static u8 SetTentPtrsGetLevel(void);
 
 // Const rom data.
-const u16 gBattleFrontierHeldItems[] =
-{
-    ITEM_NONE,
-    ITEM_KINGS_ROCK,
-    ITEM_SITRUS_BERRY,
-    ITEM_ORAN_BERRY,
-    ITEM_CHESTO_BERRY,
-    ITEM_HARD_STONE,
-    ITEM_FOCUS_BAND,
-    ITEM_PERSIM_BERRY,
-    ITEM_MIRACLE_SEED,
-    ITEM_BERRY_JUICE,
-    ITEM_MACHO_BRACE,
-    ITEM_SILVER_POWDER,
-    ITEM_CHERI_BERRY,
-    ITEM_BLACK_GLASSES,
-    ITEM_BLACK_BELT,
-    ITEM_SOUL_DEW,
-    ITEM_CHOICE_BAND,
-    ITEM_MAGNET,
-    ITEM_SILK_SCARF,
-    ITEM_WHITE_HERB,
-    ITEM_DEEP_SEA_SCALE,
-    ITEM_DEEP_SEA_TOOTH,
-    ITEM_MYSTIC_WATER,
-    ITEM_SHARP_BEAK,
-    ITEM_QUICK_CLAW,
-    ITEM_LEFTOVERS,
-    ITEM_RAWST_BERRY,
-    ITEM_LIGHT_BALL,
-    ITEM_POISON_BARB,
-    ITEM_NEVER_MELT_ICE,
-    ITEM_ASPEAR_BERRY,
-    ITEM_SPELL_TAG,
-    ITEM_BRIGHT_POWDER,
-    ITEM_LEPPA_BERRY,
-    ITEM_SCOPE_LENS,
-    ITEM_TWISTED_SPOON,
-    ITEM_METAL_COAT,
-    ITEM_MENTAL_HERB,
-    ITEM_CHARCOAL,
-    ITEM_PECHA_BERRY,
-    ITEM_SOFT_SAND,
-    ITEM_LUM_BERRY,
-    ITEM_DRAGON_SCALE,
-    ITEM_DRAGON_FANG,
-    ITEM_IAPAPA_BERRY,
-    ITEM_WIKI_BERRY,
-    ITEM_SEA_INCENSE,
-    ITEM_SHELL_BELL,
-    ITEM_SALAC_BERRY,
-    ITEM_LANSAT_BERRY,
-    ITEM_APICOT_BERRY,
-    ITEM_STARF_BERRY,
-    ITEM_LIECHI_BERRY,
-    ITEM_LEEK,
-    ITEM_LAX_INCENSE,
-    ITEM_AGUAV_BERRY,
-    ITEM_FIGY_BERRY,
-    ITEM_THICK_CLUB,
-    ITEM_MAGO_BERRY,
-    ITEM_METAL_POWDER,
-    ITEM_PETAYA_BERRY,
-    ITEM_LUCKY_PUNCH,
-    ITEM_GANLON_BERRY
-};
-
 #include "data/battle_frontier/battle_frontier_trainer_mons.h"
 #include "data/battle_frontier/battle_frontier_trainers.h"
 #include "data/battle_frontier/battle_frontier_mons.h"
@@ -1644,11 +1578,11 @@ static void FillTentTrainerParty(u8 monsCount)
 static void FillTrainerParty(u16 trainerId, u8 firstMonId, u8 monCount)
 {
     s32 i, j;
-    u16 chosenMonIndices[4];
+    u16 partySpecies[PARTY_SIZE];
+    u16 partyItems[PARTY_SIZE];
     u8 friendship = MAX_FRIENDSHIP;
     u8 level = SetFacilityPtrsGetLevel();
     u8 fixedIV = 0;
-    u8 bfMonCount;
     const u16 *monSet = NULL;
     u32 otID = 0;
 
@@ -1691,49 +1625,26 @@ static void FillTrainerParty(u16 trainerId, u8 firstMonId, u8 monCount)
     }
 
     // Regular battle frontier trainer.
-    // Attempt to fill the trainer's party with random Pokemon until 3 have been
-    // successfully chosen. The trainer's party may not have duplicate pokemon species
-    // or duplicate held items.
-    for (bfMonCount = 0; monSet[bfMonCount] != 0xFFFF; bfMonCount++)
-        ;
-    i = 0;
+    // Fill the trainer's party with random Pokemon from its set. The trainer's party may not
+    // have duplicate pokemon species or duplicate held items, so each slot is drawn directly
+    // among the set entries compatible with the Pokemon already in the party.
+    for (j = 0; j < firstMonId; j++)
+    {
+        partySpecies[j] = GetMonData(&gEnemyParty[j], MON_DATA_SPECIES, NULL);
+        partyItems[j] = GetMonData(&gEnemyParty[j], MON_DATA_HELD_ITEM, NULL);
+    }
     otID = Random32();
-    while (i != monCount)
+    for (i = 0; i < monCount; i++)
     {
-        u16 monId = monSet[Random() % bfMonCount];
-        if ((level == 50 || level == 20) && monId > FRONTIER_MONS_HIGH_TIER)
-            continue;
-
-        // Ensure this pokemon species isn't a duplicate.
-        for (j = 0; j < i + firstMonId; j++)
-        {
-            if (GetMonData(&gEnemyParty[j], MON_DATA_SPECIES, NULL) == gFacilityTrainerMons[monId].species)
-                break;
-        }
-        if (j != i + firstMonId)
-            continue;
-
-        // Ensure this Pokemon's held item isn't a duplicate.
-        for (j = 0; j < i + firstMonId; j++)
-        {
-            if (GetMonData(&gEnemyParty[j], MON_DATA_HELD_ITEM, NULL) != 0
-             && GetMonData(&gEnemyParty[j], MON_DATA_HELD_ITEM, NULL) == gBattleFrontierHeldItems[gFacilityTrainerMons[monId].itemTableId])
-                break;
-        }
-        if (j != i + firstMonId)
-            continue;
+        u16 monId = DrawFrontierPartyMon(monSet, GetMaxFrontierMonId(level), partySpecies, partyItems, i + firstMonId);
 
-        // Ensure this exact pokemon index isn't a duplicate. This check doesn't seem necessary
-        // because the species and held items were already checked directly above.
-        for (j = 0; j < i; j++)
-        {
-            if (chosenMonIndices[j] == monId)
-                break;
-        }
-        if (j != i)
-            continue;
+        // The set needs a different species and held item for every mon of the party
+        AGB_ASSERT(monId != FRONTIER_MON_NONE);
+        if (monId == FRONTIER_MON_NONE)
+            break;
 
-        chosenMonIndices[i] = monId;
+        partySpecies[i + firstMonId] = gFacilityTrainerMons[monId].species;
+        partyItems[i + firstMonId] = gBattleFrontierHeldItems[gFacilityTrainerMons[monId].itemTableId];
 
         // Place the chosen pokemon into the trainer's party.
         CreateMonWithEVSpreadNatureOTID(&gEnemyParty[i + firstMonId],
@@ -1754,11 +1665,7 @@ static void FillTrainerParty(u16 trainerId, u8 firstMonId, u8 monCount)
         }
 
         SetMonData(&gEnemyParty[i + firstMonId], MON_DATA_FRIENDSHIP, &friendship);
-        SetMonData(&gEnemyParty[i + firstMonId], MON_DATA_HELD_ITEM, &gBattleFrontierHeldItems[gFacilityTrainerMons[monId].itemTableId]);
-
-        // The pokemon was successfully added to the trainer's party, so it's safe to move on to
-        // the next party slot.
-        i++;
+        SetMonData(&gEnemyParty[i + firstMonId], MON_DATA_HELD_ITEM, &partyItems[i + firstMonId]);
     }
 }
 
@@ -1799,21 +1706,11 @@ u16 GetRandomFrontierMonFromSet(u16 trainerId)
 {
     u8 level = SetFacilityPtrsGetLevel();
     const u16 *monSet = gFacilityTrainers[trainerId].monSet;
-    u8 numMons = 0;
-    u32 monId = monSet[numMons];
+    u16 monId = DrawFrontierPartyMon(monSet, GetMaxFrontierMonId(level), NULL, NULL, 0);
 
-    while (monId != 0xFFFF)
-    {
-        numMons++;
-        monId = monSet[numMons];
-        if (monId == 0xFFFF)
-            break;
-    }
-
-    do
-    {
-        monId = monSet[Random() % numMons];
-    } while((level == 50 || level == 20) && monId > FRONTIER_MONS_HIGH_TIER);
+    // A set with no mon of the allowed tier used to hang here, fall back to the whole set.
+    if (monId == FRONTIER_MON_NONE)
+        monId = DrawFrontierPartyMon(monSet, 0xFFFF, NULL, NULL, 0);
 
     return monId;
 }
@@ -1861,6 +1758,7 @@ static void FillFactoryFrontierTrainerParty(u16 trainerId, u8 firstMonId)
         fixedIV = MAX_PER_STAT_IVS;
     }
 
+    // The mons were already drawn by the Battle Factory's GenerateOpponentMons.
     level = SetFacilityPtrsGetLevel();
     otID = T1_READ_32(gSaveBlock2Ptr->playerTrainerId);
     for (i = 0; i < FRONTIER_PARTY_SIZE; i++)
@@ -3510,63 +3408,33 @@ static void SetNextBattleTentOpponent(void)
 static void FillTentTrainerParty_(u16 trainerId, u8 firstMonId, u8 monCount)
 {
     s32 i, j;
-    u16 chosenMonIndices[MAX_FRONTIER_PARTY_SIZE];
+    u16 partySpecies[PARTY_SIZE];
+    u16 partyItems[PARTY_SIZE];
     u8 friendship;
     u8 level = SetTentPtrsGetLevel();
     u8 fixedIV = 0;
-    u8 bfMonCount;
     const u16 *monSet = NULL;
     u32 otID = 0;
-    u16 monId;
 
     monSet = gFacilityTrainers[gTrainerBattleOpponent_A].monSet;
 
-    bfMonCount = 0;
-    monId = monSet[bfMonCount];
-    while (monId != 0xFFFF)
+    // Same as FillTrainerParty, without the level tiers.
+    for (j = 0; j < firstMonId; j++)
     {
-        bfMonCount++;
-        monId = monSet[bfMonCount];
-        if (monId == 0xFFFF)
-            break;
+        partySpecies[j] = GetMonData(&gEnemyParty[j], MON_DATA_SPECIES, NULL);
+        partyItems[j] = GetMonData(&gEnemyParty[j], MON_DATA_HELD_ITEM, NULL);
     }
-
-    i = 0;
     otID = Random32();
-    while (i != monCount)
+    for (i = 0; i < monCount; i++)
     {
-        u16 monId = monSet[Random() % bfMonCount];
-
-        // Ensure this pokemon species isn't a duplicate.
-        for (j = 0; j < i + firstMonId; j++)
-        {
-            if (GetMonData(&gEnemyParty[j], MON_DATA_SPECIES, NULL) == gFacilityTrainerMons[monId].species)
-                break;
-        }
-        if (j != i + firstMonId)
-            continue;
+        u16 monId = DrawFrontierPartyMon(monSet, 0xFFFF, partySpecies, partyItems, i + firstMonId);
 
-        // Ensure this Pokemon's held item isn't a duplicate.
-        for (j = 0; j < i + firstMonId; j++)
-        {
-            if (GetMonData(&gEnemyParty[j], MON_DATA_HELD_ITEM, NULL) != 0
-             && GetMonData(&gEnemyParty[j], MON_DATA_HELD_ITEM, NULL) == gBattleFrontierHeldItems[gFacilityTrainerMons[monId].itemTableId])
-                break;
-        }
-        if (j != i + firstMonId)
-            continue;
-
-        // Ensure this exact pokemon index isn't a duplicate. This check doesn't seem necessary
-        // because the species and held items were already checked directly above.
-        for (j = 0; j < i; j++)
-        {
-            if (chosenMonIndices[j] == monId)
-                break;
-        }
-        if (j != i)
-            continue;
+        AGB_ASSERT(monId != FRONTIER_MON_NONE);
+        if (monId == FRONTIER_MON_NONE)
+            break;
 
-        chosenMonIndices[i] = monId;
+        partySpecies[i + firstMonId] = gFacilityTrainerMons[monId].species;
+        partyItems[i + firstMonId] = gBattleFrontierHeldItems[gFacilityTrainerMons[monId].itemTableId];
 
         // Place the chosen pokemon into the trainer's party.
         CreateMonWithEVSpreadNatureOTID(&gEnemyParty[i + firstMonId],
@@ -3587,11 +3455,7 @@ static void FillTentTrainerParty_(u16 trainerId, u8 firstMonId, u8 monCount)
         }
 
         SetMonData(&gEnemyParty[i + firstMonId], MON_DATA_FRIENDSHIP, &friendship);
-        SetMonData(&gEnemyParty[i + firstMonId], MON_DATA_HELD_ITEM, &gBattleFrontierHeldItems[gFacilityTrainerMons[monId].itemTableId]);
-
-        // The pokemon was successfully added to the trainer's party, so it's safe to move on to
-        // the next party slot.
-        i++;
+        SetMonData(&gEnemyParty[i + firstMonId], MON_DATA_HELD_ITEM, &partyItems[i + firstMonId]);
     }
 }
 
@@ -7350,7 +7350,7 @@ void ClearFuryCutterDestinyBondGrudge(u8 battlerId)
 void HandleAction_RunBattleScript(void) // identical to RunBattleScriptCommands
 {
     if (gBattleControllerExecFlags == 0)
-        gBattleScriptingCommandsTable[*gBattlescriptCurrInstr]();
+        RUN_BATTLE_SCRIPT_COMMAND();
 }
 
 u32 SetRandomTarget(u32 battlerId)
@@ -9031,6 +9031,20 @@ static u32 CalcFinalDmg(u32 dmg, u16 move, u8 battlerAtk, u8 battlerDef, u8 move
     return dmg;
 }
 
+static s32 CalcBaseDamage(u16 move, u8 battlerAtk, u8 battlerDef, u8 moveType, bool32 isCrit, bool32 updateFlags)
+{
+    s32 dmg;
+
+    // long dmg basic formula
+    dmg = ((gBattleMons[battlerAtk].level * 2) / 5) + 2;
+    dmg *= gBattleMovePower;
+    dmg *= CalcAttackStat(move, battlerAtk, battlerDef, moveType, isCrit, updateFlags);
+    dmg /= CalcDefenseStat(move, battlerAtk, battlerDef, moveType, isCrit, updateFlags);
+    dmg = (dmg / 50) + 2;
+
+    return dmg;
+}
+
 s32 CalculateMoveDamage(u16 move, u8 battlerAtk, u8 battlerDef, u8 moveType, s32 fixedBasePower, bool32 isCrit, bool32 randomFactor, bool32 updateFlags)
 {
     s32 dmg;
@@ -9047,12 +9061,7 @@ s32 CalculateMoveDamage(u16 move, u8 battlerAtk, u8 battlerDef, u8 moveType, s32
     else
         gBattleMovePower = CalcMoveBasePowerAfterModifiers(move, battlerAtk, battlerDef, moveType, updateFlags);
 
-    // long dmg basic formula
-    dmg = ((gBattleMons[battlerAtk].level * 2) / 5) + 2;
-    dmg *= gBattleMovePower;
-    dmg *= CalcAttackStat(move, battlerAtk, battlerDef, moveType, isCrit, updateFlags);
-    dmg /= CalcDefenseStat(move, battlerAtk, battlerDef, moveType, isCrit, updateFlags);
-    dmg = (dmg / 50) + 2;
+    dmg = CalcBaseDamage(move, battlerAtk, battlerDef, moveType, isCrit, updateFlags);
 
     // Calculate final modifiers.
     dmg = CalcFinalDmg(dmg, move, battlerAtk, battlerDef, moveType, typeEffectivenessModifier, isCrit, updateFlags);
@@ -9060,7 +9069,7 @@ s32 CalculateMoveDamage(u16 move, u8 battlerAtk, u8 battlerDef, u8 moveType, s32
     // Add a random factor.
     if (randomFactor)
     {
-        dmg *= 100 - (Random() % 16);
+        dmg *= 100 - (Random() % DMG_ROLLS_COUNT);
         dmg /= 100;
     }
 
@@ -9070,6 +9079,61 @@ s32 CalculateMoveDamage(u16 move, u8 battlerAtk, u8 battlerDef, u8 moveType, s32
     return dmg;
 }
 
+static void FillDamageRolls(s32 *rolls, s32 dmg)
+{
+    u32 i;
+
+    // rolls[0] is the 85% roll, rolls[DMG_ROLLS_COUNT - 1] the 100% one.
+    for (i = 0; i < DMG_ROLLS_COUNT; i++)
+    {
+        rolls[i] = dmg * (100 - (DMG_ROLLS_COUNT - 1) + i) / 100;
+        if (rolls[i] == 0)
+            rolls[i] = 1;
+    }
+}
+
+// Computes every roll of CalculateMoveDamage for both crit and non-crit hits,
+// sharing the type effectiveness and base power between them. Never updates flags.
+void CalculateMoveDamageRange(u16 move, u8 battlerAtk, u8 battlerDef, u8 moveType, s32 fixedBasePower, struct DamageRange *range)
+{
+    s32 dmg;
+    u16 typeEffectivenessModifier;
+
+    typeEffectivenessModifier = CalcTypeEffectivenessMultiplier(move, moveType, battlerAtk, battlerDef, FALSE);
+
+    // Don't calculate damage if the move has no effect on target.
+    if (typeEffectivenessModifier == UQ_4_12(0))
+    {
+        memset(range, 0, sizeof(*range));
+        return;
+    }
+
+    if (fixedBasePower)
+        gBattleMovePower = fixedBasePower;
+    else
+        gBattleMovePower = CalcMoveBasePowerAfterModifiers(move, battlerAtk, battlerDef, moveType, FALSE);
+
+    dmg = CalcBaseDamage(move, battlerAtk, battlerDef, moveType, FALSE, FALSE);
+    dmg = CalcFinalDmg(dmg, move, battlerAtk, battlerDef, moveType, typeEffectivenessModifier, FALSE, FALSE);
+    FillDamageRolls(range->rolls, dmg);
+
+    dmg = CalcBaseDamage(move, battlerAtk, battlerDef, moveType, TRUE, FALSE);
+    dmg = CalcFinalDmg(dmg, move, battlerAtk, battlerDef, moveType, typeEffectivenessModifier, TRUE, FALSE);
+    FillDamageRolls(range->critRolls, dmg);
+}
+
+// Returns how many of the DMG_ROLLS_COUNT rolls deal at least hp damage.
+u32 CountDamageRollsAtLeast(const s32 *rolls, s32 hp)
+{
+    u32 count = 0;
+    s32 i;
+
+    for (i = DMG_ROLLS_COUNT - 1; i >= 0 && rolls[i] >= hp; i--)
+        count++;
+
+    return count;
+}
+
 static void MulByTypeEffectiveness(u16 *modifier, u16 move, u8 moveType, u8 battlerDef, u8 defType, u8 battlerAtk, bool32 recordAbilities)
 {
     u16 mod = GetTypeModifier(moveType, defType);
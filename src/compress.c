@@ -0,0 +1,89 @@
+#include "global.h"
+#include "malloc.h"
+#include "compress.h"
+
+#define LZ_MIN_MATCH    3
+#define LZ_MAX_MATCH    18
+#define LZ_MAX_DISTANCE 0x1000
+#define LZ_HASH_BITS    10
+
+#define LZ_HASH(p) ((((p)[0] << 16 | (p)[1] << 8 | (p)[2]) * 2654435761u) >> (32 - LZ_HASH_BITS))
+
+// Compresses size bytes of src into dest in the BIOS LZ77 format that
+// LZDecompressWram reads. Instead of gbagfx's exhaustive search, each position
+// is only matched against the last one whose first three bytes hashed the
+// same, which is fast enough to run on the GBA and still catches the runs of
+// zeroes and repeated records most game data is made of. Returns the size of
+// the compressed data, or 0 if it doesn't fit in destSize bytes.
+u32 LZCompress(const void *src, u32 size, void *dest, u32 destSize)
+{
+    const u8 *in = src;
+    u8 *out = dest;
+    u16 *lastPos;
+    u32 inPos = 0;
+    u32 outPos = 4;
+    u32 flagPos;
+    u32 matchPos = 0;
+    u32 len, maxLen, distance, hash, i;
+    u8 bit;
+
+    if (size == 0 || size > 0xFFFF || destSize < 4)
+        return 0;
+
+    // Positions are stored plus one, so 0 means none.
+    lastPos = AllocZeroed(sizeof(*lastPos) << LZ_HASH_BITS);
+    if (lastPos == NULL)
+        return 0;
+
+    out[0] = 0x10;
+    out[1] = size;
+    out[2] = size >> 8;
+    out[3] = size >> 16;
+
+    while (inPos < size)
+    {
+        // A flag byte and 8 matches.
+        if (outPos + 1 + 8 * 2 > destSize)
+        {
+            Free(lastPos);
+            return 0;
+        }
+
+        flagPos = outPos++;
+        out[flagPos] = 0;
+        for (bit = 0; bit < 8 && inPos < size; bit++)
+        {
+            len = 0;
+            if (inPos + LZ_MIN_MATCH <= size)
+            {
+                hash = LZ_HASH(&in[inPos]);
+                if (lastPos[hash] != 0 && inPos - (lastPos[hash] - 1) <= LZ_MAX_DISTANCE)
+                {
+                    matchPos = lastPos[hash] - 1;
+                    maxLen = min(LZ_MAX_MATCH, size - inPos);
+                    while (len < maxLen && in[matchPos + len] == in[inPos + len])
+                        len++;
+                }
+                lastPos[hash] = inPos + 1;
+            }
+
+            if (len >= LZ_MIN_MATCH)
+            {
+                distance = inPos - matchPos - 1;
+                out[flagPos] |= 0x80 >> bit;
+                out[outPos++] = ((len - LZ_MIN_MATCH) << 4) | (distance >> 8);
+                out[outPos++] = distance;
+                for (i = 1; i < len && inPos + i + LZ_MIN_MATCH <= size; i++)
+                    lastPos[LZ_HASH(&in[inPos + i])] = inPos + i + 1;
+                inPos += len;
+            }
+            else
+            {
+                out[outPos++] = in[inPos++];
+            }
+        }
+    }
+
+    Free(lastPos);
+    return outPos;
+}
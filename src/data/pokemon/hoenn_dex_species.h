@@ -0,0 +1,214 @@
+// Species in the Hoenn Dex, in Hoenn Dex order. Each one is also its own National Dex entry.
+// Included by pokemon.c once per table, with HOENN_DEX_SPECIES defined to build that table's entries.
+
+HOENN_DEX_SPECIES(TREECKO)
+HOENN_DEX_SPECIES(GROVYLE)
+HOENN_DEX_SPECIES(SCEPTILE)
+HOENN_DEX_SPECIES(TORCHIC)
+HOENN_DEX_SPECIES(COMBUSKEN)
+HOENN_DEX_SPECIES(BLAZIKEN)
+HOENN_DEX_SPECIES(MUDKIP)
+HOENN_DEX_SPECIES(MARSHTOMP)
+HOENN_DEX_SPECIES(SWAMPERT)
+HOENN_DEX_SPECIES(POOCHYENA)
+HOENN_DEX_SPECIES(MIGHTYENA)
+HOENN_DEX_SPECIES(ZIGZAGOON)
+HOENN_DEX_SPECIES(LINOONE)
+HOENN_DEX_SPECIES(WURMPLE)
+HOENN_DEX_SPECIES(SILCOON)
+HOENN_DEX_SPECIES(BEAUTIFLY)
+HOENN_DEX_SPECIES(CASCOON)
+HOENN_DEX_SPECIES(DUSTOX)
+HOENN_DEX_SPECIES(LOTAD)
+HOENN_DEX_SPECIES(LOMBRE)
+HOENN_DEX_SPECIES(LUDICOLO)
+HOENN_DEX_SPECIES(SEEDOT)
+HOENN_DEX_SPECIES(NUZLEAF)
+HOENN_DEX_SPECIES(SHIFTRY)
+HOENN_DEX_SPECIES(TAILLOW)
+HOENN_DEX_SPECIES(SWELLOW)
+HOENN_DEX_SPECIES(WINGULL)
+HOENN_DEX_SPECIES(PELIPPER)
+HOENN_DEX_SPECIES(RALTS)
+HOENN_DEX_SPECIES(KIRLIA)
+HOENN_DEX_SPECIES(GARDEVOIR)
+HOENN_DEX_SPECIES(GALLADE)
+HOENN_DEX_SPECIES(SURSKIT)
+HOENN_DEX_SPECIES(MASQUERAIN)
+HOENN_DEX_SPECIES(SHROOMISH)
+HOENN_DEX_SPECIES(BRELOOM)
+HOENN_DEX_SPECIES(SLAKOTH)
+HOENN_DEX_SPECIES(VIGOROTH)
+HOENN_DEX_SPECIES(SLAKING)
+HOENN_DEX_SPECIES(ABRA)
+HOENN_DEX_SPECIES(KADABRA)
+HOENN_DEX_SPECIES(ALAKAZAM)
+HOENN_DEX_SPECIES(NINCADA)
+HOENN_DEX_SPECIES(NINJASK)
+HOENN_DEX_SPECIES(SHEDINJA)
+HOENN_DEX_SPECIES(WHISMUR)
+HOENN_DEX_SPECIES(LOUDRED)
+HOENN_DEX_SPECIES(EXPLOUD)
+HOENN_DEX_SPECIES(MAKUHITA)
+HOENN_DEX_SPECIES(HARIYAMA)
+HOENN_DEX_SPECIES(GOLDEEN)
+HOENN_DEX_SPECIES(SEAKING)
+HOENN_DEX_SPECIES(MAGIKARP)
+HOENN_DEX_SPECIES(GYARADOS)
+HOENN_DEX_SPECIES(AZURILL)
+HOENN_DEX_SPECIES(MARILL)
+HOENN_DEX_SPECIES(AZUMARILL)
+HOENN_DEX_SPECIES(GEODUDE)
+HOENN_DEX_SPECIES(GRAVELER)
+HOENN_DEX_SPECIES(GOLEM)
+HOENN_DEX_SPECIES(NOSEPASS)
+HOENN_DEX_SPECIES(PROBOPASS)
+HOENN_DEX_SPECIES(SKITTY)
+HOENN_DEX_SPECIES(DELCATTY)
+HOENN_DEX_SPECIES(ZUBAT)
+HOENN_DEX_SPECIES(GOLBAT)
+HOENN_DEX_SPECIES(CROBAT)
+HOENN_DEX_SPECIES(TENTACOOL)
+HOENN_DEX_SPECIES(TENTACRUEL)
+HOENN_DEX_SPECIES(SABLEYE)
+HOENN_DEX_SPECIES(MAWILE)
+HOENN_DEX_SPECIES(ARON)
+HOENN_DEX_SPECIES(LAIRON)
+HOENN_DEX_SPECIES(AGGRON)
+HOENN_DEX_SPECIES(MACHOP)
+HOENN_DEX_SPECIES(MACHOKE)
+HOENN_DEX_SPECIES(MACHAMP)
+HOENN_DEX_SPECIES(MEDITITE)
+HOENN_DEX_SPECIES(MEDICHAM)
+HOENN_DEX_SPECIES(ELECTRIKE)
+HOENN_DEX_SPECIES(MANECTRIC)
+HOENN_DEX_SPECIES(PLUSLE)
+HOENN_DEX_SPECIES(MINUN)
+HOENN_DEX_SPECIES(MAGNEMITE)
+HOENN_DEX_SPECIES(MAGNETON)
+HOENN_DEX_SPECIES(MAGNEZONE)
+HOENN_DEX_SPECIES(VOLTORB)
+HOENN_DEX_SPECIES(ELECTRODE)
+HOENN_DEX_SPECIES(VOLBEAT)
+HOENN_DEX_SPECIES(ILLUMISE)
+HOENN_DEX_SPECIES(ODDISH)
+HOENN_DEX_SPECIES(GLOOM)
+HOENN_DEX_SPECIES(VILEPLUME)
+HOENN_DEX_SPECIES(BELLOSSOM)
+HOENN_DEX_SPECIES(DODUO)
+HOENN_DEX_SPECIES(DODRIO)
+HOENN_DEX_SPECIES(BUDEW)
+HOENN_DEX_SPECIES(ROSELIA)
+HOENN_DEX_SPECIES(ROSERADE)
+HOENN_DEX_SPECIES(GULPIN)
+HOENN_DEX_SPECIES(SWALOT)
+HOENN_DEX_SPECIES(CARVANHA)
+HOENN_DEX_SPECIES(SHARPEDO)
+HOENN_DEX_SPECIES(WAILMER)
+HOENN_DEX_SPECIES(WAILORD)
+HOENN_DEX_SPECIES(NUMEL)
+HOENN_DEX_SPECIES(CAMERUPT)
+HOENN_DEX_SPECIES(SLUGMA)
+HOENN_DEX_SPECIES(MAGCARGO)
+HOENN_DEX_SPECIES(TORKOAL)
+HOENN_DEX_SPECIES(GRIMER)
+HOENN_DEX_SPECIES(MUK)
+HOENN_DEX_SPECIES(KOFFING)
+HOENN_DEX_SPECIES(WEEZING)
+HOENN_DEX_SPECIES(SPOINK)
+HOENN_DEX_SPECIES(GRUMPIG)
+HOENN_DEX_SPECIES(SANDSHREW)
+HOENN_DEX_SPECIES(SANDSLASH)
+HOENN_DEX_SPECIES(SPINDA)
+HOENN_DEX_SPECIES(SKARMORY)
+HOENN_DEX_SPECIES(TRAPINCH)
+HOENN_DEX_SPECIES(VIBRAVA)
+HOENN_DEX_SPECIES(FLYGON)
+HOENN_DEX_SPECIES(CACNEA)
+HOENN_DEX_SPECIES(CACTURNE)
+HOENN_DEX_SPECIES(SWABLU)
+HOENN_DEX_SPECIES(ALTARIA)
+HOENN_DEX_SPECIES(ZANGOOSE)
+HOENN_DEX_SPECIES(SEVIPER)
+HOENN_DEX_SPECIES(LUNATONE)
+HOENN_DEX_SPECIES(SOLROCK)
+HOENN_DEX_SPECIES(BARBOACH)
+HOENN_DEX_SPECIES(WHISCASH)
+HOENN_DEX_SPECIES(CORPHISH)
+HOENN_DEX_SPECIES(CRAWDAUNT)
+HOENN_DEX_SPECIES(BALTOY)
+HOENN_DEX_SPECIES(CLAYDOL)
+HOENN_DEX_SPECIES(LILEEP)
+HOENN_DEX_SPECIES(CRADILY)
+HOENN_DEX_SPECIES(ANORITH)
+HOENN_DEX_SPECIES(ARMALDO)
+HOENN_DEX_SPECIES(IGGLYBUFF)
+HOENN_DEX_SPECIES(JIGGLYPUFF)
+HOENN_DEX_SPECIES(WIGGLYTUFF)
+HOENN_DEX_SPECIES(FEEBAS)
+HOENN_DEX_SPECIES(MILOTIC)
+HOENN_DEX_SPECIES(CASTFORM)
+HOENN_DEX_SPECIES(STARYU)
+HOENN_DEX_SPECIES(STARMIE)
+HOENN_DEX_SPECIES(KECLEON)
+HOENN_DEX_SPECIES(SHUPPET)
+HOENN_DEX_SPECIES(BANETTE)
+HOENN_DEX_SPECIES(DUSKULL)
+HOENN_DEX_SPECIES(DUSCLOPS)
+HOENN_DEX_SPECIES(DUSKNOIR)
+HOENN_DEX_SPECIES(TROPIUS)
+HOENN_DEX_SPECIES(CHINGLING)
+HOENN_DEX_SPECIES(CHIMECHO)
+HOENN_DEX_SPECIES(ABSOL)
+HOENN_DEX_SPECIES(VULPIX)
+HOENN_DEX_SPECIES(NINETALES)
+HOENN_DEX_SPECIES(PICHU)
+HOENN_DEX_SPECIES(PIKACHU)
+HOENN_DEX_SPECIES(RAICHU)
+HOENN_DEX_SPECIES(PSYDUCK)
+HOENN_DEX_SPECIES(GOLDUCK)
+HOENN_DEX_SPECIES(WYNAUT)
+HOENN_DEX_SPECIES(WOBBUFFET)
+HOENN_DEX_SPECIES(NATU)
+HOENN_DEX_SPECIES(XATU)
+HOENN_DEX_SPECIES(GIRAFARIG)
+HOENN_DEX_SPECIES(PHANPY)
+HOENN_DEX_SPECIES(DONPHAN)
+HOENN_DEX_SPECIES(PINSIR)
+HOENN_DEX_SPECIES(HERACROSS)
+HOENN_DEX_SPECIES(RHYHORN)
+HOENN_DEX_SPECIES(RHYDON)
+HOENN_DEX_SPECIES(RHYPERIOR)
+HOENN_DEX_SPECIES(SNORUNT)
+HOENN_DEX_SPECIES(GLALIE)
+HOENN_DEX_SPECIES(FROSLASS)
+HOENN_DEX_SPECIES(SPHEAL)
+HOENN_DEX_SPECIES(SEALEO)
+HOENN_DEX_SPECIES(WALREIN)
+HOENN_DEX_SPECIES(CLAMPERL)
+HOENN_DEX_SPECIES(HUNTAIL)
+HOENN_DEX_SPECIES(GOREBYSS)
+HOENN_DEX_SPECIES(RELICANTH)
+HOENN_DEX_SPECIES(CORSOLA)
+HOENN_DEX_SPECIES(CHINCHOU)
+HOENN_DEX_SPECIES(LANTURN)
+HOENN_DEX_SPECIES(LUVDISC)
+HOENN_DEX_SPECIES(HORSEA)
+HOENN_DEX_SPECIES(SEADRA)
+HOENN_DEX_SPECIES(KINGDRA)
+HOENN_DEX_SPECIES(BAGON)
+HOENN_DEX_SPECIES(SHELGON)
+HOENN_DEX_SPECIES(SALAMENCE)
+HOENN_DEX_SPECIES(BELDUM)
+HOENN_DEX_SPECIES(METANG)
+HOENN_DEX_SPECIES(METAGROSS)
+HOENN_DEX_SPECIES(REGIROCK)
+HOENN_DEX_SPECIES(REGICE)
+HOENN_DEX_SPECIES(REGISTEEL)
+HOENN_DEX_SPECIES(LATIAS)
+HOENN_DEX_SPECIES(LATIOS)
+HOENN_DEX_SPECIES(KYOGRE)
+HOENN_DEX_SPECIES(GROUDON)
+HOENN_DEX_SPECIES(RAYQUAZA)
+HOENN_DEX_SPECIES(JIRACHI)
+HOENN_DEX_SPECIES(DEOXYS)
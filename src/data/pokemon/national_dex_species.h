@@ -0,0 +1,901 @@
+// Species which are their own National Dex entry, in National Dex order.
+// Included by pokemon.c once per table, with NATIONAL_DEX_SPECIES defined to build that table's entries.
+
+NATIONAL_DEX_SPECIES(BULBASAUR)
+NATIONAL_DEX_SPECIES(IVYSAUR)
+NATIONAL_DEX_SPECIES(VENUSAUR)
+NATIONAL_DEX_SPECIES(CHARMANDER)
+NATIONAL_DEX_SPECIES(CHARMELEON)
+NATIONAL_DEX_SPECIES(CHARIZARD)
+NATIONAL_DEX_SPECIES(SQUIRTLE)
+NATIONAL_DEX_SPECIES(WARTORTLE)
+NATIONAL_DEX_SPECIES(BLASTOISE)
+NATIONAL_DEX_SPECIES(CATERPIE)
+NATIONAL_DEX_SPECIES(METAPOD)
+NATIONAL_DEX_SPECIES(BUTTERFREE)
+NATIONAL_DEX_SPECIES(WEEDLE)
+NATIONAL_DEX_SPECIES(KAKUNA)
+NATIONAL_DEX_SPECIES(BEEDRILL)
+NATIONAL_DEX_SPECIES(PIDGEY)
+NATIONAL_DEX_SPECIES(PIDGEOTTO)
+NATIONAL_DEX_SPECIES(PIDGEOT)
+NATIONAL_DEX_SPECIES(RATTATA)
+NATIONAL_DEX_SPECIES(RATICATE)
+NATIONAL_DEX_SPECIES(SPEAROW)
+NATIONAL_DEX_SPECIES(FEAROW)
+NATIONAL_DEX_SPECIES(EKANS)
+NATIONAL_DEX_SPECIES(ARBOK)
+NATIONAL_DEX_SPECIES(PIKACHU)
+NATIONAL_DEX_SPECIES(RAICHU)
+NATIONAL_DEX_SPECIES(SANDSHREW)
+NATIONAL_DEX_SPECIES(SANDSLASH)
+NATIONAL_DEX_SPECIES(NIDORAN_F)
+NATIONAL_DEX_SPECIES(NIDORINA)
+NATIONAL_DEX_SPECIES(NIDOQUEEN)
+NATIONAL_DEX_SPECIES(NIDORAN_M)
+NATIONAL_DEX_SPECIES(NIDORINO)
+NATIONAL_DEX_SPECIES(NIDOKING)
+NATIONAL_DEX_SPECIES(CLEFAIRY)
+NATIONAL_DEX_SPECIES(CLEFABLE)
+NATIONAL_DEX_SPECIES(VULPIX)
+NATIONAL_DEX_SPECIES(NINETALES)
+NATIONAL_DEX_SPECIES(JIGGLYPUFF)
+NATIONAL_DEX_SPECIES(WIGGLYTUFF)
+NATIONAL_DEX_SPECIES(ZUBAT)
+NATIONAL_DEX_SPECIES(GOLBAT)
+NATIONAL_DEX_SPECIES(ODDISH)
+NATIONAL_DEX_SPECIES(GLOOM)
+NATIONAL_DEX_SPECIES(VILEPLUME)
+NATIONAL_DEX_SPECIES(PARAS)
+NATIONAL_DEX_SPECIES(PARASECT)
+NATIONAL_DEX_SPECIES(VENONAT)
+NATIONAL_DEX_SPECIES(VENOMOTH)
+NATIONAL_DEX_SPECIES(DIGLETT)
+NATIONAL_DEX_SPECIES(DUGTRIO)
+NATIONAL_DEX_SPECIES(MEOWTH)
+NATIONAL_DEX_SPECIES(PERSIAN)
+NATIONAL_DEX_SPECIES(PSYDUCK)
+NATIONAL_DEX_SPECIES(GOLDUCK)
+NATIONAL_DEX_SPECIES(MANKEY)
+NATIONAL_DEX_SPECIES(PRIMEAPE)
+NATIONAL_DEX_SPECIES(GROWLITHE)
+NATIONAL_DEX_SPECIES(ARCANINE)
+NATIONAL_DEX_SPECIES(POLIWAG)
+NATIONAL_DEX_SPECIES(POLIWHIRL)
+NATIONAL_DEX_SPECIES(POLIWRATH)
+NATIONAL_DEX_SPECIES(ABRA)
+NATIONAL_DEX_SPECIES(KADABRA)
+NATIONAL_DEX_SPECIES(ALAKAZAM)
+NATIONAL_DEX_SPECIES(MACHOP)
+NATIONAL_DEX_SPECIES(MACHOKE)
+NATIONAL_DEX_SPECIES(MACHAMP)
+NATIONAL_DEX_SPECIES(BELLSPROUT)
+NATIONAL_DEX_SPECIES(WEEPINBELL)
+NATIONAL_DEX_SPECIES(VICTREEBEL)
+NATIONAL_DEX_SPECIES(TENTACOOL)
+NATIONAL_DEX_SPECIES(TENTACRUEL)
+NATIONAL_DEX_SPECIES(GEODUDE)
+NATIONAL_DEX_SPECIES(GRAVELER)
+NATIONAL_DEX_SPECIES(GOLEM)
+NATIONAL_DEX_SPECIES(PONYTA)
+NATIONAL_DEX_SPECIES(RAPIDASH)
+NATIONAL_DEX_SPECIES(SLOWPOKE)
+NATIONAL_DEX_SPECIES(SLOWBRO)
+NATIONAL_DEX_SPECIES(MAGNEMITE)
+NATIONAL_DEX_SPECIES(MAGNETON)
+NATIONAL_DEX_SPECIES(FARFETCHD)
+NATIONAL_DEX_SPECIES(DODUO)
+NATIONAL_DEX_SPECIES(DODRIO)
+NATIONAL_DEX_SPECIES(SEEL)
+NATIONAL_DEX_SPECIES(DEWGONG)
+NATIONAL_DEX_SPECIES(GRIMER)
+NATIONAL_DEX_SPECIES(MUK)
+NATIONAL_DEX_SPECIES(SHELLDER)
+NATIONAL_DEX_SPECIES(CLOYSTER)
+NATIONAL_DEX_SPECIES(GASTLY)
+NATIONAL_DEX_SPECIES(HAUNTER)
+NATIONAL_DEX_SPECIES(GENGAR)
+NATIONAL_DEX_SPECIES(ONIX)
+NATIONAL_DEX_SPECIES(DROWZEE)
+NATIONAL_DEX_SPECIES(HYPNO)
+NATIONAL_DEX_SPECIES(KRABBY)
+NATIONAL_DEX_SPECIES(KINGLER)
+NATIONAL_DEX_SPECIES(VOLTORB)
+NATIONAL_DEX_SPECIES(ELECTRODE)
+NATIONAL_DEX_SPECIES(EXEGGCUTE)
+NATIONAL_DEX_SPECIES(EXEGGUTOR)
+NATIONAL_DEX_SPECIES(CUBONE)
+NATIONAL_DEX_SPECIES(MAROWAK)
+NATIONAL_DEX_SPECIES(HITMONLEE)
+NATIONAL_DEX_SPECIES(HITMONCHAN)
+NATIONAL_DEX_SPECIES(LICKITUNG)
+NATIONAL_DEX_SPECIES(KOFFING)
+NATIONAL_DEX_SPECIES(WEEZING)
+NATIONAL_DEX_SPECIES(RHYHORN)
+NATIONAL_DEX_SPECIES(RHYDON)
+NATIONAL_DEX_SPECIES(CHANSEY)
+NATIONAL_DEX_SPECIES(TANGELA)
+NATIONAL_DEX_SPECIES(KANGASKHAN)
+NATIONAL_DEX_SPECIES(HORSEA)
+NATIONAL_DEX_SPECIES(SEADRA)
+NATIONAL_DEX_SPECIES(GOLDEEN)
+NATIONAL_DEX_SPECIES(SEAKING)
+NATIONAL_DEX_SPECIES(STARYU)
+NATIONAL_DEX_SPECIES(STARMIE)
+NATIONAL_DEX_SPECIES(MR_MIME)
+NATIONAL_DEX_SPECIES(SCYTHER)
+NATIONAL_DEX_SPECIES(JYNX)
+NATIONAL_DEX_SPECIES(ELECTABUZZ)
+NATIONAL_DEX_SPECIES(MAGMAR)
+NATIONAL_DEX_SPECIES(PINSIR)
+NATIONAL_DEX_SPECIES(TAUROS)
+NATIONAL_DEX_SPECIES(MAGIKARP)
+NATIONAL_DEX_SPECIES(GYARADOS)
+NATIONAL_DEX_SPECIES(LAPRAS)
+NATIONAL_DEX_SPECIES(DITTO)
+NATIONAL_DEX_SPECIES(EEVEE)
+NATIONAL_DEX_SPECIES(VAPOREON)
+NATIONAL_DEX_SPECIES(JOLTEON)
+NATIONAL_DEX_SPECIES(FLAREON)
+NATIONAL_DEX_SPECIES(PORYGON)
+NATIONAL_DEX_SPECIES(OMANYTE)
+NATIONAL_DEX_SPECIES(OMASTAR)
+NATIONAL_DEX_SPECIES(KABUTO)
+NATIONAL_DEX_SPECIES(KABUTOPS)
+NATIONAL_DEX_SPECIES(AERODACTYL)
+NATIONAL_DEX_SPECIES(SNORLAX)
+NATIONAL_DEX_SPECIES(ARTICUNO)
+NATIONAL_DEX_SPECIES(ZAPDOS)
+NATIONAL_DEX_SPECIES(MOLTRES)
+NATIONAL_DEX_SPECIES(DRATINI)
+NATIONAL_DEX_SPECIES(DRAGONAIR)
+NATIONAL_DEX_SPECIES(DRAGONITE)
+NATIONAL_DEX_SPECIES(MEWTWO)
+NATIONAL_DEX_SPECIES(MEW)
+NATIONAL_DEX_SPECIES(CHIKORITA)
+NATIONAL_DEX_SPECIES(BAYLEEF)
+NATIONAL_DEX_SPECIES(MEGANIUM)
+NATIONAL_DEX_SPECIES(CYNDAQUIL)
+NATIONAL_DEX_SPECIES(QUILAVA)
+NATIONAL_DEX_SPECIES(TYPHLOSION)
+NATIONAL_DEX_SPECIES(TOTODILE)
+NATIONAL_DEX_SPECIES(CROCONAW)
+NATIONAL_DEX_SPECIES(FERALIGATR)
+NATIONAL_DEX_SPECIES(SENTRET)
+NATIONAL_DEX_SPECIES(FURRET)
+NATIONAL_DEX_SPECIES(HOOTHOOT)
+NATIONAL_DEX_SPECIES(NOCTOWL)
+NATIONAL_DEX_SPECIES(LEDYBA)
+NATIONAL_DEX_SPECIES(LEDIAN)
+NATIONAL_DEX_SPECIES(SPINARAK)
+NATIONAL_DEX_SPECIES(ARIADOS)
+NATIONAL_DEX_SPECIES(CROBAT)
+NATIONAL_DEX_SPECIES(CHINCHOU)
+NATIONAL_DEX_SPECIES(LANTURN)
+NATIONAL_DEX_SPECIES(PICHU)
+NATIONAL_DEX_SPECIES(CLEFFA)
+NATIONAL_DEX_SPECIES(IGGLYBUFF)
+NATIONAL_DEX_SPECIES(TOGEPI)
+NATIONAL_DEX_SPECIES(TOGETIC)
+NATIONAL_DEX_SPECIES(NATU)
+NATIONAL_DEX_SPECIES(XATU)
+NATIONAL_DEX_SPECIES(MAREEP)
+NATIONAL_DEX_SPECIES(FLAAFFY)
+NATIONAL_DEX_SPECIES(AMPHAROS)
+NATIONAL_DEX_SPECIES(BELLOSSOM)
+NATIONAL_DEX_SPECIES(MARILL)
+NATIONAL_DEX_SPECIES(AZUMARILL)
+NATIONAL_DEX_SPECIES(SUDOWOODO)
+NATIONAL_DEX_SPECIES(POLITOED)
+NATIONAL_DEX_SPECIES(HOPPIP)
+NATIONAL_DEX_SPECIES(SKIPLOOM)
+NATIONAL_DEX_SPECIES(JUMPLUFF)
+NATIONAL_DEX_SPECIES(AIPOM)
+NATIONAL_DEX_SPECIES(SUNKERN)
+NATIONAL_DEX_SPECIES(SUNFLORA)
+NATIONAL_DEX_SPECIES(YANMA)
+NATIONAL_DEX_SPECIES(WOOPER)
+NATIONAL_DEX_SPECIES(QUAGSIRE)
+NATIONAL_DEX_SPECIES(ESPEON)
+NATIONAL_DEX_SPECIES(UMBREON)
+NATIONAL_DEX_SPECIES(MURKROW)
+NATIONAL_DEX_SPECIES(SLOWKING)
+NATIONAL_DEX_SPECIES(MISDREAVUS)
+NATIONAL_DEX_SPECIES(UNOWN)
+NATIONAL_DEX_SPECIES(WOBBUFFET)
+NATIONAL_DEX_SPECIES(GIRAFARIG)
+NATIONAL_DEX_SPECIES(PINECO)
+NATIONAL_DEX_SPECIES(FORRETRESS)
+NATIONAL_DEX_SPECIES(DUNSPARCE)
+NATIONAL_DEX_SPECIES(GLIGAR)
+NATIONAL_DEX_SPECIES(STEELIX)
+NATIONAL_DEX_SPECIES(SNUBBULL)
+NATIONAL_DEX_SPECIES(GRANBULL)
+NATIONAL_DEX_SPECIES(QWILFISH)
+NATIONAL_DEX_SPECIES(SCIZOR)
+NATIONAL_DEX_SPECIES(SHUCKLE)
+NATIONAL_DEX_SPECIES(HERACROSS)
+NATIONAL_DEX_SPECIES(SNEASEL)
+NATIONAL_DEX_SPECIES(TEDDIURSA)
+NATIONAL_DEX_SPECIES(URSARING)
+NATIONAL_DEX_SPECIES(SLUGMA)
+NATIONAL_DEX_SPECIES(MAGCARGO)
+NATIONAL_DEX_SPECIES(SWINUB)
+NATIONAL_DEX_SPECIES(PILOSWINE)
+NATIONAL_DEX_SPECIES(CORSOLA)
+NATIONAL_DEX_SPECIES(REMORAID)
+NATIONAL_DEX_SPECIES(OCTILLERY)
+NATIONAL_DEX_SPECIES(DELIBIRD)
+NATIONAL_DEX_SPECIES(MANTINE)
+NATIONAL_DEX_SPECIES(SKARMORY)
+NATIONAL_DEX_SPECIES(HOUNDOUR)
+NATIONAL_DEX_SPECIES(HOUNDOOM)
+NATIONAL_DEX_SPECIES(KINGDRA)
+NATIONAL_DEX_SPECIES(PHANPY)
+NATIONAL_DEX_SPECIES(DONPHAN)
+NATIONAL_DEX_SPECIES(PORYGON2)
+NATIONAL_DEX_SPECIES(STANTLER)
+NATIONAL_DEX_SPECIES(SMEARGLE)
+NATIONAL_DEX_SPECIES(TYROGUE)
+NATIONAL_DEX_SPECIES(HITMONTOP)
+NATIONAL_DEX_SPECIES(SMOOCHUM)
+NATIONAL_DEX_SPECIES(ELEKID)
+NATIONAL_DEX_SPECIES(MAGBY)
+NATIONAL_DEX_SPECIES(MILTANK)
+NATIONAL_DEX_SPECIES(BLISSEY)
+NATIONAL_DEX_SPECIES(RAIKOU)
+NATIONAL_DEX_SPECIES(ENTEI)
+NATIONAL_DEX_SPECIES(SUICUNE)
+NATIONAL_DEX_SPECIES(LARVITAR)
+NATIONAL_DEX_SPECIES(PUPITAR)
+NATIONAL_DEX_SPECIES(TYRANITAR)
+NATIONAL_DEX_SPECIES(LUGIA)
+NATIONAL_DEX_SPECIES(HO_OH)
+NATIONAL_DEX_SPECIES(CELEBI)
+NATIONAL_DEX_SPECIES(TREECKO)
+NATIONAL_DEX_SPECIES(GROVYLE)
+NATIONAL_DEX_SPECIES(SCEPTILE)
+NATIONAL_DEX_SPECIES(TORCHIC)
+NATIONAL_DEX_SPECIES(COMBUSKEN)
+NATIONAL_DEX_SPECIES(BLAZIKEN)
+NATIONAL_DEX_SPECIES(MUDKIP)
+NATIONAL_DEX_SPECIES(MARSHTOMP)
+NATIONAL_DEX_SPECIES(SWAMPERT)
+NATIONAL_DEX_SPECIES(POOCHYENA)
+NATIONAL_DEX_SPECIES(MIGHTYENA)
+NATIONAL_DEX_SPECIES(ZIGZAGOON)
+NATIONAL_DEX_SPECIES(LINOONE)
+NATIONAL_DEX_SPECIES(WURMPLE)
+NATIONAL_DEX_SPECIES(SILCOON)
+NATIONAL_DEX_SPECIES(BEAUTIFLY)
+NATIONAL_DEX_SPECIES(CASCOON)
+NATIONAL_DEX_SPECIES(DUSTOX)
+NATIONAL_DEX_SPECIES(LOTAD)
+NATIONAL_DEX_SPECIES(LOMBRE)
+NATIONAL_DEX_SPECIES(LUDICOLO)
+NATIONAL_DEX_SPECIES(SEEDOT)
+NATIONAL_DEX_SPECIES(NUZLEAF)
+NATIONAL_DEX_SPECIES(SHIFTRY)
+NATIONAL_DEX_SPECIES(TAILLOW)
+NATIONAL_DEX_SPECIES(SWELLOW)
+NATIONAL_DEX_SPECIES(WINGULL)
+NATIONAL_DEX_SPECIES(PELIPPER)
+NATIONAL_DEX_SPECIES(RALTS)
+NATIONAL_DEX_SPECIES(KIRLIA)
+NATIONAL_DEX_SPECIES(GARDEVOIR)
+NATIONAL_DEX_SPECIES(SURSKIT)
+NATIONAL_DEX_SPECIES(MASQUERAIN)
+NATIONAL_DEX_SPECIES(SHROOMISH)
+NATIONAL_DEX_SPECIES(BRELOOM)
+NATIONAL_DEX_SPECIES(SLAKOTH)
+NATIONAL_DEX_SPECIES(VIGOROTH)
+NATIONAL_DEX_SPECIES(SLAKING)
+NATIONAL_DEX_SPECIES(NINCADA)
+NATIONAL_DEX_SPECIES(NINJASK)
+NATIONAL_DEX_SPECIES(SHEDINJA)
+NATIONAL_DEX_SPECIES(WHISMUR)
+NATIONAL_DEX_SPECIES(LOUDRED)
+NATIONAL_DEX_SPECIES(EXPLOUD)
+NATIONAL_DEX_SPECIES(MAKUHITA)
+NATIONAL_DEX_SPECIES(HARIYAMA)
+NATIONAL_DEX_SPECIES(AZURILL)
+NATIONAL_DEX_SPECIES(NOSEPASS)
+NATIONAL_DEX_SPECIES(SKITTY)
+NATIONAL_DEX_SPECIES(DELCATTY)
+NATIONAL_DEX_SPECIES(SABLEYE)
+NATIONAL_DEX_SPECIES(MAWILE)
+NATIONAL_DEX_SPECIES(ARON)
+NATIONAL_DEX_SPECIES(LAIRON)
+NATIONAL_DEX_SPECIES(AGGRON)
+NATIONAL_DEX_SPECIES(MEDITITE)
+NATIONAL_DEX_SPECIES(MEDICHAM)
+NATIONAL_DEX_SPECIES(ELECTRIKE)
+NATIONAL_DEX_SPECIES(MANECTRIC)
+NATIONAL_DEX_SPECIES(PLUSLE)
+NATIONAL_DEX_SPECIES(MINUN)
+NATIONAL_DEX_SPECIES(VOLBEAT)
+NATIONAL_DEX_SPECIES(ILLUMISE)
+NATIONAL_DEX_SPECIES(ROSELIA)
+NATIONAL_DEX_SPECIES(GULPIN)
+NATIONAL_DEX_SPECIES(SWALOT)
+NATIONAL_DEX_SPECIES(CARVANHA)
+NATIONAL_DEX_SPECIES(SHARPEDO)
+NATIONAL_DEX_SPECIES(WAILMER)
+NATIONAL_DEX_SPECIES(WAILORD)
+NATIONAL_DEX_SPECIES(NUMEL)
+NATIONAL_DEX_SPECIES(CAMERUPT)
+NATIONAL_DEX_SPECIES(TORKOAL)
+NATIONAL_DEX_SPECIES(SPOINK)
+NATIONAL_DEX_SPECIES(GRUMPIG)
+NATIONAL_DEX_SPECIES(SPINDA)
+NATIONAL_DEX_SPECIES(TRAPINCH)
+NATIONAL_DEX_SPECIES(VIBRAVA)
+NATIONAL_DEX_SPECIES(FLYGON)
+NATIONAL_DEX_SPECIES(CACNEA)
+NATIONAL_DEX_SPECIES(CACTURNE)
+NATIONAL_DEX_SPECIES(SWABLU)
+NATIONAL_DEX_SPECIES(ALTARIA)
+NATIONAL_DEX_SPECIES(ZANGOOSE)
+NATIONAL_DEX_SPECIES(SEVIPER)
+NATIONAL_DEX_SPECIES(LUNATONE)
+NATIONAL_DEX_SPECIES(SOLROCK)
+NATIONAL_DEX_SPECIES(BARBOACH)
+NATIONAL_DEX_SPECIES(WHISCASH)
+NATIONAL_DEX_SPECIES(CORPHISH)
+NATIONAL_DEX_SPECIES(CRAWDAUNT)
+NATIONAL_DEX_SPECIES(BALTOY)
+NATIONAL_DEX_SPECIES(CLAYDOL)
+NATIONAL_DEX_SPECIES(LILEEP)
+NATIONAL_DEX_SPECIES(CRADILY)
+NATIONAL_DEX_SPECIES(ANORITH)
+NATIONAL_DEX_SPECIES(ARMALDO)
+NATIONAL_DEX_SPECIES(FEEBAS)
+NATIONAL_DEX_SPECIES(MILOTIC)
+NATIONAL_DEX_SPECIES(CASTFORM)
+NATIONAL_DEX_SPECIES(KECLEON)
+NATIONAL_DEX_SPECIES(SHUPPET)
+NATIONAL_DEX_SPECIES(BANETTE)
+NATIONAL_DEX_SPECIES(DUSKULL)
+NATIONAL_DEX_SPECIES(DUSCLOPS)
+NATIONAL_DEX_SPECIES(TROPIUS)
+NATIONAL_DEX_SPECIES(CHIMECHO)
+NATIONAL_DEX_SPECIES(ABSOL)
+NATIONAL_DEX_SPECIES(WYNAUT)
+NATIONAL_DEX_SPECIES(SNORUNT)
+NATIONAL_DEX_SPECIES(GLALIE)
+NATIONAL_DEX_SPECIES(SPHEAL)
+NATIONAL_DEX_SPECIES(SEALEO)
+NATIONAL_DEX_SPECIES(WALREIN)
+NATIONAL_DEX_SPECIES(CLAMPERL)
+NATIONAL_DEX_SPECIES(HUNTAIL)
+NATIONAL_DEX_SPECIES(GOREBYSS)
+NATIONAL_DEX_SPECIES(RELICANTH)
+NATIONAL_DEX_SPECIES(LUVDISC)
+NATIONAL_DEX_SPECIES(BAGON)
+NATIONAL_DEX_SPECIES(SHELGON)
+NATIONAL_DEX_SPECIES(SALAMENCE)
+NATIONAL_DEX_SPECIES(BELDUM)
+NATIONAL_DEX_SPECIES(METANG)
+NATIONAL_DEX_SPECIES(METAGROSS)
+NATIONAL_DEX_SPECIES(REGIROCK)
+NATIONAL_DEX_SPECIES(REGICE)
+NATIONAL_DEX_SPECIES(REGISTEEL)
+NATIONAL_DEX_SPECIES(LATIAS)
+NATIONAL_DEX_SPECIES(LATIOS)
+NATIONAL_DEX_SPECIES(KYOGRE)
+NATIONAL_DEX_SPECIES(GROUDON)
+NATIONAL_DEX_SPECIES(RAYQUAZA)
+NATIONAL_DEX_SPECIES(JIRACHI)
+NATIONAL_DEX_SPECIES(DEOXYS)
+NATIONAL_DEX_SPECIES(TURTWIG)
+NATIONAL_DEX_SPECIES(GROTLE)
+NATIONAL_DEX_SPECIES(TORTERRA)
+NATIONAL_DEX_SPECIES(CHIMCHAR)
+NATIONAL_DEX_SPECIES(MONFERNO)
+NATIONAL_DEX_SPECIES(INFERNAPE)
+NATIONAL_DEX_SPECIES(PIPLUP)
+NATIONAL_DEX_SPECIES(PRINPLUP)
+NATIONAL_DEX_SPECIES(EMPOLEON)
+NATIONAL_DEX_SPECIES(STARLY)
+NATIONAL_DEX_SPECIES(STARAVIA)
+NATIONAL_DEX_SPECIES(STARAPTOR)
+NATIONAL_DEX_SPECIES(BIDOOF)
+NATIONAL_DEX_SPECIES(BIBAREL)
+NATIONAL_DEX_SPECIES(KRICKETOT)
+NATIONAL_DEX_SPECIES(KRICKETUNE)
+NATIONAL_DEX_SPECIES(SHINX)
+NATIONAL_DEX_SPECIES(LUXIO)
+NATIONAL_DEX_SPECIES(LUXRAY)
+NATIONAL_DEX_SPECIES(BUDEW)
+NATIONAL_DEX_SPECIES(ROSERADE)
+NATIONAL_DEX_SPECIES(CRANIDOS)
+NATIONAL_DEX_SPECIES(RAMPARDOS)
+NATIONAL_DEX_SPECIES(SHIELDON)
+NATIONAL_DEX_SPECIES(BASTIODON)
+NATIONAL_DEX_SPECIES(BURMY)
+NATIONAL_DEX_SPECIES(WORMADAM)
+NATIONAL_DEX_SPECIES(MOTHIM)
+NATIONAL_DEX_SPECIES(COMBEE)
+NATIONAL_DEX_SPECIES(VESPIQUEN)
+NATIONAL_DEX_SPECIES(PACHIRISU)
+NATIONAL_DEX_SPECIES(BUIZEL)
+NATIONAL_DEX_SPECIES(FLOATZEL)
+NATIONAL_DEX_SPECIES(CHERUBI)
+NATIONAL_DEX_SPECIES(CHERRIM)
+NATIONAL_DEX_SPECIES(SHELLOS)
+NATIONAL_DEX_SPECIES(GASTRODON)
+NATIONAL_DEX_SPECIES(AMBIPOM)
+NATIONAL_DEX_SPECIES(DRIFLOON)
+NATIONAL_DEX_SPECIES(DRIFBLIM)
+NATIONAL_DEX_SPECIES(BUNEARY)
+NATIONAL_DEX_SPECIES(LOPUNNY)
+NATIONAL_DEX_SPECIES(MISMAGIUS)
+NATIONAL_DEX_SPECIES(HONCHKROW)
+NATIONAL_DEX_SPECIES(GLAMEOW)
+NATIONAL_DEX_SPECIES(PURUGLY)
+NATIONAL_DEX_SPECIES(CHINGLING)
+NATIONAL_DEX_SPECIES(STUNKY)
+NATIONAL_DEX_SPECIES(SKUNTANK)
+NATIONAL_DEX_SPECIES(BRONZOR)
+NATIONAL_DEX_SPECIES(BRONZONG)
+NATIONAL_DEX_SPECIES(BONSLY)
+NATIONAL_DEX_SPECIES(MIME_JR)
+NATIONAL_DEX_SPECIES(HAPPINY)
+NATIONAL_DEX_SPECIES(CHATOT)
+NATIONAL_DEX_SPECIES(SPIRITOMB)
+NATIONAL_DEX_SPECIES(GIBLE)
+NATIONAL_DEX_SPECIES(GABITE)
+NATIONAL_DEX_SPECIES(GARCHOMP)
+NATIONAL_DEX_SPECIES(MUNCHLAX)
+NATIONAL_DEX_SPECIES(RIOLU)
+NATIONAL_DEX_SPECIES(LUCARIO)
+NATIONAL_DEX_SPECIES(HIPPOPOTAS)
+NATIONAL_DEX_SPECIES(HIPPOWDON)
+NATIONAL_DEX_SPECIES(SKORUPI)
+NATIONAL_DEX_SPECIES(DRAPION)
+NATIONAL_DEX_SPECIES(CROAGUNK)
+NATIONAL_DEX_SPECIES(TOXICROAK)
+NATIONAL_DEX_SPECIES(CARNIVINE)
+NATIONAL_DEX_SPECIES(FINNEON)
+NATIONAL_DEX_SPECIES(LUMINEON)
+NATIONAL_DEX_SPECIES(MANTYKE)
+NATIONAL_DEX_SPECIES(SNOVER)
+NATIONAL_DEX_SPECIES(ABOMASNOW)
+NATIONAL_DEX_SPECIES(WEAVILE)
+NATIONAL_DEX_SPECIES(MAGNEZONE)
+NATIONAL_DEX_SPECIES(LICKILICKY)
+NATIONAL_DEX_SPECIES(RHYPERIOR)
+NATIONAL_DEX_SPECIES(TANGROWTH)
+NATIONAL_DEX_SPECIES(ELECTIVIRE)
+NATIONAL_DEX_SPECIES(MAGMORTAR)
+NATIONAL_DEX_SPECIES(TOGEKISS)
+NATIONAL_DEX_SPECIES(YANMEGA)
+NATIONAL_DEX_SPECIES(LEAFEON)
+NATIONAL_DEX_SPECIES(GLACEON)
+NATIONAL_DEX_SPECIES(GLISCOR)
+NATIONAL_DEX_SPECIES(MAMOSWINE)
+NATIONAL_DEX_SPECIES(PORYGON_Z)
+NATIONAL_DEX_SPECIES(GALLADE)
+NATIONAL_DEX_SPECIES(PROBOPASS)
+NATIONAL_DEX_SPECIES(DUSKNOIR)
+NATIONAL_DEX_SPECIES(FROSLASS)
+NATIONAL_DEX_SPECIES(ROTOM)
+NATIONAL_DEX_SPECIES(UXIE)
+NATIONAL_DEX_SPECIES(MESPRIT)
+NATIONAL_DEX_SPECIES(AZELF)
+NATIONAL_DEX_SPECIES(DIALGA)
+NATIONAL_DEX_SPECIES(PALKIA)
+NATIONAL_DEX_SPECIES(HEATRAN)
+NATIONAL_DEX_SPECIES(REGIGIGAS)
+NATIONAL_DEX_SPECIES(GIRATINA)
+NATIONAL_DEX_SPECIES(CRESSELIA)
+NATIONAL_DEX_SPECIES(PHIONE)
+NATIONAL_DEX_SPECIES(MANAPHY)
+NATIONAL_DEX_SPECIES(DARKRAI)
+NATIONAL_DEX_SPECIES(SHAYMIN)
+NATIONAL_DEX_SPECIES(ARCEUS)
+NATIONAL_DEX_SPECIES(VICTINI)
+NATIONAL_DEX_SPECIES(SNIVY)
+NATIONAL_DEX_SPECIES(SERVINE)
+NATIONAL_DEX_SPECIES(SERPERIOR)
+NATIONAL_DEX_SPECIES(TEPIG)
+NATIONAL_DEX_SPECIES(PIGNITE)
+NATIONAL_DEX_SPECIES(EMBOAR)
+NATIONAL_DEX_SPECIES(OSHAWOTT)
+NATIONAL_DEX_SPECIES(DEWOTT)
+NATIONAL_DEX_SPECIES(SAMUROTT)
+NATIONAL_DEX_SPECIES(PATRAT)
+NATIONAL_DEX_SPECIES(WATCHOG)
+NATIONAL_DEX_SPECIES(LILLIPUP)
+NATIONAL_DEX_SPECIES(HERDIER)
+NATIONAL_DEX_SPECIES(STOUTLAND)
+NATIONAL_DEX_SPECIES(PURRLOIN)
+NATIONAL_DEX_SPECIES(LIEPARD)
+NATIONAL_DEX_SPECIES(PANSAGE)
+NATIONAL_DEX_SPECIES(SIMISAGE)
+NATIONAL_DEX_SPECIES(PANSEAR)
+NATIONAL_DEX_SPECIES(SIMISEAR)
+NATIONAL_DEX_SPECIES(PANPOUR)
+NATIONAL_DEX_SPECIES(SIMIPOUR)
+NATIONAL_DEX_SPECIES(MUNNA)
+NATIONAL_DEX_SPECIES(MUSHARNA)
+NATIONAL_DEX_SPECIES(PIDOVE)
+NATIONAL_DEX_SPECIES(TRANQUILL)
+NATIONAL_DEX_SPECIES(UNFEZANT)
+NATIONAL_DEX_SPECIES(BLITZLE)
+NATIONAL_DEX_SPECIES(ZEBSTRIKA)
+NATIONAL_DEX_SPECIES(ROGGENROLA)
+NATIONAL_DEX_SPECIES(BOLDORE)
+NATIONAL_DEX_SPECIES(GIGALITH)
+NATIONAL_DEX_SPECIES(WOOBAT)
+NATIONAL_DEX_SPECIES(SWOOBAT)
+NATIONAL_DEX_SPECIES(DRILBUR)
+NATIONAL_DEX_SPECIES(EXCADRILL)
+NATIONAL_DEX_SPECIES(AUDINO)
+NATIONAL_DEX_SPECIES(TIMBURR)
+NATIONAL_DEX_SPECIES(GURDURR)
+NATIONAL_DEX_SPECIES(CONKELDURR)
+NATIONAL_DEX_SPECIES(TYMPOLE)
+NATIONAL_DEX_SPECIES(PALPITOAD)
+NATIONAL_DEX_SPECIES(SEISMITOAD)
+NATIONAL_DEX_SPECIES(THROH)
+NATIONAL_DEX_SPECIES(SAWK)
+NATIONAL_DEX_SPECIES(SEWADDLE)
+NATIONAL_DEX_SPECIES(SWADLOON)
+NATIONAL_DEX_SPECIES(LEAVANNY)
+NATIONAL_DEX_SPECIES(VENIPEDE)
+NATIONAL_DEX_SPECIES(WHIRLIPEDE)
+NATIONAL_DEX_SPECIES(SCOLIPEDE)
+NATIONAL_DEX_SPECIES(COTTONEE)
+NATIONAL_DEX_SPECIES(WHIMSICOTT)
+NATIONAL_DEX_SPECIES(PETILIL)
+NATIONAL_DEX_SPECIES(LILLIGANT)
+NATIONAL_DEX_SPECIES(BASCULIN)
+NATIONAL_DEX_SPECIES(SANDILE)
+NATIONAL_DEX_SPECIES(KROKOROK)
+NATIONAL_DEX_SPECIES(KROOKODILE)
+NATIONAL_DEX_SPECIES(DARUMAKA)
+NATIONAL_DEX_SPECIES(DARMANITAN)
+NATIONAL_DEX_SPECIES(MARACTUS)
+NATIONAL_DEX_SPECIES(DWEBBLE)
+NATIONAL_DEX_SPECIES(CRUSTLE)
+NATIONAL_DEX_SPECIES(SCRAGGY)
+NATIONAL_DEX_SPECIES(SCRAFTY)
+NATIONAL_DEX_SPECIES(SIGILYPH)
+NATIONAL_DEX_SPECIES(YAMASK)
+NATIONAL_DEX_SPECIES(COFAGRIGUS)
+NATIONAL_DEX_SPECIES(TIRTOUGA)
+NATIONAL_DEX_SPECIES(CARRACOSTA)
+NATIONAL_DEX_SPECIES(ARCHEN)
+NATIONAL_DEX_SPECIES(ARCHEOPS)
+NATIONAL_DEX_SPECIES(TRUBBISH)
+NATIONAL_DEX_SPECIES(GARBODOR)
+NATIONAL_DEX_SPECIES(ZORUA)
+NATIONAL_DEX_SPECIES(ZOROARK)
+NATIONAL_DEX_SPECIES(MINCCINO)
+NATIONAL_DEX_SPECIES(CINCCINO)
+NATIONAL_DEX_SPECIES(GOTHITA)
+NATIONAL_DEX_SPECIES(GOTHORITA)
+NATIONAL_DEX_SPECIES(GOTHITELLE)
+NATIONAL_DEX_SPECIES(SOLOSIS)
+NATIONAL_DEX_SPECIES(DUOSION)
+NATIONAL_DEX_SPECIES(REUNICLUS)
+NATIONAL_DEX_SPECIES(DUCKLETT)
+NATIONAL_DEX_SPECIES(SWANNA)
+NATIONAL_DEX_SPECIES(VANILLITE)
+NATIONAL_DEX_SPECIES(VANILLISH)
+NATIONAL_DEX_SPECIES(VANILLUXE)
+NATIONAL_DEX_SPECIES(DEERLING)
+NATIONAL_DEX_SPECIES(SAWSBUCK)
+NATIONAL_DEX_SPECIES(EMOLGA)
+NATIONAL_DEX_SPECIES(KARRABLAST)
+NATIONAL_DEX_SPECIES(ESCAVALIER)
+NATIONAL_DEX_SPECIES(FOONGUS)
+NATIONAL_DEX_SPECIES(AMOONGUSS)
+NATIONAL_DEX_SPECIES(FRILLISH)
+NATIONAL_DEX_SPECIES(JELLICENT)
+NATIONAL_DEX_SPECIES(ALOMOMOLA)
+NATIONAL_DEX_SPECIES(JOLTIK)
+NATIONAL_DEX_SPECIES(GALVANTULA)
+NATIONAL_DEX_SPECIES(FERROSEED)
+NATIONAL_DEX_SPECIES(FERROTHORN)
+NATIONAL_DEX_SPECIES(KLINK)
+NATIONAL_DEX_SPECIES(KLANG)
+NATIONAL_DEX_SPECIES(KLINKLANG)
+NATIONAL_DEX_SPECIES(TYNAMO)
+NATIONAL_DEX_SPECIES(EELEKTRIK)
+NATIONAL_DEX_SPECIES(EELEKTROSS)
+NATIONAL_DEX_SPECIES(ELGYEM)
+NATIONAL_DEX_SPECIES(BEHEEYEM)
+NATIONAL_DEX_SPECIES(LITWICK)
+NATIONAL_DEX_SPECIES(LAMPENT)
+NATIONAL_DEX_SPECIES(CHANDELURE)
+NATIONAL_DEX_SPECIES(AXEW)
+NATIONAL_DEX_SPECIES(FRAXURE)
+NATIONAL_DEX_SPECIES(HAXORUS)
+NATIONAL_DEX_SPECIES(CUBCHOO)
+NATIONAL_DEX_SPECIES(BEARTIC)
+NATIONAL_DEX_SPECIES(CRYOGONAL)
+NATIONAL_DEX_SPECIES(SHELMET)
+NATIONAL_DEX_SPECIES(ACCELGOR)
+NATIONAL_DEX_SPECIES(STUNFISK)
+NATIONAL_DEX_SPECIES(MIENFOO)
+NATIONAL_DEX_SPECIES(MIENSHAO)
+NATIONAL_DEX_SPECIES(DRUDDIGON)
+NATIONAL_DEX_SPECIES(GOLETT)
+NATIONAL_DEX_SPECIES(GOLURK)
+NATIONAL_DEX_SPECIES(PAWNIARD)
+NATIONAL_DEX_SPECIES(BISHARP)
+NATIONAL_DEX_SPECIES(BOUFFALANT)
+NATIONAL_DEX_SPECIES(RUFFLET)
+NATIONAL_DEX_SPECIES(BRAVIARY)
+NATIONAL_DEX_SPECIES(VULLABY)
+NATIONAL_DEX_SPECIES(MANDIBUZZ)
+NATIONAL_DEX_SPECIES(HEATMOR)
+NATIONAL_DEX_SPECIES(DURANT)
+NATIONAL_DEX_SPECIES(DEINO)
+NATIONAL_DEX_SPECIES(ZWEILOUS)
+NATIONAL_DEX_SPECIES(HYDREIGON)
+NATIONAL_DEX_SPECIES(LARVESTA)
+NATIONAL_DEX_SPECIES(VOLCARONA)
+NATIONAL_DEX_SPECIES(COBALION)
+NATIONAL_DEX_SPECIES(TERRAKION)
+NATIONAL_DEX_SPECIES(VIRIZION)
+NATIONAL_DEX_SPECIES(TORNADUS)
+NATIONAL_DEX_SPECIES(THUNDURUS)
+NATIONAL_DEX_SPECIES(RESHIRAM)
+NATIONAL_DEX_SPECIES(ZEKROM)
+NATIONAL_DEX_SPECIES(LANDORUS)
+NATIONAL_DEX_SPECIES(KYUREM)
+NATIONAL_DEX_SPECIES(KELDEO)
+NATIONAL_DEX_SPECIES(MELOETTA)
+NATIONAL_DEX_SPECIES(GENESECT)
+NATIONAL_DEX_SPECIES(CHESPIN)
+NATIONAL_DEX_SPECIES(QUILLADIN)
+NATIONAL_DEX_SPECIES(CHESNAUGHT)
+NATIONAL_DEX_SPECIES(FENNEKIN)
+NATIONAL_DEX_SPECIES(BRAIXEN)
+NATIONAL_DEX_SPECIES(DELPHOX)
+NATIONAL_DEX_SPECIES(FROAKIE)
+NATIONAL_DEX_SPECIES(FROGADIER)
+NATIONAL_DEX_SPECIES(GRENINJA)
+NATIONAL_DEX_SPECIES(BUNNELBY)
+NATIONAL_DEX_SPECIES(DIGGERSBY)
+NATIONAL_DEX_SPECIES(FLETCHLING)
+NATIONAL_DEX_SPECIES(FLETCHINDER)
+NATIONAL_DEX_SPECIES(TALONFLAME)
+NATIONAL_DEX_SPECIES(SCATTERBUG)
+NATIONAL_DEX_SPECIES(SPEWPA)
+NATIONAL_DEX_SPECIES(VIVILLON)
+NATIONAL_DEX_SPECIES(LITLEO)
+NATIONAL_DEX_SPECIES(PYROAR)
+NATIONAL_DEX_SPECIES(FLABEBE)
+NATIONAL_DEX_SPECIES(FLOETTE)
+NATIONAL_DEX_SPECIES(FLORGES)
+NATIONAL_DEX_SPECIES(SKIDDO)
+NATIONAL_DEX_SPECIES(GOGOAT)
+NATIONAL_DEX_SPECIES(PANCHAM)
+NATIONAL_DEX_SPECIES(PANGORO)
+NATIONAL_DEX_SPECIES(FURFROU)
+NATIONAL_DEX_SPECIES(ESPURR)
+NATIONAL_DEX_SPECIES(MEOWSTIC)
+NATIONAL_DEX_SPECIES(HONEDGE)
+NATIONAL_DEX_SPECIES(DOUBLADE)
+NATIONAL_DEX_SPECIES(AEGISLASH)
+NATIONAL_DEX_SPECIES(SPRITZEE)
+NATIONAL_DEX_SPECIES(AROMATISSE)
+NATIONAL_DEX_SPECIES(SWIRLIX)
+NATIONAL_DEX_SPECIES(SLURPUFF)
+NATIONAL_DEX_SPECIES(INKAY)
+NATIONAL_DEX_SPECIES(MALAMAR)
+NATIONAL_DEX_SPECIES(BINACLE)
+NATIONAL_DEX_SPECIES(BARBARACLE)
+NATIONAL_DEX_SPECIES(SKRELP)
+NATIONAL_DEX_SPECIES(DRAGALGE)
+NATIONAL_DEX_SPECIES(CLAUNCHER)
+NATIONAL_DEX_SPECIES(CLAWITZER)
+NATIONAL_DEX_SPECIES(HELIOPTILE)
+NATIONAL_DEX_SPECIES(HELIOLISK)
+NATIONAL_DEX_SPECIES(TYRUNT)
+NATIONAL_DEX_SPECIES(TYRANTRUM)
+NATIONAL_DEX_SPECIES(AMAURA)
+NATIONAL_DEX_SPECIES(AURORUS)
+NATIONAL_DEX_SPECIES(SYLVEON)
+NATIONAL_DEX_SPECIES(HAWLUCHA)
+NATIONAL_DEX_SPECIES(DEDENNE)
+NATIONAL_DEX_SPECIES(CARBINK)
+NATIONAL_DEX_SPECIES(GOOMY)
+NATIONAL_DEX_SPECIES(SLIGGOO)
+NATIONAL_DEX_SPECIES(GOODRA)
+NATIONAL_DEX_SPECIES(KLEFKI)
+NATIONAL_DEX_SPECIES(PHANTUMP)
+NATIONAL_DEX_SPECIES(TREVENANT)
+NATIONAL_DEX_SPECIES(PUMPKABOO)
+NATIONAL_DEX_SPECIES(GOURGEIST)
+NATIONAL_DEX_SPECIES(BERGMITE)
+NATIONAL_DEX_SPECIES(AVALUGG)
+NATIONAL_DEX_SPECIES(NOIBAT)
+NATIONAL_DEX_SPECIES(NOIVERN)
+NATIONAL_DEX_SPECIES(XERNEAS)
+NATIONAL_DEX_SPECIES(YVELTAL)
+NATIONAL_DEX_SPECIES(ZYGARDE)
+NATIONAL_DEX_SPECIES(DIANCIE)
+NATIONAL_DEX_SPECIES(HOOPA)
+NATIONAL_DEX_SPECIES(VOLCANION)
+NATIONAL_DEX_SPECIES(ROWLET)
+NATIONAL_DEX_SPECIES(DARTRIX)
+NATIONAL_DEX_SPECIES(DECIDUEYE)
+NATIONAL_DEX_SPECIES(LITTEN)
+NATIONAL_DEX_SPECIES(TORRACAT)
+NATIONAL_DEX_SPECIES(INCINEROAR)
+NATIONAL_DEX_SPECIES(POPPLIO)
+NATIONAL_DEX_SPECIES(BRIONNE)
+NATIONAL_DEX_SPECIES(PRIMARINA)
+NATIONAL_DEX_SPECIES(PIKIPEK)
+NATIONAL_DEX_SPECIES(TRUMBEAK)
+NATIONAL_DEX_SPECIES(TOUCANNON)
+NATIONAL_DEX_SPECIES(YUNGOOS)
+NATIONAL_DEX_SPECIES(GUMSHOOS)
+NATIONAL_DEX_SPECIES(GRUBBIN)
+NATIONAL_DEX_SPECIES(CHARJABUG)
+NATIONAL_DEX_SPECIES(VIKAVOLT)
+NATIONAL_DEX_SPECIES(CRABRAWLER)
+NATIONAL_DEX_SPECIES(CRABOMINABLE)
+NATIONAL_DEX_SPECIES(ORICORIO)
+NATIONAL_DEX_SPECIES(CUTIEFLY)
+NATIONAL_DEX_SPECIES(RIBOMBEE)
+NATIONAL_DEX_SPECIES(ROCKRUFF)
+NATIONAL_DEX_SPECIES(LYCANROC)
+NATIONAL_DEX_SPECIES(WISHIWASHI)
+NATIONAL_DEX_SPECIES(MAREANIE)
+NATIONAL_DEX_SPECIES(TOXAPEX)
+NATIONAL_DEX_SPECIES(MUDBRAY)
+NATIONAL_DEX_SPECIES(MUDSDALE)
+NATIONAL_DEX_SPECIES(DEWPIDER)
+NATIONAL_DEX_SPECIES(ARAQUANID)
+NATIONAL_DEX_SPECIES(FOMANTIS)
+NATIONAL_DEX_SPECIES(LURANTIS)
+NATIONAL_DEX_SPECIES(MORELULL)
+NATIONAL_DEX_SPECIES(SHIINOTIC)
+NATIONAL_DEX_SPECIES(SALANDIT)
+NATIONAL_DEX_SPECIES(SALAZZLE)
+NATIONAL_DEX_SPECIES(STUFFUL)
+NATIONAL_DEX_SPECIES(BEWEAR)
+NATIONAL_DEX_SPECIES(BOUNSWEET)
+NATIONAL_DEX_SPECIES(STEENEE)
+NATIONAL_DEX_SPECIES(TSAREENA)
+NATIONAL_DEX_SPECIES(COMFEY)
+NATIONAL_DEX_SPECIES(ORANGURU)
+NATIONAL_DEX_SPECIES(PASSIMIAN)
+NATIONAL_DEX_SPECIES(WIMPOD)
+NATIONAL_DEX_SPECIES(GOLISOPOD)
+NATIONAL_DEX_SPECIES(SANDYGAST)
+NATIONAL_DEX_SPECIES(PALOSSAND)
+NATIONAL_DEX_SPECIES(PYUKUMUKU)
+NATIONAL_DEX_SPECIES(TYPE_NULL)
+NATIONAL_DEX_SPECIES(SILVALLY)
+NATIONAL_DEX_SPECIES(MINIOR)
+NATIONAL_DEX_SPECIES(KOMALA)
+NATIONAL_DEX_SPECIES(TURTONATOR)
+NATIONAL_DEX_SPECIES(TOGEDEMARU)
+NATIONAL_DEX_SPECIES(MIMIKYU)
+NATIONAL_DEX_SPECIES(BRUXISH)
+NATIONAL_DEX_SPECIES(DRAMPA)
+NATIONAL_DEX_SPECIES(DHELMISE)
+NATIONAL_DEX_SPECIES(JANGMO_O)
+NATIONAL_DEX_SPECIES(HAKAMO_O)
+NATIONAL_DEX_SPECIES(KOMMO_O)
+NATIONAL_DEX_SPECIES(TAPU_KOKO)
+NATIONAL_DEX_SPECIES(TAPU_LELE)
+NATIONAL_DEX_SPECIES(TAPU_BULU)
+NATIONAL_DEX_SPECIES(TAPU_FINI)
+NATIONAL_DEX_SPECIES(COSMOG)
+NATIONAL_DEX_SPECIES(COSMOEM)
+NATIONAL_DEX_SPECIES(SOLGALEO)
+NATIONAL_DEX_SPECIES(LUNALA)
+NATIONAL_DEX_SPECIES(NIHILEGO)
+NATIONAL_DEX_SPECIES(BUZZWOLE)
+NATIONAL_DEX_SPECIES(PHEROMOSA)
+NATIONAL_DEX_SPECIES(XURKITREE)
+NATIONAL_DEX_SPECIES(CELESTEELA)
+NATIONAL_DEX_SPECIES(KARTANA)
+NATIONAL_DEX_SPECIES(GUZZLORD)
+NATIONAL_DEX_SPECIES(NECROZMA)
+NATIONAL_DEX_SPECIES(MAGEARNA)
+NATIONAL_DEX_SPECIES(MARSHADOW)
+NATIONAL_DEX_SPECIES(POIPOLE)
+NATIONAL_DEX_SPECIES(NAGANADEL)
+NATIONAL_DEX_SPECIES(STAKATAKA)
+NATIONAL_DEX_SPECIES(BLACEPHALON)
+NATIONAL_DEX_SPECIES(ZERAORA)
+NATIONAL_DEX_SPECIES(MELTAN)
+NATIONAL_DEX_SPECIES(MELMETAL)
+NATIONAL_DEX_SPECIES(GROOKEY)
+NATIONAL_DEX_SPECIES(THWACKEY)
+NATIONAL_DEX_SPECIES(RILLABOOM)
+NATIONAL_DEX_SPECIES(SCORBUNNY)
+NATIONAL_DEX_SPECIES(RABOOT)
+NATIONAL_DEX_SPECIES(CINDERACE)
+NATIONAL_DEX_SPECIES(SOBBLE)
+NATIONAL_DEX_SPECIES(DRIZZILE)
+NATIONAL_DEX_SPECIES(INTELEON)
+NATIONAL_DEX_SPECIES(SKWOVET)
+NATIONAL_DEX_SPECIES(GREEDENT)
+NATIONAL_DEX_SPECIES(ROOKIDEE)
+NATIONAL_DEX_SPECIES(CORVISQUIRE)
+NATIONAL_DEX_SPECIES(CORVIKNIGHT)
+NATIONAL_DEX_SPECIES(BLIPBUG)
+NATIONAL_DEX_SPECIES(DOTTLER)
+NATIONAL_DEX_SPECIES(ORBEETLE)
+NATIONAL_DEX_SPECIES(NICKIT)
+NATIONAL_DEX_SPECIES(THIEVUL)
+NATIONAL_DEX_SPECIES(GOSSIFLEUR)
+NATIONAL_DEX_SPECIES(ELDEGOSS)
+NATIONAL_DEX_SPECIES(WOOLOO)
+NATIONAL_DEX_SPECIES(DUBWOOL)
+NATIONAL_DEX_SPECIES(CHEWTLE)
+NATIONAL_DEX_SPECIES(DREDNAW)
+NATIONAL_DEX_SPECIES(YAMPER)
+NATIONAL_DEX_SPECIES(BOLTUND)
+NATIONAL_DEX_SPECIES(ROLYCOLY)
+NATIONAL_DEX_SPECIES(CARKOL)
+NATIONAL_DEX_SPECIES(COALOSSAL)
+NATIONAL_DEX_SPECIES(APPLIN)
+NATIONAL_DEX_SPECIES(FLAPPLE)
+NATIONAL_DEX_SPECIES(APPLETUN)
+NATIONAL_DEX_SPECIES(SILICOBRA)
+NATIONAL_DEX_SPECIES(SANDACONDA)
+NATIONAL_DEX_SPECIES(CRAMORANT)
+NATIONAL_DEX_SPECIES(ARROKUDA)
+NATIONAL_DEX_SPECIES(BARRASKEWDA)
+NATIONAL_DEX_SPECIES(TOXEL)
+NATIONAL_DEX_SPECIES(TOXTRICITY)
+NATIONAL_DEX_SPECIES(SIZZLIPEDE)
+NATIONAL_DEX_SPECIES(CENTISKORCH)
+NATIONAL_DEX_SPECIES(CLOBBOPUS)
+NATIONAL_DEX_SPECIES(GRAPPLOCT)
+NATIONAL_DEX_SPECIES(SINISTEA)
+NATIONAL_DEX_SPECIES(POLTEAGEIST)
+NATIONAL_DEX_SPECIES(HATENNA)
+NATIONAL_DEX_SPECIES(HATTREM)
+NATIONAL_DEX_SPECIES(HATTERENE)
+NATIONAL_DEX_SPECIES(IMPIDIMP)
+NATIONAL_DEX_SPECIES(MORGREM)
+NATIONAL_DEX_SPECIES(GRIMMSNARL)
+NATIONAL_DEX_SPECIES(OBSTAGOON)
+NATIONAL_DEX_SPECIES(PERRSERKER)
+NATIONAL_DEX_SPECIES(CURSOLA)
+NATIONAL_DEX_SPECIES(SIRFETCHD)
+NATIONAL_DEX_SPECIES(MR_RIME)
+NATIONAL_DEX_SPECIES(RUNERIGUS)
+NATIONAL_DEX_SPECIES(MILCERY)
+NATIONAL_DEX_SPECIES(ALCREMIE)
+NATIONAL_DEX_SPECIES(FALINKS)
+NATIONAL_DEX_SPECIES(PINCURCHIN)
+NATIONAL_DEX_SPECIES(SNOM)
+NATIONAL_DEX_SPECIES(FROSMOTH)
+NATIONAL_DEX_SPECIES(STONJOURNER)
+NATIONAL_DEX_SPECIES(EISCUE)
+NATIONAL_DEX_SPECIES(INDEEDEE)
+NATIONAL_DEX_SPECIES(MORPEKO)
+NATIONAL_DEX_SPECIES(CUFANT)
+NATIONAL_DEX_SPECIES(COPPERAJAH)
+NATIONAL_DEX_SPECIES(DRACOZOLT)
+NATIONAL_DEX_SPECIES(ARCTOZOLT)
+NATIONAL_DEX_SPECIES(DRACOVISH)
+NATIONAL_DEX_SPECIES(ARCTOVISH)
+NATIONAL_DEX_SPECIES(DURALUDON)
+NATIONAL_DEX_SPECIES(DREEPY)
+NATIONAL_DEX_SPECIES(DRAKLOAK)
+NATIONAL_DEX_SPECIES(DRAGAPULT)
+NATIONAL_DEX_SPECIES(ZACIAN)
+NATIONAL_DEX_SPECIES(ZAMAZENTA)
+NATIONAL_DEX_SPECIES(ETERNATUS)
+NATIONAL_DEX_SPECIES(KUBFU)
+NATIONAL_DEX_SPECIES(URSHIFU)
+NATIONAL_DEX_SPECIES(ZARUDE)
+NATIONAL_DEX_SPECIES(REGIELEKI)
+NATIONAL_DEX_SPECIES(REGIDRAGO)
+NATIONAL_DEX_SPECIES(GLASTRIER)
+NATIONAL_DEX_SPECIES(SPECTRIER)
+NATIONAL_DEX_SPECIES(CALYREX)
@@ -16,6 +16,7 @@
 #include "metatile_behavior.h"
 #include "overworld.h"
 #include "palette.h"
+#include "profile.h"
 #include "random.h"
 #include "sprite.h"
 #include "task.h"
@@ -66,6 +67,17 @@ static EWRAM_DATA u8 sCurrentReflectionType = 0;
 static EWRAM_DATA u16 sCurrentSpecialObjectPaletteTag = 0;
 static EWRAM_DATA struct LockedAnimObjectEvents *sLockedAnimObjectEvents = {0};
 
+// Object events are indexed by the map cells of their current and previous
+// coords so collision and position lookups only look at the objects that
+// could be there. Cells are hashed onto an 8x8 grid of buckets, each holding
+// a bitmask of object event ids; lookups still compare the exact coords.
+#define OBJECT_EVENT_CELL_BUCKET(x, y) (((x) & 7) | (((y) & 7) << 3))
+#define OBJECT_EVENT_CELL_BUCKETS_COUNT 64
+#define OBJECT_EVENT_CELL_NONE 0xFF
+
+static EWRAM_DATA u32 sObjectEventCellMasks[OBJECT_EVENT_CELL_BUCKETS_COUNT] = {0}; // Holds up to 32 object events
+static EWRAM_DATA u8 sObjectEventCells[OBJECT_EVENTS_COUNT][2] = {0}; // current, previous bucket
+
 static void MoveCoordsInDirection(u32, s16 *, s16 *, s16, s16);
 static bool8 ObjectEventExecSingleMovementAction(struct ObjectEvent *, struct Sprite *);
 static void SetMovementDelay(struct Sprite *, s16);
@@ -113,6 +125,8 @@ static bool8 MovementType_Buried_Callback(struct ObjectEvent *, struct Sprite *)
 static void CreateReflectionEffectSprites(void);
 static u8 GetObjectEventIdByLocalId(u8);
 static u8 GetObjectEventIdByLocalIdAndMapInternal(u8, u8, u8);
+static void ClearObjectEventCellIndex(void);
+static void RemoveObjectEventFromCellIndex(u8);
 static bool8 GetAvailableObjectEventId(u16, u8, u8, u8 *);
 static void SetObjectEventDynamicGraphicsId(struct ObjectEvent *);
 static void RemoveObjectEventInternal(struct ObjectEvent *);
@@ -1137,6 +1151,7 @@ const u8 gUnknown_0850DC3F[][4] = {
 
 static void ClearObjectEvent(struct ObjectEvent *objectEvent)
 {
+    RemoveObjectEventFromCellIndex(objectEvent - gObjectEvents);
     *objectEvent = (struct ObjectEvent){};
     objectEvent->localId = 0xFF;
     objectEvent->mapNum = 0xFF;
@@ -1148,10 +1163,66 @@ static void ClearAllObjectEvents(void)
 {
     u8 i;
 
+    ClearObjectEventCellIndex();
     for (i = 0; i < OBJECT_EVENTS_COUNT; i++)
         ClearObjectEvent(&gObjectEvents[i]);
 }
 
+static void ClearObjectEventCellIndex(void)
+{
+    memset(sObjectEventCellMasks, 0, sizeof(sObjectEventCellMasks));
+    memset(sObjectEventCells, OBJECT_EVENT_CELL_NONE, sizeof(sObjectEventCells));
+}
+
+static void RemoveObjectEventFromCellIndex(u8 objectEventId)
+{
+    u8 i;
+
+    for (i = 0; i < ARRAY_COUNT(sObjectEventCells[0]); i++)
+    {
+        if (sObjectEventCells[objectEventId][i] != OBJECT_EVENT_CELL_NONE)
+            sObjectEventCellMasks[sObjectEventCells[objectEventId][i]] &= ~((u32)1 << objectEventId);
+        sObjectEventCells[objectEventId][i] = OBJECT_EVENT_CELL_NONE;
+    }
+}
+
+static void AddObjectEventToCellIndex(u8 objectEventId)
+{
+    struct ObjectEvent *objectEvent = &gObjectEvents[objectEventId];
+    u8 current = OBJECT_EVENT_CELL_BUCKET(objectEvent->currentCoords.x, objectEvent->currentCoords.y);
+    u8 previous = OBJECT_EVENT_CELL_BUCKET(objectEvent->previousCoords.x, objectEvent->previousCoords.y);
+
+    sObjectEventCells[objectEventId][0] = current;
+    sObjectEventCells[objectEventId][1] = previous;
+    sObjectEventCellMasks[current] |= (u32)1 << objectEventId;
+    sObjectEventCellMasks[previous] |= (u32)1 << objectEventId;
+}
+
+// Must be called whenever an object event's current or previous coords change.
+void UpdateObjectEventCellIndex(struct ObjectEvent *objectEvent)
+{
+    u8 objectEventId = objectEvent - gObjectEvents;
+
+    RemoveObjectEventFromCellIndex(objectEventId);
+    AddObjectEventToCellIndex(objectEventId);
+}
+
+// For when the coords of every object event changed at once, e.g. loading them from the save block.
+void RebuildObjectEventCellIndex(void)
+{
+    u8 i;
+
+    ClearObjectEventCellIndex();
+    for (i = 0; i < OBJECT_EVENTS_COUNT; i++)
+    {
+        if (gObjectEvents[i].active)
+            AddObjectEventToCellIndex(i);
+    }
+}
+
+// Ids of the object events that may have current or previous coords at (x, y).
+#define GetObjectEventsNearCell(x, y) (sObjectEventCellMasks[OBJECT_EVENT_CELL_BUCKET(x, y)])
+
 void ResetObjectEvents(void)
 {
     ClearLinkPlayerObjectEvents();
@@ -1208,13 +1279,15 @@ bool8 TryGetObjectEventIdByLocalIdAndMap(u8 localId, u8 mapNum, u8 mapGroupId, u
 u8 GetObjectEventIdByXY(s16 x, s16 y)
 {
     u8 i;
-    for (i = 0; i < OBJECT_EVENTS_COUNT; i++)
+    u32 candidates = GetObjectEventsNearCell(x, y);
+
+    for (i = 0; candidates != 0; i++, candidates >>= 1)
     {
-        if (gObjectEvents[i].active && gObjectEvents[i].currentCoords.x == x && gObjectEvents[i].currentCoords.y == y)
-            break;
+        if ((candidates & 1) && gObjectEvents[i].active && gObjectEvents[i].currentCoords.x == x && gObjectEvents[i].currentCoords.y == y)
+            return i;
     }
 
-    return i;
+    return OBJECT_EVENTS_COUNT;
 }
 
 static u8 GetObjectEventIdByLocalIdAndMapInternal(u8 localId, u8 mapNum, u8 mapGroupId)
@@ -1267,6 +1340,7 @@ static u8 InitObjectEventStateFromTemplate(struct ObjectEventTemplate *template,
     objectEvent->currentCoords.y = y;
     objectEvent->previousCoords.x = x;
     objectEvent->previousCoords.y = y;
+    UpdateObjectEventCellIndex(objectEvent);
     objectEvent->currentElevation = template->elevation;
     objectEvent->previousElevation = template->elevation;
     objectEvent->rangeX = template->movementRangeX;
@@ -1613,6 +1687,10 @@ void TrySpawnObjectEvents(s16 cameraX, s16 cameraY)
     u8 i;
     u8 objectCount;
 
+    // Templates that aren't live yet can only be spawned into a free slot.
+    if (GetFirstInactiveObjectEventId() == OBJECT_EVENTS_COUNT)
+        return;
+
     if (gMapHeader.events != NULL)
     {
         s16 left = gSaveBlock1Ptr->pos.x - 2;
@@ -2089,6 +2167,7 @@ static void IncrementObjectEventCoords(struct ObjectEvent *objectEvent, s16 x, s
     objectEvent->previousCoords.y = objectEvent->currentCoords.y;
     objectEvent->currentCoords.x += x;
     objectEvent->currentCoords.y += y;
+    UpdateObjectEventCellIndex(objectEvent);
 }
 
 void ShiftObjectEventCoords(struct ObjectEvent *objectEvent, s16 x, s16 y)
@@ -2097,6 +2176,7 @@ void ShiftObjectEventCoords(struct ObjectEvent *objectEvent, s16 x, s16 y)
     objectEvent->previousCoords.y = objectEvent->currentCoords.y;
     objectEvent->currentCoords.x = x;
     objectEvent->currentCoords.y = y;
+    UpdateObjectEventCellIndex(objectEvent);
 }
 
 static void SetObjectEventCoords(struct ObjectEvent *objectEvent, s16 x, s16 y)
@@ -2105,6 +2185,7 @@ static void SetObjectEventCoords(struct ObjectEvent *objectEvent, s16 x, s16 y)
     objectEvent->previousCoords.y = y;
     objectEvent->currentCoords.x = x;
     objectEvent->currentCoords.y = y;
+    UpdateObjectEventCellIndex(objectEvent);
 }
 
 void MoveObjectEventToMapCoords(struct ObjectEvent *objectEvent, s16 x, s16 y)
@@ -2163,16 +2244,18 @@ void UpdateObjectEventCoordsForCameraUpdate(void)
                 gObjectEvents[i].previousCoords.y -= dy;
             }
         }
+        RebuildObjectEventCellIndex();
     }
 }
 
 u8 GetObjectEventIdByXYZ(u16 x, u16 y, u8 z)
 {
     u8 i;
+    u32 candidates = GetObjectEventsNearCell(x, y);
 
-    for (i = 0; i < OBJECT_EVENTS_COUNT; i++)
+    for (i = 0; candidates != 0; i++, candidates >>= 1)
     {
-        if (gObjectEvents[i].active)
+        if ((candidates & 1) && gObjectEvents[i].active)
         {
             if (gObjectEvents[i].currentCoords.x == x && gObjectEvents[i].currentCoords.y == y && ObjectEventDoesZCoordMatch(&gObjectEvents[i], z))
             {
@@ -2192,11 +2275,41 @@ static bool8 ObjectEventDoesZCoordMatch(struct ObjectEvent *objectEvent, u8 z)
     return TRUE;
 }
 
+#if OW_PROFILE_OBJECT_EVENT_SPAWNS
+static u8 CountActiveObjectEvents(void)
+{
+    u8 i, count = 0;
+
+    for (i = 0; i < OBJECT_EVENTS_COUNT; i++)
+    {
+        if (gObjectEvents[i].active)
+            count++;
+    }
+    return count;
+}
+#endif // OW_PROFILE_OBJECT_EVENT_SPAWNS
+
 void UpdateObjectEventsForCameraUpdate(s16 x, s16 y)
 {
+#if OW_PROFILE_OBJECT_EVENT_SPAWNS
+    u8 liveBefore = CountActiveObjectEvents(), liveAfterRemoval;
+    u32 cycles;
+
+    StartProfileTimer();
+#endif
     UpdateObjectEventCoordsForCameraUpdate();
-    TrySpawnObjectEvents(x, y);
+    // Objects leaving the view are removed first so that their slots can be
+    // reused by the ones entering it on the same step.
     RemoveObjectEventsOutsideView();
+#if OW_PROFILE_OBJECT_EVENT_SPAWNS
+    liveAfterRemoval = CountActiveObjectEvents();
+#endif
+    TrySpawnObjectEvents(x, y);
+#if OW_PROFILE_OBJECT_EVENT_SPAWNS
+    cycles = StopProfileTimer();
+    AGBPrintf("object events: %u live, %u removed, %u spawned, %u cycles\n",
+              CountActiveObjectEvents(), liveBefore - liveAfterRemoval, CountActiveObjectEvents() - liveAfterRemoval, cycles);
+#endif
 }
 
 #define sLinkedSpriteId data[0]
@@ -4792,11 +4905,12 @@ static bool8 DoesObjectCollideWithObjectAt(struct ObjectEvent *objectEvent, s16
 {
     u8 i;
     struct ObjectEvent *curObject;
+    u32 candidates = GetObjectEventsNearCell(x, y);
 
-    for (i = 0; i < OBJECT_EVENTS_COUNT; i++)
+    for (i = 0; candidates != 0; i++, candidates >>= 1)
     {
         curObject = &gObjectEvents[i];
-        if (curObject->active && curObject != objectEvent)
+        if ((candidates & 1) && curObject->active && curObject != objectEvent)
         {
             if ((curObject->currentCoords.x == x && curObject->currentCoords.y == y) || (curObject->previousCoords.x == x && curObject->previousCoords.y == y))
             {
@@ -33,6 +33,7 @@ static s32 MapPosToBgTilemapOffset(struct FieldCameraOffset *a, s32 x, s32 y);
 static void DrawWholeMapViewInternal(int x, int y, const struct MapLayout *mapLayout);
 static void DrawMetatileAt(const struct MapLayout *mapLayout, u16, int, int);
 static void DrawMetatile(s32 a, u16 *b, u16 c);
+static void ScheduleDirtyMapTilemapRowCopies(void);
 static void CameraPanningCB_PanAhead(void);
 
 // IWRAM bss vars
@@ -41,6 +42,7 @@ static s16 sHorizontalCameraPan;
 static s16 sVerticalCameraPan;
 static bool8 sBikeCameraPanFlag;
 static void (*sFieldCameraPanningCallback)(void);
+static u32 sDirtyMapTilemapRows; // bit n = tilemap row n was redrawn this frame
 
 struct CameraObject gFieldCamera;
 u16 gTotalCameraPixelOffsetY;
@@ -98,6 +100,7 @@ void GetCameraOffsetWithPan(s16 *x, s16 *y)
 void DrawWholeMapView(void)
 {
     DrawWholeMapViewInternal(gSaveBlock1Ptr->pos.x, gSaveBlock1Ptr->pos.y, gMapHeader.mapLayout);
+    ScheduleDirtyMapTilemapRowCopies();
     sFieldCameraOffset.copyBGToVRAM = TRUE;
 }
 
@@ -136,6 +139,7 @@ static void RedrawMapSlicesForCameraUpdate(struct FieldCameraOffset *cameraOffse
         RedrawMapSliceNorth(cameraOffset, mapLayout);
     if (y < 0)
         RedrawMapSliceSouth(cameraOffset, mapLayout);
+    ScheduleDirtyMapTilemapRowCopies();
     cameraOffset->copyBGToVRAM = TRUE;
 }
 
@@ -212,6 +216,7 @@ void CurrentMapDrawMetatileAt(int x, int y)
     if (offset >= 0)
     {
         DrawMetatileAt(gMapHeader.mapLayout, offset, x, y);
+        ScheduleDirtyMapTilemapRowCopies();
         sFieldCameraOffset.copyBGToVRAM = TRUE;
     }
 }
@@ -223,6 +228,7 @@ void DrawDoorMetatileAt(int x, int y, u16 *arr)
     if (offset >= 0)
     {
         DrawMetatile(1, arr, offset);
+        ScheduleDirtyMapTilemapRowCopies();
         sFieldCameraOffset.copyBGToVRAM = TRUE;
     }
 }
@@ -306,9 +312,18 @@ static void DrawMetatile(s32 metatileLayerType, u16 *metatiles, u16 offset)
         gBGTilemapBuffers2[offset + 0x21] = metatiles[7];
         break;
     }
-    ScheduleBgCopyTilemapToVram(1);
-    ScheduleBgCopyTilemapToVram(2);
-    ScheduleBgCopyTilemapToVram(3);
+    // A metatile covers two tile rows.
+    sDirtyMapTilemapRows |= (u32)3 << (offset / 32);
+}
+
+// Only the rows touched by the metatiles drawn since the last call are
+// copied to VRAM, instead of the three full map tilemaps.
+static void ScheduleDirtyMapTilemapRowCopies(void)
+{
+    ScheduleBgCopyTilemapRowsToVram(1, sDirtyMapTilemapRows);
+    ScheduleBgCopyTilemapRowsToVram(2, sDirtyMapTilemapRows);
+    ScheduleBgCopyTilemapRowsToVram(3, sDirtyMapTilemapRows);
+    sDirtyMapTilemapRows = 0;
 }
 
 static s32 MapPosToBgTilemapOffset(struct FieldCameraOffset *cameraOffset, s32 x, s32 y)
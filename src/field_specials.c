@@ -4262,22 +4262,18 @@ bool8 ShouldShowBoxWasFullMessage(void)
 bool8 IsDestinationBoxFull(void)
 {
     int box;
-    int i;
     SetPCBoxToSendMon(VarGet(VAR_PC_BOX_TO_SEND_MON));
     box = StorageGetCurrentBox();
     do
     {
-        for (i = 0; i < IN_BOX_COUNT; i++)
+        if (CountMonsInBox(box) < IN_BOX_COUNT)
         {
-            if (GetBoxMonData(GetBoxedMonPtr(box, i), MON_DATA_SPECIES, 0) == SPECIES_NONE)
+            if (GetPCBoxToSendMon() != box)
             {
-                if (GetPCBoxToSendMon() != box)
-                {
-                    FlagClear(FLAG_SHOWN_BOX_WAS_FULL_MESSAGE);
-                }
-                VarSet(VAR_PC_BOX_TO_SEND_MON, box);
-                return ShouldShowBoxWasFullMessage();
+                FlagClear(FLAG_SHOWN_BOX_WAS_FULL_MESSAGE);
             }
+            VarSet(VAR_PC_BOX_TO_SEND_MON, box);
+            return ShouldShowBoxWasFullMessage();
         }
 
         if (++box == TOTAL_BOXES_COUNT)
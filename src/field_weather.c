@@ -540,10 +540,7 @@ static void ApplyGammaShiftWithBlend(u8 startPalIndex, u8 numPalettes, s8 gammaI
     u16 palOffset;
     u16 curPalIndex;
     u16 i;
-    struct RGBColor color = *(struct RGBColor *)&blendColor;
-    u8 rBlend = color.r;
-    u8 gBlend = color.g;
-    u8 bBlend = color.b;
+    u32 spreadBlend = SPREAD_RGB(blendColor) * blendCoeff;
 
     palOffset = startPalIndex * 16;
     numPalettes += startPalIndex;
@@ -575,10 +572,7 @@ static void ApplyGammaShiftWithBlend(u8 startPalIndex, u8 numPalettes, s8 gammaI
                 u8 b = gammaTable[baseColor.b];
 
                 // Apply gamma shift and target blend color to the original color.
-                r += ((rBlend - r) * blendCoeff) >> 4;
-                g += ((gBlend - g) * blendCoeff) >> 4;
-                b += ((bBlend - b) * blendCoeff) >> 4;
-                gPlttBufferFaded[palOffset++] = RGB2(r, g, b);
+                gPlttBufferFaded[palOffset++] = UNSPREAD_RGB(BLEND_SPREAD_RGB(SPREAD_RGB(RGB2(r, g, b)), blendCoeff, spreadBlend));
             }
         }
 
@@ -588,19 +582,13 @@ static void ApplyGammaShiftWithBlend(u8 startPalIndex, u8 numPalettes, s8 gammaI
 
 static void ApplyDroughtGammaShiftWithBlend(s8 gammaIndex, u8 blendCoeff, u16 blendColor)
 {
-    struct RGBColor color;
-    u8 rBlend;
-    u8 gBlend;
-    u8 bBlend;
+    u32 spreadBlend;
     u16 curPalIndex;
     u16 palOffset;
     u16 i;
 
     gammaIndex = -gammaIndex - 1;
-    color = *(struct RGBColor *)&blendColor;
-    rBlend = color.r;
-    gBlend = color.g;
-    bBlend = color.b;
+    spreadBlend = SPREAD_RGB(blendColor) * blendCoeff;
     palOffset = 0;
     for (curPalIndex = 0; curPalIndex < 32; curPalIndex++)
     {
@@ -616,9 +604,7 @@ static void ApplyDroughtGammaShiftWithBlend(s8 gammaIndex, u8 blendCoeff, u16 bl
             {
                 u32 offset;
                 struct RGBColor color1;
-                struct RGBColor color2;
                 u8 r1, g1, b1;
-                u8 r2, g2, b2;
 
                 color1 = *(struct RGBColor *)&gPlttBufferUnfaded[palOffset];
                 r1 = color1.r;
@@ -626,16 +612,7 @@ static void ApplyDroughtGammaShiftWithBlend(s8 gammaIndex, u8 blendCoeff, u16 bl
                 b1 = color1.b;
 
                 offset = ((b1 & 0x1E) << 7) | ((g1 & 0x1E) << 3) | ((r1 & 0x1E) >> 1);
-                color2 = *(struct RGBColor *)&sDroughtWeatherColors[gammaIndex][offset];
-                r2 = color2.r;
-                g2 = color2.g;
-                b2 = color2.b;
-
-                r2 += ((rBlend - r2) * blendCoeff) >> 4;
-                g2 += ((gBlend - g2) * blendCoeff) >> 4;
-                b2 += ((bBlend - b2) * blendCoeff) >> 4;
-
-                gPlttBufferFaded[palOffset++] = RGB2(r2, g2, b2);
+                gPlttBufferFaded[palOffset++] = UNSPREAD_RGB(BLEND_SPREAD_RGB(SPREAD_RGB(sDroughtWeatherColors[gammaIndex][offset]), blendCoeff, spreadBlend));
             }
         }
     }
@@ -643,17 +620,11 @@ static void ApplyDroughtGammaShiftWithBlend(s8 gammaIndex, u8 blendCoeff, u16 bl
 
 static void ApplyFogBlend(u8 blendCoeff, u16 blendColor)
 {
-    struct RGBColor color;
-    u8 rBlend;
-    u8 gBlend;
-    u8 bBlend;
+    u32 spreadBlend;
     u16 curPalIndex;
 
     BlendPalette(0, 256, blendCoeff, blendColor);
-    color = *(struct RGBColor *)&blendColor;
-    rBlend = color.r;
-    gBlend = color.g;
-    bBlend = color.b;
+    spreadBlend = SPREAD_RGB(blendColor) * blendCoeff;
 
     for (curPalIndex = 16; curPalIndex < 32; curPalIndex++)
     {
@@ -673,11 +644,7 @@ static void ApplyFogBlend(u8 blendCoeff, u16 blendColor)
                 g += ((31 - g) * 3) >> 2;
                 b += ((28 - b) * 3) >> 2;
 
-                r += ((rBlend - r) * blendCoeff) >> 4;
-                g += ((gBlend - g) * blendCoeff) >> 4;
-                b += ((bBlend - b) * blendCoeff) >> 4;
-
-                gPlttBufferFaded[palOffset] = RGB2(r, g, b);
+                gPlttBufferFaded[palOffset] = UNSPREAD_RGB(BLEND_SPREAD_RGB(SPREAD_RGB(RGB2(r, g, b)), blendCoeff, spreadBlend));
                 palOffset++;
             }
         }
@@ -29,6 +29,8 @@ EWRAM_DATA static u16 gBackupMapData[MAX_MAP_DATA_SIZE] = {0};
 EWRAM_DATA struct MapHeader gMapHeader = {0};
 EWRAM_DATA struct Camera gCamera = {0};
 EWRAM_DATA static struct ConnectionFlags gMapConnectionFlags = {0};
+EWRAM_DATA static u16 sMetatileAttributes[NUM_METATILES_TOTAL] = {0};
+EWRAM_DATA static const struct MapLayout *sMetatileAttributesLayout = NULL;
 EWRAM_DATA static u32 sFiller = 0; // without this, the next file won't align properly
 
 struct BackupMapLayout gBackupMapLayout;
@@ -47,6 +49,7 @@ static bool8 SkipCopyingMetatileFromSavedMap(u16* mapMetatilePtr, u16 mapWidth,
 static struct MapConnection *GetIncomingConnection(u8 direction, int x, int y);
 static bool8 IsPosInIncomingConnectingMap(u8 direction, int x, int y, struct MapConnection *connection);
 static bool8 IsCoordInIncomingConnectingMap(int coord, int srcMax, int destMax, int offset);
+static void LoadMetatileAttributes(const struct MapLayout *mapLayout);
 
 #define MapGridGetBorderTileAt(x, y) ({                                                            \
     u16 block;                                                                                     \
@@ -375,13 +378,19 @@ u32 MapGridGetMetatileIdAt(int x, int y)
 u32 MapGridGetMetatileBehaviorAt(int x, int y)
 {
     u16 metatile = MapGridGetMetatileIdAt(x, y);
-    return GetBehaviorByMetatileId(metatile) & METATILE_BEHAVIOR_MASK;
+
+    if (sMetatileAttributesLayout != gMapHeader.mapLayout)
+        LoadMetatileAttributes(gMapHeader.mapLayout);
+    return sMetatileAttributes[metatile] & METATILE_BEHAVIOR_MASK;
 }
 
 u8 MapGridGetMetatileLayerTypeAt(int x, int y)
 {
     u16 metatile = MapGridGetMetatileIdAt(x, y);
-    return (GetBehaviorByMetatileId(metatile) & METATILE_ELEVATION_MASK) >> METATILE_ELEVATION_SHIFT;
+
+    if (sMetatileAttributesLayout != gMapHeader.mapLayout)
+        LoadMetatileAttributes(gMapHeader.mapLayout);
+    return (sMetatileAttributes[metatile] & METATILE_ELEVATION_MASK) >> METATILE_ELEVATION_SHIFT;
 }
 
 void MapGridSetMetatileIdAt(int x, int y, u16 metatile)
@@ -404,23 +413,34 @@ void MapGridSetMetatileEntryAt(int x, int y, u16 metatile)
     }
 }
 
+// Copies a tileset's attributes to its part of sMetatileAttributes. Many tilesets have
+// fewer attributes than metatile ids, the ids past the end get zero attributes.
+static void LoadTilesetMetatileAttributes(const struct Tileset *tileset, u16 *dest, u16 size)
+{
+    u16 count = min(tileset->numMetatileAttributes, size);
+
+    CpuCopy16(tileset->metatileAttributes, dest, count * sizeof(u16));
+    CpuFill16(0, &dest[count], (size - count) * sizeof(u16));
+}
+
+// Merges the primary and secondary tileset attributes into one table indexed
+// by metatile id, so lookups don't need to pick a tileset. The tilesets only
+// change along with the map layout, which is what the table is keyed on.
+static void LoadMetatileAttributes(const struct MapLayout *mapLayout)
+{
+    LoadTilesetMetatileAttributes(mapLayout->primaryTileset, sMetatileAttributes, NUM_METATILES_IN_PRIMARY);
+    LoadTilesetMetatileAttributes(mapLayout->secondaryTileset, &sMetatileAttributes[NUM_METATILES_IN_PRIMARY], NUM_METATILES_TOTAL - NUM_METATILES_IN_PRIMARY);
+    sMetatileAttributesLayout = mapLayout;
+}
+
 u16 GetBehaviorByMetatileId(u16 metatile)
 {
-    u16 *attributes;
-    if (metatile < NUM_METATILES_IN_PRIMARY)
-    {
-        attributes = gMapHeader.mapLayout->primaryTileset->metatileAttributes;
-        return attributes[metatile];
-    }
-    else if (metatile < NUM_METATILES_TOTAL)
-    {
-        attributes = gMapHeader.mapLayout->secondaryTileset->metatileAttributes;
-        return attributes[metatile - NUM_METATILES_IN_PRIMARY];
-    }
-    else
-    {
+    if (metatile >= NUM_METATILES_TOTAL)
         return MB_INVALID;
-    }
+
+    if (sMetatileAttributesLayout != gMapHeader.mapLayout)
+        LoadMetatileAttributes(gMapHeader.mapLayout);
+    return sMetatileAttributes[metatile];
 }
 
 void SaveMapView(void)
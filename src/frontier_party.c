@@ -0,0 +1,120 @@
+#include "global.h"
+#include "battle_tower.h"
+#include "frontier_party.h"
+#include "random.h"
+#include "constants/battle_frontier_mons.h"
+#include "constants/items.h"
+
+// Kept apart from battle_tower.c so that tools/hosttest can check it on the host.
+
+const u16 gBattleFrontierHeldItems[] =
+{
+    ITEM_NONE,
+    ITEM_KINGS_ROCK,
+    ITEM_SITRUS_BERRY,
+    ITEM_ORAN_BERRY,
+    ITEM_CHESTO_BERRY,
+    ITEM_HARD_STONE,
+    ITEM_FOCUS_BAND,
+    ITEM_PERSIM_BERRY,
+    ITEM_MIRACLE_SEED,
+    ITEM_BERRY_JUICE,
+    ITEM_MACHO_BRACE,
+    ITEM_SILVER_POWDER,
+    ITEM_CHERI_BERRY,
+    ITEM_BLACK_GLASSES,
+    ITEM_BLACK_BELT,
+    ITEM_SOUL_DEW,
+    ITEM_CHOICE_BAND,
+    ITEM_MAGNET,
+    ITEM_SILK_SCARF,
+    ITEM_WHITE_HERB,
+    ITEM_DEEP_SEA_SCALE,
+    ITEM_DEEP_SEA_TOOTH,
+    ITEM_MYSTIC_WATER,
+    ITEM_SHARP_BEAK,
+    ITEM_QUICK_CLAW,
+    ITEM_LEFTOVERS,
+    ITEM_RAWST_BERRY,
+    ITEM_LIGHT_BALL,
+    ITEM_POISON_BARB,
+    ITEM_NEVER_MELT_ICE,
+    ITEM_ASPEAR_BERRY,
+    ITEM_SPELL_TAG,
+    ITEM_BRIGHT_POWDER,
+    ITEM_LEPPA_BERRY,
+    ITEM_SCOPE_LENS,
+    ITEM_TWISTED_SPOON,
+    ITEM_METAL_COAT,
+    ITEM_MENTAL_HERB,
+    ITEM_CHARCOAL,
+    ITEM_PECHA_BERRY,
+    ITEM_SOFT_SAND,
+    ITEM_LUM_BERRY,
+    ITEM_DRAGON_SCALE,
+    ITEM_DRAGON_FANG,
+    ITEM_IAPAPA_BERRY,
+    ITEM_WIKI_BERRY,
+    ITEM_SEA_INCENSE,
+    ITEM_SHELL_BELL,
+    ITEM_SALAC_BERRY,
+    ITEM_LANSAT_BERRY,
+    ITEM_APICOT_BERRY,
+    ITEM_STARF_BERRY,
+    ITEM_LIECHI_BERRY,
+    ITEM_LEEK,
+    ITEM_LAX_INCENSE,
+    ITEM_AGUAV_BERRY,
+    ITEM_FIGY_BERRY,
+    ITEM_THICK_CLUB,
+    ITEM_MAGO_BERRY,
+    ITEM_METAL_POWDER,
+    ITEM_PETAYA_BERRY,
+    ITEM_LUCKY_PUNCH,
+    ITEM_GANLON_BERRY
+};
+
+// Frontier mons past FRONTIER_MONS_HIGH_TIER are too strong for the level 50 and level 20 challenges.
+u16 GetMaxFrontierMonId(u8 level)
+{
+    if (level == 50 || level == 20)
+        return FRONTIER_MONS_HIGH_TIER;
+    return 0xFFFF;
+}
+
+static bool32 IsFrontierMonAllowedInParty(u16 monId, u16 maxMonId, const u16 *partySpecies, const u16 *partyItems, s32 partyCount)
+{
+    s32 i;
+    u16 item = gBattleFrontierHeldItems[gFacilityTrainerMons[monId].itemTableId];
+
+    if (monId > maxMonId)
+        return FALSE;
+
+    for (i = 0; i < partyCount; i++)
+    {
+        if (partySpecies[i] == gFacilityTrainerMons[monId].species)
+            return FALSE;
+        if (partyItems[i] != ITEM_NONE && partyItems[i] == item)
+            return FALSE;
+    }
+
+    return TRUE;
+}
+
+// Draws one of the mons of monSet, which ends with 0xFFFF, with a single Random() call.
+// Every entry up to maxMonId whose species and held item aren't in the party yet is equally likely.
+u16 DrawFrontierPartyMon(const u16 *monSet, u16 maxMonId, const u16 *partySpecies, const u16 *partyItems, s32 partyCount)
+{
+    u16 validMonIds[0xFF];
+    s32 i, validCount = 0;
+
+    for (i = 0; monSet[i] != 0xFFFF; i++)
+    {
+        if (IsFrontierMonAllowedInParty(monSet[i], maxMonId, partySpecies, partyItems, partyCount))
+            validMonIds[validCount++] = monSet[i];
+    }
+
+    if (validCount == 0)
+        return FRONTIER_MON_NONE;
+    return validMonIds[Random() % validCount];
+}
@@ -96,6 +96,7 @@ u8 gLastSendQueueCount;
 struct Link gLink;
 u8 gLastRecvQueueCount;
 u16 gLinkSavedIme;
+EWRAM_DATA struct LinkQueueStats gLinkQueueStats = {};
 
 static EWRAM_DATA u8 sLinkTestDebugValuesEnabled = 0;
 static EWRAM_DATA u8 sDummyFlag = FALSE;
@@ -121,9 +122,11 @@ static void InitLocalLinkPlayer(void);
 static void VBlankCB_LinkError(void);
 static void CB2_LinkTest(void);
 static void ProcessRecvCmds(u8 unused);
+static void RecvBlockData(u8 who, const u16 *data, u16 count);
 static void LinkCB_SendHeldKeys(void);
 static void ResetBlockSend(void);
 static bool32 InitBlockSend(const void *src, size_t size);
+static bool32 CanBatchBlockSend(void);
 static void LinkCB_BlockSendBegin(void);
 static void LinkCB_BlockSend(void);
 static void LinkCB_BlockSendEnd(void);
@@ -328,6 +331,13 @@ static void InitLocalLinkPlayer(void)
     {
         gLocalLinkPlayer.progressFlags |= 0x10;
     }
+    gLocalLinkPlayer.features = 0;
+#if LINK_PACKED_RECORD_MIXING
+    gLocalLinkPlayer.features |= LINK_FEATURE_PACKED_RECORDS;
+#endif
+#if LINK_BATCHED_BLOCKS
+    gLocalLinkPlayer.features |= LINK_FEATURE_BATCHED_BLOCKS;
+#endif
 }
 
 static void VBlankCB_LinkError(void)
@@ -382,6 +392,7 @@ void OpenLink(void)
         InitRFUAPI();
     }
     gReceivedRemoteLinkPlayers = 0;
+    memset(&gLinkQueueStats, 0, sizeof(gLinkQueueStats));
     for (i = 0; i < MAX_LINK_PLAYERS; i++)
     {
         gRemoteLinkPlayersNotReceived[i] = TRUE;
@@ -522,6 +533,57 @@ static void HandleReceiveRemoteLinkPlayer(u8 who)
     }
 }
 
+static void RecvBlockData(u8 who, const u16 *data, u16 count)
+{
+    u16 *buffer;
+    u16 j;
+
+    if (sBlockRecv[who].size > BLOCK_BUFFER_SIZE)
+        buffer = (u16 *)gDecompressionBuffer;
+    else
+        buffer = gBlockRecvBuffer[who];
+
+    for (j = 0; j < count; j++)
+    {
+        buffer[(sBlockRecv[who].pos / 2) + j] = data[j];
+    }
+
+    sBlockRecv[who].pos += count * 2;
+
+    if (sBlockRecv[who].pos >= sBlockRecv[who].size)
+    {
+        if (gRemoteLinkPlayersNotReceived[who] == TRUE)
+        {
+            struct LinkPlayerBlock *block;
+            struct LinkPlayer *linkPlayer;
+
+            block = (struct LinkPlayerBlock *)&gBlockRecvBuffer[who];
+            linkPlayer = &gLinkPlayers[who];
+            *linkPlayer = block->linkPlayer;
+            if ((linkPlayer->version & 0xFF) == VERSION_RUBY || (linkPlayer->version & 0xFF) == VERSION_SAPPHIRE)
+            {
+                linkPlayer->progressFlagsCopy = 0;
+                linkPlayer->features = 0;
+                linkPlayer->progressFlags = 0;
+            }
+            ConvertLinkPlayerName(linkPlayer);
+            if (strcmp(block->magic1, sASCIIGameFreakInc) != 0
+                || strcmp(block->magic2, sASCIIGameFreakInc) != 0)
+            {
+                SetMainCallback2(CB2_LinkError);
+            }
+            else
+            {
+                HandleReceiveRemoteLinkPlayer(who);
+            }
+        }
+        else
+        {
+            SetBlockReceivedFlag(who);
+        }
+    }
+}
+
 static void ProcessRecvCmds(u8 unused)
 {
     u16 i;
@@ -566,64 +628,19 @@ static void ProcessRecvCmds(u8 unused)
                 blockRecv->multiplayerId = gRecvCmds[i][2];
                 break;
             }
-            case LINKCMD_CONT_BLOCK:
+            case LINKCMD_INIT_BLOCK_WITH_DATA:
             {
-                if (sBlockRecv[i].size > BLOCK_BUFFER_SIZE)
-                {
-                    u16 *buffer;
-                    u16 j;
-
-                    buffer = (u16 *)gDecompressionBuffer;
-                    for (j = 0; j < CMD_LENGTH - 1; j++)
-                    {
-                        buffer[(sBlockRecv[i].pos / 2) + j] = gRecvCmds[i][j + 1];
-                    }
-                }
-                else
-                {
-                    u16 j;
-
-                    for (j = 0; j < CMD_LENGTH - 1; j++)
-                    {
-                        gBlockRecvBuffer[i][(sBlockRecv[i].pos / 2) + j] = gRecvCmds[i][j + 1];
-                    }
-                }
-
-                sBlockRecv[i].pos += (CMD_LENGTH - 1) * 2;
+                struct BlockTransfer *blockRecv;
 
-                if (sBlockRecv[i].pos >= sBlockRecv[i].size)
-                {
-                    if (gRemoteLinkPlayersNotReceived[i] == TRUE)
-                    {
-                        struct LinkPlayerBlock *block;
-                        struct LinkPlayer *linkPlayer;
-
-                        block = (struct LinkPlayerBlock *)&gBlockRecvBuffer[i];
-                        linkPlayer = &gLinkPlayers[i];
-                        *linkPlayer = block->linkPlayer;
-                        if ((linkPlayer->version & 0xFF) == VERSION_RUBY || (linkPlayer->version & 0xFF) == VERSION_SAPPHIRE)
-                        {
-                            linkPlayer->progressFlagsCopy = 0;
-                            linkPlayer->neverRead = 0;
-                            linkPlayer->progressFlags = 0;
-                        }
-                        ConvertLinkPlayerName(linkPlayer);
-                        if (strcmp(block->magic1, sASCIIGameFreakInc) != 0
-                            || strcmp(block->magic2, sASCIIGameFreakInc) != 0)
-                        {
-                            SetMainCallback2(CB2_LinkError);
-                        }
-                        else
-                        {
-                            HandleReceiveRemoteLinkPlayer(i);
-                        }
-                    }
-                    else
-                    {
-                        SetBlockReceivedFlag(i);
-                    }
-                }
+                blockRecv = &sBlockRecv[i];
+                blockRecv->pos = 0;
+                blockRecv->size = gRecvCmds[i][1];
+                blockRecv->multiplayerId = gRecvCmds[i][2];
+                RecvBlockData(i, &gRecvCmds[i][3], CMD_LENGTH - 3);
+                break;
             }
+            case LINKCMD_CONT_BLOCK:
+                RecvBlockData(i, &gRecvCmds[i][1], CMD_LENGTH - 1);
                 break;
             case LINKCMD_READY_CLOSE_LINK:
                 gReadyToCloseLink[i] = TRUE;
@@ -679,6 +696,19 @@ static void BuildSendCmd(u16 command)
             gSendCmd[1] = sBlockSend.size;
             gSendCmd[2] = sBlockSend.multiplayerId + 0x80;
             break;
+        case LINKCMD_INIT_BLOCK_WITH_DATA:
+        {
+            u8 i;
+            const u8 *src = sBlockSend.src;
+
+            gSendCmd[0] = LINKCMD_INIT_BLOCK_WITH_DATA;
+            gSendCmd[1] = sBlockSend.size;
+            gSendCmd[2] = sBlockSend.multiplayerId + 0x80;
+            for (i = 0; i < CMD_LENGTH - 3; i++)
+                gSendCmd[i + 3] = (src[i * 2 + 1] << 8) | src[i * 2];
+            sBlockSend.pos = (CMD_LENGTH - 3) * 2;
+            break;
+        }
         case LINKCMD_BLENDER_NO_PBLOCK_SPACE:
             gSendCmd[0] = LINKCMD_BLENDER_NO_PBLOCK_SPACE;
             break;
@@ -795,6 +825,19 @@ bool32 Link_AnyPartnersPlayingRubyOrSapphire(void)
     return FALSE;
 }
 
+bool32 Link_AllPlayersHaveFeatures(u8 features)
+{
+    s32 i;
+    s32 count = GetLinkPlayerCount();
+
+    for (i = 0; i < count; i++)
+    {
+        if ((gLinkPlayers[i].features & features) != features)
+            return FALSE;
+    }
+    return TRUE;
+}
+
 bool32 Link_AnyPartnersPlayingFRLG_JP(void)
 {
     int i;
@@ -957,12 +1000,38 @@ static bool32 InitBlockSend(const void *src, size_t size)
 
         sBlockSend.src = gBlockSendBuffer;
     }
+    // Once everyone is known to read data in the header, the block starts
+    // on the next frame instead of after three empty ones.
+    if (CanBatchBlockSend())
+    {
+        BuildSendCmd(LINKCMD_INIT_BLOCK_WITH_DATA);
+        gLinkQueueStats.batchedBlocks++;
+        if (sBlockSend.size <= sBlockSend.pos)
+        {
+            sBlockSend.active = FALSE;
+            gLinkCallback = LinkCB_BlockSendEnd;
+        }
+        else
+        {
+            gLinkCallback = LinkCB_BlockSend;
+        }
+        return TRUE;
+    }
     BuildSendCmd(LINKCMD_INIT_BLOCK);
     gLinkCallback = LinkCB_BlockSendBegin;
     sBlockSendDelayCounter = 0;
     return TRUE;
 }
 
+static bool32 CanBatchBlockSend(void)
+{
+#if LINK_BATCHED_BLOCKS
+    return gReceivedRemoteLinkPlayers == TRUE && Link_AllPlayersHaveFeatures(LINK_FEATURE_BATCHED_BLOCKS);
+#else
+    return FALSE;
+#endif
+}
+
 static void LinkCB_BlockSendBegin(void)
 {
     if (++sBlockSendDelayCounter > 2)
@@ -974,6 +1043,19 @@ static void LinkCB_BlockSend(void)
     int i;
     const u8 *src;
 
+    // Nothing is lost by skipping a frame, so wait rather than let a lagging
+    // link fill the send queue.
+    if (gLink.sendQueue.count >= LINK_BLOCK_SEND_QUEUE_LIMIT)
+    {
+        gLinkQueueStats.blockSendThrottled++;
+        return;
+    }
+
+    // A block started by a request in ProcessRecvCmds has its header in
+    // gSendCmd already, so its data follows on the next frame.
+    if (gSendCmd[0] != 0)
+        return;
+
     src = sBlockSend.src;
     gSendCmd[0] = LINKCMD_CONT_BLOCK;
     for (i = 0; i < CMD_LENGTH - 1; i++)
@@ -1245,6 +1327,15 @@ static void Task_PrintTestData(u8 taskId)
 
     for (i = 0; i < MAX_LINK_PLAYERS; i++)
         LinkTest_PrintHex(gLinkTestBlockChecksums[i], 10, 4 + i, 4);
+
+    LinkTest_PrintHex(gLinkQueueStats.maxSendQueue, 2, 15, 2);
+    LinkTest_PrintHex(gLinkQueueStats.maxRecvQueue, 5, 15, 2);
+    LinkTest_PrintHex(gLinkQueueStats.sendQueueFull, 8, 15, 4);
+    LinkTest_PrintHex(gLinkQueueStats.recvQueueFull, 13, 15, 4);
+    LinkTest_PrintHex(gLinkQueueStats.recvStalls, 18, 15, 4);
+    LinkTest_PrintHex(gLinkQueueStats.blockSendThrottled, 2, 16, 4);
+    LinkTest_PrintHex(gLinkQueueStats.blockResends, 7, 16, 4);
+    LinkTest_PrintHex(gLinkQueueStats.batchedBlocks, 12, 16, 4);
 }
 
 void SetLinkDebugValues(u32 seed, u32 flags)
@@ -2042,11 +2133,14 @@ static void EnqueueSendCmd(u16 *sendCmd)
     else
     {
         gLink.queueFull = QUEUE_FULL_SEND;
+        gLinkQueueStats.sendQueueFull++;
     }
     if (sSendNonzeroCheck)
     {
         gLink.sendQueue.count++;
         sSendNonzeroCheck = 0;
+        if (gLinkQueueStats.maxSendQueue < gLink.sendQueue.count)
+            gLinkQueueStats.maxSendQueue = gLink.sendQueue.count;
     }
     REG_IME = gLinkSavedIme;
     gLastSendQueueCount = gLink.sendQueue.count;
@@ -2071,6 +2165,7 @@ static void DequeueRecvCmds(u16 (*recvCmds)[CMD_LENGTH])
         }
 
         gLink.receivedNothing = TRUE;
+        gLinkQueueStats.recvStalls++;
     }
     else
     {
@@ -2278,12 +2373,15 @@ static void DoRecv(void)
         else
         {
             gLink.queueFull = QUEUE_FULL_RECV;
+            gLinkQueueStats.recvQueueFull++;
         }
         gLink.recvCmdIndex++;
         if (gLink.recvCmdIndex == CMD_LENGTH && sRecvNonzeroCheck)
         {
             gLink.recvQueue.count++;
             sRecvNonzeroCheck = 0;
+            if (gLinkQueueStats.maxRecvQueue < gLink.recvQueue.count)
+                gLinkQueueStats.maxRecvQueue = gLink.recvQueue.count;
         }
     }
 }
@@ -943,6 +943,7 @@ static void HandleSendFailure(u8 unused, u32 flags)
             }
             RfuSendQueue_Enqueue(&Rfu.sendQueue, sResendBlock8);
             Rfu.sendBlock.failedFlags |= (1 << i);
+            gLinkQueueStats.blockResends++;
         }
         flags >>= 1;
     }
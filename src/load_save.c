@@ -1,6 +1,7 @@
 #include "global.h"
 #include "malloc.h"
 #include "berry_powder.h"
+#include "event_object_movement.h"
 #include "item.h"
 #include "load_save.h"
 #include "main.h"
@@ -188,6 +189,7 @@ void LoadObjectEvents(void)
 
     for (i = 0; i < OBJECT_EVENTS_COUNT; i++)
         gObjectEvents[i] = gSaveBlock1Ptr->objectEvents[i];
+    RebuildObjectEventCellIndex();
 }
 
 void SaveSerializedGame(void)
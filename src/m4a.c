@@ -1,12 +1,43 @@
 #include <string.h>
 #include "gba/m4a_internal.h"
+#include "constants/sound_config.h"
 
 extern const u8 gCgb3Vol[];
 
 #define BSS_CODE __attribute__((section(".bss.code")))
 
-BSS_CODE ALIGNED(4) char SoundMainRAM_Buffer[0xB40] = {0};
-BSS_CODE ALIGNED(4) u32 hq_buffer_ptr[0xE0] = {0};
+// gPcmSamplesPerVBlankTable for SOUND_MIXER_FREQ, to size the mixing buffers
+#if SOUND_MIXER_FREQ == SOUND_MODE_FREQ_05734
+#define MIXER_FRAME_LENGTH 96
+#elif SOUND_MIXER_FREQ == SOUND_MODE_FREQ_10512
+#define MIXER_FRAME_LENGTH 176
+#elif SOUND_MIXER_FREQ == SOUND_MODE_FREQ_13379
+#define MIXER_FRAME_LENGTH 224
+#elif SOUND_MIXER_FREQ == SOUND_MODE_FREQ_18157
+#define MIXER_FRAME_LENGTH 304
+#elif SOUND_MIXER_FREQ == SOUND_MODE_FREQ_21024
+#define MIXER_FRAME_LENGTH 352
+#elif SOUND_MIXER_FREQ == SOUND_MODE_FREQ_26758
+#define MIXER_FRAME_LENGTH 448
+#elif SOUND_MIXER_FREQ == SOUND_MODE_FREQ_31536
+#define MIXER_FRAME_LENGTH 528
+#elif SOUND_MIXER_FREQ == SOUND_MODE_FREQ_36314
+#define MIXER_FRAME_LENGTH 608
+#elif SOUND_MIXER_FREQ == SOUND_MODE_FREQ_40137
+#define MIXER_FRAME_LENGTH 672
+#elif SOUND_MIXER_FREQ == SOUND_MODE_FREQ_42048
+#define MIXER_FRAME_LENGTH 704
+#else
+#error "SOUND_MIXER_FREQ is not a rate the mixer supports"
+#endif
+
+BSS_CODE ALIGNED(4) char SoundMainRAM_Buffer[0xC00] = {0};
+BSS_CODE ALIGNED(4) u32 hq_buffer_ptr[MIXER_FRAME_LENGTH] = {0};
+#if SOUND_MIXER_HALF_RATE_BAND
+// The half rate band, after the last full rate sample and the last sample of
+// the band from the frame before
+BSS_CODE ALIGNED(4) u32 half_rate_buffer_ptr[MIXER_FRAME_LENGTH / 2 + 2] = {0};
+#endif
 
 struct SoundInfo gSoundInfo;
 struct PokemonCrySong gPokemonCrySongs[MAX_POKEMON_CRIES];
@@ -77,7 +108,7 @@ void m4aSoundInit(void)
     SoundInit(&gSoundInfo);
     MPlayExtender(gCgbChans);
     m4aSoundMode(SOUND_MODE_DA_BIT_8
-               | SOUND_MODE_FREQ_13379
+               | SOUND_MIXER_FREQ
                | (12 << SOUND_MODE_MASVOL_SHIFT)
                | (15 << SOUND_MODE_MAXCHN_SHIFT));
 
@@ -373,7 +404,7 @@ void SoundInit(struct SoundInfo *soundInfo)
 
     soundInfo->MPlayJumpTable = gMPlayJumpTable;
 
-    SampleFreqSet(SOUND_MODE_FREQ_13379);
+    SampleFreqSet(SOUND_MIXER_FREQ);
 
     soundInfo->ident = ID_NUMBER;
 }
@@ -393,6 +424,9 @@ void SampleFreqSet(u32 freq)
     // CPU frequency 16.78Mhz
     soundInfo->divFreq = (16777216 / soundInfo->pcmFreq + 1) >> 1;
 
+    // The mixing loops need half a frame to still be a multiple of 8 samples.
+    soundInfo->halfRateBand = SOUND_MIXER_HALF_RATE_BAND && !(soundInfo->pcmSamplesPerVBlank & 15);
+
     // Turn off timer 0.
     REG_TM0CNT_H = 0;
 
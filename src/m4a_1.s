@@ -2,6 +2,11 @@
 	.include "constants/gba_constants.inc"
 	.include "constants/m4a_constants.inc"
 
+@ sound_config.h is written for C, which gets these from gba/defines.h
+#define TRUE  1
+#define FALSE 0
+#include "constants/sound_config.h"
+
 	.syntax unified
 
 	.text
@@ -138,6 +143,7 @@ lt_PCM_DMA_BUF_SIZE:      .word PCM_DMA_BUF_SIZE
 	.equ VAR_REVERB, 0x5                     @ [byte] 0-127 = reverb level
 	.equ VAR_MAX_CHN, 0x6                    @ [byte] maximum channels to process
 	.equ VAR_MASTER_VOL, 0x7                 @ [byte] PCM master volume
+	.equ VAR_EXT_HALF_RATE_BAND, 0xD         @ [byte] normally unused, set to mix low pitched channels at half rate
 	.equ VAR_EXT_NOISE_SHAPE_LEFT, 0xE       @ [byte] normally unused, used here for noise shaping
 	.equ VAR_EXT_NOISE_SHAPE_RIGHT, 0xF      @ [byte] normally unused, used here for noise shaping
 	.equ VAR_DEF_PITCH_FAC, 0x18             @ [word] this value get's multiplied with the samplerate for the inter sample distance
@@ -395,6 +401,10 @@ C_sample_loop_setup_skip:
 	.align 2
 hq_buffer_literal:
 	.word hq_buffer_ptr
+#if SOUND_MIXER_HALF_RATE_BAND
+half_rate_buffer_literal:
+	.word half_rate_buffer_ptr + 8
+#endif
 
 	.arm
 	.align  2
@@ -417,7 +427,12 @@ hq_buffer_literal:
 C_mixing_setup:
 	/* frequency and mixing loading routine */
 	ldrsb r6, [r4, #CHN_SAMPLE_STOR]
+#if SOUND_MIXER_HALF_RATE_BAND
+	ldr r1, [sp, #ARG_PCM_STRUCT]
+	ldr r8, [r1, #o_SoundInfo_pcmSamplesPerVBlank]     @ the half rate band changes ARG_FRAME_LENGTH
+#else
 	ldr r8, [sp, #ARG_FRAME_LENGTH]
+#endif
 	orrs r11, r11, r10, lsl#16           @ r11 = 00LL00RR
 	beq C_mixing_epilogue               @ volume #0 --> branch and skip channel processing
 	/* normal processing otherwise */
@@ -439,6 +454,23 @@ C_mixing_setup_comp_rev:
 	movs r11, r11, lsr#1
 	adc r11, r11, #0x8000
 	bic r11, r11, #0x8000
+#if SOUND_MIXER_HALF_RATE_BAND
+	/*
+	 * Channels with a step below 0.5 have nothing above half of the half
+	 * sample rate, so the half rate band mixes them at half the frame
+	 * length into their own buffer, which is added to the mix afterwards
+	 */
+	ldrb r1, [r1, #VAR_EXT_HALF_RATE_BAND]
+	cmp r1, #0
+	cmpne r4, #0x400000
+	bhs C_mixing_setup_full_rate
+	tst r0, #TONEDATA_TYPE_FIX
+	moveq r4, r4, lsl#1
+	moveq r8, r8, lsr#1
+	ldreq r5, half_rate_buffer_literal
+C_mixing_setup_full_rate:
+	str r8, [sp, #(ARG_FRAME_LENGTH+0xC)]
+#endif
 	mov r1, r7                          @ r1 = inter sample position
 	/*
 	 * There is 2 different mixing codepaths for uncompressed data
@@ -1035,6 +1067,67 @@ C_end_channel_state_loop:
 	b C_channel_state_loop
 
 C_main_mixer_return:
+#if SOUND_MIXER_HALF_RATE_BAND
+	ldr r3, [sp, #ARG_PCM_STRUCT]
+	ldr r0, [r3, #o_SoundInfo_pcmSamplesPerVBlank]
+	str r0, [sp, #ARG_FRAME_LENGTH]
+	ldrb r0, [r3, #VAR_EXT_HALF_RATE_BAND]
+	cmp r0, #0
+	beq C_upsampler_return
+	adr r0, C_upsampler
+	bx r0
+
+	.arm
+	.align 2
+
+	/*
+	 * adds the half rate band to the mix, with a sample between each two of
+	 * its own that is their average. The lanes are averaged apart so the
+	 * right one doesn't carry into the left. The last sample of the band is
+	 * kept in front of it for the next frame, which puts the band a sample
+	 * late, so the rest of the mix is moved a sample later too and its last
+	 * sample kept in front of that. A channel whose step crosses into or out
+	 * of the band then doesn't skip a sample.
+	 */
+C_upsampler:
+	ldr r8, [sp, #ARG_FRAME_LENGTH]
+	ldr r9, half_rate_buffer_literal
+	ldr r10, hq_buffer_literal
+	ldr r4, [r9, #-8]                   @ r4 = previous full rate sample
+	ldr r0, [r9, #-4]                   @ r0 = previous band sample
+	mov r11, #0
+
+C_upsampler_loop:
+	ldr r1, [r9]                        @ r1 = next band sample
+	str r11, [r9], #4
+	mov r2, r0, asr#1
+	add r2, r2, r1, asr#1               @ r2 = average, left lane in the upper half
+	mov r0, r0, lsl#16
+	mov r0, r0, asr#1
+	mov r3, r1, lsl#16
+	add r0, r0, r3, asr#1               @ r0 = average of the right lanes in the upper half
+	mov r2, r2, lsr#16
+	mov r0, r0, lsr#16
+	orr r2, r0, r2, lsl#16
+	ldmia r10, {r3, r12}
+	add r2, r2, r4
+	add r3, r3, r1
+	mov r4, r12
+	stmia r10!, {r2, r3}
+	mov r0, r1
+	subs r8, r8, #2
+	bgt C_upsampler_loop
+
+	ldr r9, half_rate_buffer_literal
+	str r4, [r9, #-8]
+	str r0, [r9, #-4]
+	adr r0, (C_upsampler_return+1)
+	bx r0
+
+	.thumb
+
+C_upsampler_return:
+#endif
 	ldr r3, [sp, #ARG_PCM_STRUCT]
 	ldrb r4, [r3, #VAR_EXT_NOISE_SHAPE_LEFT]
 	lsl r4, r4, #16
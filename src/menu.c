@@ -57,6 +57,7 @@ static EWRAM_DATA u8 sYesNoWindowId = 0;
 static EWRAM_DATA u8 sWindowId = 0;
 static EWRAM_DATA u16 sFiller = 0;  // needed to align
 static EWRAM_DATA bool8 sScheduledBgCopiesToVram[4] = {FALSE};
+static EWRAM_DATA u32 sScheduledBgRowCopiesToVram[4] = {0};
 static EWRAM_DATA u16 sTempTileDataBufferIdx = 0;
 static EWRAM_DATA void *sTempTileDataBuffer[0x20] = {NULL};
 
@@ -1736,6 +1737,7 @@ u8 InitMenuActionGrid(u8 windowId, u8 optionWidth, u8 columns, u8 rows, u8 initi
 void ClearScheduledBgCopiesToVram(void)
 {
     memset(sScheduledBgCopiesToVram, 0, sizeof(sScheduledBgCopiesToVram));
+    memset(sScheduledBgRowCopiesToVram, 0, sizeof(sScheduledBgRowCopiesToVram));
 }
 
 void ScheduleBgCopyTilemapToVram(u8 bgId)
@@ -1743,27 +1745,64 @@ void ScheduleBgCopyTilemapToVram(u8 bgId)
     sScheduledBgCopiesToVram[bgId] = TRUE;
 }
 
-void DoScheduledBgTilemapCopiesToVram(void)
+// Schedules a copy of only the tilemap rows set in rowMask (bit n = tile row n).
+// Rows scheduled for the same bg during a frame are merged and copied once.
+void ScheduleBgCopyTilemapRowsToVram(u8 bgId, u32 rowMask)
 {
-    if (sScheduledBgCopiesToVram[0] == TRUE)
-    {
-        CopyBgTilemapBufferToVram(0);
-        sScheduledBgCopiesToVram[0] = FALSE;
-    }
-    if (sScheduledBgCopiesToVram[1] == TRUE)
+    sScheduledBgRowCopiesToVram[bgId] |= rowMask;
+}
+
+// Past this many separate runs of rows the per-request overhead outweighs
+// the bytes saved, so the whole tilemap is copied instead.
+#define MAX_BG_ROW_COPY_RUNS 4
+
+static void CopyBgTilemapRowsToVram(u8 bgId, u32 rowMask)
+{
+    u8 rows[MAX_BG_ROW_COPY_RUNS][2];
+    u8 numRuns = 0;
+    u8 row = 0;
+
+    while (rowMask != 0)
     {
-        CopyBgTilemapBufferToVram(1);
-        sScheduledBgCopiesToVram[1] = FALSE;
+        while (!(rowMask & 1))
+        {
+            rowMask >>= 1;
+            row++;
+        }
+        if (numRuns == MAX_BG_ROW_COPY_RUNS)
+        {
+            CopyBgTilemapBufferToVram(bgId);
+            return;
+        }
+        rows[numRuns][0] = row;
+        while (rowMask & 1)
+        {
+            rowMask >>= 1;
+            row++;
+        }
+        rows[numRuns][1] = row - rows[numRuns][0];
+        numRuns++;
     }
-    if (sScheduledBgCopiesToVram[2] == TRUE)
+
+    while (numRuns != 0)
     {
-        CopyBgTilemapBufferToVram(2);
-        sScheduledBgCopiesToVram[2] = FALSE;
+        numRuns--;
+        CopyBgTilemapBufferRowsToVram(bgId, rows[numRuns][0], rows[numRuns][1]);
     }
-    if (sScheduledBgCopiesToVram[3] == TRUE)
+}
+
+void DoScheduledBgTilemapCopiesToVram(void)
+{
+    u8 i;
+
+    for (i = 0; i < ARRAY_COUNT(sScheduledBgCopiesToVram); i++)
     {
-        CopyBgTilemapBufferToVram(3);
-        sScheduledBgCopiesToVram[3] = FALSE;
+        if (sScheduledBgCopiesToVram[i] == TRUE)
+            CopyBgTilemapBufferToVram(i);
+        else if (sScheduledBgRowCopiesToVram[i] != 0)
+            CopyBgTilemapRowsToVram(i, sScheduledBgRowCopiesToVram[i]);
+        sScheduledBgCopiesToVram[i] = FALSE;
+        sScheduledBgRowCopiesToVram[i] = 0;
     }
 }
 
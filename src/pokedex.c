@@ -199,6 +199,18 @@ struct PokedexListItem
     u16 owned:1;
 };
 
+#define DEX_SEARCH_WORDS ((NATIONAL_DEX_COUNT + 31) / 32)
+#define BODY_COLOR_COUNT (BODY_COLOR_PINK + 1)
+
+// Bitsets over national dex numbers (bit n - 1 for dex number n), so a search
+// is a few ANDs instead of a pass over the list per criterion
+struct PokedexSearchIndex
+{
+    u32 types[NUMBER_OF_MON_TYPES][DEX_SEARCH_WORDS];
+    u32 bodyColors[BODY_COLOR_COUNT][DEX_SEARCH_WORDS];
+    u32 abcGroups[NAME_YZ + 1][DEX_SEARCH_WORDS];
+};
+
 struct PokedexView
 {
     struct PokedexListItem pokedexList[NATIONAL_DEX_COUNT + 1];
@@ -249,6 +261,7 @@ struct PokedexView
     s16 menuY;     //Menu Y position (inverted because we use REG_BG0VOFS for this)
     u8 unkArr2[8]; // Cleared, never read
     u8 unkArr3[8]; // Cleared, never read
+    struct PokedexSearchIndex *searchIndex; // Built on the first search
 };
 
 // this file's functions
@@ -2183,6 +2196,7 @@ static void Task_ClosePokedex(u8 taskId)
             SetMainCallback2(CB2_ReturnToFieldWithOpenMenu);
         }
         m4aMPlayVolumeControl(&gMPlayInfo_BGM, 0xFFFF, 0x100);
+        TRY_FREE_AND_SET_NULL(sPokedexView->searchIndex);
         Free(sPokedexView);
     }
 }
@@ -5180,64 +5194,73 @@ bool8  SpeciesCanLearnLvlUpMove(u16 species, u16 move) //Move search PokedexPlus
 }
 
 
+static void BuildPokedexSearchIndex(struct PokedexSearchIndex *index)
+{
+    u16 dexNum, species;
+    u32 word, bit;
+    u8 firstLetter, group;
+
+    for (dexNum = 1; dexNum <= NATIONAL_DEX_COUNT; dexNum++)
+    {
+        species = NationalPokedexNumToSpecies(dexNum);
+        word = (dexNum - 1) / 32;
+        bit = 1 << ((dexNum - 1) % 32);
+
+        if (gBaseStats[species].type1 < NUMBER_OF_MON_TYPES)
+            index->types[gBaseStats[species].type1][word] |= bit;
+        if (gBaseStats[species].type2 < NUMBER_OF_MON_TYPES)
+            index->types[gBaseStats[species].type2][word] |= bit;
+        if (gBaseStats[species].bodyColor < BODY_COLOR_COUNT)
+            index->bodyColors[gBaseStats[species].bodyColor][word] |= bit;
+
+        firstLetter = gSpeciesNames[species][0];
+        for (group = NAME_ABC; group <= NAME_YZ; group++)
+        {
+            if (LETTER_IN_RANGE_UPPER(firstLetter, group) || LETTER_IN_RANGE_LOWER(firstLetter, group))
+                index->abcGroups[group][word] |= bit;
+        }
+    }
+}
+
+static void AndSearchBitset(u32 *matches, const u32 *bitset)
+{
+    u16 i;
+
+    for (i = 0; i < DEX_SEARCH_WORDS; i++)
+        matches[i] &= bitset[i];
+}
+
 static int DoPokedexSearch(u8 dexMode, u8 order, u8 abcGroup, u8 bodyColor, u8 type1, u8 type2) // ,u16 move)
 {
     u16 species;
     u16 i,j;
     u16 resultsCount;
-    u8 types[2];
+    u16 dexNum;
+    u32 matches[DEX_SEARCH_WORDS];
+    bool8 searchType;
 
     u8 tutorMoveId, tmMoveId; //PokedexPlus HGSS_Ui
     u16 move = 0xFFFF;
 
     CreatePokedexList(dexMode, order);
 
-    for (i = 0, resultsCount = 0; i < NATIONAL_DEX_COUNT; i++)
+    if (sPokedexView->searchIndex == NULL)
     {
-        if (sPokedexView->pokedexList[i].seen)
-        {
-            sPokedexView->pokedexList[resultsCount] = sPokedexView->pokedexList[i];
-            resultsCount++;
-        }
+        sPokedexView->searchIndex = AllocZeroed(sizeof(struct PokedexSearchIndex));
+        BuildPokedexSearchIndex(sPokedexView->searchIndex);
     }
-    sPokedexView->pokemonListCount = resultsCount;
-
-    // Search by name
-    if (abcGroup != 0xFF)
-    {
-        for (i = 0, resultsCount = 0; i < sPokedexView->pokemonListCount; i++)
-        {
-            u8 firstLetter;
 
-            species = NationalPokedexNumToSpecies(sPokedexView->pokedexList[i].dexNum);
-            firstLetter = gSpeciesNames[species][0];
-            if (LETTER_IN_RANGE_UPPER(firstLetter, abcGroup) || LETTER_IN_RANGE_LOWER(firstLetter, abcGroup))
-            {
-                sPokedexView->pokedexList[resultsCount] = sPokedexView->pokedexList[i];
-                resultsCount++;
-            }
-        }
-        sPokedexView->pokemonListCount = resultsCount;
-    }
+    // Combine the name, color and type criteria into one set of matching dex numbers
+    for (i = 0; i < DEX_SEARCH_WORDS; i++)
+        matches[i] = 0xFFFFFFFF;
 
-    // Search by body color
+    if (abcGroup != 0xFF)
+        AndSearchBitset(matches, sPokedexView->searchIndex->abcGroups[abcGroup]);
     if (bodyColor != 0xFF)
-    {
-        for (i = 0, resultsCount = 0; i < sPokedexView->pokemonListCount; i++)
-        {
-            species = NationalPokedexNumToSpecies(sPokedexView->pokedexList[i].dexNum);
+        AndSearchBitset(matches, sPokedexView->searchIndex->bodyColors[bodyColor]);
 
-            if (bodyColor == gBaseStats[species].bodyColor)
-            {
-                sPokedexView->pokedexList[resultsCount] = sPokedexView->pokedexList[i];
-                resultsCount++;
-            }
-        }
-        sPokedexView->pokemonListCount = resultsCount;
-    }
-
-    // Search by type
-    if (type1 != TYPE_NONE || type2 != TYPE_NONE)
+    searchType = (type1 != TYPE_NONE || type2 != TYPE_NONE);
+    if (searchType)
     {
         if (type1 == TYPE_NONE)
         {
@@ -5245,44 +5268,35 @@ static int DoPokedexSearch(u8 dexMode, u8 order, u8 abcGroup, u8 bodyColor, u8 t
             type2 = TYPE_NONE;
         }
 
-        if (type2 == TYPE_NONE)
-        {
-            for (i = 0, resultsCount = 0; i < sPokedexView->pokemonListCount; i++)
-            {
-                if (sPokedexView->pokedexList[i].owned)
-                {
-                    species = NationalPokedexNumToSpecies(sPokedexView->pokedexList[i].dexNum);
-
-                    types[0] = gBaseStats[species].type1;
-                    types[1] = gBaseStats[species].type2;
-                    if (types[0] == type1 || types[1] == type1)
-                    {
-                        sPokedexView->pokedexList[resultsCount] = sPokedexView->pokedexList[i];
-                        resultsCount++;
-                    }
-                }
-            }
-        }
-        else
+        AndSearchBitset(matches, sPokedexView->searchIndex->types[type1]);
+        if (type2 != TYPE_NONE)
+            AndSearchBitset(matches, sPokedexView->searchIndex->types[type2]);
+    }
+
+    // Filter the list in one pass, keeping its order. Type searches only show caught Pokémon.
+    for (i = 0, resultsCount = 0; i < NATIONAL_DEX_COUNT; i++)
+    {
+        if (!sPokedexView->pokedexList[i].seen)
+            continue;
+        if (searchType && !sPokedexView->pokedexList[i].owned)
+            continue;
+
+        dexNum = sPokedexView->pokedexList[i].dexNum;
+        if (!(matches[(dexNum - 1) / 32] & (1 << ((dexNum - 1) % 32))))
+            continue;
+
+        // Picking the same type twice only matches single-type Pokémon
+        if (searchType && type1 == type2)
         {
-            for (i = 0, resultsCount = 0; i < sPokedexView->pokemonListCount; i++)
-            {
-                if (sPokedexView->pokedexList[i].owned)
-                {
-                    species = NationalPokedexNumToSpecies(sPokedexView->pokedexList[i].dexNum);
-
-                    types[0] = gBaseStats[species].type1;
-                    types[1] = gBaseStats[species].type2;
-                    if ((types[0] == type1 && types[1] == type2) || (types[0] == type2 && types[1] == type1))
-                    {
-                        sPokedexView->pokedexList[resultsCount] = sPokedexView->pokedexList[i];
-                        resultsCount++;
-                    }
-                }
-            }
+            species = NationalPokedexNumToSpecies(dexNum);
+            if (gBaseStats[species].type1 != gBaseStats[species].type2)
+                continue;
         }
-        sPokedexView->pokemonListCount = resultsCount;
+
+        sPokedexView->pokedexList[resultsCount] = sPokedexView->pokedexList[i];
+        resultsCount++;
     }
+    sPokedexView->pokemonListCount = resultsCount;
 
     // Search by move
     if (move != 0xFFFF)
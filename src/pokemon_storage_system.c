@@ -27,8 +27,10 @@
 #include "pokemon_icon.h"
 #include "pokemon_summary_screen.h"
 #include "pokemon_storage_system.h"
+#include "save.h"
 #include "script.h"
 #include "sound.h"
+#include "storage_sort.h"
 #include "string_util.h"
 #include "strings.h"
 #include "text.h"
@@ -93,6 +95,8 @@ enum {
     MSG_ITEM_IS_HELD,
     MSG_CHANGED_TO_ITEM,
     MSG_CANT_STORE_MAIL,
+    MSG_SORT_BY_WHAT,
+    MSG_BOXES_TOO_FULL,
 };
 
 // IDs for how to resolve variables in the above messages
@@ -148,9 +152,17 @@ enum {
     MENU_POKECENTER,
     MENU_MACHINE,
     MENU_SIMPLE,
+    MENU_SORT,
+    MENU_SORT_SPECIES,
+    MENU_SORT_DEX_NUM,
+    MENU_SORT_LEVEL,
+    MENU_SORT_TYPE,
+    MENU_SORT_ITEM,
+    MENU_SORT_NATURE,
 };
 #define MENU_WALLPAPER_SETS_START MENU_SCENERY_1
 #define MENU_WALLPAPERS_START MENU_FOREST
+#define MENU_SORT_KEYS_START MENU_SORT_SPECIES
 #define GENDER_MASK 0x7FFF
 
 // Return IDs for input handlers
@@ -570,6 +582,7 @@ EWRAM_DATA static bool8 sIsMonBeingMoved = 0;
 EWRAM_DATA static u8 sMovingMonOrigBoxId = 0;
 EWRAM_DATA static u8 sMovingMonOrigBoxPos = 0;
 EWRAM_DATA static bool8 sAutoActionOn = 0;
+EWRAM_DATA static u16 sBoxMonCountOnOpen = 0;
 
 // Main tasks
 static void EnterPokeStorage(u8);
@@ -600,6 +613,7 @@ static void Task_ReleaseMon(u8);
 static void Task_ReshowPokeStorage(u8);
 static void Task_PokeStorageMain(u8);
 static void Task_JumpBox(u8);
+static void Task_SortBox(u8);
 static void Task_HandleWallpapers(u8);
 static void Task_NameBox(u8);
 static void Task_PrintCantStoreMail(u8);
@@ -628,12 +642,15 @@ static void InitMenu(void);
 static void SetMenuText(u8);
 static s8 GetMenuItemTextId(u8);
 static void AddMenu(void);
+static void AddSortMenu(void);
 static bool8 IsMenuLoading(void);
 static s16 HandleMenuInput(void);
 static void RemoveMenu(void);
 
 // Pokémon sprites
 static void InitMonIconFields(void);
+static void InitBoxMonSprites(u8);
+static void DestroyBoxMonIconAtPosition(u8);
 static void SpriteCB_BoxMonIconScrollOut(struct Sprite *);
 static void GetIncomingBoxMonData(u8);
 static void CreatePartyMonsSprites(bool8);
@@ -659,6 +676,7 @@ static void SetPlacedMonData(u8, u8);
 static void PurgeMonOrBoxMon(u8, u8);
 static void SetShiftedMonData(u8, u8);
 static bool8 TryStorePartyMonInBox(u8);
+static bool8 CanStoreMonInBoxes(void);
 static void ResetSelectionAfterDeposit(void);
 static void InitReleaseMon(void);
 static bool8 TryHideReleaseMon(void);
@@ -698,6 +716,11 @@ static void MultiMove_ResetBg(void);
 static void MultiMove_UpdateSelectedIcons(void);
 static void MultiMove_InitMove(u16, u16, u16);
 static void MultiMove_GetMonsFromSelection(void);
+
+// Storage index
+static u32 GetIndexedBoxMonData(u8, u8, s32);
+static u32 GetIndexedBoxMonKnownMoves(u8, u8, const u16 *);
+static u8 GetIndexedBoxMonCount(u8);
 static void MultiMove_RemoveMonsFromBox(void);
 static void MultiMove_CreatePlacedMonIcons(void);
 static void MultiMove_SetPlacedMonData(void);
@@ -1108,6 +1131,8 @@ static const struct StorageMessage sMessages[] =
     [MSG_ITEM_IS_HELD]         = {gText_ItemIsNowHeld,           MSG_VAR_ITEM_NAME},
     [MSG_CHANGED_TO_ITEM]      = {gText_ChangedToNewItem,        MSG_VAR_ITEM_NAME},
     [MSG_CANT_STORE_MAIL]      = {gText_MailCantBeStored,        MSG_VAR_NONE},
+    [MSG_SORT_BY_WHAT]         = {gText_SortBoxByWhat,           MSG_VAR_NONE},
+    [MSG_BOXES_TOO_FULL]       = {gText_BoxesTooFullToSave,      MSG_VAR_NONE},
 };
 
 static const struct WindowTemplate sYesNoWindowTemplate =
@@ -1411,21 +1436,37 @@ static void UnusedDrawTextWindow(const u8 *string, void *dst, u16 offset, u8 bgC
 
 u8 CountMonsInBox(u8 boxId)
 {
-    u16 i, count;
+    if (boxId < TOTAL_BOXES_COUNT)
+        return GetIndexedBoxMonCount(boxId);
+    else
+        return 0;
+}
 
-    for (i = 0, count = 0; i < IN_BOX_COUNT; i++)
-    {
-        if (GetBoxMonDataAt(boxId, i, MON_DATA_SPECIES) != SPECIES_NONE)
-            count++;
-    }
+u16 CountStorageMons(void)
+{
+    u16 count = 0;
+    u8 boxId;
+
+    for (boxId = 0; boxId < TOTAL_BOXES_COUNT; boxId++)
+        count += CountMonsInBox(boxId);
 
     return count;
 }
 
+// Returns whether another Pokémon can go into the boxes without making them
+// too large to save, see IsStorageMonCountSaveable.
+bool8 CanStorageHoldAnotherMon(void)
+{
+    return IsStorageMonCountSaveable(CountStorageMons() + 1);
+}
+
 s16 GetFirstFreeBoxSpot(u8 boxId)
 {
     u16 i;
 
+    if (CountMonsInBox(boxId) == IN_BOX_COUNT)
+        return -1;
+
     for (i = 0; i < IN_BOX_COUNT; i++)
     {
         if (GetBoxMonDataAt(boxId, i, MON_DATA_SPECIES) == SPECIES_NONE)
@@ -2027,6 +2068,7 @@ static void EnterPokeStorage(u8 boxOption)
         sStorage->state = 0;
         sStorage->taskId = CreateTask(Task_InitPokeStorage, 3);
         sLastUsedBox = StorageGetCurrentBox();
+        sBoxMonCountOnOpen = CountStorageMons();
         SetMainCallback2(CB2_PokeStorage);
     }
 }
@@ -2274,6 +2316,7 @@ enum {
     MSTATE_WAIT_MSG,
     MSTATE_ERROR_LAST_PARTY_MON,
     MSTATE_ERROR_HAS_MAIL,
+    MSTATE_ERROR_BOXES_TOO_FULL,
     MSTATE_WAIT_ERROR_MSG,
     MSTATE_MULTIMOVE_RUN,
     MSTATE_MULTIMOVE_RUN_CANCEL,
@@ -2408,8 +2451,15 @@ static void Task_PokeStorageMain(u8 taskId)
             SetPokeStorageTask(Task_WithdrawMon);
             break;
         case INPUT_PLACE_MON:
-            PlaySE(SE_SELECT);
-            SetPokeStorageTask(Task_PlaceMon);
+            if (sCursorArea == CURSOR_AREA_IN_BOX && !CanStoreMonInBoxes())
+            {
+                sStorage->state = MSTATE_ERROR_BOXES_TOO_FULL;
+            }
+            else
+            {
+                PlaySE(SE_SELECT);
+                SetPokeStorageTask(Task_PlaceMon);
+            }
             break;
         case INPUT_TAKE_ITEM:
             PlaySE(SE_SELECT);
@@ -2509,6 +2559,11 @@ static void Task_PokeStorageMain(u8 taskId)
         PrintMessage(MSG_PLEASE_REMOVE_MAIL);
         sStorage->state = MSTATE_WAIT_ERROR_MSG;
         break;
+    case MSTATE_ERROR_BOXES_TOO_FULL:
+        PlaySE(SE_FAILURE);
+        PrintMessage(MSG_BOXES_TOO_FULL);
+        sStorage->state = MSTATE_WAIT_ERROR_MSG;
+        break;
     case MSTATE_WAIT_ERROR_MSG:
         if (JOY_NEW(A_BUTTON | B_BUTTON | DPAD_ANY))
         {
@@ -2884,7 +2939,12 @@ static void Task_DepositMenu(u8 taskId)
             SetPokeStorageTask(Task_PokeStorageMain);
             break;
         default:
-            if (TryStorePartyMonInBox(boxId))
+            if (!CanStoreMonInBoxes())
+            {
+                PrintMessage(MSG_BOXES_TOO_FULL);
+                sStorage->state = 4;
+            }
+            else if (TryStorePartyMonInBox(boxId))
             {
                 sDepositBoxId = boxId;
                 ClearBottomWindow();
@@ -3426,6 +3486,54 @@ static void Task_HandleBoxOptions(u8 taskId)
             ClearBottomWindow();
             SetPokeStorageTask(Task_JumpBox);
             break;
+        case MENU_SORT:
+            PlaySE(SE_SELECT);
+            ClearBottomWindow();
+            SetPokeStorageTask(Task_SortBox);
+            break;
+        }
+        break;
+    }
+}
+
+static void Task_SortBox(u8 taskId)
+{
+    s16 input;
+
+    switch (sStorage->state)
+    {
+    case 0:
+        AddSortMenu();
+        PrintMessage(MSG_SORT_BY_WHAT);
+        sStorage->state++;
+        break;
+    case 1:
+        input = HandleMenuInput();
+        switch (input)
+        {
+        case MENU_NOTHING_CHOSEN:
+            break;
+        case MENU_B_PRESSED:
+            AnimateBoxScrollArrows(TRUE);
+            ClearBottomWindow();
+            SetPokeStorageTask(Task_PokeStorageMain);
+            break;
+        default:
+            PlaySE(SE_SELECT);
+            ClearBottomWindow();
+            SortStorageBoxes(StorageGetCurrentBox(), StorageGetCurrentBox(), input - MENU_SORT_KEYS_START);
+            for (input = 0; input < IN_BOX_COUNT; input++)
+                DestroyBoxMonIconAtPosition(input);
+            InitBoxMonSprites(StorageGetCurrentBox());
+            sStorage->state++;
+            break;
+        }
+        break;
+    case 2:
+        if (!IsDma3ManagerBusyWithBgCopy())
+        {
+            AnimateBoxScrollArrows(TRUE);
+            SetPokeStorageTask(Task_PokeStorageMain);
         }
         break;
     }
@@ -6461,6 +6569,16 @@ static bool8 TryStorePartyMonInBox(u8 boxId)
     return TRUE;
 }
 
+// Whether the Pokémon being deposited or placed may go into the boxes. They may
+// not get too full to save, unless they already were when the PC was opened,
+// so that a Pokémon taken out of them can always be put back.
+static bool8 CanStoreMonInBoxes(void)
+{
+    u16 count = CountStorageMons() + 1;
+
+    return count <= sBoxMonCountOnOpen || IsStorageMonCountSaveable(count);
+}
+
 static void ResetSelectionAfterDeposit(void)
 {
     StartSpriteAnim(sStorage->cursorSprite, CURSOR_ANIM_BOUNCE);
@@ -6679,8 +6797,9 @@ static s8 RunCanReleaseMon(void)
         break;
     case 1:
         // Check PC for other Pokémon that know any restricted
-        // moves the release Pokémon knows
-        for (i = 0; i < IN_BOX_COUNT; i++)
+        // moves the release Pokémon knows. The storage index
+        // makes this cheap enough to check every box at once.
+        while (!sStorage->releaseStatusResolved)
         {
             knownMoves = GetAndCopyBoxMonDataAt(sStorage->releaseCheckBoxId, sStorage->releaseCheckBoxPos, MON_DATA_KNOWN_MOVES, (u8*)sStorage->restrictedMoveList);
             if (knownMoves != 0 && !(sStorage->releaseBoxId == sStorage->releaseCheckBoxId 
@@ -6923,27 +7042,28 @@ static void SetDisplayMonData(void *pokemon, u8 mode)
     }
     else if (mode == MODE_BOX)
     {
-        struct BoxPokemon *boxMon = (struct BoxPokemon *)pokemon;
+        struct DecodedBoxMon boxMon;
 
-        sStorage->displayMonSpecies = GetBoxMonData(pokemon, MON_DATA_SPECIES2);
+        DecodeBoxMon(&boxMon, (struct BoxPokemon *)pokemon);
+        sStorage->displayMonSpecies = GetDecodedBoxMonData(&boxMon, MON_DATA_SPECIES2, NULL);
         if (sStorage->displayMonSpecies != SPECIES_NONE)
         {
-            u32 otId = GetBoxMonData(boxMon, MON_DATA_OT_ID);
-            sanityIsBadEgg = GetBoxMonData(boxMon, MON_DATA_SANITY_IS_BAD_EGG);
+            u32 otId = GetDecodedBoxMonData(&boxMon, MON_DATA_OT_ID, NULL);
+            sanityIsBadEgg = GetDecodedBoxMonData(&boxMon, MON_DATA_SANITY_IS_BAD_EGG, NULL);
             if (sanityIsBadEgg)
                 sStorage->displayMonIsEgg = TRUE;
             else
-                sStorage->displayMonIsEgg = GetBoxMonData(boxMon, MON_DATA_IS_EGG);
+                sStorage->displayMonIsEgg = GetDecodedBoxMonData(&boxMon, MON_DATA_IS_EGG, NULL);
 
 
-            GetBoxMonData(boxMon, MON_DATA_NICKNAME, sStorage->displayMonName);
+            GetDecodedBoxMonData(&boxMon, MON_DATA_NICKNAME, sStorage->displayMonName);
             StringGetEnd10(sStorage->displayMonName);
-            sStorage->displayMonLevel = GetLevelFromBoxMonExp(boxMon);
-            sStorage->displayMonMarkings = GetBoxMonData(boxMon, MON_DATA_MARKINGS);
-            sStorage->displayMonPersonality = GetBoxMonData(boxMon, MON_DATA_PERSONALITY);
+            sStorage->displayMonLevel = GetLevelFromSpeciesAndExp(GetDecodedBoxMonData(&boxMon, MON_DATA_SPECIES, NULL), GetDecodedBoxMonData(&boxMon, MON_DATA_EXP, NULL));
+            sStorage->displayMonMarkings = GetDecodedBoxMonData(&boxMon, MON_DATA_MARKINGS, NULL);
+            sStorage->displayMonPersonality = GetDecodedBoxMonData(&boxMon, MON_DATA_PERSONALITY, NULL);
             sStorage->displayMonPalette = GetMonSpritePalFromSpeciesAndPersonality(sStorage->displayMonSpecies, otId, sStorage->displayMonPersonality);
             gender = GetGenderFromSpeciesAndPersonality(sStorage->displayMonSpecies, sStorage->displayMonPersonality);
-            sStorage->displayMonItemId = GetBoxMonData(boxMon, MON_DATA_HELD_ITEM);
+            sStorage->displayMonItemId = GetDecodedBoxMonData(&boxMon, MON_DATA_HELD_ITEM, NULL);
         }
     }
     else
@@ -7644,9 +7764,22 @@ static void AddBoxOptionsMenu(void)
     SetMenuText(MENU_JUMP);
     SetMenuText(MENU_WALLPAPER);
     SetMenuText(MENU_NAME);
+    SetMenuText(MENU_SORT);
     SetMenuText(MENU_CANCEL);
 }
 
+static void AddSortMenu(void)
+{
+    InitMenu();
+    SetMenuText(MENU_SORT_SPECIES);
+    SetMenuText(MENU_SORT_DEX_NUM);
+    SetMenuText(MENU_SORT_LEVEL);
+    SetMenuText(MENU_SORT_TYPE);
+    SetMenuText(MENU_SORT_ITEM);
+    SetMenuText(MENU_SORT_NATURE);
+    AddMenu();
+}
+
 static u8 SetSelectionMenuTexts(void)
 {
     InitMenu();
@@ -8010,6 +8143,13 @@ static const u8 *const sMenuTexts[] =
     [MENU_POKECENTER] = gPCText_Pokecenter,
     [MENU_MACHINE]    = gPCText_Machine,
     [MENU_SIMPLE]     = gPCText_Simple,
+    [MENU_SORT]       = gPCText_Sort,
+    [MENU_SORT_SPECIES] = gPCText_SortSpecies,
+    [MENU_SORT_DEX_NUM] = gPCText_SortDexNum,
+    [MENU_SORT_LEVEL]   = gPCText_SortLevel,
+    [MENU_SORT_TYPE]    = gPCText_SortType,
+    [MENU_SORT_ITEM]    = gPCText_SortItem,
+    [MENU_SORT_NATURE]  = gPCText_SortNature,
 };
 
 static void SetMenuText(u8 textId)
@@ -9423,6 +9563,310 @@ static void SpriteCB_ItemIcon_HideParty(struct Sprite *sprite)
 #undef sCursorPos
 
 
+//------------------------------------------------------------------------------
+//  SECTION: Storage index
+//
+//  Keeps the species, held item, egg flags and known HM moves of every PC slot
+//  so that searches over the whole PC don't have to decrypt every boxed
+//  Pokémon. Slots are re-indexed by the write functions below, and the whole
+//  index is rebuilt on first use after the save is loaded.
+//  Anything that writes to a box directly through GetBoxedMonPtr must call
+//  UpdateStorageIndexAt afterwards.
+//------------------------------------------------------------------------------
+
+
+#define SLOT_HAS_SPECIES  (1 << 0) // MON_DATA_SANITY_HAS_SPECIES
+#define SLOT_IS_EGG       (1 << 1) // MON_DATA_IS_EGG
+#define SLOT_SANITY_EGG   (1 << 2) // MON_DATA_SANITY_IS_EGG
+#define SLOT_BAD_EGG      (1 << 3) // MON_DATA_SANITY_IS_BAD_EGG
+
+struct StorageIndexSlot
+{
+    u16 species; // As returned by MON_DATA_SPECIES
+    u16 heldItem;
+    u8 flags;
+    u8 knownMoves; // One bit per entry of sIndexedMoves
+};
+
+struct StorageIndex
+{
+    bool8 isValid;
+    u8 monCount[TOTAL_BOXES_COUNT];
+    struct StorageIndexSlot slots[TOTAL_BOXES_COUNT][IN_BOX_COUNT];
+};
+
+EWRAM_DATA static struct StorageIndex sStorageIndex = {0};
+
+// Moves that can be checked without decrypting, i.e. the HMs
+static const u16 sIndexedMoves[] =
+{
+    MOVE_CUT, MOVE_FLY, MOVE_SURF, MOVE_STRENGTH,
+    MOVE_FLASH, MOVE_ROCK_SMASH, MOVE_WATERFALL, MOVE_DIVE,
+    MOVES_COUNT
+};
+
+static void IndexStorageSlot(u8 boxId, u8 boxPosition)
+{
+    struct DecodedBoxMon mon;
+    struct StorageIndexSlot *slot = &sStorageIndex.slots[boxId][boxPosition];
+
+    if (slot->species != SPECIES_NONE)
+        sStorageIndex.monCount[boxId]--;
+
+    DecodeBoxMon(&mon, &gPokemonStoragePtr->boxes[boxId][boxPosition]);
+    slot->species = GetDecodedBoxMonData(&mon, MON_DATA_SPECIES, NULL);
+    slot->heldItem = GetDecodedBoxMonData(&mon, MON_DATA_HELD_ITEM, NULL);
+    slot->knownMoves = GetDecodedBoxMonData(&mon, MON_DATA_KNOWN_MOVES, (u8 *)sIndexedMoves);
+    slot->flags = 0;
+    if (GetDecodedBoxMonData(&mon, MON_DATA_SANITY_HAS_SPECIES, NULL))
+        slot->flags |= SLOT_HAS_SPECIES;
+    if (GetDecodedBoxMonData(&mon, MON_DATA_IS_EGG, NULL))
+        slot->flags |= SLOT_IS_EGG;
+    if (GetDecodedBoxMonData(&mon, MON_DATA_SANITY_IS_EGG, NULL))
+        slot->flags |= SLOT_SANITY_EGG;
+    if (GetDecodedBoxMonData(&mon, MON_DATA_SANITY_IS_BAD_EGG, NULL))
+        slot->flags |= SLOT_BAD_EGG;
+
+    if (slot->species != SPECIES_NONE)
+        sStorageIndex.monCount[boxId]++;
+}
+
+static void RebuildStorageIndex(void)
+{
+    u32 boxId, boxPosition;
+
+    for (boxId = 0; boxId < TOTAL_BOXES_COUNT; boxId++)
+    {
+        sStorageIndex.monCount[boxId] = 0;
+        for (boxPosition = 0; boxPosition < IN_BOX_COUNT; boxPosition++)
+        {
+            sStorageIndex.slots[boxId][boxPosition].species = SPECIES_NONE;
+            IndexStorageSlot(boxId, boxPosition);
+        }
+    }
+    sStorageIndex.isValid = TRUE;
+}
+
+static const struct StorageIndexSlot *GetStorageIndexSlot(u8 boxId, u8 boxPosition)
+{
+    if (!sStorageIndex.isValid)
+        RebuildStorageIndex();
+
+    return &sStorageIndex.slots[boxId][boxPosition];
+}
+
+// Called when the storage is replaced wholesale, e.g. by loading the save
+void InvalidateStorageIndex(void)
+{
+    sStorageIndex.isValid = FALSE;
+}
+
+void UpdateStorageIndexAt(u8 boxId, u8 boxPosition)
+{
+    // An invalid index is rebuilt in full on next use
+    if (sStorageIndex.isValid && boxId < TOTAL_BOXES_COUNT && boxPosition < IN_BOX_COUNT)
+        IndexStorageSlot(boxId, boxPosition);
+}
+
+// Same as GetBoxMonData for the fields the index tracks, requests for other fields return 0
+static u32 GetIndexedBoxMonData(u8 boxId, u8 boxPosition, s32 request)
+{
+    const struct StorageIndexSlot *slot = GetStorageIndexSlot(boxId, boxPosition);
+
+    switch (request)
+    {
+    case MON_DATA_SPECIES:
+        return slot->species;
+    case MON_DATA_HELD_ITEM:
+        return slot->heldItem;
+    case MON_DATA_IS_EGG:
+        return (slot->flags & SLOT_IS_EGG) != 0;
+    case MON_DATA_SANITY_HAS_SPECIES:
+        return (slot->flags & SLOT_HAS_SPECIES) != 0;
+    case MON_DATA_SANITY_IS_EGG:
+        return (slot->flags & SLOT_SANITY_EGG) != 0;
+    case MON_DATA_SANITY_IS_BAD_EGG:
+        return (slot->flags & SLOT_BAD_EGG) != 0;
+    }
+
+    return 0;
+}
+
+// Same as MON_DATA_KNOWN_MOVES. Slots are only decrypted if a move isn't indexed.
+static u32 GetIndexedBoxMonKnownMoves(u8 boxId, u8 boxPosition, const u16 *moves)
+{
+    const struct StorageIndexSlot *slot = GetStorageIndexSlot(boxId, boxPosition);
+    u32 retVal = 0;
+    s32 i, j;
+
+    for (i = 0; moves[i] != MOVES_COUNT; i++)
+    {
+        for (j = 0; sIndexedMoves[j] != MOVES_COUNT; j++)
+        {
+            if (sIndexedMoves[j] == moves[i])
+                break;
+        }
+        if (sIndexedMoves[j] == MOVES_COUNT)
+            return GetBoxMonData(&gPokemonStoragePtr->boxes[boxId][boxPosition], MON_DATA_KNOWN_MOVES, (u8 *)moves);
+
+        if (slot->knownMoves & (1 << j))
+            retVal |= 1 << i;
+    }
+
+    return retVal;
+}
+
+static u8 GetIndexedBoxMonCount(u8 boxId)
+{
+    if (!sStorageIndex.isValid)
+        RebuildStorageIndex();
+
+    return sStorageIndex.monCount[boxId];
+}
+
+#undef SLOT_HAS_SPECIES
+#undef SLOT_IS_EGG
+#undef SLOT_SANITY_EGG
+#undef SLOT_BAD_EGG
+
+
+//------------------------------------------------------------------------------
+//  SECTION: Sort and search
+//
+//  Sorting builds one key per slot, decoding each Pokémon at most once, and
+//  sorts the keys so that ties keep their current order (see storage_sort.c).
+//  The boxes are then rearranged in place by following the cycles of the
+//  resulting permutation, so no copy of the boxes is needed. Searching
+//  matches on the same keys.
+//------------------------------------------------------------------------------
+
+
+EWRAM_DATA static struct BoxPokemon sSortTempMon = {0};
+EWRAM_DATA static struct StorageIndexSlot sSortTempSlot = {0};
+
+static u32 GetStorageMonValue(struct DecodedBoxMon *mon, u8 sortBy)
+{
+    u16 species = GetDecodedBoxMonData(mon, MON_DATA_SPECIES, NULL);
+
+    switch (sortBy)
+    {
+    case STORAGE_SORT_SPECIES:
+    default:
+        return species;
+    case STORAGE_SORT_DEX_NUM:
+        return SpeciesToNationalPokedexNum(species);
+    case STORAGE_SORT_LEVEL:
+        return GetLevelFromSpeciesAndExp(species, GetDecodedBoxMonData(mon, MON_DATA_EXP, NULL));
+    case STORAGE_SORT_TYPE:
+        return (gBaseStats[species].type1 << 8) | gBaseStats[species].type2;
+    case STORAGE_SORT_ITEM:
+        return GetDecodedBoxMonData(mon, MON_DATA_HELD_ITEM, NULL);
+    case STORAGE_SORT_NATURE:
+        return GetNatureFromPersonality(GetDecodedBoxMonData(mon, MON_DATA_PERSONALITY, NULL));
+    }
+}
+
+static u32 GetStorageSortKey(u16 slot, u8 sortBy)
+{
+    struct DecodedBoxMon mon;
+    u8 boxId = slot / IN_BOX_COUNT;
+    u8 boxPosition = slot % IN_BOX_COUNT;
+
+    if (GetIndexedBoxMonData(boxId, boxPosition, MON_DATA_SPECIES) == SPECIES_NONE)
+        return STORAGE_SORT_KEY_EMPTY;
+    if (GetIndexedBoxMonData(boxId, boxPosition, MON_DATA_IS_EGG))
+        return STORAGE_SORT_KEY_EGG;
+
+    DecodeBoxMon(&mon, &gPokemonStoragePtr->boxes[boxId][boxPosition]);
+    return GetStorageSortKeyFromValue(GetStorageMonValue(&mon, sortBy), sortBy);
+}
+
+// Moves a Pokémon along with its index entry, so nothing needs to be decrypted again
+static void MoveSortedStorageSlot(u16 dst, u16 src)
+{
+    struct BoxPokemon *boxMons = &gPokemonStoragePtr->boxes[0][0];
+    struct StorageIndexSlot *slots = &sStorageIndex.slots[0][0];
+
+    if (dst == STORAGE_SORT_TEMP_SLOT)
+    {
+        sSortTempMon = boxMons[src];
+        sSortTempSlot = slots[src];
+    }
+    else if (src == STORAGE_SORT_TEMP_SLOT)
+    {
+        boxMons[dst] = sSortTempMon;
+        slots[dst] = sSortTempSlot;
+    }
+    else
+    {
+        boxMons[dst] = boxMons[src];
+        slots[dst] = slots[src];
+    }
+}
+
+// Sorts the Pokémon in boxes firstBox to lastBox as one list. Returns FALSE
+// if there wasn't enough memory to sort.
+bool32 SortStorageBoxes(u8 firstBox, u8 lastBox, u8 sortBy)
+{
+    struct StorageSortEntry *entries;
+    u16 first, count, i, boxPosition;
+
+    if (firstBox > lastBox || lastBox >= TOTAL_BOXES_COUNT)
+        return FALSE;
+
+    first = firstBox * IN_BOX_COUNT;
+    count = (lastBox - firstBox + 1) * IN_BOX_COUNT;
+    entries = Alloc(count * sizeof(*entries));
+    if (entries == NULL)
+        return FALSE;
+
+    for (i = 0; i < count; i++)
+    {
+        entries[i].key = GetStorageSortKey(first + i, sortBy);
+        entries[i].slot = first + i;
+    }
+
+    SortStorageEntries(entries, count);
+    ApplyStorageSortOrder(entries, first, count, MoveSortedStorageSlot);
+    Free(entries);
+
+    for (i = firstBox; i <= lastBox; i++)
+    {
+        sStorageIndex.monCount[i] = 0;
+        for (boxPosition = 0; boxPosition < IN_BOX_COUNT; boxPosition++)
+        {
+            if (sStorageIndex.slots[i][boxPosition].species != SPECIES_NONE)
+                sStorageIndex.monCount[i]++;
+        }
+    }
+    return TRUE;
+}
+
+// Fills results with the slots (boxId * IN_BOX_COUNT + boxPosition) of the
+// Pokémon whose value for searchBy is value, and returns how many were found.
+// For STORAGE_SORT_TYPE either of the Pokémon's types may match. Eggs are skipped.
+// Returns 0 if there wasn't enough memory to search.
+u16 SearchStorageMons(u8 searchBy, u16 value, u16 *results, u16 maxResults)
+{
+    struct StorageSortEntry *entries;
+    u16 i, count = TOTAL_BOXES_COUNT * IN_BOX_COUNT;
+
+    entries = Alloc(count * sizeof(*entries));
+    if (entries == NULL)
+        return 0;
+
+    for (i = 0; i < count; i++)
+    {
+        entries[i].key = GetStorageSortKey(i, searchBy);
+        entries[i].slot = i;
+    }
+
+    count = SearchStorageEntries(entries, count, searchBy, value, results, maxResults);
+    Free(entries);
+    return count;
+}
+
+
 //------------------------------------------------------------------------------
 //  SECTION: General utility
 //------------------------------------------------------------------------------
@@ -9455,15 +9899,33 @@ static void SetCurrentBox(u8 boxId)
 u32 GetBoxMonDataAt(u8 boxId, u8 boxPosition, s32 request)
 {
     if (boxId < TOTAL_BOXES_COUNT && boxPosition < IN_BOX_COUNT)
-        return GetBoxMonData(&gPokemonStoragePtr->boxes[boxId][boxPosition], request);
+    {
+        switch (request)
+        {
+        case MON_DATA_SPECIES:
+        case MON_DATA_HELD_ITEM:
+        case MON_DATA_IS_EGG:
+        case MON_DATA_SANITY_HAS_SPECIES:
+        case MON_DATA_SANITY_IS_EGG:
+        case MON_DATA_SANITY_IS_BAD_EGG:
+            return GetIndexedBoxMonData(boxId, boxPosition, request);
+        default:
+            return GetBoxMonData(&gPokemonStoragePtr->boxes[boxId][boxPosition], request);
+        }
+    }
     else
+    {
         return 0;
+    }
 }
 
 void SetBoxMonDataAt(u8 boxId, u8 boxPosition, s32 request, const void *value)
 {
     if (boxId < TOTAL_BOXES_COUNT && boxPosition < IN_BOX_COUNT)
+    {
         SetBoxMonData(&gPokemonStoragePtr->boxes[boxId][boxPosition], request, value);
+        UpdateStorageIndexAt(boxId, boxPosition);
+    }
 }
 
 u32 GetCurrentBoxMonData(u8 boxPosition, s32 request)
@@ -9488,7 +9950,7 @@ u32 GetBoxMonLevelAt(u8 boxId, u8 boxPosition)
 {
     u32 lvl;
 
-    if (boxId < TOTAL_BOXES_COUNT && boxPosition < IN_BOX_COUNT && GetBoxMonData(&gPokemonStoragePtr->boxes[boxId][boxPosition], MON_DATA_SANITY_HAS_SPECIES))
+    if (boxId < TOTAL_BOXES_COUNT && boxPosition < IN_BOX_COUNT && GetIndexedBoxMonData(boxId, boxPosition, MON_DATA_SANITY_HAS_SPECIES))
         lvl = GetLevelFromBoxMonExp(&gPokemonStoragePtr->boxes[boxId][boxPosition]);
 #ifdef BUGFIX
     else
@@ -9507,15 +9969,25 @@ void SetBoxMonNickAt(u8 boxId, u8 boxPosition, const u8 *nick)
 u32 GetAndCopyBoxMonDataAt(u8 boxId, u8 boxPosition, s32 request, void *dst)
 {
     if (boxId < TOTAL_BOXES_COUNT && boxPosition < IN_BOX_COUNT)
-        return GetBoxMonData(&gPokemonStoragePtr->boxes[boxId][boxPosition], request, dst);
+    {
+        if (request == MON_DATA_KNOWN_MOVES)
+            return GetIndexedBoxMonKnownMoves(boxId, boxPosition, dst);
+        else
+            return GetBoxMonData(&gPokemonStoragePtr->boxes[boxId][boxPosition], request, dst);
+    }
     else
+    {
         return 0;
+    }
 }
 
 void SetBoxMonAt(u8 boxId, u8 boxPosition, struct BoxPokemon *src)
 {
     if (boxId < TOTAL_BOXES_COUNT && boxPosition < IN_BOX_COUNT)
+    {
         gPokemonStoragePtr->boxes[boxId][boxPosition] = *src;
+        UpdateStorageIndexAt(boxId, boxPosition);
+    }
 }
 
 void CopyBoxMonAt(u8 boxId, u8 boxPosition, struct BoxPokemon *dst)
@@ -9534,13 +10006,17 @@ void CreateBoxMonAt(u8 boxId, u8 boxPosition, u16 species, u8 level, u8 fixedIV,
                      fixedIV,
                      hasFixedPersonality, personality,
                      otIDType, otID);
+        UpdateStorageIndexAt(boxId, boxPosition);
     }
 }
 
 void ZeroBoxMonAt(u8 boxId, u8 boxPosition)
 {
     if (boxId < TOTAL_BOXES_COUNT && boxPosition < IN_BOX_COUNT)
+    {
         ZeroBoxMonData(&gPokemonStoragePtr->boxes[boxId][boxPosition]);
+        UpdateStorageIndexAt(boxId, boxPosition);
+    }
 }
 
 void BoxMonAtToMon(u8 boxId, u8 boxPosition, struct Pokemon *dst)
@@ -9613,11 +10089,14 @@ bool8 CheckFreePokemonStorageSpace(void)
 {
     s32 i, j;
 
+    if (!CanStorageHoldAnotherMon())
+        return FALSE;
+
     for (i = 0; i < TOTAL_BOXES_COUNT; i++)
     {
         for (j = 0; j < IN_BOX_COUNT; j++)
         {
-            if (!GetBoxMonData(&gPokemonStoragePtr->boxes[i][j], MON_DATA_SANITY_HAS_SPECIES))
+            if (!GetIndexedBoxMonData(i, j, MON_DATA_SANITY_HAS_SPECIES))
                 return TRUE;
         }
     }
@@ -9629,9 +10108,9 @@ bool32 CheckBoxMonSanityAt(u32 boxId, u32 boxPosition)
 {
     if (boxId < TOTAL_BOXES_COUNT
         && boxPosition < IN_BOX_COUNT
-        && GetBoxMonData(&gPokemonStoragePtr->boxes[boxId][boxPosition], MON_DATA_SANITY_HAS_SPECIES)
-        && !GetBoxMonData(&gPokemonStoragePtr->boxes[boxId][boxPosition], MON_DATA_SANITY_IS_EGG)
-        && !GetBoxMonData(&gPokemonStoragePtr->boxes[boxId][boxPosition], MON_DATA_SANITY_IS_BAD_EGG))
+        && GetIndexedBoxMonData(boxId, boxPosition, MON_DATA_SANITY_HAS_SPECIES)
+        && !GetIndexedBoxMonData(boxId, boxPosition, MON_DATA_SANITY_IS_EGG)
+        && !GetIndexedBoxMonData(boxId, boxPosition, MON_DATA_SANITY_IS_BAD_EGG))
         return TRUE;
     else
         return FALSE;
@@ -9646,8 +10125,8 @@ u32 CountStorageNonEggMons(void)
     {
         for (j = 0; j < IN_BOX_COUNT; j++)
         {
-            if (GetBoxMonData(&gPokemonStoragePtr->boxes[i][j], MON_DATA_SANITY_HAS_SPECIES)
-                && !GetBoxMonData(&gPokemonStoragePtr->boxes[i][j], MON_DATA_SANITY_IS_EGG))
+            if (GetIndexedBoxMonData(i, j, MON_DATA_SANITY_HAS_SPECIES)
+                && !GetIndexedBoxMonData(i, j, MON_DATA_SANITY_IS_EGG))
                 count++;
         }
     }
@@ -9664,8 +10143,8 @@ u32 CountAllStorageMons(void)
     {
         for (j = 0; j < IN_BOX_COUNT; j++)
         {
-            if (GetBoxMonData(&gPokemonStoragePtr->boxes[i][j], MON_DATA_SANITY_HAS_SPECIES)
-                || GetBoxMonData(&gPokemonStoragePtr->boxes[i][j], MON_DATA_SANITY_IS_EGG))
+            if (GetIndexedBoxMonData(i, j, MON_DATA_SANITY_HAS_SPECIES)
+                || GetIndexedBoxMonData(i, j, MON_DATA_SANITY_IS_EGG))
                 count++;
         }
     }
@@ -9682,9 +10161,9 @@ bool32 AnyStorageMonWithMove(u16 moveId)
     {
         for (j = 0; j < IN_BOX_COUNT; j++)
         {
-            if (GetBoxMonData(&gPokemonStoragePtr->boxes[i][j], MON_DATA_SANITY_HAS_SPECIES)
-                && !GetBoxMonData(&gPokemonStoragePtr->boxes[i][j], MON_DATA_SANITY_IS_EGG)
-                && GetBoxMonData(&gPokemonStoragePtr->boxes[i][j], MON_DATA_KNOWN_MOVES, (u8*)moves))
+            if (GetIndexedBoxMonData(i, j, MON_DATA_SANITY_HAS_SPECIES)
+                && !GetIndexedBoxMonData(i, j, MON_DATA_SANITY_IS_EGG)
+                && GetIndexedBoxMonKnownMoves(i, j, moves))
                 return TRUE;
         }
     }
@@ -0,0 +1,45 @@
+#include "global.h"
+#include "profile.h"
+
+// Cycle counter for the debug profilers. Timer 1 counts cycles and overflows into timer 2,
+// the only pair of cascadable timers left: timer 0 drives the sound mixer and timer 3 the link.
+// Timer 1 is also run from the naming screen until the trainer id is seeded from it
+// (see StartTimer1), so while it is running nothing is measured and 0 is returned instead.
+// Timer 2 is shared with the flash timeout (see SetFlashTimerIntr in main.c), which runs it
+// while a save writes or erases a sector. Nothing is measured while a save holds timer 2,
+// and a measurement the save took timer 2 over from returns 0 without touching it again,
+// so a profiled section never cancels a flash timeout.
+// Interrupts raised while the timer runs are counted too.
+
+#define PROFILE_TIMER2_CNT (TIMER_ENABLE | TIMER_COUNTUP)
+
+static bool8 sProfileTimerRunning;
+
+void StartProfileTimer(void)
+{
+    if ((REG_TM1CNT_H & TIMER_ENABLE) || (REG_TM2CNT_H & TIMER_ENABLE))
+    {
+        sProfileTimerRunning = FALSE;
+        return;
+    }
+
+    REG_TM1CNT_L = 0;
+    REG_TM2CNT_L = 0;
+    REG_TM2CNT_H = PROFILE_TIMER2_CNT;
+    REG_TM1CNT_H = TIMER_ENABLE | TIMER_1CLK;
+    sProfileTimerRunning = TRUE;
+}
+
+u32 StopProfileTimer(void)
+{
+    if (!sProfileTimerRunning)
+        return 0;
+
+    REG_TM1CNT_H = 0;
+    sProfileTimerRunning = FALSE;
+    if (REG_TM2CNT_H != PROFILE_TIMER2_CNT)
+        return 0;
+
+    REG_TM2CNT_H = 0;
+    return REG_TM1CNT_L | (REG_TM2CNT_L << 16);
+}
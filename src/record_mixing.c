@@ -1,6 +1,8 @@
 #include "global.h"
 #include "malloc.h"
 #include "random.h"
+#include "compress.h"
+#include "decompress.h"
 #include "constants/items.h"
 #include "text.h"
 #include "item.h"
@@ -93,12 +95,16 @@ static LilycoveLady *sLilycoveLadySave;
 static void *sApprenticesSave;
 static void *sBattleTowerSave_Duplicate;
 static u32 sRecordStructSize;
+static u32 sRecordPacketSize;
+static u32 sRecordChunkCount;
+static bool8 sRecordsPacked;
 static u8 gUnknown_03001160;
 static struct PlayerHallRecords *gUnknown_03001168[3];
 
 static EWRAM_DATA struct RecordMixingDaycareMail sDaycareMail = {0};
 static EWRAM_DATA union PlayerRecords *sReceivedRecords = NULL;
 static EWRAM_DATA union PlayerRecords *sSentRecord = NULL;
+static EWRAM_DATA u8 *sRecordPackets = NULL;
 
 // Static ROM declarations
 
@@ -111,6 +117,9 @@ static void *LoadPtrFromTaskData(const u16 *asShort);
 static void StorePtrInTaskData(void *records, u16 *a1);
 static u8 GetMultiplayerId_(void);
 static void *GetPlayerRecvBuffer(u8);
+static void PackSentRecord(void);
+static void UpdatePackedRecordChunkCount(void);
+static void UnpackReceivedRecords(void);
 static void ReceiveOldManData(OldMan *, size_t, u8);
 static void ReceiveBattleTowerData(void *battleTowerRecord, size_t, u8);
 static void ReceiveLilycoveLadyData(LilycoveLady *, size_t, u8);
@@ -363,6 +372,7 @@ static void Task_RecordMixing_Main(u8 taskId)
         {
             free(sReceivedRecords);
             free(sSentRecord);
+            TRY_FREE_AND_SET_NULL(sRecordPackets);
             SetLinkWaitingForScript();
             if (gWirelessCommType != 0)
             {
@@ -452,22 +462,27 @@ static void Task_MixingRecordsRecv(u8 taskId)
             task->data[5] = GetMultiplayerId_();
             task->func = Task_SendPacket;
             if (Link_AnyPartnersPlayingRubyOrSapphire())
-            {
-                StorePtrInTaskData(sSentRecord, (u16 *)&task->data[2]);
-                subTaskId = CreateTask(Task_CopyReceiveBuffer, 80);
-                task->data[10] = subTaskId;
-                gTasks[subTaskId].data[0] = taskId;
-                StorePtrInTaskData(sReceivedRecords, (u16 *)&gTasks[subTaskId].data[5]);
                 sRecordStructSize = sizeof(struct PlayerRecordsRS);
+            else
+                sRecordStructSize = sizeof(struct PlayerRecordsEmerald);
+
+            sRecordsPacked = !Link_AnyPartnersPlayingRubyOrSapphire()
+                          && Link_AllPlayersHaveFeatures(LINK_FEATURE_PACKED_RECORDS);
+            subTaskId = CreateTask(Task_CopyReceiveBuffer, 80);
+            task->data[10] = subTaskId;
+            gTasks[subTaskId].data[0] = taskId;
+            if (sRecordsPacked)
+            {
+                PackSentRecord();
+                StorePtrInTaskData(sRecordPackets, (u16 *)&task->data[2]);
+                StorePtrInTaskData(sRecordPackets + sRecordPacketSize, (u16 *)&gTasks[subTaskId].data[5]);
             }
             else
             {
+                sRecordPacketSize = sRecordStructSize;
+                sRecordChunkCount = sRecordStructSize / BUFFER_CHUNK_SIZE + 1;
                 StorePtrInTaskData(sSentRecord, (u16 *)&task->data[2]);
-                subTaskId = CreateTask(Task_CopyReceiveBuffer, 80);
-                task->data[10] = subTaskId;
-                gTasks[subTaskId].data[0] = taskId;
                 StorePtrInTaskData(sReceivedRecords, (u16 *)&gTasks[subTaskId].data[5]);
-                sRecordStructSize = sizeof(struct PlayerRecordsEmerald);
             }
             // Note: This task is destroyed by Task_CopyReceiveBuffer when it's done.
         }
@@ -506,7 +521,7 @@ static void Task_SendPacket(u8 taskId)
         break;
     case 3:
         task->data[4]++;
-        if (task->data[4] == sRecordStructSize / 200 + 1)
+        if (task->data[4] == sRecordChunkCount)
             task->data[0]++;
         else
             task->data[0] = 0;
@@ -535,18 +550,35 @@ static void Task_CopyReceiveBuffer(u8 taskId)
 
             if ((status >> i) & 1)
             {
-                dest = LoadPtrFromTaskData((u16 *)&task->data[5]) + task->data[i + 1] * BUFFER_CHUNK_SIZE + sRecordStructSize * i;
+                dest = LoadPtrFromTaskData((u16 *)&task->data[5]) + task->data[i + 1] * BUFFER_CHUNK_SIZE + sRecordPacketSize * i;
                 src = GetPlayerRecvBuffer(i);
-                if ((task->data[i + 1] + 1) * BUFFER_CHUNK_SIZE > sRecordStructSize)
-                    memcpy(dest, src, sRecordStructSize - task->data[i + 1] * BUFFER_CHUNK_SIZE);
+                if ((task->data[i + 1] + 1) * BUFFER_CHUNK_SIZE > sRecordPacketSize)
+                    memcpy(dest, src, sRecordPacketSize - task->data[i + 1] * BUFFER_CHUNK_SIZE);
                 else
                     memcpy(dest, src, BUFFER_CHUNK_SIZE);
                 ResetBlockReceivedFlag(i);
                 task->data[i + 1]++;
-                if (task->data[i + 1] == sRecordStructSize / BUFFER_CHUNK_SIZE + 1)
-                    handledPlayers++;
             }
         }
+
+        // Everyone's first chunk says how long their packet is, so the chunk
+        // count is known once every player's has arrived.
+        if (sRecordsPacked)
+        {
+            for (i = 0; i < GetLinkPlayerCount(); i++)
+            {
+                if (task->data[i + 1] == 0)
+                    break;
+            }
+            if (i == GetLinkPlayerCount())
+                UpdatePackedRecordChunkCount();
+        }
+
+        for (i = 0; i < GetLinkPlayerCount(); i++)
+        {
+            if (task->data[i + 1] >= sRecordChunkCount)
+                handledPlayers++;
+        }
         gTasks[task->data[0]].data[0]++;
     }
 
@@ -573,6 +605,8 @@ static void Task_ReceivePacket(u8 taskId)
 
 static void Task_SendPacket_SwitchToReceive(u8 taskId)
 {
+    if (sRecordsPacked)
+        UnpackReceivedRecords();
     gTasks[taskId].func = Task_ReceivePacket;
     gUnknown_03001130 = TRUE;
 }
@@ -598,6 +632,72 @@ static void *GetPlayerRecvBuffer(u8 id)
     return gBlockRecvBuffer[id];
 }
 
+// When every player supports LINK_FEATURE_PACKED_RECORDS, each record is sent
+// as a packet of a u32 holding the size of the LZ compressed record that
+// follows, or 0 if the record follows as is because it didn't compress. The
+// packets are exchanged BUFFER_CHUNK_SIZE bytes at a time like the records
+// are, for as many chunks as the longest packet needs. Most of a record is
+// empty secret bases and TV shows, so this takes a fraction of the chunks.
+// sRecordPackets holds the sent packet, then one for each player.
+static void PackSentRecord(void)
+{
+    u32 size;
+
+    sRecordPacketSize = sizeof(u32) + sRecordStructSize;
+    sRecordPacketSize += BUFFER_CHUNK_SIZE - 1;
+    sRecordPacketSize -= sRecordPacketSize % BUFFER_CHUNK_SIZE;
+    sRecordPackets = AllocZeroed(sRecordPacketSize * (MAX_LINK_PLAYERS + 1));
+
+    size = LZCompress(sSentRecord, sRecordStructSize, sRecordPackets + sizeof(u32), sRecordStructSize);
+    *(u32 *)sRecordPackets = size;
+    if (size == 0)
+        memcpy(sRecordPackets + sizeof(u32), sSentRecord, sRecordStructSize);
+
+    // Updated once the first chunks are in.
+    sRecordChunkCount = 1;
+}
+
+static void UpdatePackedRecordChunkCount(void)
+{
+    u32 i;
+    u32 size;
+    u32 chunks;
+
+    for (i = 0; i < GetLinkPlayerCount(); i++)
+    {
+        size = *(u32 *)(sRecordPackets + sRecordPacketSize * (i + 1));
+        if (size == 0 || size > sRecordStructSize)
+            size = sRecordStructSize;
+        chunks = (sizeof(u32) + size + BUFFER_CHUNK_SIZE - 1) / BUFFER_CHUNK_SIZE;
+        if (sRecordChunkCount < chunks)
+            sRecordChunkCount = chunks;
+    }
+}
+
+static void UnpackReceivedRecords(void)
+{
+    u32 i;
+    u32 size;
+    u32 *packet;
+    void *dest;
+
+    for (i = 0; i < GetLinkPlayerCount(); i++)
+    {
+        packet = (u32 *)(sRecordPackets + sRecordPacketSize * (i + 1));
+        dest = (u8 *)sReceivedRecords + sRecordStructSize * i;
+        size = packet[0];
+        if (size == 0)
+            memcpy(dest, &packet[1], sRecordStructSize);
+        // The BIOS trusts the header, so only let it write a whole record.
+        else if (size <= sRecordStructSize
+              && (packet[1] & 0xFF) == 0x10
+              && GetDecompressedDataSize(&packet[1]) == sRecordStructSize)
+            LZDecompressWram(&packet[1], dest);
+        else
+            memset(dest, 0, sRecordStructSize);
+    }
+}
+
 static void ShufflePlayerIndices(u32 *data)
 {
     u32 i;
@@ -1,6 +1,9 @@
 #include "global.h"
 #include "battle.h"
 #include "battle_anim.h"
+#include "battle_controllers.h"
+#include "battle_snapshot.h"
+#include "battle_util.h"
 #include "recorded_battle.h"
 #include "main.h"
 #include "pokemon.h"
@@ -16,10 +19,15 @@
 #include "text.h"
 #include "battle_setup.h"
 #include "frontier_util.h"
+#include "constants/battle_ai.h"
+#include "constants/moves.h"
+#include "constants/opponents.h"
 #include "constants/trainers.h"
 #include "constants/rgb.h"
 
 #define BATTLER_RECORD_SIZE 664
+#define CHECKED_TURNS_COUNT 256
+#define SLOWEST_TURNS_COUNT 4
 #define ILLEGAL_BATTLE_TYPES ((BATTLE_TYPE_LINK | BATTLE_TYPE_SAFARI | BATTLE_TYPE_FIRST_BATTLE                  \
                               | BATTLE_TYPE_WALLY_TUTORIAL | BATTLE_TYPE_ROAMER | BATTLE_TYPE_EREADER_TRAINER    \
                               | BATTLE_TYPE_KYOGRE_GROUDON | BATTLE_TYPE_LEGENDARY | BATTLE_TYPE_REGI            \
@@ -103,10 +111,66 @@ EWRAM_DATA static u8 sBattleOutcome = 0;
 static u8 sRecordMixFriendLanguage;
 static u8 sApprenticeLanguage;
 
+#if B_CHECK_RECORDED_BATTLES
+// Kept in RAM only, so a battle can be checked by watching it right after it was recorded.
+struct TurnChecks
+{
+    u32 rngSeed;
+    u32 stateHashes[CHECKED_TURNS_COUNT];
+    u16 turnFrames[CHECKED_TURNS_COUNT];
+    u16 recordedTurns;
+    u16 playedTurns;
+    u16 mismatches;
+    u16 firstMismatchTurn;
+    u16 playbackRuns;
+    u32 lastTurnFrame;
+};
+
+EWRAM_DATA static struct TurnChecks sTurnChecks = {0};
+
+#if B_FUZZ_RECORDED_BATTLES
+#define FUZZ_PARTY_SIZE 3
+#define FUZZ_LEVEL 50
+
+// Battles between random parties, each played twice. The first run makes the
+// player's choices as they are asked for and writes them into the record, the
+// second plays that record back against the turn hashes of the first.
+struct FuzzRuns
+{
+    u32 battleSeed;
+    u32 rngValue;
+    u32 savedMoney;
+    u32 slowestBattleSeed;
+    u16 battle;
+    u16 desyncs;
+    u16 slowestTurn;
+    u16 slowestFrames;
+    bool8 choosing;
+};
+
+EWRAM_DATA static struct FuzzRuns sFuzzRuns = {0};
+#endif
+#endif
+
 static u8 GetNextRecordedDataByte(u8 *, u8 *, u8 *);
 static bool32 CopyRecordedBattleFromSave(struct RecordedBattleSave *);
 static void RecordedBattle_RestoreSavedParties(void);
 static void CB2_RecordedBattle(void);
+#if B_CHECK_RECORDED_BATTLES && B_FUZZ_RECORDED_BATTLES
+static bool32 ContinueFuzzedBattles(void);
+#endif
+
+#if B_CHECK_RECORDED_BATTLES
+// Whether this run makes the turn hashes a later playback is checked against
+static bool32 IsRecordingTurnChecks(void)
+{
+#if B_FUZZ_RECORDED_BATTLES
+    if (sFuzzRuns.choosing)
+        return TRUE;
+#endif
+    return sRecordMode == B_RECORD_MODE_RECORDING;
+}
+#endif
 
 void RecordedBattle_Init(u8 mode)
 {
@@ -115,6 +179,14 @@ void RecordedBattle_Init(u8 mode)
     sRecordMode = mode;
     sUnknown_0203CCD0 = FALSE;
 
+#if B_CHECK_RECORDED_BATTLES
+    if (IsRecordingTurnChecks())
+        sTurnChecks.recordedTurns = 0;
+    sTurnChecks.playedTurns = 0;
+    sTurnChecks.mismatches = 0;
+    sTurnChecks.lastTurnFrame = gMain.vblankCounter1;
+#endif
+
     for (i = 0; i < MAX_BATTLERS_COUNT; i++)
     {
         sBattlerRecordSizes[i] = 0;
@@ -213,8 +285,64 @@ void RecordedBattle_ClearBattlerAction(u8 battlerId, u8 bytesToClear)
     }
 }
 
+#if B_CHECK_RECORDED_BATTLES && B_FUZZ_RECORDED_BATTLES
+static u16 FuzzRandom(u32 *rngValue)
+{
+    *rngValue = ISO_RANDOMIZE1(*rngValue);
+    return *rngValue >> 16;
+}
+
+// Writes whatever the battle asks the player's battler for where it is about to be read.
+// Only moves are chosen, switches happen when a mon faints or a move asks for one.
+static void FuzzBattlerChoice(u8 battlerId)
+{
+    u8 *record = &sBattleRecords[battlerId][sBattlerRecordSizes[battlerId]];
+    u32 i, slot, unusable;
+    u8 potentialItemEffectBattler;
+
+    // Left empty near the end of the record, so the battle ends there
+    if (record[0] != 0xFF || sBattlerRecordSizes[battlerId] + 2 >= BATTLER_RECORD_SIZE)
+        return;
+
+    switch (gBattleResources->bufferA[battlerId][0])
+    {
+    case CONTROLLER_CHOOSEACTION:
+        record[0] = B_ACTION_USE_MOVE;
+        break;
+    case CONTROLLER_CHOOSEMOVE:
+        // Checking the moves mustn't change anything the second run could see
+        potentialItemEffectBattler = gPotentialItemEffectBattler;
+        unusable = CheckMoveLimitations(battlerId, 0, 0xFF);
+        gPotentialItemEffectBattler = potentialItemEffectBattler;
+        slot = FuzzRandom(&sFuzzRuns.rngValue) % MAX_MON_MOVES;
+        for (i = 0; i < MAX_MON_MOVES && (unusable & gBitTable[slot]); i++)
+            slot = (slot + 1) % MAX_MON_MOVES;
+        record[0] = slot;
+        record[1] = GetBattlerAtPosition(B_POSITION_OPPONENT_LEFT);
+        break;
+    case CONTROLLER_CHOOSEPOKEMON:
+        slot = FuzzRandom(&sFuzzRuns.rngValue) % PARTY_SIZE;
+        for (i = 0; i < PARTY_SIZE; i++, slot = (slot + 1) % PARTY_SIZE)
+        {
+            if (slot != gBattlerPartyIndexes[battlerId]
+             && GetMonData(&gPlayerParty[slot], MON_DATA_SPECIES2) != SPECIES_NONE
+             && GetMonData(&gPlayerParty[slot], MON_DATA_SPECIES2) != SPECIES_EGG
+             && GetMonData(&gPlayerParty[slot], MON_DATA_HP) != 0)
+                break;
+        }
+        record[0] = slot;
+        break;
+    }
+}
+#endif
+
 u8 RecordedBattle_GetBattlerAction(u8 battlerId)
 {
+#if B_CHECK_RECORDED_BATTLES && B_FUZZ_RECORDED_BATTLES
+    if (sFuzzRuns.choosing && sBattlerRecordSizes[battlerId] < BATTLER_RECORD_SIZE)
+        FuzzBattlerChoice(battlerId);
+#endif
+
     // Trying to read past array or invalid action byte, battle is over.
     if (sBattlerRecordSizes[battlerId] >= BATTLER_RECORD_SIZE || sBattleRecords[battlerId][sBattlerRecordSizes[battlerId]] == 0xFF)
     {
@@ -525,6 +653,19 @@ static void CB2_RecordedBattleEnd(void)
     gPartnerTrainerId = 0;
 
     RecordedBattle_RestoreSavedParties();
+#if B_CHECK_RECORDED_BATTLES
+#if B_FUZZ_RECORDED_BATTLES
+    if (ContinueFuzzedBattles())
+        return;
+#else
+    if (++sTurnChecks.playbackRuns < B_CHECK_RECORDED_BATTLE_RUNS)
+    {
+        PlayRecordedBattle(sCallback2_AfterRecordedBattle);
+        return;
+    }
+    sTurnChecks.playbackRuns = 0;
+#endif
+#endif
     SetMainCallback2(sCallback2_AfterRecordedBattle);
 }
 
@@ -610,24 +751,159 @@ static void SetVariablesForRecordedBattle(struct RecordedBattleSave *src)
     }
 }
 
-void PlayRecordedBattle(void (*CB2_After)(void))
+static void StartRecordedBattle(struct RecordedBattleSave *battleSave)
+{
+    u8 taskId;
+
+    RecordedBattle_SaveParties();
+    SetVariablesForRecordedBattle(battleSave);
+
+    taskId = CreateTask(Task_StartAfterCountdown, 1);
+    gTasks[taskId].tFramesToWait = 128;
+
+    PlayMapChosenOrBattleBGM(FALSE);
+    SetMainCallback2(CB2_RecordedBattle);
+}
+
+#if B_CHECK_RECORDED_BATTLES && B_FUZZ_RECORDED_BATTLES
+static void CreateFuzzedMon(struct Pokemon *mon, u32 *rngValue)
+{
+    u32 i, j, iv, personality;
+    u16 species, moves[MAX_MON_MOVES];
+
+    do
+        species = 1 + FuzzRandom(rngValue) % FORMS_START;
+    while (gBaseStats[species].baseHP == 0);
+    iv = FuzzRandom(rngValue) % (MAX_PER_STAT_IVS + 1);
+    personality = FuzzRandom(rngValue);
+    personality |= FuzzRandom(rngValue) << 16;
+    CreateMon(mon, species, FUZZ_LEVEL, iv, TRUE, personality, OT_ID_PRESET, 0);
+
+    for (i = 0; i < MAX_MON_MOVES; i++)
+    {
+        do
+        {
+            moves[i] = 1 + FuzzRandom(rngValue) % (MOVES_COUNT - 1);
+            for (j = 0; j < i && moves[j] != moves[i]; j++)
+                ;
+        } while (moves[i] == MOVE_STRUGGLE || j != i);
+        SetMonMoveSlot(mon, moves[i], i);
+    }
+}
+
+// Everything comes from the battle's seed, so both runs start the same battle
+static void CreateFuzzedBattle(struct RecordedBattleSave *battleSave)
+{
+    u32 i, rngValue = sFuzzRuns.battleSeed;
+
+    for (i = 0; i < FUZZ_PARTY_SIZE; i++)
+    {
+        CreateFuzzedMon(&battleSave->playerParty[i], &rngValue);
+        CreateFuzzedMon(&battleSave->opponentParty[i], &rngValue);
+    }
+
+    StringCopy(battleSave->playersName[0], gSaveBlock2Ptr->playerName);
+    battleSave->playersGender[0] = gSaveBlock2Ptr->playerGender;
+    battleSave->playersLanguage[0] = gGameLanguage;
+    battleSave->rngSeed = FuzzRandom(&rngValue);
+    battleSave->rngSeed |= FuzzRandom(&rngValue) << 16;
+    battleSave->battleFlags = BATTLE_TYPE_TRAINER;
+    battleSave->opponentA = TRAINER_CALVIN_1;
+    battleSave->lvlMode = gSaveBlock2Ptr->frontier.lvlMode;
+    battleSave->battleScene = gSaveBlock2Ptr->optionsBattleSceneOff;
+    battleSave->textSpeed = OPTIONS_TEXT_SPEED_FAST;
+    battleSave->AI_scripts = AI_FLAG_CHECK_BAD_MOVE | AI_FLAG_TRY_TO_FAINT | AI_FLAG_CHECK_VIABILITY;
+    memset(battleSave->battleRecord, 0xFF, sizeof(battleSave->battleRecord));
+}
+
+static void PlayFuzzedBattle(void)
 {
     struct RecordedBattleSave *battleSave = AllocZeroed(sizeof(struct RecordedBattleSave));
-    if (CopyRecordedBattleFromSave(battleSave) == TRUE)
+
+    CreateFuzzedBattle(battleSave);
+    if (sFuzzRuns.choosing)
+        sFuzzRuns.rngValue = ~sFuzzRuns.battleSeed;
+    else
+        memcpy(battleSave->battleRecord, sBattleRecords, sizeof(sBattleRecords));
+    sTurnChecks.playbackRuns = !sFuzzRuns.choosing;
+    StartRecordedBattle(battleSave);
+    Free(battleSave);
+}
+
+static void StartFuzzedBattles(void)
+{
+    sFuzzRuns.battleSeed = B_FUZZ_RECORDED_BATTLES_SEED;
+    if (sFuzzRuns.battleSeed == 0)
+        sFuzzRuns.battleSeed = gMain.vblankCounter1;
+    sFuzzRuns.savedMoney = gSaveBlock1Ptr->money;
+    sFuzzRuns.battle = 0;
+    sFuzzRuns.desyncs = 0;
+    sFuzzRuns.slowestFrames = 0;
+    sFuzzRuns.choosing = TRUE;
+    AGBPrintf("fuzzing %u recorded battles from seed %x\n", B_FUZZ_RECORDED_BATTLES, sFuzzRuns.battleSeed);
+    PlayFuzzedBattle();
+}
+
+// Called after every run, returns FALSE once each battle was played twice
+static bool32 ContinueFuzzedBattles(void)
+{
+    struct TurnChecks *checks = &sTurnChecks;
+    u32 i, turns = min(checks->playedTurns, CHECKED_TURNS_COUNT);
+
+    for (i = 0; i < turns; i++)
     {
-        u8 taskId;
+        if (checks->turnFrames[i] > sFuzzRuns.slowestFrames)
+        {
+            sFuzzRuns.slowestFrames = checks->turnFrames[i];
+            sFuzzRuns.slowestTurn = i;
+            sFuzzRuns.slowestBattleSeed = sFuzzRuns.battleSeed;
+        }
+    }
 
-        RecordedBattle_SaveParties();
-        SetVariablesForRecordedBattle(battleSave);
+    if (sFuzzRuns.choosing)
+    {
+        sFuzzRuns.choosing = FALSE;
+        PlayFuzzedBattle();
+        return TRUE;
+    }
+
+    if (checks->mismatches != 0 || turns != checks->recordedTurns)
+    {
+        sFuzzRuns.desyncs++;
+        AGBPrintf("DESYNC: fuzzed battle %u, seed %x\n", sFuzzRuns.battle, sFuzzRuns.battleSeed);
+    }
+    if (++sFuzzRuns.battle < B_FUZZ_RECORDED_BATTLES)
+    {
+        sFuzzRuns.battleSeed = ISO_RANDOMIZE2(sFuzzRuns.battleSeed);
+        sFuzzRuns.choosing = TRUE;
+        PlayFuzzedBattle();
+        return TRUE;
+    }
 
-        taskId = CreateTask(Task_StartAfterCountdown, 1);
-        gTasks[taskId].tFramesToWait = 128;
+    // Trainer battles pay out, the parties were restored already
+    gSaveBlock1Ptr->money = sFuzzRuns.savedMoney;
+    sTurnChecks.playbackRuns = 0;
+    AGBPrintf("fuzzed %u battles, %u desynced, slowest turn %u of seed %x: %u frames\n", sFuzzRuns.battle,
+              sFuzzRuns.desyncs, sFuzzRuns.slowestTurn, sFuzzRuns.slowestBattleSeed, sFuzzRuns.slowestFrames);
+    AGBPrintFlush();
+    return FALSE;
+}
+#endif
 
+void PlayRecordedBattle(void (*CB2_After)(void))
+{
+#if B_CHECK_RECORDED_BATTLES && B_FUZZ_RECORDED_BATTLES
+    sCallback2_AfterRecordedBattle = CB2_After;
+    StartFuzzedBattles();
+#else
+    struct RecordedBattleSave *battleSave = AllocZeroed(sizeof(struct RecordedBattleSave));
+    if (CopyRecordedBattleFromSave(battleSave) == TRUE)
+    {
         sCallback2_AfterRecordedBattle = CB2_After;
-        PlayMapChosenOrBattleBGM(FALSE);
-        SetMainCallback2(CB2_RecordedBattle);
+        StartRecordedBattle(battleSave);
     }
     Free(battleSave);
+#endif
 }
 
 #undef tFramesToWait
@@ -890,3 +1166,79 @@ u16 *GetRecordedBattleEasyChatSpeech(void)
 {
     return sEasyChatSpeech;
 }
+
+// Called at the end of every turn. When recording, stores a hash of the battle state;
+// when playing back the same battle, checks it still matches.
+// The RNG state is left out, menus and animations which only run while recording may call Random().
+void RecordedBattle_CheckTurn(void)
+{
+#if B_CHECK_RECORDED_BATTLES
+    struct TurnChecks *checks = &sTurnChecks;
+    u32 hash = CalcBattleStateHash(SNAPSHOT_REPLAYED_REGIONS);
+    u32 turn = checks->playedTurns++;
+
+    if (turn >= CHECKED_TURNS_COUNT)
+        return;
+
+    checks->turnFrames[turn] = gMain.vblankCounter1 - checks->lastTurnFrame;
+    checks->lastTurnFrame = gMain.vblankCounter1;
+
+    if (IsRecordingTurnChecks())
+    {
+        checks->rngSeed = gRecordedBattleRngSeed;
+        checks->stateHashes[turn] = hash;
+        checks->recordedTurns = turn + 1;
+    }
+    else if (sRecordMode == B_RECORD_MODE_PLAYBACK
+             && checks->rngSeed == gRecordedBattleRngSeed
+             && turn < checks->recordedTurns
+             && checks->stateHashes[turn] != hash)
+    {
+        if (checks->mismatches++ == 0)
+            checks->firstMismatchTurn = turn;
+    }
+#endif
+}
+
+void RecordedBattle_PrintTurnChecks(void)
+{
+#if B_CHECK_RECORDED_BATTLES
+    struct TurnChecks *checks = &sTurnChecks;
+    u16 slowest[SLOWEST_TURNS_COUNT];
+    u32 i, j, turns, slowestCount = 0, frames = 0;
+
+    turns = min(checks->playedTurns, CHECKED_TURNS_COUNT);
+    for (i = 0; i < turns; i++)
+    {
+        frames += checks->turnFrames[i];
+        for (j = 0; j < slowestCount; j++)
+        {
+            if (checks->turnFrames[i] > checks->turnFrames[slowest[j]])
+                break;
+        }
+        if (j < SLOWEST_TURNS_COUNT)
+        {
+            memmove(&slowest[j + 1], &slowest[j], (min(slowestCount, SLOWEST_TURNS_COUNT - 1) - j) * sizeof(slowest[0]));
+            slowest[j] = i;
+            if (slowestCount < SLOWEST_TURNS_COUNT)
+                slowestCount++;
+        }
+    }
+
+    AGBPrintf("recorded battle: mode %d, run %u, %u turns, %u frames\n", sRecordMode, checks->playbackRuns + 1, turns, frames);
+    for (i = 0; i < slowestCount; i++)
+        AGBPrintf("slow turn %u: %u frames\n", slowest[i], checks->turnFrames[slowest[i]]);
+    if (sRecordMode == B_RECORD_MODE_PLAYBACK && !IsRecordingTurnChecks())
+    {
+        if (checks->rngSeed != gRecordedBattleRngSeed)
+            AGBPrintf("not the last recorded battle, state not checked\n");
+        else if (checks->mismatches != 0)
+            AGBPrintf("DESYNC: %u turns differ, first on turn %u\n", checks->mismatches, checks->firstMismatchTurn);
+        else if (turns != checks->recordedTurns)
+            AGBPrintf("DESYNC: %u turns recorded\n", checks->recordedTurns);
+        else
+            AGBPrintf("playback matches\n");
+    }
+    AGBPrintFlush();
+#endif
+}
@@ -3,6 +3,7 @@
 #include "gba/flash_internal.h"
 #include "fieldmap.h"
 #include "save.h"
+#include "save_checksum.h"
 #include "task.h"
 #include "decompress.h"
 #include "load_save.h"
@@ -13,13 +14,19 @@
 #include "link.h"
 #include "constants/game_stat.h"
 
-static u16 CalculateChecksum(void *data, u16 size);
 static bool8 DoReadFlashWholeSection(u8 sector, struct SaveSection *section);
 static u8 GetSaveValidStatus(const struct SaveSectionLocation *location);
 static u8 sub_8152E10(u16 a1, const struct SaveSectionLocation *location);
 static u8 ClearSaveData_2(u16 a1, const struct SaveSectionLocation *location);
 static u8 TryWriteSector(u8 sector, u8 *data);
 static u8 HandleWriteSector(u16 a1, const struct SaveSectionLocation *location);
+static u16 GetSaveSlotRotation(u8 slot);
+static bool8 IsSaveSectorUpToDate(u16 sectorId, const struct SaveSectionLocation *location);
+static bool8 StartSaveSlotWrite(void);
+static void Task_SaveInBackground(u8 taskId);
+static bool8 PlanPackedStorage(void);
+static bool8 PackStorageSection(u16 sectorId);
+static bool8 UnpackStorageSection(u16 sectorId);
 
 // Divide save blocks into individual chunks to be written to flash sectors
 
@@ -37,7 +44,22 @@ static u8 HandleWriteSector(u16 a1, const struct SaveSectionLocation *location);
  * we can load the previous one. We also rotate the sectors in each save slot
  * so that the same data is not always being written to the same sector. This
  * might be done to reduce wear on the flash memory, but I'm not sure, since all
- * 14 sectors get written anyway.
+ * 14 sectors got written anyway.
+ *
+ * A normal save now keeps the rotation the slot being overwritten already has,
+ * and skips the sectors whose contents are unchanged since that slot was
+ * written. Only the SaveBlock2 sector (id 0) is always written, and it is
+ * written last: its counter is the slot's counter, so the slot only becomes
+ * the newest one once every other changed sector is in place.
+ *
+ * With P_COMPRESSED_PC_STORAGE, the PC storage sectors hold PokemonStorage
+ * compressed instead of cut into 3968 byte chunks, see PackStorageData. It is
+ * packed twice per save: once up front to split it between the sectors and to
+ * check that it fits, then again a sector at a time as each is written, so
+ * only one sector's worth of buffer is needed. Loading unpacks it once. If it
+ * doesn't fit, the save fails before anything is written. The PC and
+ * SendMonToPC don't let the boxes hold more Pokémon than always fit, see
+ * IsStorageMonCountSaveable, and links check the boxes fit before starting.
  */
 
 // (u8 *)structure was removed from the first statement of the macro in Emerald.
@@ -86,6 +108,12 @@ u16 gSaveAttemptStatus;
 
 EWRAM_DATA struct SaveSection gSaveDataBuffer = {0};
 EWRAM_DATA static u8 sUnusedVar = 0;
+EWRAM_DATA static bool8 sPokemonStorageTooLarge = FALSE;
+#if P_COMPRESSED_PC_STORAGE
+EWRAM_DATA static struct PackedStorageSection sPackedStorageSection = {0};
+EWRAM_DATA static u16 sPackedStorageSectionId = 0;
+EWRAM_DATA static u32 sPackedStorageOffsets[SECTOR_ID_PKMN_STORAGE_END - SECTOR_ID_PKMN_STORAGE_START + 2] = {0};
+#endif
 
 void ClearSaveData(void)
 {
@@ -139,15 +167,29 @@ static u8 SaveWriteToFlash(u16 a1, const struct SaveSectionLocation *location)
     }
     else
     {
-        gLastKnownGoodSector = gLastWrittenSector; // backup the current written sector before attempting to write.
-        gLastSaveCounter = gSaveCounter;
-        gLastWrittenSector++;
-        gLastWrittenSector = gLastWrittenSector % SECTOR_SAVE_SLOT_LENGTH; // array count save sector locations
-        gSaveCounter++;
+        bool8 inPlace;
+
+        if (!PlanPackedStorage())
+            return SAVE_STATUS_ERROR;
+
+        inPlace = StartSaveSlotWrite();
         status = SAVE_STATUS_OK;
 
-        for (i = 0; i < SECTOR_SAVE_SLOT_LENGTH; i++)
-            HandleWriteSector(i, location);
+        for (i = SECTOR_ID_SAVEBLOCK2 + 1; i < SECTOR_SAVE_SLOT_LENGTH && !sPokemonStorageTooLarge; i++)
+        {
+            if (!inPlace || !IsSaveSectorUpToDate(i, location))
+                HandleWriteSector(i, location);
+        }
+
+        if (sPokemonStorageTooLarge)
+        {
+            // A storage section no longer packed into its planned share.
+            // SaveBlock2 isn't written, so the slot isn't completed.
+            gLastWrittenSector = gLastKnownGoodSector;
+            gSaveCounter = gLastSaveCounter;
+            return SAVE_STATUS_ERROR;
+        }
+        HandleWriteSector(SECTOR_ID_SAVEBLOCK2, location);
 
         if (gDamagedSaveSectors != 0) // skip the damaged sector.
         {
@@ -160,9 +202,89 @@ static u8 SaveWriteToFlash(u16 a1, const struct SaveSectionLocation *location)
     return status;
 }
 
-static u8 HandleWriteSector(u16 sectorId, const struct SaveSectionLocation *location)
+// Advances gSaveCounter and picks the rotation of the slot to write. Returns
+// TRUE if the slot is overwritten in place, so unchanged sectors can be skipped.
+static bool8 StartSaveSlotWrite(void)
+{
+    u16 rotation;
+
+    gLastKnownGoodSector = gLastWrittenSector; // backup the current written sector before attempting to write.
+    gLastSaveCounter = gSaveCounter;
+    gSaveCounter++;
+
+    rotation = GetSaveSlotRotation(gSaveCounter % 2);
+    if (rotation != SECTOR_SAVE_SLOT_LENGTH)
+    {
+        gLastWrittenSector = rotation;
+        return TRUE;
+    }
+
+    // The slot is empty or damaged, so it's written in full.
+    gLastWrittenSector++;
+    gLastWrittenSector = gLastWrittenSector % SECTOR_SAVE_SLOT_LENGTH; // array count save sector locations
+    return FALSE;
+}
+
+// Returns the rotation of a save slot whose sectors all hold a valid footer
+// for their section id, or SECTOR_SAVE_SLOT_LENGTH if it has none.
+static u16 GetSaveSlotRotation(u8 slot)
 {
     u16 i;
+    u16 rotation = SECTOR_SAVE_SLOT_LENGTH;
+    u16 ids[SECTOR_SAVE_SLOT_LENGTH];
+
+    for (i = 0; i < SECTOR_SAVE_SLOT_LENGTH; i++)
+    {
+        ReadFlash(i + SECTOR_SAVE_SLOT_LENGTH * slot, sizeof(gFastSaveSection->data), (u8 *)&gFastSaveSection->id, sizeof(struct SaveSection) - sizeof(gFastSaveSection->data));
+        if (gFastSaveSection->security != UNKNOWN_CHECK_VALUE || gFastSaveSection->id >= SECTOR_SAVE_SLOT_LENGTH)
+            return SECTOR_SAVE_SLOT_LENGTH;
+        ids[i] = gFastSaveSection->id;
+        if (ids[i] == 0)
+            rotation = i;
+    }
+
+    if (rotation == SECTOR_SAVE_SLOT_LENGTH)
+        return SECTOR_SAVE_SLOT_LENGTH;
+
+    for (i = 0; i < SECTOR_SAVE_SLOT_LENGTH; i++)
+    {
+        if (ids[(i + rotation) % SECTOR_SAVE_SLOT_LENGTH] != i)
+            return SECTOR_SAVE_SLOT_LENGTH;
+    }
+
+    return rotation;
+}
+
+// Checks whether the sector the section would be written to already holds it.
+// The stored checksum rules out most changed sections without reading their
+// data; a matching one is then compared in full.
+static bool8 IsSaveSectorUpToDate(u16 sectorId, const struct SaveSectionLocation *location)
+{
+    u16 sector;
+    u8 *data;
+    u16 size;
+
+    sector = sectorId + gLastWrittenSector;
+    sector %= SECTOR_SAVE_SLOT_LENGTH;
+    sector += SECTOR_SAVE_SLOT_LENGTH * (gSaveCounter % 2);
+
+    if (!PackStorageSection(sectorId))
+        return FALSE;
+    data = location[sectorId].data;
+    size = location[sectorId].size;
+
+    ReadFlash(sector, sizeof(gFastSaveSection->data), (u8 *)&gFastSaveSection->id, sizeof(struct SaveSection) - sizeof(gFastSaveSection->data));
+    if (gFastSaveSection->security != UNKNOWN_CHECK_VALUE
+     || gFastSaveSection->id != sectorId
+     || gFastSaveSection->checksum != CalculateChecksum(data, size))
+        return FALSE;
+
+    ReadFlash(sector, 0, gFastSaveSection->data, size);
+    return memcmp(gFastSaveSection->data, data, size) == 0;
+}
+
+static u8 HandleWriteSector(u16 sectorId, const struct SaveSectionLocation *location)
+{
     u16 sector;
     u8 *data;
     u16 size;
@@ -171,38 +293,29 @@ static u8 HandleWriteSector(u16 sectorId, const struct SaveSectionLocation *loca
     sector %= SECTOR_SAVE_SLOT_LENGTH;
     sector += SECTOR_SAVE_SLOT_LENGTH * (gSaveCounter % 2);
 
+    if (!PackStorageSection(sectorId))
+        return SAVE_STATUS_ERROR;
     data = location[sectorId].data;
     size = location[sectorId].size;
 
     // clear save section.
-    for (i = 0; i < sizeof(struct SaveSection); i++)
-        ((char *)gFastSaveSection)[i] = 0;
+    CpuFill32(0, gFastSaveSection, sizeof(struct SaveSection));
 
     gFastSaveSection->id = sectorId;
     gFastSaveSection->security = UNKNOWN_CHECK_VALUE;
     gFastSaveSection->counter = gSaveCounter;
-
-    for (i = 0; i < size; i++)
-        gFastSaveSection->data[i] = data[i];
-
-    gFastSaveSection->checksum = CalculateChecksum(data, size);
+    gFastSaveSection->checksum = CopySaveSectionData(gFastSaveSection->data, data, size);
     return TryWriteSector(sector, gFastSaveSection->data);
 }
 
 static u8 HandleWriteSectorNBytes(u8 sector, u8 *data, u16 size)
 {
-    u16 i;
     struct SaveSection *section = &gSaveDataBuffer;
 
-    for (i = 0; i < sizeof(struct SaveSection); i++)
-        ((char *)section)[i] = 0;
+    CpuFill32(0, section, sizeof(struct SaveSection));
 
     section->security = UNKNOWN_CHECK_VALUE;
-
-    for (i = 0; i < size; i++)
-        section->data[i] = data[i];
-
-    section->id = CalculateChecksum(data, size); // though this appears to be incorrect, it might be some sector checksum instead of a whole save checksum and only appears to be relevent to HOF data, if used.
+    section->id = CopySaveSectionData(section->data, data, size); // though this appears to be incorrect, it might be some sector checksum instead of a whole save checksum and only appears to be relevent to HOF data, if used.
     return TryWriteSector(sector, section->data);
 }
 
@@ -252,7 +365,7 @@ static u8 sub_81529D4(u16 sectorId, const struct SaveSectionLocation *location)
         status = SAVE_STATUS_OK;
         HandleWriteSector(gUnknown_03006208, location);
         gUnknown_03006208++;
-        if (gDamagedSaveSectors)
+        if (gDamagedSaveSectors || sPokemonStorageTooLarge)
         {
             status = SAVE_STATUS_ERROR;
             gLastWrittenSector = gLastKnownGoodSector;
@@ -294,23 +407,20 @@ static u8 ClearSaveData_2(u16 sectorId, const struct SaveSectionLocation *locati
     sector %= SECTOR_SAVE_SLOT_LENGTH;
     sector += SECTOR_SAVE_SLOT_LENGTH * (gSaveCounter % 2);
 
+    if (!PackStorageSection(sectorId))
+        return SAVE_STATUS_ERROR;
     data = location[sectorId].data;
     size = location[sectorId].size;
 
     // clear temp save section.
-    for (i = 0; i < sizeof(struct SaveSection); i++)
-        ((char *)gFastSaveSection)[i] = 0;
+    CpuFill32(0, gFastSaveSection, sizeof(struct SaveSection));
 
     gFastSaveSection->id = sectorId;
     gFastSaveSection->security = UNKNOWN_CHECK_VALUE;
     gFastSaveSection->counter = gSaveCounter;
 
-    // set temp section's data.
-    for (i = 0; i < size; i++)
-        gFastSaveSection->data[i] = data[i];
-
-    // calculate checksum.
-    gFastSaveSection->checksum = CalculateChecksum(data, size);
+    // set temp section's data and calculate checksum.
+    gFastSaveSection->checksum = CopySaveSectionData(gFastSaveSection->data, data, size);
 
     EraseFlashSector(sector);
 
@@ -436,7 +546,9 @@ static u8 sub_8152DD0(u16 a1, const struct SaveSectionLocation *location)
     else
     {
         status = GetSaveValidStatus(location);
-        sub_8152E10(0xFFFF, location);
+        // Packed PC storage that doesn't unpack loads as a corrupt save.
+        if (sub_8152E10(0xFFFF, location) == SAVE_STATUS_CORRUPT && status == SAVE_STATUS_OK)
+            status = SAVE_STATUS_CORRUPT;
     }
 
     return status;
@@ -448,6 +560,7 @@ static u8 sub_8152E10(u16 a1, const struct SaveSectionLocation *location)
     u16 checksum;
     u16 v3 = SECTOR_SAVE_SLOT_LENGTH * (gSaveCounter % 2);
     u16 id;
+    u8 status = SAVE_STATUS_OK;
 
     for (i = 0; i < SECTOR_SAVE_SLOT_LENGTH; i++)
     {
@@ -459,13 +572,13 @@ static u8 sub_8152E10(u16 a1, const struct SaveSectionLocation *location)
         if (gFastSaveSection->security == UNKNOWN_CHECK_VALUE
          && gFastSaveSection->checksum == checksum)
         {
-            u16 j;
-            for (j = 0; j < location[id].size; j++)
-                ((u8 *)location[id].data)[j] = gFastSaveSection->data[j];
+            memcpy(location[id].data, gFastSaveSection->data, location[id].size);
+            if (!UnpackStorageSection(id))
+                status = SAVE_STATUS_CORRUPT;
         }
     }
 
-    return SAVE_STATUS_OK;
+    return status;
 }
 
 static u8 GetSaveValidStatus(const struct SaveSectionLocation *location)
@@ -489,7 +602,9 @@ static u8 GetSaveValidStatus(const struct SaveSectionLocation *location)
             checksum = CalculateChecksum(gFastSaveSection->data, location[gFastSaveSection->id].size);
             if (gFastSaveSection->checksum == checksum)
             {
-                saveSlot1Counter = gFastSaveSection->counter;
+                // Unchanged sectors keep the counter of the save that wrote them.
+                if (gFastSaveSection->id == SECTOR_ID_SAVEBLOCK2)
+                    saveSlot1Counter = gFastSaveSection->counter;
                 slotCheckField |= 1 << gFastSaveSection->id;
             }
         }
@@ -520,7 +635,8 @@ static u8 GetSaveValidStatus(const struct SaveSectionLocation *location)
             checksum = CalculateChecksum(gFastSaveSection->data, location[gFastSaveSection->id].size);
             if (gFastSaveSection->checksum == checksum)
             {
-                saveSlot2Counter = gFastSaveSection->counter;
+                if (gFastSaveSection->id == SECTOR_ID_SAVEBLOCK2)
+                    saveSlot2Counter = gFastSaveSection->counter;
                 slotCheckField |= 1 << gFastSaveSection->id;
             }
         }
@@ -587,7 +703,6 @@ static u8 GetSaveValidStatus(const struct SaveSectionLocation *location)
 
 static u8 sub_81530DC(u8 sectorId, u8 *data, u16 size)
 {
-    u16 i;
     struct SaveSection *section = &gSaveDataBuffer;
     DoReadFlashWholeSection(sectorId, section);
     if (section->security == UNKNOWN_CHECK_VALUE)
@@ -595,8 +710,7 @@ static u8 sub_81530DC(u8 sectorId, u8 *data, u16 size)
         u16 checksum = CalculateChecksum(section->data, size);
         if (section->id == checksum)
         {
-            for (i = 0; i < size; i++)
-                data[i] = section->data[i];
+            memcpy(data, section->data, size);
             return SAVE_STATUS_OK;
         }
         else
@@ -617,20 +731,6 @@ static bool8 DoReadFlashWholeSection(u8 sector, struct SaveSection *section)
     return TRUE;
 }
 
-static u16 CalculateChecksum(void *data, u16 size)
-{
-    u16 i;
-    u32 checksum = 0;
-
-    for (i = 0; i < (size / 4); i++)
-    {
-        checksum += *((u32 *)data);
-        data += sizeof(u32);
-    }
-
-    return ((checksum >> 16) + checksum);
-}
-
 static void UpdateSaveAddresses(void)
 {
     int i = 0;
@@ -646,9 +746,258 @@ static void UpdateSaveAddresses(void)
 
     for (; i <= SECTOR_ID_PKMN_STORAGE_END; i++) //setting i to SECTOR_ID_PKMN_STORAGE_START does not match
     {
+#if P_COMPRESSED_PC_STORAGE
+        // Each section is packed into and unpacked from the same buffer.
+        gRamSaveSectionLocations[i].data = &sPackedStorageSection;
+        gRamSaveSectionLocations[i].size = sizeof(sPackedStorageSection);
+#else
         gRamSaveSectionLocations[i].data = (void*)(gPokemonStoragePtr) + sSaveSectionOffsets[i].toAdd;
         gRamSaveSectionLocations[i].size = sSaveSectionOffsets[i].size;
+#endif
+    }
+}
+
+#if P_COMPRESSED_PC_STORAGE
+
+#define PACKED_RUN_MIN     3
+#define PACKED_RUN_MAX     (0x7F + PACKED_RUN_MIN)
+#define PACKED_LITERAL_MAX 0x80
+
+// Encodes up to srcSize bytes of src into dest, stopping early once dest is
+// full, and returns how many bytes of src were encoded. Each token starts with
+// a control byte. If its top bit is set, the next byte is repeated
+// (control & 0x7F) + PACKED_RUN_MIN times, otherwise control + 1 bytes are
+// copied as they are. Empty box slots and blank names pack down to almost
+// nothing; the encrypted part of a BoxPokemon barely packs at all.
+static u32 PackStorageData(u8 *dest, u32 destSize, const u8 *src, u32 srcSize)
+{
+    u32 in = 0;
+    u32 out = 0;
+    u32 run;
+    u32 literal;
+    u8 value;
+
+    while (in < srcSize)
+    {
+        value = src[in];
+        run = 1;
+        while (run < PACKED_RUN_MAX && in + run < srcSize && src[in + run] == value)
+            run++;
+
+        if (run >= PACKED_RUN_MIN)
+        {
+            if (out + 2 > destSize)
+                break;
+            dest[out++] = 0x80 | (run - PACKED_RUN_MIN);
+            dest[out++] = value;
+            in += run;
+            continue;
+        }
+
+        // Copy bytes as they are up to the next run worth encoding.
+        literal = run;
+        while (literal < PACKED_LITERAL_MAX && in + literal < srcSize)
+        {
+            if (in + literal + 2 < srcSize
+             && src[in + literal] == src[in + literal + 1]
+             && src[in + literal] == src[in + literal + 2])
+                break;
+            literal++;
+        }
+
+        if (out + 1 + literal > destSize)
+        {
+            if (out + 2 > destSize)
+                break;
+            literal = destSize - out - 1;
+        }
+        dest[out++] = literal - 1;
+        memcpy(&dest[out], &src[in], literal);
+        out += literal;
+        in += literal;
+    }
+
+    return in;
+}
+
+// Decodes src into exactly destSize bytes of dest. Returns FALSE if src is
+// malformed.
+static bool8 UnpackStorageData(u8 *dest, u32 destSize, const u8 *src, u32 srcSize)
+{
+    u32 in = 0;
+    u32 out = 0;
+    u32 count;
+    u8 control;
+
+    while (out < destSize)
+    {
+        if (in >= srcSize)
+            return FALSE;
+
+        control = src[in++];
+        if (control & 0x80)
+        {
+            count = (control & 0x7F) + PACKED_RUN_MIN;
+            if (in >= srcSize || out + count > destSize)
+                return FALSE;
+            memset(&dest[out], src[in++], count);
+        }
+        else
+        {
+            count = control + 1;
+            if (in + count > srcSize || out + count > destSize)
+                return FALSE;
+            memcpy(&dest[out], &src[in], count);
+            in += count;
+        }
+        out += count;
+    }
+
+    return TRUE;
+}
+
+// Packs PokemonStorage a section at a time, as a save writes it, and returns
+// how much of it fits in the storage sections. If offsets isn't NULL, it's
+// given where each section starts. Packs into sPackedStorageSection.
+static u32 SplitPackedStorage(u32 *offsets)
+{
+    u32 i;
+    u32 offset = 0;
+
+    for (i = 0; i <= SECTOR_ID_PKMN_STORAGE_END - SECTOR_ID_PKMN_STORAGE_START; i++)
+    {
+        if (offsets != NULL)
+            offsets[i] = offset;
+        offset += PackStorageData(sPackedStorageSection.data, sizeof(sPackedStorageSection.data),
+                                  (u8 *)gPokemonStoragePtr + offset,
+                                  min(sizeof(struct PokemonStorage) - offset, 0xFFFF));
+    }
+    if (offsets != NULL)
+        offsets[i] = offset;
+    sPackedStorageSectionId = SECTOR_SAVE_SLOT_LENGTH;
+    return offset;
+}
+
+#endif // P_COMPRESSED_PC_STORAGE
+
+// Splits PokemonStorage between the storage sections for the save about to be
+// written. Returns FALSE if it doesn't fit in them, in which case no sector
+// may be written.
+// Budget: packing may add at most 16 frames to a save and unpacking at most
+// 4 frames to a load. savetool bench models 14 full boxes at 6 frames per
+// packing pass (a save does two) and 2.3 frames to unpack, and empty boxes at
+// 2.5 and 1.4 frames. The background save runs this first pass in one frame,
+// so it stalls there.
+static bool8 PlanPackedStorage(void)
+{
+#if P_COMPRESSED_PC_STORAGE
+    sPokemonStorageTooLarge = (SplitPackedStorage(sPackedStorageOffsets) != sizeof(struct PokemonStorage));
+#endif
+    return !sPokemonStorageTooLarge;
+}
+
+// Returns whether PokemonStorage as it is now fits in the save. Links check
+// this before they start, so that a trade can't go through on one side and
+// then fail to save on that side only.
+bool8 DoesPokemonStorageFitInSave(void)
+{
+#if P_COMPRESSED_PC_STORAGE
+    return SplitPackedStorage(NULL) == sizeof(struct PokemonStorage);
+#else
+    return TRUE;
+#endif
+}
+
+// Returns whether PokemonStorage is sure to fit in the save with monCount box
+// slots holding a Pokémon, wherever they are. This assumes the worst for each
+// Pokémon: its encrypted data doesn't pack, so all of it is copied as
+// literals, and it cuts short the runs of empty slots around it. The PC and
+// SendMonToPC keep the boxes within this, so that packing can't fail later.
+bool8 IsStorageMonCountSaveable(u32 monCount)
+{
+#if P_COMPRESSED_PC_STORAGE
+    u32 slots = TOTAL_BOXES_COUNT * IN_BOX_COUNT;
+    u32 sections = SECTOR_ID_PKMN_STORAGE_END - SECTOR_ID_PKMN_STORAGE_START + 1;
+    u32 gaps, literalBytes, emptyBytes, packedSize;
+
+    if (monCount > slots)
+        return FALSE;
+
+    // Each stretch of empty slots ends a literal and a run, and may leave up to
+    // PACKED_RUN_MIN - 1 bytes to be copied as they are.
+    gaps = min(monCount, slots - monCount) + 1;
+    literalBytes = monCount * sizeof(struct BoxPokemon)
+                 + offsetof(struct PokemonStorage, boxes)
+                 + sizeof(gPokemonStoragePtr->boxNames)
+                 + sizeof(gPokemonStoragePtr->boxWallpapers)
+                 + gaps * (PACKED_RUN_MIN - 1);
+    emptyBytes = (slots - monCount) * sizeof(struct BoxPokemon);
+    packedSize = literalBytes + literalBytes / PACKED_LITERAL_MAX + gaps + 2
+               + 2 * (emptyBytes / PACKED_RUN_MAX + gaps);
+
+    // A section may leave a byte unused and split a literal in two.
+    return packedSize <= sections * (sizeof(sPackedStorageSection.data) - 2);
+#else
+    return TRUE;
+#endif
+}
+
+// Packs a storage section into sPackedStorageSection, split as planned by
+// PlanPackedStorage. Other sections are saved straight from their save block.
+// A background save packs each section frames after the plan, so the boxes
+// may have changed and no longer fit. Returns FALSE and sets
+// sPokemonStorageTooLarge then, and the section must not be written.
+static bool8 PackStorageSection(u16 sectorId)
+{
+#if P_COMPRESSED_PC_STORAGE
+    u32 i = sectorId - SECTOR_ID_PKMN_STORAGE_START;
+
+    // Checking whether a section changed packs it right before it's written.
+    if (sectorId < SECTOR_ID_PKMN_STORAGE_START || sectorId > SECTOR_ID_PKMN_STORAGE_END
+     || sectorId == sPackedStorageSectionId)
+        return TRUE;
+
+    sPackedStorageSectionId = sectorId;
+    CpuFill32(0, &sPackedStorageSection, sizeof(sPackedStorageSection));
+    sPackedStorageSection.signature = PACKED_STORAGE_SIGNATURE;
+    sPackedStorageSection.offset = sPackedStorageOffsets[i];
+    sPackedStorageSection.size = sPackedStorageOffsets[i + 1] - sPackedStorageOffsets[i];
+    if (PackStorageData(sPackedStorageSection.data, sizeof(sPackedStorageSection.data),
+                        (u8 *)gPokemonStoragePtr + sPackedStorageSection.offset,
+                        sPackedStorageSection.size) != sPackedStorageSection.size)
+    {
+        sPackedStorageSectionId = SECTOR_SAVE_SLOT_LENGTH;
+        sPokemonStorageTooLarge = TRUE;
+        return FALSE;
     }
+#endif
+    return TRUE;
+}
+
+// Unpacks a storage section that was just loaded into sPackedStorageSection.
+// Sections saved before P_COMPRESSED_PC_STORAGE was enabled are loaded as the
+// plain chunks they are. Returns FALSE if a packed section is malformed.
+static bool8 UnpackStorageSection(u16 sectorId)
+{
+#if P_COMPRESSED_PC_STORAGE
+    u32 offset;
+
+    if (sectorId < SECTOR_ID_PKMN_STORAGE_START || sectorId > SECTOR_ID_PKMN_STORAGE_END)
+        return TRUE;
+
+    sPackedStorageSectionId = SECTOR_SAVE_SLOT_LENGTH;
+    if (sPackedStorageSection.signature == PACKED_STORAGE_SIGNATURE
+     && sPackedStorageSection.offset + sPackedStorageSection.size <= sizeof(struct PokemonStorage))
+    {
+        return UnpackStorageData((u8 *)gPokemonStoragePtr + sPackedStorageSection.offset, sPackedStorageSection.size,
+                                 sPackedStorageSection.data, sizeof(sPackedStorageSection.data));
+    }
+
+    offset = (sectorId - SECTOR_ID_PKMN_STORAGE_START) * SECTOR_DATA_SIZE;
+    if (offset < sizeof(struct PokemonStorage))
+        memcpy((u8 *)gPokemonStoragePtr + offset, &sPackedStorageSection, min(sizeof(struct PokemonStorage) - offset, SECTOR_DATA_SIZE));
+#endif
+    return TRUE;
 }
 
 u8 HandleSavingData(u8 saveType)
@@ -656,6 +1005,7 @@ u8 HandleSavingData(u8 saveType)
     u8 i;
     u32 *backupVar = gTrainerHillVBlankCounter;
     u8 *tempAddr;
+    u8 status = SAVE_STATUS_OK;
 
     gTrainerHillVBlankCounter = NULL;
     UpdateSaveAddresses();
@@ -668,7 +1018,7 @@ u8 HandleSavingData(u8 saveType)
         if (GetGameStat(GAME_STAT_ENTERED_HOF) < 999)
             IncrementGameStat(GAME_STAT_ENTERED_HOF);
         SaveSerializedGame();
-        SaveWriteToFlash(0xFFFF, gRamSaveSectionLocations);
+        status = SaveWriteToFlash(0xFFFF, gRamSaveSectionLocations);
         tempAddr = gDecompressionBuffer;
         HandleWriteSectorNBytes(SECTOR_ID_HOF_1, tempAddr, SECTOR_DATA_SIZE);
         HandleWriteSectorNBytes(SECTOR_ID_HOF_2, tempAddr + SECTOR_DATA_SIZE, SECTOR_DATA_SIZE);
@@ -676,7 +1026,7 @@ u8 HandleSavingData(u8 saveType)
     case SAVE_NORMAL: // normal save. also called by overwriting your own save.
     default:
         SaveSerializedGame();
-        SaveWriteToFlash(0xFFFF, gRamSaveSectionLocations);
+        status = SaveWriteToFlash(0xFFFF, gRamSaveSectionLocations);
         break;
     case SAVE_LINK:  // Link and Battle Frontier
     case SAVE_LINK2: // Unused
@@ -697,11 +1047,11 @@ u8 HandleSavingData(u8 saveType)
         for (i = SECTOR_ID_HOF_1; i < SECTORS_COUNT; i++)
             EraseFlashSector(i); // erase HOF.
         SaveSerializedGame();
-        SaveWriteToFlash(0xFFFF, gRamSaveSectionLocations);
+        status = SaveWriteToFlash(0xFFFF, gRamSaveSectionLocations);
         break;
     }
     gTrainerHillVBlankCounter = backupVar;
-    return 0;
+    return status;
 }
 
 u8 TrySavingData(u8 saveType)
@@ -712,7 +1062,13 @@ u8 TrySavingData(u8 saveType)
         return SAVE_STATUS_ERROR;
     }
 
-    HandleSavingData(saveType);
+    if (HandleSavingData(saveType) == SAVE_STATUS_ERROR && !gDamagedSaveSectors)
+    {
+        // The PC boxes didn't fit in the save, so the slot wasn't completed.
+        gSaveAttemptStatus = SAVE_STATUS_ERROR;
+        return SAVE_STATUS_ERROR;
+    }
+
     if (!gDamagedSaveSectors)
     {
         gSaveAttemptStatus = SAVE_STATUS_OK;
@@ -726,12 +1082,139 @@ u8 TrySavingData(u8 saveType)
     }
 }
 
+#define tState              data[0]
+#define tSaveType           data[1]
+#define tSectorId           data[2]
+#define tInPlace            data[3]
+#define tCallback           4 // data[4] and data[5]
+#define tTrainerHillCounter 6 // data[6] and data[7]
+#define tTooLarge           data[8]
+
+// Saves like TrySavingData, but programs at most one flash sector per frame
+// so the game keeps running meanwhile. The save blocks are written as they
+// are when each sector's turn comes, so the caller must keep the game state
+// still (e.g. by staying in a menu) until callback is called with the
+// result. Damaged sectors are reported the same way TrySavingData does.
+// Save types other than SAVE_NORMAL and SAVE_OVERWRITE_DIFFERENT_FILE are
+// saved at once.
+void TrySavingDataInBackground(u8 saveType, void (*callback)(u8 status))
+{
+    u8 taskId;
+
+    if (gFlashMemoryPresent != TRUE
+     || (saveType != SAVE_NORMAL && saveType != SAVE_OVERWRITE_DIFFERENT_FILE))
+    {
+        callback(TrySavingData(saveType));
+        return;
+    }
+
+    taskId = CreateTask(Task_SaveInBackground, 80);
+    gTasks[taskId].tSaveType = saveType;
+    gTasks[taskId].tSectorId = SECTOR_ID_HOF_1;
+    SetWordTaskArg(taskId, tCallback, (u32)callback);
+    SetWordTaskArg(taskId, tTrainerHillCounter, (u32)gTrainerHillVBlankCounter);
+    gTrainerHillVBlankCounter = NULL;
+}
+
+static void Task_SaveInBackground(u8 taskId)
+{
+    s16 *data = gTasks[taskId].data;
+    void (*callback)(u8 status);
+    u8 status;
+
+    switch (tState)
+    {
+    case 0:
+        if (tSaveType == SAVE_OVERWRITE_DIFFERENT_FILE && tSectorId < SECTORS_COUNT)
+        {
+            EraseFlashSector(tSectorId++); // erase HOF.
+            break;
+        }
+        gFastSaveSection = &gSaveDataBuffer;
+        UpdateSaveAddresses();
+        SaveSerializedGame();
+        if (!PlanPackedStorage())
+        {
+            tTooLarge = TRUE;
+            tState = 2;
+            break;
+        }
+        tInPlace = StartSaveSlotWrite();
+        tSectorId = SECTOR_ID_SAVEBLOCK2 + 1;
+        tState++;
+        break;
+    case 1:
+        // Unchanged sectors don't need to be programmed, so they don't take a frame.
+        while (tSectorId < SECTOR_SAVE_SLOT_LENGTH)
+        {
+            u16 sectorId = tSectorId++;
+
+            if (!tInPlace || !IsSaveSectorUpToDate(sectorId, gRamSaveSectionLocations))
+            {
+                HandleWriteSector(sectorId, gRamSaveSectionLocations);
+                if (sPokemonStorageTooLarge)
+                {
+                    // The boxes changed since the save started and no longer
+                    // fit. SaveBlock2 isn't written, so the slot isn't completed.
+                    gLastWrittenSector = gLastKnownGoodSector;
+                    gSaveCounter = gLastSaveCounter;
+                    tTooLarge = TRUE;
+                    tState = 2;
+                }
+                return;
+            }
+        }
+        HandleWriteSector(SECTOR_ID_SAVEBLOCK2, gRamSaveSectionLocations);
+        tState++;
+        break;
+    case 2:
+        gTrainerHillVBlankCounter = (u32 *)GetWordTaskArg(taskId, tTrainerHillCounter);
+        if (tTooLarge)
+        {
+            // The save slot wasn't completed, see TrySavingData.
+            status = SAVE_STATUS_ERROR;
+        }
+        else if (!gDamagedSaveSectors)
+        {
+            status = SAVE_STATUS_OK;
+        }
+        else
+        {
+            gLastWrittenSector = gLastKnownGoodSector;
+            gSaveCounter = gLastSaveCounter;
+            DoSaveFailedScreen(tSaveType);
+            status = SAVE_STATUS_ERROR;
+        }
+        gSaveAttemptStatus = status;
+        callback = (void *)GetWordTaskArg(taskId, tCallback);
+        DestroyTask(taskId);
+        callback(status);
+        break;
+    }
+}
+
+#undef tState
+#undef tSaveType
+#undef tSectorId
+#undef tInPlace
+#undef tCallback
+#undef tTrainerHillCounter
+#undef tTooLarge
+
 bool8 sub_8153380(void) // trade.c
 {
     if (gFlashMemoryPresent != TRUE)
         return TRUE;
     UpdateSaveAddresses();
     SaveSerializedGame();
+    if (!PlanPackedStorage())
+    {
+        // Skip the save. sub_81533AC is done at once and the later steps
+        // check sPokemonStorageTooLarge, so no sector is written. The trade
+        // shows this once sub_81533AC is done, see IsPokemonStorageTooLargeToSave.
+        gUnknown_03006208 = SECTOR_SAVE_SLOT_LENGTH;
+        return FALSE;
+    }
     RestoreSaveBackupVarsAndIncrement(gRamSaveSectionLocations);
     return FALSE;
 }
@@ -747,8 +1230,16 @@ bool8 sub_81533AC(void) // trade.c
         return FALSE;
 }
 
+// Returns whether the last save failed because the PC boxes didn't fit in it.
+bool8 IsPokemonStorageTooLargeToSave(void)
+{
+    return sPokemonStorageTooLarge;
+}
+
 bool8 sub_81533E0(void) // trade.c
 {
+    if (sPokemonStorageTooLarge)
+        return FALSE;
     sub_8152A34(SECTOR_SAVE_SLOT_LENGTH, gRamSaveSectionLocations);
     if (gDamagedSaveSectors)
         DoSaveFailedScreen(SAVE_NORMAL);
@@ -757,6 +1248,8 @@ bool8 sub_81533E0(void) // trade.c
 
 bool8 sub_8153408(void) // trade.c
 {
+    if (sPokemonStorageTooLarge)
+        return FALSE;
     sub_8152CAC(SECTOR_SAVE_SLOT_LENGTH, gRamSaveSectionLocations);
     if (gDamagedSaveSectors)
         DoSaveFailedScreen(SAVE_NORMAL);
@@ -811,6 +1304,7 @@ u8 Save_LoadGameData(u8 saveType)
     default:
         status = sub_8152DD0(0xFFFF, gRamSaveSectionLocations);
         LoadSerializedGame();
+        InvalidateStorageIndex();
         gSaveFileStatus = status;
         gGameContinueCallback = 0;
         break;
@@ -0,0 +1,40 @@
+#include "global.h"
+#include "save_checksum.h"
+
+// Kept apart from save.c so that tools/hosttest can check it on the host.
+
+u16 CalculateChecksum(const void *data, u16 size)
+{
+    u16 i;
+    u32 checksum = 0;
+
+    for (i = 0; i < (size / 4); i++)
+    {
+        checksum += *((const u32 *)data);
+        data += sizeof(u32);
+    }
+
+    return ((checksum >> 16) + checksum);
+}
+
+// Copies a section's data a word at a time and returns CalculateChecksum's
+// result for it from the same pass. Both buffers must be word aligned.
+u16 CopySaveSectionData(void *dest, const void *src, u16 size)
+{
+    u16 i;
+    u32 word;
+    u32 checksum = 0;
+
+    for (i = 0; i < (size / 4); i++)
+    {
+        word = ((const u32 *)src)[i];
+        checksum += word;
+        ((u32 *)dest)[i] = word;
+    }
+
+    // Trailing bytes are copied but, as in CalculateChecksum, not summed.
+    for (i *= 4; i < size; i++)
+        ((u8 *)dest)[i] = ((const u8 *)src)[i];
+
+    return ((checksum >> 16) + checksum);
+}
@@ -121,6 +121,8 @@ static u8 SaveConfirmOverwriteCallback(void);
 static u8 SaveOverwriteInputCallback(void);
 static u8 SaveSavingMessageCallback(void);
 static u8 SaveDoSaveCallback(void);
+static u8 SaveWaitForSaveCallback(void);
+static void SaveDoneCallback(u8 saveStatus);
 static u8 SaveSuccessCallback(void);
 static u8 SaveReturnSuccessCallback(void);
 static u8 SaveErrorCallback(void);
@@ -1059,28 +1061,37 @@ static u8 SaveSavingMessageCallback(void)
 
 static u8 SaveDoSaveCallback(void)
 {
-    u8 saveStatus;
-
     IncrementGameStat(GAME_STAT_SAVED_GAME);
     PausePyramidChallenge();
 
+    // Replaced by SaveDoneCallback once the save finishes
+    sSaveDialogCallback = SaveWaitForSaveCallback;
     if (gDifferentSaveFile == TRUE)
     {
-        saveStatus = TrySavingData(SAVE_OVERWRITE_DIFFERENT_FILE);
         gDifferentSaveFile = FALSE;
+        TrySavingDataInBackground(SAVE_OVERWRITE_DIFFERENT_FILE, SaveDoneCallback);
     }
     else
     {
-        saveStatus = TrySavingData(SAVE_NORMAL);
+        TrySavingDataInBackground(SAVE_NORMAL, SaveDoneCallback);
     }
 
+    return SAVE_IN_PROGRESS;
+}
+
+static u8 SaveWaitForSaveCallback(void)
+{
+    return SAVE_IN_PROGRESS;
+}
+
+static void SaveDoneCallback(u8 saveStatus)
+{
     if (saveStatus == SAVE_STATUS_OK)
         ShowSaveMessage(gText_PlayerSavedGame, SaveSuccessCallback);
     else
         ShowSaveMessage(gText_SaveError, SaveErrorCallback);
 
     SaveStartTimer();
-    return SAVE_IN_PROGRESS;
 }
 
 static u8 SaveSuccessCallback(void)
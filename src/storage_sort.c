@@ -0,0 +1,86 @@
+#include "global.h"
+#include "pokemon_storage_system.h"
+#include "storage_sort.h"
+#include "constants/items.h"
+
+// Kept apart from pokemon_storage_system.c so that tools/hosttest can check it on the host.
+
+// Turns a Pokémon's value for sortBy, as read from the Pokémon, into the key it is sorted and searched by
+u32 GetStorageSortKeyFromValue(u32 value, u8 sortBy)
+{
+    if (sortBy == STORAGE_SORT_LEVEL)
+        return MAX_LEVEL - value; // Highest level first
+    if (sortBy == STORAGE_SORT_ITEM && value == ITEM_NONE)
+        return ITEMS_COUNT; // Pokémon without an item go last
+    return value;
+}
+
+// Insertion sort by key, so that entries with the same key keep their current order.
+// Needs no buffer, and box contents are often partly sorted already.
+void SortStorageEntries(struct StorageSortEntry *entries, u16 count)
+{
+    struct StorageSortEntry entry;
+    u16 i, j;
+
+    for (i = 1; i < count; i++)
+    {
+        entry = entries[i];
+        for (j = i; j > 0 && entries[j - 1].key > entry.key; j--)
+            entries[j] = entries[j - 1];
+        entries[j] = entry;
+    }
+}
+
+// Fills results with the slots of the entries whose key is value for searchBy, in entry order,
+// and returns how many were found. For STORAGE_SORT_TYPE either of the two types may match.
+// Eggs and empty slots never match.
+u16 SearchStorageEntries(const struct StorageSortEntry *entries, u16 count, u8 searchBy, u16 value, u16 *results, u16 maxResults)
+{
+    u32 key = GetStorageSortKeyFromValue(value, searchBy);
+    u16 i, found = 0;
+
+    for (i = 0; i < count && found < maxResults; i++)
+    {
+        if (entries[i].key == STORAGE_SORT_KEY_EGG || entries[i].key == STORAGE_SORT_KEY_EMPTY)
+            continue;
+
+        if (searchBy == STORAGE_SORT_TYPE)
+        {
+            if ((entries[i].key >> 8) == value || (entries[i].key & 0xFF) == value)
+                results[found++] = entries[i].slot;
+        }
+        else if (entries[i].key == key)
+        {
+            results[found++] = entries[i].slot;
+        }
+    }
+
+    return found;
+}
+
+// Moves what is in entries[i].slot to slot first + i, for slots first to first + count - 1.
+// Each cycle of the permutation is rotated through one spare slot, so every item is moved
+// at most once, plus once to and from the spare slot per cycle.
+void ApplyStorageSortOrder(struct StorageSortEntry *entries, u16 first, u16 count, void (*moveSlot)(u16 dst, u16 src))
+{
+    u16 i, dst, src;
+
+    for (i = 0; i < count; i++)
+    {
+        // Already in place, or moved as part of an earlier cycle
+        if (entries[i].slot == first + i)
+            continue;
+
+        moveSlot(STORAGE_SORT_TEMP_SLOT, first + i);
+        dst = first + i;
+        while (entries[dst - first].slot != first + i)
+        {
+            src = entries[dst - first].slot;
+            moveSlot(dst, src);
+            entries[dst - first].slot = dst;
+            dst = src;
+        }
+        moveSlot(dst, STORAGE_SORT_TEMP_SLOT);
+        entries[dst - first].slot = dst;
+    }
+}
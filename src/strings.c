@@ -953,6 +953,14 @@ const u8 gPCText_PolkaDot[] = _("Polka-Dot");
 const u8 gPCText_Pokecenter[] = _("PokéCenter");
 const u8 gPCText_Machine[] = _("Machine");
 const u8 gPCText_Simple[] = _("Simple");
+const u8 gPCText_Sort[] = _("Sort");
+const u8 gPCText_SortSpecies[] = _("Species");
+const u8 gPCText_SortDexNum[] = _("Dex No.");
+const u8 gPCText_SortLevel[] = _("Level");
+const u8 gPCText_SortType[] = _("Type");
+const u8 gPCText_SortItem[] = _("Item");
+const u8 gPCText_SortNature[] = _("Nature");
+const u8 gText_SortBoxByWhat[] = _("Sort this Box by what?");
 const u8 gText_WhatWouldYouLikeToDo[] = _("What would you like to do?"); // Unused
 const u8 gText_WithdrawPokemon[] = _("Withdraw Pokémon");
 const u8 gText_DepositPokemon[] = _("Deposit Pokémon");
@@ -1754,6 +1762,7 @@ const u8 gText_PlayersBattleResults[] = _("{PLAYER}'s Battle Results");
 const u8 gText_TotalRecordWLD[] = _("Total Record W:{STR_VAR_1} L:{STR_VAR_2} D:{STR_VAR_3}");
 const u8 gText_WinLoseDraw[] = _("{CLEAR_TO 0x53}WIN{CLEAR_TO 0x80}LOSE{CLEAR_TO 0xB0}DRAW");
 const u8 gText_CommunicationStandby5[] = _("Communication standby…");
+const u8 gText_BoxesTooFullToSave[] = _("The Pokémon Boxes are too\nfull to save the game.");
 const u8 gText_QuitTheGame[] = _("Quit the game?");
 const u8 gText_YouveGot9999Coins[] = _("You've got 9,999 Coins.");
 const u8 gText_YouveRunOutOfCoins[] = _("You've run out of Coins.\nGame over!");
@@ -4703,6 +4703,8 @@ static void CB2_SaveAndEndTrade(void)
         if (sub_81533AC())
         {
             ClearContinueGameWarpStatus2();
+            if (IsPokemonStorageTooLargeToSave())
+                DrawTextOnTradeWindow(0, gText_BoxesTooFullToSave, 0);
             gMain.state = 4;
         }
         else
@@ -5011,6 +5013,8 @@ static void CB2_SaveAndEndWirelessTrade(void)
     case 4:
         if (sub_81533AC())
         {
+            if (IsPokemonStorageTooLargeToSave())
+                DrawTextOnTradeWindow(0, gText_BoxesTooFullToSave, 0);
             gMain.state = 5;
         }
         else
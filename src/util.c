@@ -261,9 +261,37 @@ u32 CalcByteArraySum(const u8* data, u32 length)
     return sum;
 }
 
+// Each channel's blend is at most 31 * 16, which fits in the 10 bits
+// SPREAD_RGB gives it, so the whole color is blended with one multiply.
 void BlendPalette(u16 palOffset, u16 numEntries, u8 coeff, u16 blendColor)
 {
     u16 i;
+    u32 spreadBlend;
+    u16 *src = &gPlttBufferUnfaded[palOffset];
+    u16 *dst = &gPlttBufferFaded[palOffset];
+
+    if (coeff == 0)
+    {
+        for (i = 0; i < numEntries; i++)
+            dst[i] = src[i] & 0x7FFF;
+        return;
+    }
+
+    if (coeff == 16)
+    {
+        CpuFill16(blendColor & 0x7FFF, dst, numEntries * sizeof(u16));
+        return;
+    }
+
+    if (coeff < 16)
+    {
+        spreadBlend = SPREAD_RGB(blendColor) * coeff;
+        for (i = 0; i < numEntries; i++)
+            dst[i] = UNSPREAD_RGB(BLEND_SPREAD_RGB(SPREAD_RGB(src[i]), coeff, spreadBlend));
+        return;
+    }
+
+    // Coefficients above 16 overflow the channels, blend them one at a time like before
     for (i = 0; i < numEntries; i++)
     {
         u16 index = i + palOffset;
@@ -0,0 +1,209 @@
+// Saves every battle snapshot region, scribbles over the live state and checks
+// that restoring brings every region back byte for byte.
+
+#include <stdlib.h>
+#include <string.h>
+#include "hosttest.h"
+#include "battle.h"
+#include "battle_snapshot.h"
+
+#define RUNS 50
+
+// The battle state battle_snapshot.c copies, normally defined by battle_main.c
+struct BattlePokemon gBattleMons[MAX_BATTLERS_COUNT];
+struct BattleStruct *gBattleStruct;
+u32 gSideStatuses[2];
+struct SideTimer gSideTimers[2];
+u32 gFieldStatuses;
+struct FieldTimer gFieldTimers;
+u16 gBattleWeather;
+u32 gStatuses3[MAX_BATTLERS_COUNT];
+u32 gStatuses4[MAX_BATTLERS_COUNT];
+struct ProtectStruct gProtectStructs[MAX_BATTLERS_COUNT];
+struct DisableStruct gDisableStructs[MAX_BATTLERS_COUNT];
+struct SpecialStatus gSpecialStatuses[MAX_BATTLERS_COUNT];
+struct WishFutureKnock gWishFutureKnock;
+u16 gLastMoves[MAX_BATTLERS_COUNT];
+u16 gLastLandedMoves[MAX_BATTLERS_COUNT];
+u16 gLastHitByType[MAX_BATTLERS_COUNT];
+u16 gLastResultingMoves[MAX_BATTLERS_COUNT];
+u16 gLockedMoves[MAX_BATTLERS_COUNT];
+u8 gLastHitBy[MAX_BATTLERS_COUNT];
+u16 gBattlerPartyIndexes[MAX_BATTLERS_COUNT];
+struct BattleScripting gBattleScripting;
+u32 gHitMarker;
+s32 gBattleMoveDamage;
+u8 gBattleCommunication[BATTLE_COMMUNICATION_ENTRIES_COUNT];
+struct BattleResources *gBattleResources;
+struct Pokemon gPlayerParty[PARTY_SIZE];
+struct Pokemon gEnemyParty[PARTY_SIZE];
+
+// util.c can't be built for the host. Any hash that sees every byte does here.
+u16 CalcCRC16WithTable(const u8 *data, u32 length)
+{
+    u32 i, hash = 0x811C9DC5;
+
+    for (i = 0; i < length; i++)
+        hash = (hash ^ data[i]) * 0x01000193;
+    return hash ^ (hash >> 16);
+}
+
+struct TestRegion
+{
+    void *data;
+    u32 size;
+    void *saved;
+};
+
+static struct TestRegion sRegions[SNAPSHOT_REGIONS_COUNT];
+
+static void SetRegion(u32 regionId, void *data, u32 size)
+{
+    sRegions[regionId].data = data;
+    sRegions[regionId].size = size;
+    sRegions[regionId].saved = malloc(size);
+}
+
+static void SetUpBattleState(void)
+{
+    gBattleStruct = calloc(1, sizeof(*gBattleStruct));
+    gBattleResources = calloc(1, sizeof(*gBattleResources));
+    gBattleResources->flags = calloc(1, sizeof(*gBattleResources->flags));
+    gBattleResources->battleScriptsStack = calloc(1, sizeof(*gBattleResources->battleScriptsStack));
+    gBattleResources->battleCallbackStack = calloc(1, sizeof(*gBattleResources->battleCallbackStack));
+    gBattleResources->battleHistory = calloc(1, sizeof(*gBattleResources->battleHistory));
+
+    SetRegion(SNAPSHOT_REGION_BATTLE_MONS, gBattleMons, sizeof(gBattleMons));
+    SetRegion(SNAPSHOT_REGION_BATTLE_STRUCT, gBattleStruct, sizeof(*gBattleStruct));
+    SetRegion(SNAPSHOT_REGION_SIDE_STATUSES, gSideStatuses, sizeof(gSideStatuses));
+    SetRegion(SNAPSHOT_REGION_SIDE_TIMERS, gSideTimers, sizeof(gSideTimers));
+    SetRegion(SNAPSHOT_REGION_FIELD_STATUSES, &gFieldStatuses, sizeof(gFieldStatuses));
+    SetRegion(SNAPSHOT_REGION_FIELD_TIMERS, &gFieldTimers, sizeof(gFieldTimers));
+    SetRegion(SNAPSHOT_REGION_WEATHER, &gBattleWeather, sizeof(gBattleWeather));
+    SetRegion(SNAPSHOT_REGION_STATUSES3, gStatuses3, sizeof(gStatuses3));
+    SetRegion(SNAPSHOT_REGION_STATUSES4, gStatuses4, sizeof(gStatuses4));
+    SetRegion(SNAPSHOT_REGION_PROTECT_STRUCTS, gProtectStructs, sizeof(gProtectStructs));
+    SetRegion(SNAPSHOT_REGION_DISABLE_STRUCTS, gDisableStructs, sizeof(gDisableStructs));
+    SetRegion(SNAPSHOT_REGION_SPECIAL_STATUSES, gSpecialStatuses, sizeof(gSpecialStatuses));
+    SetRegion(SNAPSHOT_REGION_WISH_FUTURE_KNOCK, &gWishFutureKnock, sizeof(gWishFutureKnock));
+    SetRegion(SNAPSHOT_REGION_LAST_MOVES, gLastMoves, sizeof(gLastMoves));
+    SetRegion(SNAPSHOT_REGION_LAST_LANDED_MOVES, gLastLandedMoves, sizeof(gLastLandedMoves));
+    SetRegion(SNAPSHOT_REGION_LAST_HIT_BY_TYPE, gLastHitByType, sizeof(gLastHitByType));
+    SetRegion(SNAPSHOT_REGION_LAST_RESULTING_MOVES, gLastResultingMoves, sizeof(gLastResultingMoves));
+    SetRegion(SNAPSHOT_REGION_LOCKED_MOVES, gLockedMoves, sizeof(gLockedMoves));
+    SetRegion(SNAPSHOT_REGION_LAST_HIT_BY, gLastHitBy, sizeof(gLastHitBy));
+    SetRegion(SNAPSHOT_REGION_PARTY_INDEXES, gBattlerPartyIndexes, sizeof(gBattlerPartyIndexes));
+    SetRegion(SNAPSHOT_REGION_BATTLE_SCRIPTING, &gBattleScripting, sizeof(gBattleScripting));
+    SetRegion(SNAPSHOT_REGION_HIT_MARKER, &gHitMarker, sizeof(gHitMarker));
+    SetRegion(SNAPSHOT_REGION_MOVE_DAMAGE, &gBattleMoveDamage, sizeof(gBattleMoveDamage));
+    SetRegion(SNAPSHOT_REGION_BATTLE_COMMUNICATION, gBattleCommunication, sizeof(gBattleCommunication));
+    SetRegion(SNAPSHOT_REGION_RESOURCE_FLAGS, gBattleResources->flags, sizeof(*gBattleResources->flags));
+    SetRegion(SNAPSHOT_REGION_SCRIPTS_STACK, gBattleResources->battleScriptsStack, sizeof(*gBattleResources->battleScriptsStack));
+    SetRegion(SNAPSHOT_REGION_CALLBACKS_STACK, gBattleResources->battleCallbackStack, sizeof(*gBattleResources->battleCallbackStack));
+    SetRegion(SNAPSHOT_REGION_BATTLE_HISTORY, gBattleResources->battleHistory, sizeof(*gBattleResources->battleHistory));
+    SetRegion(SNAPSHOT_REGION_PLAYER_PARTY, gPlayerParty, sizeof(gPlayerParty));
+    SetRegion(SNAPSHOT_REGION_ENEMY_PARTY, gEnemyParty, sizeof(gEnemyParty));
+}
+
+static void TearDownBattleState(void)
+{
+    u32 i;
+
+    for (i = 0; i < SNAPSHOT_REGIONS_COUNT; i++)
+        free(sRegions[i].saved);
+    free(gBattleResources->flags);
+    free(gBattleResources->battleScriptsStack);
+    free(gBattleResources->battleCallbackStack);
+    free(gBattleResources->battleHistory);
+    free(gBattleResources);
+    free(gBattleStruct);
+}
+
+// Changes at least one byte of every region in regions
+static void ScribbleRegions(u32 regions)
+{
+    u32 i, j;
+
+    for (i = 0; i < SNAPSHOT_REGIONS_COUNT; i++)
+    {
+        u8 *data = sRegions[i].data;
+        u32 forced;
+
+        if (!(regions & (1 << i)))
+            continue;
+        forced = TestRandom() % sRegions[i].size;
+        for (j = 0; j < sRegions[i].size; j++)
+        {
+            if (j == forced || TestRandom() % 4 == 0)
+                data[j] ^= 1 + TestRandom() % 0xFF;
+        }
+    }
+}
+
+// Returns the regions whose live state differs from what was put aside
+static u32 GetRegionsUnlikeSaved(void)
+{
+    u32 i, differ = 0;
+
+    for (i = 0; i < SNAPSHOT_REGIONS_COUNT; i++)
+    {
+        if (memcmp(sRegions[i].data, sRegions[i].saved, sRegions[i].size) != 0)
+            differ |= 1 << i;
+    }
+    return differ;
+}
+
+static void TestRoundTrip(struct BattleSnapshot *snapshot)
+{
+    u32 i, hash, scribbled, changed;
+
+    ScribbleRegions(SNAPSHOT_ALL_REGIONS);
+    for (i = 0; i < SNAPSHOT_REGIONS_COUNT; i++)
+        memcpy(sRegions[i].saved, sRegions[i].data, sRegions[i].size);
+    hash = CalcBattleStateHash(SNAPSHOT_ALL_REGIONS);
+    SaveBattleSnapshot(snapshot);
+    CHECK(IsBattleSnapshotValid(snapshot), "snapshot isn't valid after saving");
+    CHECK(GetBattleSnapshotChangedRegions(snapshot, SNAPSHOT_ALL_REGIONS) == 0, "regions changed by saving");
+
+    // One region at a time, then random sets of them
+    for (i = 0; i < SNAPSHOT_REGIONS_COUNT * 2; i++)
+    {
+        scribbled = (i < SNAPSHOT_REGIONS_COUNT) ? 1 << i : TestRandom() & SNAPSHOT_ALL_REGIONS;
+        ScribbleRegions(scribbled);
+        changed = GetBattleSnapshotChangedRegions(snapshot, SNAPSHOT_ALL_REGIONS);
+        CHECK(changed == scribbled, "scribbled regions %x, changed regions %x", scribbled, changed);
+        CHECK(CalcBattleStateHash(SNAPSHOT_ALL_REGIONS) != hash || scribbled == 0, "hash missed regions %x", scribbled);
+        RestoreBattleSnapshotRegions(snapshot, changed);
+        CHECK(GetRegionsUnlikeSaved() == 0, "regions %x not restored", GetRegionsUnlikeSaved());
+        CHECK(CalcBattleStateHash(SNAPSHOT_ALL_REGIONS) == hash, "hash differs after restoring %x", changed);
+    }
+
+    // Restoring only some regions leaves the others alone
+    scribbled = SNAPSHOT_ALL_REGIONS;
+    ScribbleRegions(scribbled);
+    RestoreBattleSnapshotRegions(snapshot, SNAPSHOT_AI_ROLLBACK_REGIONS);
+    CHECK(GetRegionsUnlikeSaved() == (scribbled & ~SNAPSHOT_AI_ROLLBACK_REGIONS), "restored regions %x",
+          scribbled & ~GetRegionsUnlikeSaved());
+    RestoreBattleSnapshot(snapshot);
+    CHECK(GetRegionsUnlikeSaved() == 0, "regions %x not restored", GetRegionsUnlikeSaved());
+
+    // A snapshot from another version is never restored
+    snapshot->version++;
+    ScribbleRegions(1 << SNAPSHOT_REGION_BATTLE_MONS);
+    RestoreBattleSnapshot(snapshot);
+    CHECK(GetRegionsUnlikeSaved() == 1 << SNAPSHOT_REGION_BATTLE_MONS, "restored from an invalid snapshot");
+    snapshot->version--;
+    RestoreBattleSnapshot(snapshot);
+}
+
+void Test_BattleSnapshot(void)
+{
+    struct BattleSnapshot *snapshot = calloc(1, sizeof(*snapshot));
+    int run, failures = gTestFailures;
+
+    SetUpBattleState();
+    for (run = 0; run < RUNS && gTestFailures == failures; run++)
+        TestRoundTrip(snapshot);
+    TearDownBattleState();
+    free(snapshot);
+}
@@ -0,0 +1,152 @@
+// Compresses record-like, random and repetitive data with LZCompress and checks
+// that a reference decoder of the BIOS LZ77 format gets every byte back.
+
+#include <stdlib.h>
+#include <string.h>
+#include "hosttest.h"
+#include "compress.h"
+
+#define MAX_SIZE 0x1800
+#define RUNS     300
+
+static s32 sAllocCount;
+static u8 sSource[MAX_SIZE];
+static u8 sCompressed[MAX_SIZE * 2];
+static u8 sDecompressed[MAX_SIZE];
+
+// compress.c allocates from the game heap, which the host heap stands in for.
+void *AllocZeroed(u32 size)
+{
+    sAllocCount++;
+    return calloc(size, 1);
+}
+
+void Free(void *pointer)
+{
+    sAllocCount--;
+    free(pointer);
+}
+
+// What LZDecompressWram does, per GBATEK. Returns the decompressed size, or
+// 0 if the data reads or writes out of bounds.
+static u32 DecompressLZ77(const u8 *src, u32 srcSize, u8 *dest, u32 destSize)
+{
+    u32 size = src[1] | (src[2] << 8) | (src[3] << 16);
+    u32 in = 4;
+    u32 out = 0;
+    u32 len, distance;
+    u8 flags;
+    s32 bit;
+
+    if (srcSize < 4 || src[0] != 0x10 || size > destSize)
+        return 0;
+
+    while (out < size)
+    {
+        if (in >= srcSize)
+            return 0;
+        flags = src[in++];
+        for (bit = 7; bit >= 0 && out < size; bit--)
+        {
+            if (!(flags & (1 << bit)))
+            {
+                if (in >= srcSize)
+                    return 0;
+                dest[out++] = src[in++];
+                continue;
+            }
+            if (in + 2 > srcSize)
+                return 0;
+            len = (src[in] >> 4) + 3;
+            distance = (((src[in] & 0xF) << 8) | src[in + 1]) + 1;
+            in += 2;
+            if (distance > out || out + len > size)
+                return 0;
+            for (; len != 0; len--, out++)
+                dest[out] = dest[out - distance];
+        }
+    }
+
+    return size;
+}
+
+// Like a record mixing record: fixed-size entries, some filled with data that
+// repeats a little, the rest left zero.
+static void FillRecordLike(u8 *dest, u32 size)
+{
+    u32 entrySize = 8 + TestRandom() % 120;
+    u32 fill = TestRandom() % 101;
+    u32 i, j;
+
+    memset(dest, 0, size);
+    for (i = 0; i < size; i += entrySize)
+    {
+        if (TestRandom() % 100 >= fill)
+            continue;
+        for (j = i; j < i + entrySize && j < size; j++)
+            dest[j] = (TestRandom() % 4 == 0) ? 0xFF : TestRandom() % 16;
+    }
+}
+
+static void TestRoundTrip(const u8 *src, u32 size)
+{
+    u32 compressedSize = LZCompress(src, size, sCompressed, sizeof(sCompressed));
+
+    CHECK(compressedSize != 0, "size %u didn't compress", size);
+    CHECK(compressedSize <= sizeof(sCompressed), "size %u compressed to %u", size, compressedSize);
+    memset(sDecompressed, 0xAA, sizeof(sDecompressed));
+    CHECK(DecompressLZ77(sCompressed, compressedSize, sDecompressed, sizeof(sDecompressed)) == size,
+          "size %u didn't decompress", size);
+    CHECK(memcmp(src, sDecompressed, size) == 0, "size %u decompressed to other data", size);
+}
+
+void Test_Compress(void)
+{
+    u32 run, size, i;
+    int failures = gTestFailures;
+
+    for (run = 0; run < RUNS && gTestFailures == failures; run++)
+    {
+        size = 1 + TestRandom() % MAX_SIZE;
+        switch (run % 4)
+        {
+        case 0:
+            memset(sSource, 0, size);
+            break;
+        case 1:
+            for (i = 0; i < size; i++)
+                sSource[i] = TestRandom();
+            break;
+        case 2:
+            for (i = 0; i < size; i++)
+                sSource[i] = i % (1 + run % 23);
+            break;
+        default:
+            FillRecordLike(sSource, size);
+            break;
+        }
+        TestRoundTrip(sSource, size);
+    }
+
+    // Matches at the longest distance and length, and sizes around a flag byte
+    for (size = 1; size <= 40 && gTestFailures == failures; size++)
+    {
+        memset(sSource, 7, size);
+        TestRoundTrip(sSource, size);
+    }
+    for (i = 0; i < MAX_SIZE; i++)
+        sSource[i] = (i < 0x1000) ? TestRandom() : sSource[i - 0x1000];
+    if (gTestFailures == failures)
+        TestRoundTrip(sSource, MAX_SIZE);
+
+    // Output that doesn't fit is refused instead of overrunning dest
+    for (i = 0; i < MAX_SIZE; i++)
+        sSource[i] = TestRandom();
+    memset(sCompressed, 0xAA, sizeof(sCompressed));
+    CHECK(LZCompress(sSource, MAX_SIZE, sCompressed, MAX_SIZE) == 0, "random data fit in its own size");
+    for (i = MAX_SIZE; i < sizeof(sCompressed); i++)
+        CHECK(sCompressed[i] == 0xAA, "wrote past dest at %u", i);
+
+    // The hash table was freed every time
+    CHECK(sAllocCount == 0, "LZCompress leaked %d hash tables", sAllocCount);
+}
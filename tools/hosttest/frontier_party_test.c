@@ -0,0 +1,198 @@
+// Draws parties for every Battle Frontier trainer, checks that they follow the party rules
+// and that every allowed mon is equally likely, and times the draws.
+
+#include <math.h>
+#include <string.h>
+#include <time.h>
+#include "hosttest.h"
+#include "battle_tower.h"
+#include "frontier_party.h"
+#include "random.h"
+#include "constants/battle_frontier.h"
+#include "constants/battle_frontier_mons.h"
+#include "constants/battle_frontier_trainers.h"
+#include "constants/easy_chat.h"
+#include "constants/items.h"
+#include "constants/moves.h"
+#include "constants/trainers.h"
+
+// Trainer names are charmap strings the host can't build, and aren't needed here
+#define _(x) {0}
+#include "../../src/data/battle_frontier/battle_frontier_trainer_mons.h"
+#include "../../src/data/battle_frontier/battle_frontier_trainers.h"
+#include "../../src/data/battle_frontier/battle_frontier_mons.h"
+#undef _
+
+#define PARTY_MONS        4 // Tower doubles, the most mons one trainer brings
+#define DRAWS_PER_MON     64
+#define TIMED_RUNS        200
+
+// Normally set by SetFacilityPtrsGetLevel in battle_tower.c
+const struct FacilityMon *gFacilityTrainerMons = gBattleFrontierMons;
+
+u16 Random(void)
+{
+    return TestRandom() >> 16;
+}
+
+static const u16 sMaxMonIds[] = {FRONTIER_MONS_HIGH_TIER, 0xFFFF};
+
+struct TestParty
+{
+    u16 species[PARTY_SIZE];
+    u16 items[PARTY_SIZE];
+    s32 count;
+};
+
+static void AddToParty(struct TestParty *party, u16 monId)
+{
+    party->species[party->count] = gBattleFrontierMons[monId].species;
+    party->items[party->count] = gBattleFrontierHeldItems[gBattleFrontierMons[monId].itemTableId];
+    party->count++;
+}
+
+// The party rules, written out again independently of frontier_party.c
+static bool32 IsAllowed(u16 monId, u16 maxMonId, const struct TestParty *party)
+{
+    u16 item = gBattleFrontierHeldItems[gBattleFrontierMons[monId].itemTableId];
+    s32 i;
+
+    if (monId > maxMonId)
+        return FALSE;
+    for (i = 0; i < party->count; i++)
+    {
+        if (party->species[i] == gBattleFrontierMons[monId].species)
+            return FALSE;
+        if (item != ITEM_NONE && party->items[i] == item)
+            return FALSE;
+    }
+    return TRUE;
+}
+
+static bool32 IsInSet(const u16 *monSet, u16 monId)
+{
+    for (; *monSet != 0xFFFF; monSet++)
+    {
+        if (*monSet == monId)
+            return TRUE;
+    }
+    return FALSE;
+}
+
+// Every party drawn for every trainer is full and follows the rules
+static void TestPartyRules(void)
+{
+    u32 trainerId, tier, run, i;
+
+    for (trainerId = 0; trainerId < FRONTIER_TRAINERS_COUNT; trainerId++)
+    {
+        const u16 *monSet = gBattleFrontierTrainers[trainerId].monSet;
+
+        for (tier = 0; tier < ARRAY_COUNT(sMaxMonIds); tier++)
+        {
+            for (run = 0; run < 16; run++)
+            {
+                struct TestParty party = {0};
+
+                for (i = 0; i < PARTY_MONS; i++)
+                {
+                    u16 monId = DrawFrontierPartyMon(monSet, sMaxMonIds[tier], party.species, party.items, party.count);
+
+                    CHECK(monId != FRONTIER_MON_NONE, "trainer %u, max mon %u: no mon for slot %u", trainerId, sMaxMonIds[tier], i);
+                    CHECK(IsInSet(monSet, monId), "trainer %u: mon %u isn't in its set", trainerId, monId);
+                    CHECK(IsAllowed(monId, sMaxMonIds[tier], &party), "trainer %u, max mon %u: mon %u breaks the party rules",
+                          trainerId, sMaxMonIds[tier], monId);
+                    AddToParty(&party, monId);
+                }
+            }
+        }
+    }
+}
+
+// With a random part of the party drawn already, each allowed mon of the set comes up
+// about equally often for the next slot, and nothing else ever does
+static void TestDrawDistribution(void)
+{
+    static u32 counts[NUM_FRONTIER_MONS];
+    u32 trainerId, tier, i, draws;
+
+    for (trainerId = 0; trainerId < FRONTIER_TRAINERS_COUNT; trainerId++)
+    {
+        const u16 *monSet = gBattleFrontierTrainers[trainerId].monSet;
+
+        for (tier = 0; tier < ARRAY_COUNT(sMaxMonIds); tier++)
+        {
+            struct TestParty party = {0};
+            u32 allowedCount = 0, partyMons = TestRandom() % PARTY_MONS;
+            double chiSquare = 0, limit;
+
+            for (i = 0; i < partyMons; i++)
+                AddToParty(&party, DrawFrontierPartyMon(monSet, sMaxMonIds[tier], party.species, party.items, party.count));
+            for (i = 0; monSet[i] != 0xFFFF; i++)
+            {
+                if (IsAllowed(monSet[i], sMaxMonIds[tier], &party))
+                    allowedCount++;
+            }
+            if (allowedCount < 2)
+                continue;
+
+            memset(counts, 0, sizeof(counts));
+            draws = allowedCount * DRAWS_PER_MON;
+            for (i = 0; i < draws; i++)
+                counts[DrawFrontierPartyMon(monSet, sMaxMonIds[tier], party.species, party.items, party.count)]++;
+
+            for (i = 0; monSet[i] != 0xFFFF; i++)
+            {
+                if (!IsAllowed(monSet[i], sMaxMonIds[tier], &party))
+                {
+                    CHECK(counts[monSet[i]] == 0, "trainer %u: disallowed mon %u drawn", trainerId, monSet[i]);
+                    continue;
+                }
+                CHECK(counts[monSet[i]] != 0, "trainer %u: allowed mon %u never drawn", trainerId, monSet[i]);
+                chiSquare += (counts[monSet[i]] - DRAWS_PER_MON) * (counts[monSet[i]] - DRAWS_PER_MON) / (double)DRAWS_PER_MON;
+            }
+
+            // Mean allowedCount - 1, six standard deviations above it
+            limit = (allowedCount - 1) + 6 * sqrt(2.0 * (allowedCount - 1));
+            CHECK(chiSquare < limit, "trainer %u, max mon %u: chi-square %.1f over %.1f for %u mons",
+                  trainerId, sMaxMonIds[tier], chiSquare, limit, allowedCount);
+        }
+    }
+}
+
+static void TimePartyDraws(void)
+{
+    u32 trainerId, tier, run, i, parties = 0;
+    clock_t start = clock();
+    double seconds;
+
+    for (run = 0; run < TIMED_RUNS; run++)
+    {
+        for (trainerId = 0; trainerId < FRONTIER_TRAINERS_COUNT; trainerId++)
+        {
+            for (tier = 0; tier < ARRAY_COUNT(sMaxMonIds); tier++)
+            {
+                struct TestParty party = {0};
+
+                for (i = 0; i < PARTY_MONS; i++)
+                    AddToParty(&party, DrawFrontierPartyMon(gBattleFrontierTrainers[trainerId].monSet, sMaxMonIds[tier],
+                                                            party.species, party.items, party.count));
+                parties++;
+            }
+        }
+    }
+
+    seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+    printf("     frontier_party: %u parties of %u in %.3f s, %.0f ns each\n", parties, PARTY_MONS, seconds, seconds * 1e9 / parties);
+}
+
+void Test_FrontierParty(void)
+{
+    int failures = gTestFailures;
+
+    TestPartyRules();
+    if (gTestFailures == failures)
+        TestDrawDistribution();
+    if (gTestFailures == failures)
+        TimePartyDraws();
+}
@@ -0,0 +1,79 @@
+// hosttest - checks game code that doesn't touch the hardware by building it
+// for the host.
+//
+// Usage:
+//   hosttest [test...]
+//
+// Runs the named tests, or all of them, and exits with 1 if any failed.
+// "make check" builds and runs everything.
+
+#include <stdlib.h>
+#include <string.h>
+#include "hosttest.h"
+
+int gTestFailures;
+
+static u32 sTestRandomState = 1;
+
+static const struct
+{
+    const char *name;
+    void (*func)(void);
+} sTests[] =
+{
+    {"battle_snapshot", Test_BattleSnapshot},
+    {"compress", Test_Compress},
+    {"frontier_party", Test_FrontierParty},
+    {"palette_blend", Test_PaletteBlend},
+    {"save_checksum", Test_SaveChecksum},
+    {"storage_sort", Test_StorageSort},
+};
+
+// xorshift32, so that runs are the same on every host
+u32 TestRandom(void)
+{
+    sTestRandomState ^= sTestRandomState << 13;
+    sTestRandomState ^= sTestRandomState >> 17;
+    sTestRandomState ^= sTestRandomState << 5;
+    return sTestRandomState;
+}
+
+void SeedTestRandom(u32 seed)
+{
+    sTestRandomState = seed != 0 ? seed : 1;
+}
+
+static bool32 IsTestSelected(const char *name, int argc, char **argv)
+{
+    int i;
+
+    if (argc < 2)
+        return TRUE;
+    for (i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], name) == 0)
+            return TRUE;
+    }
+    return FALSE;
+}
+
+int main(int argc, char **argv)
+{
+    size_t i;
+    int failedTests = 0;
+
+    for (i = 0; i < sizeof(sTests) / sizeof(sTests[0]); i++)
+    {
+        int failures = gTestFailures;
+
+        if (!IsTestSelected(sTests[i].name, argc, argv))
+            continue;
+        SeedTestRandom(1);
+        sTests[i].func();
+        if (gTestFailures != failures)
+            failedTests++;
+        printf("%s %s\n", gTestFailures != failures ? "FAIL" : "ok  ", sTests[i].name);
+    }
+
+    return failedTests != 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+}
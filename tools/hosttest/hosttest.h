@@ -0,0 +1,32 @@
+#ifndef HOSTTEST_H
+#define HOSTTEST_H
+
+#include <stdio.h>
+
+// Game sources are built with the game's headers, so tests use the game's types too.
+#include "global.h"
+
+extern int gTestFailures;
+
+#define CHECK(cond, format, ...)                                                        \
+do                                                                                      \
+{                                                                                       \
+    if (!(cond))                                                                        \
+    {                                                                                   \
+        fprintf(stderr, "%s:%d: %s: " format "\n", __FILE__, __LINE__, #cond, ##__VA_ARGS__); \
+        gTestFailures++;                                                                \
+        return;                                                                         \
+    }                                                                                   \
+} while (0)
+
+u32 TestRandom(void);
+void SeedTestRandom(u32 seed);
+
+void Test_BattleSnapshot(void);
+void Test_Compress(void);
+void Test_FrontierParty(void);
+void Test_PaletteBlend(void);
+void Test_SaveChecksum(void);
+void Test_StorageSort(void);
+
+#endif // HOSTTEST_H
@@ -0,0 +1,51 @@
+// Checks the packed blend used by BlendPalette and the weather blends against the
+// per-channel formula, for every color, every coefficient from 0 to 16 and a spread
+// of blend colors with each channel at or next to its limits and midpoint.
+
+#include "hosttest.h"
+#include "util.h"
+#include "constants/rgb.h"
+
+static const u8 sBlendChannels[] = {0, 1, 15, 16, 30, 31};
+
+// The formula BlendPalette used before, one channel at a time
+static u16 BlendColorPerChannel(u16 color, u8 coeff, u16 blendColor)
+{
+    s32 r = color & 0x1F, g = (color >> 5) & 0x1F, b = (color >> 10) & 0x1F;
+    s32 rBlend = blendColor & 0x1F, gBlend = (blendColor >> 5) & 0x1F, bBlend = (blendColor >> 10) & 0x1F;
+
+    r += ((rBlend - r) * coeff) >> 4;
+    g += ((gBlend - g) * coeff) >> 4;
+    b += ((bBlend - b) * coeff) >> 4;
+    return r | (g << 5) | (b << 10);
+}
+
+void Test_PaletteBlend(void)
+{
+    u32 r, g, b, color, coeff;
+
+    for (r = 0; r < ARRAY_COUNT(sBlendChannels); r++)
+    {
+        for (g = 0; g < ARRAY_COUNT(sBlendChannels); g++)
+        {
+            for (b = 0; b < ARRAY_COUNT(sBlendChannels); b++)
+            {
+                u16 blendColor = RGB(sBlendChannels[r], sBlendChannels[g], sBlendChannels[b]);
+
+                for (coeff = 0; coeff <= 16; coeff++)
+                {
+                    u32 spreadBlend = SPREAD_RGB(blendColor) * coeff;
+
+                    for (color = 0; color < 0x8000; color++)
+                    {
+                        u16 expected = BlendColorPerChannel(color, coeff, blendColor);
+                        u16 blended = UNSPREAD_RGB(BLEND_SPREAD_RGB(SPREAD_RGB(color), coeff, spreadBlend));
+
+                        CHECK(blended == expected, "color %04X to %04X at %u: %04X, expected %04X",
+                              color, blendColor, coeff, blended, expected);
+                    }
+                }
+            }
+        }
+    }
+}
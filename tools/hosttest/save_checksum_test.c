@@ -0,0 +1,99 @@
+// Checks that CopySaveSectionData copies and checksums a save section exactly like
+// the byte copy and separate CalculateChecksum pass the save paths used before.
+
+#include <string.h>
+#include <time.h>
+#include "hosttest.h"
+#include "pokemon_storage_system.h"
+#include "save.h"
+#include "save_checksum.h"
+
+#define RANDOM_SIZES      500
+#define TIMED_RUNS        20000
+#define FILL_BYTE         0xA5
+
+// Section sizes the save paths write: full sectors, as the Hall of Fame halves are,
+// the tail of PC storage, and a run of small sizes that end on every byte of a word
+static const u16 sSectionSizes[] =
+{
+    SECTOR_DATA_SIZE,
+    sizeof(struct PokemonStorage) % SECTOR_DATA_SIZE,
+    SECTOR_DATA_SIZE - 1,
+    SECTOR_DATA_SIZE - 2,
+    SECTOR_DATA_SIZE - 3,
+    0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13,
+};
+
+static u32 sSrc[sizeof(struct SaveSection) / 4];
+static u32 sDest[sizeof(struct SaveSection) / 4];
+static u32 sExpected[sizeof(struct SaveSection) / 4];
+
+// How HandleWriteSector filled the section before
+static u16 CopySectionBytes(u8 *dest, const u8 *src, u16 size)
+{
+    u16 i;
+
+    for (i = 0; i < size; i++)
+        dest[i] = src[i];
+    return CalculateChecksum(dest, size);
+}
+
+static void TestSection(u16 size, bool32 allFF)
+{
+    u16 checksum, expected;
+    u32 i;
+
+    for (i = 0; i < ARRAY_COUNT(sSrc); i++)
+        sSrc[i] = allFF ? 0xFFFFFFFF : TestRandom();
+    memset(sDest, FILL_BYTE, sizeof(sDest));
+    memset(sExpected, FILL_BYTE, sizeof(sExpected));
+
+    expected = CopySectionBytes((u8 *)sExpected, (const u8 *)sSrc, size);
+    checksum = CopySaveSectionData(sDest, sSrc, size);
+    CHECK(checksum == expected, "size %u%s: checksum %04x, byte copy %04x", size, allFF ? ", all 0xFF" : "", checksum, expected);
+    CHECK(memcmp(sDest, sExpected, sizeof(sDest)) == 0, "size %u%s: copy differs from the byte copy", size, allFF ? ", all 0xFF" : "");
+    CHECK(CalculateChecksum(sDest, size) == checksum, "size %u: checksum of the copy differs", size);
+}
+
+static void TestSectionSizes(void)
+{
+    u32 i;
+
+    for (i = 0; i < ARRAY_COUNT(sSectionSizes); i++)
+    {
+        TestSection(sSectionSizes[i], FALSE);
+        TestSection(sSectionSizes[i], TRUE);
+    }
+    for (i = 0; i < RANDOM_SIZES; i++)
+        TestSection(TestRandom() % (SECTOR_DATA_SIZE + 1), i % 2);
+}
+
+static void TimeSectionCopies(void)
+{
+    clock_t start;
+    double byteSeconds, wordSeconds;
+    volatile u16 sink = 0;
+    u32 run;
+
+    start = clock();
+    for (run = 0; run < TIMED_RUNS; run++)
+        sink += CopySectionBytes((u8 *)sDest, (const u8 *)sSrc, SECTOR_DATA_SIZE);
+    byteSeconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    start = clock();
+    for (run = 0; run < TIMED_RUNS; run++)
+        sink += CopySaveSectionData(sDest, sSrc, SECTOR_DATA_SIZE);
+    wordSeconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    printf("     save_checksum: %u sections, byte copy %.0f ns, word copy %.0f ns each\n",
+           TIMED_RUNS, byteSeconds * 1e9 / TIMED_RUNS, wordSeconds * 1e9 / TIMED_RUNS);
+}
+
+void Test_SaveChecksum(void)
+{
+    int failures = gTestFailures;
+
+    TestSectionSizes();
+    if (gTestFailures == failures)
+        TimeSectionCopies();
+}
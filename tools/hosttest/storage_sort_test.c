@@ -0,0 +1,182 @@
+// Sorts random full PCs and checks that every Pokémon is still there exactly once,
+// and searches them for random values.
+
+#include <string.h>
+#include "hosttest.h"
+#include "pokemon_storage_system.h"
+#include "storage_sort.h"
+#include "constants/items.h"
+
+#define SLOT_COUNT (TOTAL_BOXES_COUNT * IN_BOX_COUNT)
+#define RUNS       2000
+#define SEARCH_RUNS 500
+
+// Stands in for a box Pokémon, id is its original slot
+struct TestMon
+{
+    u16 id;
+    u32 key;
+};
+
+static struct TestMon sSlots[SLOT_COUNT];
+static struct TestMon sTempSlot;
+static u32 sMoves;
+
+static void MoveTestSlot(u16 dst, u16 src)
+{
+    struct TestMon *dstMon = (dst == STORAGE_SORT_TEMP_SLOT) ? &sTempSlot : &sSlots[dst];
+    struct TestMon *srcMon = (src == STORAGE_SORT_TEMP_SLOT) ? &sTempSlot : &sSlots[src];
+
+    *dstMon = *srcMon;
+    sMoves++;
+}
+
+static void TestSortRun(void)
+{
+    static struct StorageSortEntry entries[SLOT_COUNT];
+    static u8 seen[SLOT_COUNT];
+    u16 firstBox = TestRandom() % TOTAL_BOXES_COUNT;
+    u16 lastBox = firstBox + TestRandom() % (TOTAL_BOXES_COUNT - firstBox);
+    u16 first = firstBox * IN_BOX_COUNT;
+    u16 count = (lastBox - firstBox + 1) * IN_BOX_COUNT;
+    u32 keyRange = 1 + TestRandom() % 40; // Small ranges give lots of ties
+    u16 i;
+
+    for (i = 0; i < SLOT_COUNT; i++)
+    {
+        sSlots[i].id = i;
+        sSlots[i].key = TestRandom() % keyRange;
+        if (TestRandom() % 4 == 0)
+            sSlots[i].key = 0xFFFFFFFF; // Empty slot
+    }
+
+    for (i = 0; i < count; i++)
+    {
+        entries[i].key = sSlots[first + i].key;
+        entries[i].slot = first + i;
+    }
+    sMoves = 0;
+    SortStorageEntries(entries, count);
+    ApplyStorageSortOrder(entries, first, count, MoveTestSlot);
+
+    memset(seen, 0, sizeof(seen));
+    for (i = 0; i < SLOT_COUNT; i++)
+    {
+        u16 id = sSlots[i].id;
+
+        CHECK(!seen[id], "mon %u duplicated, boxes %u-%u", id, firstBox, lastBox);
+        seen[id] = TRUE;
+        if (i < first || i >= first + count)
+            CHECK(id == i, "slot %u outside boxes %u-%u changed", i, firstBox, lastBox);
+        else
+            CHECK(entries[i - first].slot == i, "entry %u not applied", i - first);
+        if (i > first && i < first + count)
+        {
+            CHECK(sSlots[i - 1].key <= sSlots[i].key, "slots %u and %u out of order", i - 1, i);
+            if (sSlots[i - 1].key == sSlots[i].key)
+                CHECK(sSlots[i - 1].id < id, "slots %u and %u swapped, sort isn't stable", i - 1, i);
+        }
+    }
+    // Every mon moves at most once, plus two moves through the spare slot per cycle
+    CHECK(sMoves <= count + count / 2 * 2, "%u moves for %u slots", sMoves, count);
+}
+
+// Makes up what reading searchBy from a random Pokémon could give
+static u32 GetRandomMonValue(u8 searchBy)
+{
+    switch (searchBy)
+    {
+    case STORAGE_SORT_SPECIES:
+    case STORAGE_SORT_DEX_NUM:
+    default:
+        return 1 + TestRandom() % 30;
+    case STORAGE_SORT_LEVEL:
+        return 1 + TestRandom() % MAX_LEVEL;
+    case STORAGE_SORT_TYPE:
+        return ((TestRandom() % NUMBER_OF_MON_TYPES) << 8) | (TestRandom() % NUMBER_OF_MON_TYPES);
+    case STORAGE_SORT_ITEM:
+        return (TestRandom() % 3 == 0) ? ITEM_NONE : 1 + TestRandom() % 20;
+    case STORAGE_SORT_NATURE:
+        return TestRandom() % NUM_NATURES;
+    }
+}
+
+// Searches a PC of random values and checks the results against the values themselves
+static void TestSearchRun(void)
+{
+    static struct StorageSortEntry entries[SLOT_COUNT];
+    static u32 values[SLOT_COUNT];
+    static u16 results[SLOT_COUNT];
+    u8 searchBy = TestRandom() % (STORAGE_SORT_NATURE + 1);
+    u16 maxResults = (TestRandom() % 4 == 0) ? 1 + TestRandom() % 10 : SLOT_COUNT;
+    u16 i, value, found, expected = 0;
+    bool32 matches;
+
+    for (i = 0; i < SLOT_COUNT; i++)
+    {
+        values[i] = GetRandomMonValue(searchBy);
+        entries[i].slot = i;
+        switch (TestRandom() % 8)
+        {
+        case 0:
+            entries[i].key = STORAGE_SORT_KEY_EMPTY;
+            break;
+        case 1:
+            entries[i].key = STORAGE_SORT_KEY_EGG;
+            break;
+        default:
+            entries[i].key = GetStorageSortKeyFromValue(values[i], searchBy);
+            break;
+        }
+    }
+
+    // A value some Pokémon have, or one none may have
+    value = values[TestRandom() % SLOT_COUNT];
+    if (searchBy == STORAGE_SORT_TYPE)
+        value = (TestRandom() % 2) ? value >> 8 : value & 0xFF;
+    if (TestRandom() % 8 == 0)
+        value = 500 + TestRandom() % 100;
+
+    found = SearchStorageEntries(entries, SLOT_COUNT, searchBy, value, results, maxResults);
+    CHECK(found <= maxResults, "%u results for at most %u", found, maxResults);
+    for (i = 0; i < SLOT_COUNT; i++)
+    {
+        if (entries[i].key == STORAGE_SORT_KEY_EMPTY || entries[i].key == STORAGE_SORT_KEY_EGG)
+            matches = FALSE;
+        else if (searchBy == STORAGE_SORT_TYPE)
+            matches = (values[i] >> 8) == value || (values[i] & 0xFF) == value;
+        else
+            matches = values[i] == value;
+
+        if (!matches)
+            continue;
+        if (expected == maxResults)
+            break;
+        CHECK(expected < found && results[expected] == i, "search %u for %u: slot %u missing", searchBy, value, i);
+        expected++;
+    }
+    CHECK(found == expected, "search %u for %u: %u results, %u expected", searchBy, value, found, expected);
+}
+
+void Test_StorageSort(void)
+{
+    int run;
+
+    for (run = 0; run < RUNS; run++)
+    {
+        int failures = gTestFailures;
+
+        TestSortRun();
+        if (gTestFailures != failures)
+            return;
+    }
+
+    for (run = 0; run < SEARCH_RUNS; run++)
+    {
+        int failures = gTestFailures;
+
+        TestSearchRun();
+        if (gTestFailures != failures)
+            return;
+    }
+}
@@ -0,0 +1,1662 @@
+// linksim - runs several link endpoints in one process over a simulated cable
+// or wireless adapter, and measures how the link protocol behaves with lag and
+// lost data.
+//
+// Usage:
+//   linksim [options] block <size>
+//   linksim [options] records <size>
+//   linksim [options] recordsizes <size>
+//   linksim [options] keys <frames>
+//
+// Options:
+//   -m sio|rfu   transport (default sio)
+//   -p <n>       number of players, 2-4 (default 2)
+//   -l <frames>  latency. For sio the master only runs a transfer every
+//                <frames> + 1 frames, as a lagging master does. For rfu each
+//                packet takes <frames> frames to arrive, each hop.
+//   -d <percent> data loss. For sio each halfword has this chance of a bit
+//                error, which the checksum catches. For rfu each packet has
+//                this chance to be dropped, each hop.
+//   -s <seed>    random seed (default 1)
+//   -r <runs>    number of runs to average (default 1)
+//   -o           use the original cable block protocol, without
+//                LINK_BATCHED_BLOCKS or LINK_BLOCK_SEND_QUEUE_LIMIT
+//
+// Scenarios:
+//   block     every player sends one block of <size> bytes with SendBlock
+//   records   every player sends <size> bytes in 200 byte rounds the way
+//             record mixing does, with the master requesting each round
+//   recordsizes
+//             every player makes a record of <size> bytes with a random
+//             share of its entries in use (5188 is the Emerald record), and
+//             each run exchanges the records both raw and LZ compressed, as
+//             with LINK_FEATURE_PACKED_RECORDS. Prints the packet sizes and
+//             frames of each, then their distribution over the runs.
+//   keys      every player sends its held keys every frame for <frames>
+//             frames, and the delay until the others see them is reported
+//
+// "make check" runs each scenario on both transports and fails if one doesn't
+// complete.
+//
+// The queues, the command framing and the block protocol follow src/link.c
+// and src/link_rfu_2.c, with the constants taken from their headers. Records
+// are compressed by src/compress.c itself. Hardware timing is reduced to
+// frames: the cable runs one 9 transfer burst (8 halfwords and a checksum) per
+// frame, and the wireless adapter one packet per player per frame, relayed by
+// the parent.
+// The adapter's own retries aren't modelled, so rfu loss stands for packets
+// that were lost even after those.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "global.h"
+#include "compress.h"
+#include "link.h"
+#include "link_rfu.h"
+
+#ifdef _MSC_VER
+
+#define FATAL_ERROR(format, ...)          \
+do                                        \
+{                                         \
+    fprintf(stderr, format, __VA_ARGS__); \
+    exit(1);                              \
+} while (0)
+
+#else
+
+#define FATAL_ERROR(format, ...)            \
+do                                          \
+{                                           \
+    fprintf(stderr, format, ##__VA_ARGS__); \
+    exit(1);                                \
+} while (0)
+
+#endif // _MSC_VER
+
+// Must match src/link_rfu_2.c, which has no names for these
+#define RFUCMD_INIT_BLOCK 0x8800
+#define RFUCMD_CONT_BLOCK 0x8900
+#define RFU_PACKET_LENGTH (CMD_LENGTH - 1)
+#define RFU_BLOCK_CHUNK_SIZE 12
+#define RFU_MAX_BLOCK_CHUNKS 24
+
+// Must match gDecompressionBuffer, which receives cable blocks too big for
+// gBlockRecvBuffer.
+#define LARGE_BLOCK_SIZE 0x4000
+
+// Must match sBlockRequests and BUFFER_CHUNK_SIZE in src/record_mixing.c
+#define RECORDS_CHUNK_SIZE 200
+#define RECORDS_BLOCK_REQ 1
+
+// The BIOS LZ77 format that LZCompress in src/compress.c writes
+#define LZ_MIN_MATCH 3
+
+#define FRAMES_PER_SECOND 59.7275
+#define TIMEOUT_FRAMES (60 * 60 * 10)
+#define MAX_LATENCY 64
+
+enum
+{
+    TRANSPORT_SIO,
+    TRANSPORT_RFU,
+};
+
+enum
+{
+    SCENARIO_BLOCK,
+    SCENARIO_RECORDS,
+    SCENARIO_RECORD_SIZES,
+    SCENARIO_KEYS,
+};
+
+enum
+{
+    RESULT_OK,
+    RESULT_BAD_CHECKSUM,
+    RESULT_QUEUE_FULL,
+    RESULT_BAD_DATA,
+    RESULT_TIMEOUT,
+};
+
+struct Config
+{
+    int transport;
+    int scenario;
+    int numPlayers;
+    int latency;
+    double loss;
+    unsigned seed;
+    int runs;
+    int size;
+    bool original;
+    bool packed;
+};
+
+// The cable side of struct Link in include/link.h
+struct SioLink
+{
+    uint16_t sendQueue[CMD_LENGTH][QUEUE_CAPACITY];
+    int sendPos;
+    int sendCount;
+    uint16_t recvQueue[MAX_LINK_PLAYERS][CMD_LENGTH][QUEUE_CAPACITY];
+    int recvPos;
+    int recvCount;
+    uint16_t checksum;
+    int sendCmdIndex;
+    int recvCmdIndex;
+    bool sendBufferEmpty;
+    bool sendNonzero;
+    bool recvNonzero;
+    bool checksumAvailable;
+    uint16_t sendReg;
+};
+
+struct RfuQueuePacket
+{
+    uint16_t data[RFU_PACKET_LENGTH];
+};
+
+struct RfuFrame
+{
+    uint16_t cmds[MAX_LINK_PLAYERS][RFU_PACKET_LENGTH];
+};
+
+struct RfuLink
+{
+    struct RfuQueuePacket sendQueue[SEND_QUEUE_NUM_SLOTS];
+    int sendPos;
+    int sendCount;
+    struct RfuFrame recvQueue[RECV_QUEUE_NUM_SLOTS];
+    int recvPos;
+    int recvCount;
+    // Packets from the children, only used by the parent
+    struct RfuQueuePacket childQueue[MAX_LINK_PLAYERS][SEND_QUEUE_NUM_SLOTS];
+    int childPos[MAX_LINK_PLAYERS];
+    int childCount[MAX_LINK_PLAYERS];
+};
+
+struct BlockSend
+{
+    bool active;
+    int size;
+    int pos;
+    int count;
+    int next;
+    int delay;
+    const uint8_t *src;
+};
+
+struct BlockRecv
+{
+    int size;
+    int pos;
+    int count;
+    uint32_t receivedFlags;
+    int receiving;
+};
+
+struct Endpoint;
+typedef void (*LinkCallback)(struct Endpoint *);
+
+struct Endpoint
+{
+    int id;
+    uint16_t sendCmd[CMD_LENGTH];
+    uint16_t recvCmds[MAX_LINK_PLAYERS][CMD_LENGTH];
+    bool receivedNothing;
+    LinkCallback callback;
+    struct BlockSend blockSend;
+    struct BlockRecv blockRecv[MAX_LINK_PLAYERS];
+    // Padded for the bytes the last chunk reads past the end of the block
+    uint8_t blockSendBuffer[BLOCK_BUFFER_SIZE + CMD_LENGTH * 2];
+    uint8_t blockRecvBuffer[MAX_LINK_PLAYERS][BLOCK_BUFFER_SIZE];
+    uint8_t largeRecvBuffer[MAX_LINK_PLAYERS][LARGE_BLOCK_SIZE];
+    uint8_t blockReceived;
+    struct SioLink sio;
+    struct RfuLink rfu;
+
+    // Scenario state
+    uint8_t *payload;
+    uint8_t *received[MAX_LINK_PLAYERS];
+    // Packed records: the sent packet, the received ones and the rounds they take
+    uint8_t *packet;
+    uint8_t *receivedPackets[MAX_LINK_PLAYERS];
+    int rounds;
+    int round;
+    int state;
+    bool done;
+};
+
+// A packet on its way through the wireless adapter
+struct RfuFlight
+{
+    int arrival;
+    int from;
+    int to;
+    bool isFrame;
+    struct RfuQueuePacket packet;
+    struct RfuFrame frame;
+};
+
+struct Stats
+{
+    int result;
+    int frames;
+    long payloadBytes;
+    long commands;
+    long transfers;
+    long corrupted;
+    long dropped;
+    long resends;
+    long throttled;
+    int maxSendQueue;
+    int maxRecvQueue;
+    long keyLatencySum;
+    long keyLatencyCount;
+    int keyLatencyMax;
+    int keysLost;
+    int recordFill[MAX_LINK_PLAYERS];
+    int packetSizes[MAX_LINK_PLAYERS];
+    int rounds;
+};
+
+static struct Config sConfig;
+static struct Endpoint *sEndpoints;
+static struct Stats sStats;
+static int sFrame;
+static unsigned long long sRandomState;
+
+static struct RfuFlight *sFlights;
+static int sNumFlights;
+static int sFlightCapacity;
+
+static uint32_t Random32(void)
+{
+    // xorshift64*
+    sRandomState ^= sRandomState >> 12;
+    sRandomState ^= sRandomState << 25;
+    sRandomState ^= sRandomState >> 27;
+    return (uint32_t)((sRandomState * 0x2545F4914F6CDD1DULL) >> 32);
+}
+
+static bool RandomLoss(void)
+{
+    return sConfig.loss > 0 && Random32() < sConfig.loss / 100.0 * 4294967296.0;
+}
+
+static uint8_t PayloadByte(int player, int offset)
+{
+    return (uint8_t)(player * 73 + offset * 31 + (offset >> 8));
+}
+
+// The entries of struct PlayerRecordsEmerald in src/record_mixing.c. Arrays
+// are filled up to each player's share, the other parts always are.
+static const struct
+{
+    int size;
+    int count;
+} sRecordEntries[] =
+{
+    {160, 20}, // secretBases
+    {36, 25},  // tvShows
+    {4, 16},   // pokeNews
+    {64, 1},   // oldMan
+    {8, 5},    // dewfordTrends
+    {120, 1},  // daycareMail
+    {236, 1},  // battleTowerRecord
+    {4, 1},    // giftItem
+    {64, 1},   // lilycoveLady
+    {68, 2},   // apprentices
+    {344, 1},  // hallRecords
+    {16, 1},   // field_1434
+};
+
+// Fills a record of size bytes with entries laid out like sRecordEntries,
+// repeated if it's larger. An entry in use is a rough stand-in for game data:
+// half random bytes, the rest zero or 0xFF padding. Returns the share of
+// array entries in use, in percent.
+static int FillRecord(uint8_t *dest, int size)
+{
+    int fill = Random32() % 101;
+    int offset = 0;
+    int i, j, k;
+
+    memset(dest, 0, size);
+    for (i = 0; offset < size; i = (i + 1) % (int)(sizeof(sRecordEntries) / sizeof(sRecordEntries[0])))
+    {
+        for (j = 0; j < sRecordEntries[i].count && offset < size; j++)
+        {
+            bool used = sRecordEntries[i].count == 1 || j * 100 < fill * sRecordEntries[i].count;
+
+            for (k = 0; k < sRecordEntries[i].size && offset < size; k++, offset++)
+            {
+                uint32_t value = Random32();
+
+                if (!used)
+                    continue;
+                if (value & 1)
+                    dest[offset] = value >> 8;
+                else
+                    dest[offset] = (value & 2) ? 0xFF : 0;
+            }
+        }
+    }
+    return fill;
+}
+
+// src/compress.c allocates from the game heap, which the host heap stands in for.
+void *AllocZeroed(u32 size)
+{
+    void *pointer = calloc(size, 1);
+
+    if (pointer == NULL)
+        FATAL_ERROR("Out of memory\n");
+    return pointer;
+}
+
+void Free(void *pointer)
+{
+    free(pointer);
+}
+
+// What LZDecompressWram does. Returns false if the data is malformed.
+static bool LZDecompress(const uint8_t *in, int srcSize, uint8_t *out, int size)
+{
+    int inPos = 4;
+    int outPos = 0;
+
+    if (srcSize < 4 || in[0] != 0x10 || (in[1] | in[2] << 8 | in[3] << 16) != size)
+        return false;
+
+    while (outPos < size)
+    {
+        if (inPos >= srcSize)
+            return false;
+
+        uint8_t flags = in[inPos++];
+
+        for (int bit = 7; bit >= 0 && outPos < size; bit--)
+        {
+            if (!(flags & (1 << bit)))
+            {
+                if (inPos >= srcSize)
+                    return false;
+                out[outPos++] = in[inPos++];
+                continue;
+            }
+            if (inPos + 2 > srcSize)
+                return false;
+
+            int len = (in[inPos] >> 4) + LZ_MIN_MATCH;
+            int distance = ((in[inPos] & 0xF) << 8 | in[inPos + 1]) + 1;
+
+            inPos += 2;
+            if (distance > outPos || outPos + len > size)
+                return false;
+            for (; len != 0; len--, outPos++)
+                out[outPos] = out[outPos - distance];
+        }
+    }
+    return true;
+}
+
+// Must match PackSentRecord in src/record_mixing.c
+static int GetRecordPacketSize(void)
+{
+    return (4 + sConfig.size + RECORDS_CHUNK_SIZE - 1) / RECORDS_CHUNK_SIZE * RECORDS_CHUNK_SIZE;
+}
+
+static int PackRecord(uint8_t *packet, const uint8_t *record)
+{
+    int size = LZCompress(record, sConfig.size, packet + 4, sConfig.size);
+
+    packet[0] = size;
+    packet[1] = size >> 8;
+    packet[2] = size >> 16;
+    packet[3] = size >> 24;
+    if (size == 0)
+        memcpy(packet + 4, record, sConfig.size);
+    return 4 + (size != 0 ? size : sConfig.size);
+}
+
+static int GetPacketDataSize(const uint8_t *packet)
+{
+    int size = packet[0] | packet[1] << 8 | packet[2] << 16 | packet[3] << 24;
+
+    return (size == 0 || size > sConfig.size) ? sConfig.size : size;
+}
+
+static void NoteQueueDepth(int send, int recv)
+{
+    if (sStats.maxSendQueue < send)
+        sStats.maxSendQueue = send;
+    if (sStats.maxRecvQueue < recv)
+        sStats.maxRecvQueue = recv;
+}
+
+// Cable transport, after EnqueueSendCmd, DequeueRecvCmds, DoRecv and DoSend
+
+static void Sio_EnqueueSendCmd(struct Endpoint *ep)
+{
+    struct SioLink *link = &ep->sio;
+    int i;
+
+    if (link->sendCount < QUEUE_CAPACITY)
+    {
+        int offset = link->sendPos + link->sendCount;
+
+        if (offset >= QUEUE_CAPACITY)
+            offset -= QUEUE_CAPACITY;
+        for (i = 0; i < CMD_LENGTH; i++)
+        {
+            link->sendNonzero |= ep->sendCmd[i] != 0;
+            link->sendQueue[i][offset] = ep->sendCmd[i];
+            ep->sendCmd[i] = 0;
+        }
+    }
+    else
+    {
+        sStats.result = RESULT_QUEUE_FULL;
+    }
+    if (link->sendNonzero)
+    {
+        link->sendCount++;
+        link->sendNonzero = false;
+        sStats.commands++;
+    }
+}
+
+static void Sio_DequeueRecvCmds(struct Endpoint *ep)
+{
+    struct SioLink *link = &ep->sio;
+    int i, j;
+
+    if (link->recvCount == 0)
+    {
+        memset(ep->recvCmds, 0, sizeof(ep->recvCmds));
+        ep->receivedNothing = true;
+    }
+    else
+    {
+        for (i = 0; i < sConfig.numPlayers; i++)
+        {
+            for (j = 0; j < CMD_LENGTH; j++)
+                ep->recvCmds[i][j] = link->recvQueue[i][j][link->recvPos];
+        }
+        link->recvCount--;
+        if (++link->recvPos >= QUEUE_CAPACITY)
+            link->recvPos = 0;
+        ep->receivedNothing = false;
+    }
+}
+
+static void Sio_DoRecv(struct Endpoint *ep, const uint16_t *recv)
+{
+    struct SioLink *link = &ep->sio;
+    int i;
+
+    if (link->sendCmdIndex == 0)
+    {
+        for (i = 0; i < sConfig.numPlayers; i++)
+        {
+            if (link->checksum != recv[i] && link->checksumAvailable)
+                sStats.result = RESULT_BAD_CHECKSUM;
+        }
+        link->checksum = 0;
+        link->checksumAvailable = true;
+    }
+    else
+    {
+        int index = link->recvPos + link->recvCount;
+
+        if (index >= QUEUE_CAPACITY)
+            index -= QUEUE_CAPACITY;
+        if (link->recvCount < QUEUE_CAPACITY)
+        {
+            for (i = 0; i < sConfig.numPlayers; i++)
+            {
+                link->checksum += recv[i];
+                link->recvNonzero |= recv[i] != 0;
+                link->recvQueue[i][link->recvCmdIndex][index] = recv[i];
+            }
+        }
+        else
+        {
+            sStats.result = RESULT_QUEUE_FULL;
+        }
+        link->recvCmdIndex++;
+        if (link->recvCmdIndex == CMD_LENGTH && link->recvNonzero)
+        {
+            link->recvCount++;
+            link->recvNonzero = false;
+        }
+    }
+}
+
+static void Sio_DoSend(struct Endpoint *ep)
+{
+    struct SioLink *link = &ep->sio;
+
+    if (link->sendCmdIndex == CMD_LENGTH)
+    {
+        link->sendReg = link->checksum;
+        if (!link->sendBufferEmpty)
+        {
+            link->sendCount--;
+            if (++link->sendPos >= QUEUE_CAPACITY)
+                link->sendPos = 0;
+        }
+        else
+        {
+            link->sendBufferEmpty = false;
+        }
+    }
+    else
+    {
+        if (!link->sendBufferEmpty && link->sendCount == 0)
+            link->sendBufferEmpty = true;
+        if (link->sendBufferEmpty)
+            link->sendReg = 0;
+        else
+            link->sendReg = link->sendQueue[link->sendCmdIndex][link->sendPos];
+        link->sendCmdIndex++;
+    }
+}
+
+static void Sio_RunBurst(void)
+{
+    int transfer, i, j;
+
+    // One command and its checksum per burst, like LinkVSync and Timer3Intr
+    for (transfer = 0; transfer < CMD_LENGTH + 1; transfer++)
+    {
+        uint16_t bus[MAX_LINK_PLAYERS];
+
+        for (i = 0; i < MAX_LINK_PLAYERS; i++)
+            bus[i] = i < sConfig.numPlayers ? sEndpoints[i].sio.sendReg : 0xFFFF;
+        sStats.transfers++;
+
+        for (i = 0; i < sConfig.numPlayers; i++)
+        {
+            struct Endpoint *ep = &sEndpoints[i];
+            uint16_t recv[MAX_LINK_PLAYERS];
+
+            memcpy(recv, bus, sizeof(recv));
+            for (j = 0; j < sConfig.numPlayers; j++)
+            {
+                if (RandomLoss())
+                {
+                    recv[j] ^= 1 << (Random32() % 16);
+                    sStats.corrupted++;
+                }
+            }
+            Sio_DoRecv(ep, recv);
+            Sio_DoSend(ep);
+            if (ep->sio.recvCmdIndex == CMD_LENGTH)
+            {
+                ep->sio.sendCmdIndex = 0;
+                ep->sio.recvCmdIndex = 0;
+            }
+            NoteQueueDepth(ep->sio.sendCount, ep->sio.recvCount);
+        }
+    }
+}
+
+// Cable blocks, after InitBlockSend, LinkCB_BlockSend and ProcessRecvCmds
+
+static void Sio_BlockSendBegin(struct Endpoint *ep);
+static void Sio_BlockSend(struct Endpoint *ep);
+
+static bool Sio_InitBlockSend(struct Endpoint *ep, const void *src, int size)
+{
+    if (ep->blockSend.active)
+        return false;
+    ep->blockSend.active = true;
+    ep->blockSend.size = size;
+    ep->blockSend.pos = 0;
+    if (size > BLOCK_BUFFER_SIZE)
+    {
+        ep->blockSend.src = src;
+    }
+    else
+    {
+        if (src != ep->blockSendBuffer)
+            memcpy(ep->blockSendBuffer, src, size);
+        ep->blockSend.src = ep->blockSendBuffer;
+    }
+    ep->callback = Sio_BlockSendBegin;
+    if (!sConfig.original)
+    {
+        const uint8_t *data = ep->blockSend.src;
+        int i;
+
+        ep->sendCmd[0] = LINKCMD_INIT_BLOCK_WITH_DATA;
+        ep->sendCmd[1] = size;
+        ep->sendCmd[2] = ep->id + 0x80;
+        for (i = 0; i < CMD_LENGTH - 3; i++)
+            ep->sendCmd[i + 3] = (data[i * 2 + 1] << 8) | data[i * 2];
+        ep->blockSend.pos = (CMD_LENGTH - 3) * 2;
+        ep->callback = Sio_BlockSend;
+        if (ep->blockSend.size <= ep->blockSend.pos)
+        {
+            ep->blockSend.active = false;
+            ep->callback = NULL;
+        }
+        return true;
+    }
+    ep->sendCmd[0] = LINKCMD_INIT_BLOCK;
+    ep->sendCmd[1] = size;
+    ep->sendCmd[2] = ep->id + 0x80;
+    ep->blockSend.delay = 0;
+    return true;
+}
+
+static void Sio_BlockSendBegin(struct Endpoint *ep)
+{
+    if (++ep->blockSend.delay > 2)
+        ep->callback = Sio_BlockSend;
+}
+
+static void Sio_BlockSend(struct Endpoint *ep)
+{
+    const uint8_t *src = ep->blockSend.src;
+    int i;
+
+    if (!sConfig.original && ep->sio.sendCount >= LINK_BLOCK_SEND_QUEUE_LIMIT)
+    {
+        sStats.throttled++;
+        return;
+    }
+    if (ep->sendCmd[0] != 0)
+        return;
+
+    // Like the game, this reads up to 13 bytes past the end of the block.
+    ep->sendCmd[0] = LINKCMD_CONT_BLOCK;
+    for (i = 0; i < CMD_LENGTH - 1; i++)
+        ep->sendCmd[i + 1] = (src[ep->blockSend.pos + i * 2 + 1] << 8) | src[ep->blockSend.pos + i * 2];
+    ep->blockSend.pos += (CMD_LENGTH - 1) * 2;
+    if (ep->blockSend.size <= ep->blockSend.pos)
+    {
+        ep->blockSend.active = false;
+        ep->callback = NULL;
+    }
+}
+
+static void Sio_RecvBlockData(struct Endpoint *ep, int player, const uint16_t *data, int count)
+{
+    struct BlockRecv *blockRecv = &ep->blockRecv[player];
+    uint8_t *dest = blockRecv->size > BLOCK_BUFFER_SIZE ? ep->largeRecvBuffer[player] : ep->blockRecvBuffer[player];
+    int limit = blockRecv->size > BLOCK_BUFFER_SIZE ? LARGE_BLOCK_SIZE : BLOCK_BUFFER_SIZE;
+    int i;
+
+    for (i = 0; i < count; i++)
+    {
+        if (blockRecv->pos + i * 2 + 1 < limit)
+        {
+            dest[blockRecv->pos + i * 2] = data[i];
+            dest[blockRecv->pos + i * 2 + 1] = data[i] >> 8;
+        }
+    }
+    blockRecv->pos += count * 2;
+    if (blockRecv->pos >= blockRecv->size)
+        ep->blockReceived |= 1 << player;
+}
+
+static void Sio_ProcessRecvCmds(struct Endpoint *ep)
+{
+    int i;
+
+    for (i = 0; i < sConfig.numPlayers; i++)
+    {
+        struct BlockRecv *blockRecv = &ep->blockRecv[i];
+        uint16_t *cmd = ep->recvCmds[i];
+
+        switch (cmd[0])
+        {
+        case LINKCMD_INIT_BLOCK:
+            blockRecv->pos = 0;
+            blockRecv->size = cmd[1];
+            break;
+        case LINKCMD_INIT_BLOCK_WITH_DATA:
+            blockRecv->pos = 0;
+            blockRecv->size = cmd[1];
+            Sio_RecvBlockData(ep, i, &cmd[3], CMD_LENGTH - 3);
+            break;
+        case LINKCMD_CONT_BLOCK:
+            Sio_RecvBlockData(ep, i, &cmd[1], CMD_LENGTH - 1);
+            break;
+        case LINKCMD_SEND_BLOCK_REQ:
+            Sio_InitBlockSend(ep, ep->blockSendBuffer, RECORDS_CHUNK_SIZE);
+            break;
+        case LINKCMD_SEND_HELD_KEYS:
+            if (i != ep->id)
+            {
+                int latency = (uint16_t)(sFrame - cmd[1]);
+
+                sStats.keyLatencySum += latency;
+                sStats.keyLatencyCount++;
+                if (sStats.keyLatencyMax < latency)
+                    sStats.keyLatencyMax = latency;
+            }
+            break;
+        }
+    }
+}
+
+// Wireless transport. Children send one packet a frame to the parent, which
+// sends every player's packet for that frame back out to all of them.
+
+static void Rfu_EnqueueSendCmd(struct Endpoint *ep, const uint16_t *cmd)
+{
+    struct RfuLink *link = &ep->rfu;
+    int i;
+
+    for (i = 0; i < RFU_PACKET_LENGTH; i++)
+    {
+        if (cmd[i] != 0)
+            break;
+    }
+    if (i == RFU_PACKET_LENGTH)
+        return;
+    if (link->sendCount >= SEND_QUEUE_NUM_SLOTS)
+    {
+        sStats.result = RESULT_QUEUE_FULL;
+        return;
+    }
+    memcpy(link->sendQueue[(link->sendPos + link->sendCount) % SEND_QUEUE_NUM_SLOTS].data, cmd, sizeof(uint16_t) * RFU_PACKET_LENGTH);
+    link->sendCount++;
+    sStats.commands++;
+}
+
+static bool Rfu_DequeueSendCmd(struct Endpoint *ep, struct RfuQueuePacket *packet)
+{
+    struct RfuLink *link = &ep->rfu;
+
+    if (link->sendCount == 0)
+        return false;
+    *packet = link->sendQueue[link->sendPos];
+    link->sendPos = (link->sendPos + 1) % SEND_QUEUE_NUM_SLOTS;
+    link->sendCount--;
+    return true;
+}
+
+static void Rfu_PushRecvFrame(struct Endpoint *ep, const struct RfuFrame *frame)
+{
+    struct RfuLink *link = &ep->rfu;
+
+    if (link->recvCount >= RECV_QUEUE_NUM_SLOTS)
+    {
+        sStats.result = RESULT_QUEUE_FULL;
+        return;
+    }
+    link->recvQueue[(link->recvPos + link->recvCount) % RECV_QUEUE_NUM_SLOTS] = *frame;
+    link->recvCount++;
+}
+
+static void Rfu_DequeueRecvCmds(struct Endpoint *ep)
+{
+    struct RfuLink *link = &ep->rfu;
+    int i;
+
+    memset(ep->recvCmds, 0, sizeof(ep->recvCmds));
+    if (link->recvCount == 0)
+    {
+        ep->receivedNothing = true;
+        return;
+    }
+    for (i = 0; i < sConfig.numPlayers; i++)
+        memcpy(ep->recvCmds[i], link->recvQueue[link->recvPos].cmds[i], sizeof(uint16_t) * RFU_PACKET_LENGTH);
+    link->recvPos = (link->recvPos + 1) % RECV_QUEUE_NUM_SLOTS;
+    link->recvCount--;
+    ep->receivedNothing = false;
+}
+
+static void Rfu_Send(int from, int to, const struct RfuQueuePacket *packet, const struct RfuFrame *frame)
+{
+    struct RfuFlight *flight;
+
+    if (RandomLoss())
+    {
+        sStats.dropped++;
+        return;
+    }
+    if (sNumFlights == sFlightCapacity)
+    {
+        sFlightCapacity = sFlightCapacity ? sFlightCapacity * 2 : 64;
+        sFlights = realloc(sFlights, sizeof(*sFlights) * sFlightCapacity);
+        if (sFlights == NULL)
+            FATAL_ERROR("Out of memory\n");
+    }
+    flight = &sFlights[sNumFlights++];
+    flight->arrival = sFrame + sConfig.latency;
+    flight->from = from;
+    flight->to = to;
+    flight->isFrame = frame != NULL;
+    if (packet != NULL)
+        flight->packet = *packet;
+    if (frame != NULL)
+        flight->frame = *frame;
+}
+
+static void Rfu_DeliverArrivals(void)
+{
+    int i = 0;
+
+    // Flights are kept in send order, so arrivals stay in order per link.
+    while (i < sNumFlights)
+    {
+        struct RfuFlight *flight = &sFlights[i];
+
+        if (flight->arrival > sFrame)
+        {
+            i++;
+            continue;
+        }
+        if (flight->isFrame)
+        {
+            Rfu_PushRecvFrame(&sEndpoints[flight->to], &flight->frame);
+        }
+        else
+        {
+            struct RfuLink *parent = &sEndpoints[0].rfu;
+            int from = flight->from;
+
+            if (parent->childCount[from] < SEND_QUEUE_NUM_SLOTS)
+            {
+                parent->childQueue[from][(parent->childPos[from] + parent->childCount[from]) % SEND_QUEUE_NUM_SLOTS] = flight->packet;
+                parent->childCount[from]++;
+            }
+            else
+            {
+                sStats.result = RESULT_QUEUE_FULL;
+            }
+        }
+        memmove(flight, flight + 1, sizeof(*flight) * (sNumFlights - i - 1));
+        sNumFlights--;
+    }
+}
+
+static void Rfu_RunFrame(void)
+{
+    struct Endpoint *parent = &sEndpoints[0];
+    struct RfuFrame frame;
+    struct RfuQueuePacket packet;
+    bool nonzero = false;
+    int i;
+
+    Rfu_DeliverArrivals();
+    for (i = 0; i < sConfig.numPlayers; i++)
+        NoteQueueDepth(sEndpoints[i].rfu.sendCount, sEndpoints[i].rfu.recvCount);
+
+    for (i = 1; i < sConfig.numPlayers; i++)
+    {
+        if (Rfu_DequeueSendCmd(&sEndpoints[i], &packet))
+            Rfu_Send(i, 0, &packet, NULL);
+    }
+
+    memset(&frame, 0, sizeof(frame));
+    if (Rfu_DequeueSendCmd(parent, &packet))
+    {
+        memcpy(frame.cmds[0], packet.data, sizeof(packet.data));
+        nonzero = true;
+    }
+    for (i = 1; i < sConfig.numPlayers; i++)
+    {
+        struct RfuLink *link = &parent->rfu;
+
+        if (link->childCount[i] != 0)
+        {
+            memcpy(frame.cmds[i], link->childQueue[i][link->childPos[i]].data, sizeof(packet.data));
+            link->childPos[i] = (link->childPos[i] + 1) % SEND_QUEUE_NUM_SLOTS;
+            link->childCount[i]--;
+            nonzero = true;
+        }
+    }
+    if (nonzero)
+    {
+        Rfu_PushRecvFrame(parent, &frame);
+        for (i = 1; i < sConfig.numPlayers; i++)
+            Rfu_Send(0, i, NULL, &frame);
+    }
+}
+
+// Wireless blocks, after Rfu_InitBlockSend, HandleBlockSend, SendNextBlock,
+// SendLastBlock and HandleSendFailure
+
+static void Rfu_BlockSendHeader(struct Endpoint *ep);
+static void Rfu_BlockSendNext(struct Endpoint *ep);
+static void Rfu_BlockSendLast(struct Endpoint *ep);
+
+static void Rfu_BuildBlockChunk(struct Endpoint *ep, uint16_t *cmd, int chunk)
+{
+    const uint8_t *src = ep->blockSend.src;
+    int i;
+
+    cmd[0] = RFUCMD_CONT_BLOCK | chunk;
+    for (i = 0; i < RFU_PACKET_LENGTH - 1; i++)
+        cmd[i + 1] = (src[chunk * RFU_BLOCK_CHUNK_SIZE + i * 2 + 1] << 8) | src[chunk * RFU_BLOCK_CHUNK_SIZE + i * 2];
+}
+
+static bool Rfu_BlockSendStart(struct Endpoint *ep, const void *src, int size)
+{
+    if (ep->callback != NULL || ep->sendCmd[0] != 0 || ep->blockSend.active)
+        return false;
+    ep->blockSend.active = true;
+    ep->blockSend.size = size;
+    ep->blockSend.count = (size + RFU_BLOCK_CHUNK_SIZE - 1) / RFU_BLOCK_CHUNK_SIZE;
+    ep->blockSend.next = 0;
+    ep->blockSend.delay = 0;
+    if (src != ep->blockSendBuffer)
+        memcpy(ep->blockSendBuffer, src, size);
+    ep->blockSend.src = ep->blockSendBuffer;
+    ep->sendCmd[0] = RFUCMD_INIT_BLOCK;
+    ep->sendCmd[1] = ep->blockSend.count;
+    ep->sendCmd[2] = ep->id + 0x80;
+    ep->callback = Rfu_BlockSendHeader;
+    return true;
+}
+
+static void Rfu_BlockSendHeader(struct Endpoint *ep)
+{
+    if (ep->sendCmd[0] != 0)
+        return;
+    ep->sendCmd[0] = RFUCMD_INIT_BLOCK;
+    ep->sendCmd[1] = ep->blockSend.count;
+    ep->sendCmd[2] = ep->id + 0x80;
+    if (ep->id == 0)
+    {
+        if (++ep->blockSend.delay > 2)
+            ep->callback = Rfu_BlockSendNext;
+    }
+    else if ((ep->recvCmds[ep->id][0] & 0xFF00) == RFUCMD_INIT_BLOCK)
+    {
+        ep->callback = Rfu_BlockSendNext;
+    }
+}
+
+static void Rfu_BlockSendNext(struct Endpoint *ep)
+{
+    Rfu_BuildBlockChunk(ep, ep->sendCmd, ep->blockSend.next);
+    if (++ep->blockSend.next >= ep->blockSend.count)
+    {
+        ep->blockSend.active = false;
+        ep->callback = Rfu_BlockSendLast;
+    }
+}
+
+static void Rfu_BlockSendLast(struct Endpoint *ep)
+{
+    struct BlockRecv *echo = &ep->blockRecv[ep->id];
+    int last = ep->blockSend.count - 1;
+    int i;
+
+    if (ep->id == 0)
+    {
+        ep->callback = NULL;
+        return;
+    }
+    Rfu_BuildBlockChunk(ep, ep->sendCmd, last);
+    if ((ep->recvCmds[ep->id][0] & 0xFF00) == RFUCMD_CONT_BLOCK && (ep->recvCmds[ep->id][0] & 0xFF) == last)
+    {
+        uint32_t all = (1u << ep->blockSend.count) - 1;
+
+        if (echo->receiving == 1 && echo->receivedFlags != all)
+        {
+            // Resend what this child didn't see come back from the parent
+            for (i = 0; i < ep->blockSend.count; i++)
+            {
+                if (!(echo->receivedFlags & (1u << i)))
+                {
+                    uint16_t cmd[RFU_PACKET_LENGTH];
+
+                    Rfu_BuildBlockChunk(ep, cmd, i);
+                    Rfu_EnqueueSendCmd(ep, cmd);
+                    sStats.resends++;
+                }
+            }
+        }
+        else
+        {
+            ep->callback = NULL;
+        }
+    }
+}
+
+static void Rfu_ProcessRecvCmds(struct Endpoint *ep)
+{
+    int i, j;
+
+    for (i = 0; i < sConfig.numPlayers; i++)
+    {
+        struct BlockRecv *blockRecv = &ep->blockRecv[i];
+        uint16_t *cmd = ep->recvCmds[i];
+
+        switch (cmd[0] & 0xFF00)
+        {
+        case RFUCMD_INIT_BLOCK:
+            if (blockRecv->receiving == 0)
+            {
+                blockRecv->count = cmd[1];
+                blockRecv->receivedFlags = 0;
+                blockRecv->receiving = 1;
+                ep->blockReceived &= ~(1 << i);
+            }
+            break;
+        case RFUCMD_CONT_BLOCK:
+            if (blockRecv->receiving == 1)
+            {
+                int chunk = cmd[0] & 0xFF;
+
+                if (chunk >= RFU_MAX_BLOCK_CHUNKS || blockRecv->count > RFU_MAX_BLOCK_CHUNKS)
+                    break;
+                blockRecv->receivedFlags |= 1u << chunk;
+                for (j = 0; j < RFU_PACKET_LENGTH - 1; j++)
+                {
+                    int offset = chunk * RFU_BLOCK_CHUNK_SIZE + j * 2;
+
+                    if (offset + 1 < BLOCK_BUFFER_SIZE)
+                    {
+                        ep->blockRecvBuffer[i][offset] = cmd[j + 1];
+                        ep->blockRecvBuffer[i][offset + 1] = cmd[j + 1] >> 8;
+                    }
+                }
+                if (blockRecv->receivedFlags == (1u << blockRecv->count) - 1)
+                {
+                    blockRecv->receiving = 2;
+                    ep->blockReceived |= 1 << i;
+                }
+            }
+            break;
+        case RFUCMD_SEND_BLOCK_REQ:
+            Rfu_BlockSendStart(ep, ep->blockSendBuffer, RECORDS_CHUNK_SIZE);
+            break;
+        case RFUCMD_SEND_HELD_KEYS:
+            if (i != ep->id)
+            {
+                int latency = (uint16_t)(sFrame - cmd[1]);
+
+                sStats.keyLatencySum += latency;
+                sStats.keyLatencyCount++;
+                if (sStats.keyLatencyMax < latency)
+                    sStats.keyLatencyMax = latency;
+            }
+            break;
+        }
+    }
+}
+
+// Game side, named after the link.c functions they stand for
+
+static bool Game_SendBlock(struct Endpoint *ep, const void *src, int size)
+{
+    if (sConfig.transport == TRANSPORT_RFU)
+        return Rfu_BlockSendStart(ep, src, size);
+    return Sio_InitBlockSend(ep, src, size);
+}
+
+static void Game_SendBlockRequest(struct Endpoint *ep, int type)
+{
+    ep->sendCmd[0] = sConfig.transport == TRANSPORT_RFU ? RFUCMD_SEND_BLOCK_REQ : LINKCMD_SEND_BLOCK_REQ;
+    ep->sendCmd[1] = type;
+}
+
+static void Game_ResetBlockReceivedFlag(struct Endpoint *ep, int player)
+{
+    ep->blockReceived &= ~(1 << player);
+    ep->blockRecv[player].receiving = 0;
+}
+
+static const uint8_t *Game_GetReceivedBlock(struct Endpoint *ep, int player)
+{
+    if (sConfig.transport == TRANSPORT_SIO && ep->blockRecv[player].size > BLOCK_BUFFER_SIZE)
+        return ep->largeRecvBuffer[player];
+    return ep->blockRecvBuffer[player];
+}
+
+static bool HaveAllBlocks(struct Endpoint *ep)
+{
+    return ep->blockReceived == (1 << sConfig.numPlayers) - 1;
+}
+
+// The packed side of Task_SendPacket and Task_CopyReceiveBuffer in
+// src/record_mixing.c
+static void RunPackedRecordsRound(struct Endpoint *ep)
+{
+    int i;
+
+    switch (ep->state)
+    {
+    case 0:
+        memcpy(ep->blockSendBuffer, ep->packet + ep->round * RECORDS_CHUNK_SIZE, RECORDS_CHUNK_SIZE);
+        ep->state++;
+        break;
+    case 1:
+        if (ep->id == 0)
+            Game_SendBlockRequest(ep, RECORDS_BLOCK_REQ);
+        ep->state++;
+        break;
+    case 2:
+        if (!HaveAllBlocks(ep))
+            break;
+        for (i = 0; i < sConfig.numPlayers; i++)
+        {
+            memcpy(ep->receivedPackets[i] + ep->round * RECORDS_CHUNK_SIZE, Game_GetReceivedBlock(ep, i), RECORDS_CHUNK_SIZE);
+            Game_ResetBlockReceivedFlag(ep, i);
+        }
+        // Everyone's first chunk says how long their packet is.
+        if (++ep->round == 1)
+        {
+            for (i = 0; i < sConfig.numPlayers; i++)
+            {
+                int rounds = (4 + GetPacketDataSize(ep->receivedPackets[i]) + RECORDS_CHUNK_SIZE - 1) / RECORDS_CHUNK_SIZE;
+
+                if (ep->rounds < rounds)
+                    ep->rounds = rounds;
+            }
+        }
+        if (ep->round >= ep->rounds)
+        {
+            for (i = 0; i < sConfig.numPlayers; i++)
+            {
+                const uint8_t *packet = ep->receivedPackets[i];
+
+                if (packet[0] == 0 && packet[1] == 0 && packet[2] == 0 && packet[3] == 0)
+                    memcpy(ep->received[i], packet + 4, sConfig.size);
+                else if (!LZDecompress(packet + 4, GetPacketDataSize(packet), ep->received[i], sConfig.size))
+                    memset(ep->received[i], 0, sConfig.size);
+            }
+            ep->done = true;
+        }
+        ep->state = 0;
+        break;
+    }
+}
+
+static void RunScenario(struct Endpoint *ep)
+{
+    int i;
+
+    switch (sConfig.scenario)
+    {
+    case SCENARIO_BLOCK:
+        if (ep->state == 0)
+        {
+            if (Game_SendBlock(ep, ep->payload, sConfig.size))
+                ep->state++;
+        }
+        else if (!ep->done && HaveAllBlocks(ep))
+        {
+            for (i = 0; i < sConfig.numPlayers; i++)
+            {
+                memcpy(ep->received[i], Game_GetReceivedBlock(ep, i), sConfig.size);
+                Game_ResetBlockReceivedFlag(ep, i);
+            }
+            ep->done = true;
+        }
+        break;
+    case SCENARIO_RECORDS:
+    case SCENARIO_RECORD_SIZES:
+    {
+        if (ep->done)
+            break;
+        if (ep->packet != NULL)
+        {
+            RunPackedRecordsRound(ep);
+            break;
+        }
+        switch (ep->state)
+        {
+        case 0:
+            memcpy(ep->blockSendBuffer, ep->payload + ep->round * RECORDS_CHUNK_SIZE, RECORDS_CHUNK_SIZE);
+            ep->state++;
+            break;
+        case 1:
+            if (ep->id == 0)
+                Game_SendBlockRequest(ep, RECORDS_BLOCK_REQ);
+            ep->state++;
+            break;
+        case 2:
+            if (!HaveAllBlocks(ep))
+                break;
+            for (i = 0; i < sConfig.numPlayers; i++)
+            {
+                int offset = ep->round * RECORDS_CHUNK_SIZE;
+                int size = sConfig.size - offset < RECORDS_CHUNK_SIZE ? sConfig.size - offset : RECORDS_CHUNK_SIZE;
+
+                memcpy(ep->received[i] + offset, Game_GetReceivedBlock(ep, i), size);
+                Game_ResetBlockReceivedFlag(ep, i);
+            }
+            if (++ep->round == ep->rounds)
+                ep->done = true;
+            ep->state = 0;
+            break;
+        }
+        break;
+    }
+    case SCENARIO_KEYS:
+        if (ep->state < sConfig.size)
+        {
+            ep->sendCmd[0] = sConfig.transport == TRANSPORT_RFU ? RFUCMD_SEND_HELD_KEYS : LINKCMD_SEND_HELD_KEYS;
+            ep->sendCmd[1] = (uint16_t)sFrame;
+            ep->state++;
+        }
+        else if (ep->state++ > sConfig.size + 4 * (sConfig.latency + 2))
+        {
+            ep->done = true;
+        }
+        break;
+    }
+}
+
+static void RunGameFrame(struct Endpoint *ep)
+{
+    // LinkMain1, then LinkMain2, then the tasks
+    if (sConfig.transport == TRANSPORT_SIO)
+    {
+        Sio_EnqueueSendCmd(ep);
+        Sio_DequeueRecvCmds(ep);
+        memset(ep->sendCmd, 0, sizeof(ep->sendCmd));
+        Sio_ProcessRecvCmds(ep);
+    }
+    else
+    {
+        Rfu_EnqueueSendCmd(ep, ep->sendCmd);
+        Rfu_DequeueRecvCmds(ep);
+        memset(ep->sendCmd, 0, sizeof(ep->sendCmd));
+        Rfu_ProcessRecvCmds(ep);
+    }
+    if (ep->callback != NULL)
+        ep->callback(ep);
+    RunScenario(ep);
+}
+
+static bool AllDone(void)
+{
+    int i;
+
+    for (i = 0; i < sConfig.numPlayers; i++)
+    {
+        if (!sEndpoints[i].done)
+            return false;
+    }
+    return true;
+}
+
+static void VerifyPayloads(void)
+{
+    int i, j, k;
+
+    if (sConfig.scenario == SCENARIO_KEYS)
+    {
+        long expected = (long)sConfig.size * sConfig.numPlayers * (sConfig.numPlayers - 1);
+
+        sStats.keysLost = expected - sStats.keyLatencyCount;
+        return;
+    }
+    for (i = 0; i < sConfig.numPlayers; i++)
+    {
+        for (j = 0; j < sConfig.numPlayers; j++)
+        {
+            for (k = 0; k < sConfig.size; k++)
+            {
+                if (sEndpoints[i].received[j][k] != sEndpoints[j].payload[k])
+                {
+                    sStats.result = RESULT_BAD_DATA;
+                    return;
+                }
+            }
+        }
+    }
+    sStats.payloadBytes = (long)sConfig.size * sConfig.numPlayers;
+}
+
+static void RunOnce(unsigned seed)
+{
+    int i, j;
+
+    memset(&sStats, 0, sizeof(sStats));
+    sRandomState = seed * 0x9E3779B97F4A7C15ULL + 1;
+    sNumFlights = 0;
+    sFrame = 0;
+
+    sEndpoints = calloc(sConfig.numPlayers, sizeof(*sEndpoints));
+    if (sEndpoints == NULL)
+        FATAL_ERROR("Out of memory\n");
+    for (i = 0; i < sConfig.numPlayers; i++)
+    {
+        struct Endpoint *ep = &sEndpoints[i];
+
+        ep->id = i;
+        // Extra room for the bytes read past the end of the last chunk
+        ep->payload = calloc(sConfig.size + RECORDS_CHUNK_SIZE, 1);
+        if (ep->payload == NULL)
+            FATAL_ERROR("Out of memory\n");
+        if (sConfig.scenario == SCENARIO_RECORD_SIZES)
+        {
+            sStats.recordFill[i] = FillRecord(ep->payload, sConfig.size);
+        }
+        else
+        {
+            for (j = 0; j < sConfig.size; j++)
+                ep->payload[j] = PayloadByte(i, j);
+        }
+        for (j = 0; j < sConfig.numPlayers; j++)
+        {
+            ep->received[j] = calloc(sConfig.size + 1, 1);
+            if (ep->received[j] == NULL)
+                FATAL_ERROR("Out of memory\n");
+        }
+
+        if (sConfig.scenario == SCENARIO_RECORDS)
+        {
+            ep->rounds = (sConfig.size + RECORDS_CHUNK_SIZE - 1) / RECORDS_CHUNK_SIZE;
+        }
+        else if (!sConfig.packed)
+        {
+            // sizeof(record) / BUFFER_CHUNK_SIZE + 1, as record mixing does
+            ep->rounds = sConfig.size / RECORDS_CHUNK_SIZE + 1;
+            sStats.packetSizes[i] = sConfig.size;
+        }
+        else
+        {
+            // Updated once the first chunks are in.
+            ep->rounds = 1;
+            ep->packet = calloc(GetRecordPacketSize(), 1);
+            if (ep->packet == NULL)
+                FATAL_ERROR("Out of memory\n");
+            sStats.packetSizes[i] = PackRecord(ep->packet, ep->payload);
+            for (j = 0; j < sConfig.numPlayers; j++)
+            {
+                ep->receivedPackets[j] = calloc(GetRecordPacketSize(), 1);
+                if (ep->receivedPackets[j] == NULL)
+                    FATAL_ERROR("Out of memory\n");
+            }
+        }
+    }
+
+    for (sFrame = 0; sFrame < TIMEOUT_FRAMES; sFrame++)
+    {
+        for (i = 0; i < sConfig.numPlayers; i++)
+            RunGameFrame(&sEndpoints[i]);
+        if (sConfig.transport == TRANSPORT_SIO)
+        {
+            if (sFrame % (sConfig.latency + 1) == 0)
+                Sio_RunBurst();
+        }
+        else
+        {
+            Rfu_RunFrame();
+        }
+        if (sStats.result != RESULT_OK || AllDone())
+            break;
+    }
+    sStats.frames = sFrame + 1;
+    sStats.rounds = sEndpoints[0].rounds;
+    if (sStats.result == RESULT_OK)
+    {
+        if (sFrame == TIMEOUT_FRAMES)
+            sStats.result = RESULT_TIMEOUT;
+        else
+            VerifyPayloads();
+    }
+
+    for (i = 0; i < sConfig.numPlayers; i++)
+    {
+        free(sEndpoints[i].payload);
+        free(sEndpoints[i].packet);
+        for (j = 0; j < sConfig.numPlayers; j++)
+        {
+            free(sEndpoints[i].received[j]);
+            free(sEndpoints[i].receivedPackets[j]);
+        }
+    }
+    free(sEndpoints);
+    sEndpoints = NULL;
+}
+
+static const char *GetResultName(int result)
+{
+    switch (result)
+    {
+    case RESULT_OK:
+        return "ok";
+    case RESULT_BAD_CHECKSUM:
+        return "link error (bad checksum)";
+    case RESULT_QUEUE_FULL:
+        return "link error (queue full)";
+    case RESULT_BAD_DATA:
+        return "received data does not match";
+    case RESULT_TIMEOUT:
+        return "stalled";
+    default:
+        return "unknown";
+    }
+}
+
+static void PrintStats(int run, const struct Stats *stats)
+{
+    double seconds = stats->frames / FRAMES_PER_SECOND;
+
+    printf("run %d: %s after %d frames (%.2f s)\n", run, GetResultName(stats->result), stats->frames, seconds);
+    if (stats->result != RESULT_OK)
+        return;
+    if (sConfig.scenario == SCENARIO_KEYS)
+    {
+        printf("  key latency: avg %.2f frames, max %d frames, %d of %ld lost\n",
+               stats->keyLatencyCount ? (double)stats->keyLatencySum / stats->keyLatencyCount : 0.0,
+               stats->keyLatencyMax, stats->keysLost,
+               stats->keyLatencyCount + stats->keysLost);
+    }
+    else
+    {
+        printf("  %ld payload bytes, %.1f bytes/s per player\n",
+               stats->payloadBytes, stats->payloadBytes / sConfig.numPlayers / seconds);
+    }
+    printf("  %ld commands queued, max send queue %d, max recv queue %d\n",
+           stats->commands, stats->maxSendQueue, stats->maxRecvQueue);
+    if (sConfig.transport == TRANSPORT_SIO)
+        printf("  %ld transfers, %ld halfwords corrupted, %ld block frames throttled\n", stats->transfers, stats->corrupted, stats->throttled);
+    else
+        printf("  %ld packets dropped, %ld chunks resent\n", stats->dropped, stats->resends);
+}
+
+static int CompareInts(const void *a, const void *b)
+{
+    return *(const int *)a - *(const int *)b;
+}
+
+// Exchanges the records of each run raw, then packed.
+static int RunRecordSizes(void)
+{
+    int *sizes = malloc(sizeof(*sizes) * sConfig.runs * sConfig.numPlayers);
+    int numSizes = 0;
+    int okRuns = 0;
+    double rawFrames = 0, packedFrames = 0;
+    int run, i;
+
+    if (sizes == NULL)
+        FATAL_ERROR("Out of memory\n");
+
+    for (run = 0; run < sConfig.runs; run++)
+    {
+        struct Stats raw;
+
+        sConfig.packed = false;
+        RunOnce(sConfig.seed + run);
+        raw = sStats;
+        sConfig.packed = true;
+        RunOnce(sConfig.seed + run);
+
+        printf("run %d: packets", run);
+        for (i = 0; i < sConfig.numPlayers; i++)
+            printf(" %d (%d%% full)", sStats.packetSizes[i], sStats.recordFill[i]);
+        printf(", %d -> %d rounds, %d -> %d frames", raw.rounds, sStats.rounds, raw.frames, sStats.frames);
+        if (raw.result != RESULT_OK || sStats.result != RESULT_OK)
+        {
+            printf(", %s, %s\n", GetResultName(raw.result), GetResultName(sStats.result));
+            continue;
+        }
+        printf("\n");
+        okRuns++;
+        rawFrames += raw.frames;
+        packedFrames += sStats.frames;
+        for (i = 0; i < sConfig.numPlayers; i++)
+            sizes[numSizes++] = sStats.packetSizes[i];
+    }
+
+    if (numSizes != 0)
+    {
+        qsort(sizes, numSizes, sizeof(*sizes), CompareInts);
+        printf("packet size of a %d byte record: min %d, median %d, 90th percentile %d, max %d\n",
+               sConfig.size, sizes[0], sizes[numSizes / 2], sizes[numSizes * 9 / 10], sizes[numSizes - 1]);
+    }
+    printf("%d of %d runs ok", okRuns, sConfig.runs);
+    if (okRuns != 0)
+        printf(", %.1f frames raw and %.1f packed on average", rawFrames / okRuns, packedFrames / okRuns);
+    printf("\n");
+
+    free(sizes);
+    return okRuns == sConfig.runs ? 0 : 1;
+}
+
+static void Usage(void)
+{
+    fprintf(stderr,
+            "Usage: linksim [options] block <size>\n"
+            "       linksim [options] records <size>\n"
+            "       linksim [options] recordsizes <size>\n"
+            "       linksim [options] keys <frames>\n"
+            "Options: -m sio|rfu  -p <players>  -l <latency frames>\n"
+            "         -d <loss percent>  -s <seed>  -r <runs>  -o\n");
+    exit(1);
+}
+
+static int ParseInt(const char *string, int min, int max)
+{
+    char *end;
+    long value = strtol(string, &end, 0);
+
+    if (*string == '\0' || *end != '\0' || value < min || value > max)
+        FATAL_ERROR("Expected a number from %d to %d, got \"%s\"\n", min, max, string);
+    return value;
+}
+
+int main(int argc, char **argv)
+{
+    int arg;
+    int run;
+    int okRuns = 0;
+    double totalFrames = 0;
+
+    sConfig.transport = TRANSPORT_SIO;
+    sConfig.numPlayers = 2;
+    sConfig.seed = 1;
+    sConfig.runs = 1;
+
+    arg = 1;
+    while (arg < argc && argv[arg][0] == '-')
+    {
+        const char *option = argv[arg++];
+
+        if (strcmp(option, "-o") == 0)
+        {
+            sConfig.original = true;
+            continue;
+        }
+        if (arg >= argc)
+            Usage();
+        switch (option[1])
+        {
+        case 'm':
+            if (strcmp(argv[arg], "sio") == 0)
+                sConfig.transport = TRANSPORT_SIO;
+            else if (strcmp(argv[arg], "rfu") == 0)
+                sConfig.transport = TRANSPORT_RFU;
+            else
+                Usage();
+            break;
+        case 'p':
+            sConfig.numPlayers = ParseInt(argv[arg], 2, MAX_LINK_PLAYERS);
+            break;
+        case 'l':
+            sConfig.latency = ParseInt(argv[arg], 0, MAX_LATENCY);
+            break;
+        case 'd':
+            sConfig.loss = atof(argv[arg]);
+            if (sConfig.loss < 0 || sConfig.loss > 100)
+                FATAL_ERROR("Loss must be a percentage\n");
+            break;
+        case 's':
+            sConfig.seed = ParseInt(argv[arg], 0, 0x7FFFFFFF);
+            break;
+        case 'r':
+            sConfig.runs = ParseInt(argv[arg], 1, 100000);
+            break;
+        default:
+            Usage();
+        }
+        arg++;
+    }
+    if (argc - arg != 2)
+        Usage();
+
+    if (strcmp(argv[arg], "block") == 0)
+    {
+        sConfig.scenario = SCENARIO_BLOCK;
+        sConfig.size = ParseInt(argv[arg + 1], 1, sConfig.transport == TRANSPORT_RFU ? BLOCK_BUFFER_SIZE : LARGE_BLOCK_SIZE);
+    }
+    else if (strcmp(argv[arg], "records") == 0)
+    {
+        sConfig.scenario = SCENARIO_RECORDS;
+        sConfig.size = ParseInt(argv[arg + 1], 1, 0x10000);
+    }
+    else if (strcmp(argv[arg], "recordsizes") == 0)
+    {
+        sConfig.scenario = SCENARIO_RECORD_SIZES;
+        sConfig.size = ParseInt(argv[arg + 1], 1, 0xFFFF);
+    }
+    else if (strcmp(argv[arg], "keys") == 0)
+    {
+        sConfig.scenario = SCENARIO_KEYS;
+        sConfig.size = ParseInt(argv[arg + 1], 1, 0x8000);
+    }
+    else
+    {
+        Usage();
+    }
+
+    printf("%s, %d players, latency %d, loss %g%%\n",
+           sConfig.transport == TRANSPORT_RFU ? "wireless" : "cable",
+           sConfig.numPlayers, sConfig.latency, sConfig.loss);
+    if (sConfig.scenario == SCENARIO_RECORD_SIZES)
+    {
+        int result = RunRecordSizes();
+
+        free(sFlights);
+        return result;
+    }
+    for (run = 0; run < sConfig.runs; run++)
+    {
+        RunOnce(sConfig.seed + run);
+        PrintStats(run, &sStats);
+        if (sStats.result == RESULT_OK)
+        {
+            okRuns++;
+            totalFrames += sStats.frames;
+        }
+    }
+    if (sConfig.runs > 1)
+    {
+        printf("%d of %d runs ok", okRuns, sConfig.runs);
+        if (okRuns != 0)
+            printf(", %.1f frames on average", totalFrames / okRuns);
+        printf("\n");
+    }
+
+    free(sFlights);
+    return okRuns == sConfig.runs ? 0 : 1;
+}
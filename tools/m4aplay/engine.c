@@ -0,0 +1,1650 @@
+// The sequencer side of the m4a engine: the music players, the track commands,
+// note allocation and the CGB channels, following src/m4a.c and src/m4a_1.s.
+// The GB sound channels are a plain model of the hardware, enough to hear
+// what m4a plays on them; sweep and wave RAM banking aren't modelled.
+
+#include <stddef.h>
+#include <string.h>
+#include "m4aplay.h"
+
+// Must match src/m4a_tables.c
+static const uint32_t sFreqTable[] = {
+    2147483648u, 2275179671u, 2410468894u, 2553802834u,
+    2705659852u, 2866546760u, 3037000500u, 3217589947u,
+    3408917802u, 3611622603u, 3826380858u, 4053909305u,
+};
+
+static const int16_t sCgbFreqTable[] = {
+    -2004, -1891, -1785, -1685, -1591, -1501,
+    -1417, -1337, -1262, -1192, -1125, -1062,
+};
+
+static const uint8_t sNoiseTable[] = {
+    0xD7, 0xD6, 0xD5, 0xD4, 0xC7, 0xC6, 0xC5, 0xC4,
+    0xB7, 0xB6, 0xB5, 0xB4, 0xA7, 0xA6, 0xA5, 0xA4,
+    0x97, 0x96, 0x95, 0x94, 0x87, 0x86, 0x85, 0x84,
+    0x77, 0x76, 0x75, 0x74, 0x67, 0x66, 0x65, 0x64,
+    0x57, 0x56, 0x55, 0x54, 0x47, 0x46, 0x45, 0x44,
+    0x37, 0x36, 0x35, 0x34, 0x27, 0x26, 0x25, 0x24,
+    0x17, 0x16, 0x15, 0x14, 0x07, 0x06, 0x05, 0x04,
+    0x03, 0x02, 0x01, 0x00,
+};
+
+static const uint8_t sCgb3Vol[] = {
+    0x00, 0x00, 0x60, 0x60, 0x60, 0x60, 0x40, 0x40,
+    0x40, 0x40, 0x80, 0x80, 0x80, 0x80, 0x20, 0x20,
+};
+
+static const uint8_t sClockTable[] = {
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+    0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F,
+    0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17,
+    0x18, 0x1C, 0x1E, 0x20, 0x24, 0x28, 0x2A, 0x2C,
+    0x30, 0x34, 0x36, 0x38, 0x3C, 0x40, 0x42, 0x44,
+    0x48, 0x4C, 0x4E, 0x50, 0x54, 0x58, 0x5A, 0x5C,
+    0x60,
+};
+
+const uint16_t gPcmSamplesPerVBlankTable[] = {
+    96, 132, 176, 224, 264, 304, 352, 448, 528, 608, 672, 704,
+};
+
+// Must match include/gba/m4a_internal.h
+#define MPT_FLG_VOLSET 0x01
+#define MPT_FLG_VOLCHG 0x03
+#define MPT_FLG_PITSET 0x04
+#define MPT_FLG_PITCHG 0x0C
+#define MPT_FLG_START  0x40
+#define MPT_FLG_EXIST  0x80
+
+#define MUSICPLAYER_STATUS_PAUSE 0x80000000
+
+// Must match sound/MPlayDef.s
+#define C_V   0x40
+#define GOTO  0xB2
+#define TUNE  0xC8
+#define VOICE 0xBD
+#define VOL   0xBE
+#define PAN   0xBF
+#define XCMD  0xCD
+#define xRELE 0x07
+#define EOT   0xCE
+#define TIE   0xCF
+#define FINE  0xB1
+
+// Must match sound/music_player_table.inc and MAX_POKEMON_CRIES
+enum
+{
+    PLAYER_BGM,
+    PLAYER_SE1,
+    PLAYER_SE2,
+    PLAYER_SE3,
+    PLAYER_CRY1,
+    PLAYER_CRY2,
+    NUM_PLAYERS,
+};
+
+static const uint8_t sPlayerTrackCounts[NUM_PLAYERS] = { 16, 3, 11, 1, 2, 2 };
+
+// Must match src/sound.c (PlayCryInternal with mode 0) and CRY_VOLUME
+#define CRY_LENGTH  140
+#define CRY_PITCH   15360
+#define CRY_VOLUME  120
+#define CRY_PRIORITY 10
+#define CRY_BGM_VOLUME 85
+
+// GB sound registers, as offsets from REG_NR10
+#define NR10 0x00
+#define NR11 0x02
+#define NR12 0x03
+#define NR13 0x04
+#define NR14 0x05
+#define NR21 0x08
+#define NR22 0x09
+#define NR23 0x0C
+#define NR24 0x0D
+#define NR30 0x10
+#define NR31 0x12
+#define NR32 0x13
+#define NR33 0x14
+#define NR34 0x15
+#define NR41 0x18
+#define NR42 0x19
+#define NR43 0x1C
+#define NR44 0x1D
+#define NR50 0x20
+#define NR51 0x21
+#define NUM_APU_REGS 0x30
+
+struct PsgChannel
+{
+    bool on;
+    uint8_t volume;
+    uint32_t envelopeCounter;
+    uint32_t lengthCounter;
+    uint32_t phase;
+    uint32_t noiseClock;
+    uint16_t lfsr;
+};
+
+struct SoundInfo gSoundInfo;
+
+static struct MusicPlayerInfo sPlayers[NUM_PLAYERS];
+static struct MusicPlayerTrack sTracks[16 + 3 + 11 + 1 + 2 + 2];
+static uint8_t sMemAccArea[0x100];
+static uint32_t sCrySongs[2];
+static bool sBgmDucked;
+
+static uint8_t sApuRegs[NUM_APU_REGS];
+static uint8_t sWaveRam[16];
+static struct PsgChannel sPsg[4];
+
+typedef void (*PlyFunc)(struct MusicPlayerInfo *, struct MusicPlayerTrack *);
+
+static uint32_t Umul3232H32(uint32_t a, uint32_t b)
+{
+    return (uint32_t)(((uint64_t)a * b) >> 32);
+}
+
+static uint8_t ReadCmdByte(struct MusicPlayerTrack *track)
+{
+    return RomRead8(track->cmdPtr++);
+}
+
+static uint32_t MidiKeyToFreq(uint32_t wav, uint8_t key, uint8_t fineAdjust)
+{
+    uint32_t fineAdjustShifted = (uint32_t)fineAdjust << 24;
+    uint32_t val1, val2, scale;
+
+    if (key > 178)
+    {
+        key = 178;
+        fineAdjustShifted = 255u << 24;
+    }
+
+    // gScaleTable in src/m4a_tables.c
+    scale = ((0xE - key / 12) << 4) | (key % 12);
+    val1 = sFreqTable[scale & 0xF] >> (scale >> 4);
+    key++;
+    scale = ((0xE - key / 12) << 4) | (key % 12);
+    val2 = sFreqTable[scale & 0xF] >> (scale >> 4);
+
+    return Umul3232H32(RomRead32(wav + 4), val1 + Umul3232H32(val2 - val1, fineAdjustShifted));
+}
+
+static uint32_t MidiKeyToCgbFreq(uint8_t chanNum, uint8_t key, uint8_t fineAdjust)
+{
+    uint32_t val1, val2, scale;
+
+    if (chanNum == 4)
+    {
+        if (key <= 20)
+        {
+            key = 0;
+        }
+        else
+        {
+            key -= 21;
+            if (key > 59)
+                key = 59;
+        }
+        return sNoiseTable[key];
+    }
+
+    if (key <= 35)
+    {
+        fineAdjust = 0;
+        key = 0;
+    }
+    else
+    {
+        key -= 36;
+        if (key > 130)
+        {
+            key = 130;
+            fineAdjust = 255;
+        }
+    }
+
+    // gCgbScaleTable in src/m4a_tables.c
+    scale = ((key / 12) << 4) | (key % 12);
+    val1 = sCgbFreqTable[scale & 0xF] >> (scale >> 4);
+    key++;
+    scale = ((key / 12) << 4) | (key % 12);
+    val2 = sCgbFreqTable[scale & 0xF] >> (scale >> 4);
+
+    return val1 + ((fineAdjust * (val2 - val1)) >> 8) + 2048;
+}
+
+// The GB sound hardware
+
+static uint32_t PsgSamples(uint32_t units, uint32_t perSecond)
+{
+    return (uint32_t)((uint64_t)units * gSoundInfo.pcmFreq / perSecond);
+}
+
+static void PsgTrigger(int ch)
+{
+    struct PsgChannel *psg = &sPsg[ch - 1];
+    static const uint8_t nrx2[] = { NR12, NR22, 0, NR42 };
+
+    psg->on = true;
+    if (psg->lengthCounter == 0)
+        psg->lengthCounter = PsgSamples(ch == 3 ? 256 : 64, 256);
+    if (ch == 3)
+    {
+        psg->on = (sApuRegs[NR30] & 0x80) != 0;
+        psg->phase = 0;
+        return;
+    }
+    psg->volume = sApuRegs[nrx2[ch - 1]] >> 4;
+    psg->envelopeCounter = PsgSamples(sApuRegs[nrx2[ch - 1]] & 7, 64);
+    if ((sApuRegs[nrx2[ch - 1]] & 0xF8) == 0)
+        psg->on = false;
+    if (ch == 4)
+        psg->lfsr = 0x7FFF;
+}
+
+static void ApuWrite(int reg, uint8_t value)
+{
+    sApuRegs[reg] = value;
+    switch (reg)
+    {
+    case NR11:
+    case NR21:
+    case NR41:
+        sPsg[reg / 8].lengthCounter = PsgSamples(64 - (value & 0x3F), 256);
+        break;
+    case NR31:
+        sPsg[2].lengthCounter = PsgSamples(256 - value, 256);
+        break;
+    case NR30:
+        if (!(value & 0x80))
+            sPsg[2].on = false;
+        break;
+    case NR14:
+    case NR24:
+    case NR34:
+    case NR44:
+        if (value & 0x80)
+            PsgTrigger(reg / 8 + 1);
+        break;
+    }
+}
+
+static int PsgSample(int ch)
+{
+    struct PsgChannel *psg = &sPsg[ch - 1];
+    static const uint8_t nrx2[] = { NR12, NR22, 0, NR42 };
+    uint32_t rate = gSoundInfo.pcmFreq;
+    uint32_t freq;
+    int sample;
+
+    if (!psg->on)
+        return 0;
+
+    switch (ch)
+    {
+    case 1:
+    case 2:
+    {
+        static const uint8_t duty[] = { 1, 2, 4, 6 };
+        int base = (ch - 1) * 8;
+
+        freq = sApuRegs[base + NR13] | ((sApuRegs[base + NR14] & 7) << 8);
+        psg->phase += (uint32_t)(((uint64_t)131072 << 32) / (2048 - freq) / rate);
+        sample = (psg->phase >> 29) < duty[sApuRegs[base + NR11] >> 6] ? psg->volume : -psg->volume;
+        break;
+    }
+    case 3:
+    {
+        uint8_t index, level;
+
+        freq = sApuRegs[NR33] | ((sApuRegs[NR34] & 7) << 8);
+        psg->phase += (uint32_t)(((uint64_t)65536 << 32) / (2048 - freq) / rate);
+        index = psg->phase >> 27;
+        level = (index & 1) ? sWaveRam[index / 2] & 0xF : sWaveRam[index / 2] >> 4;
+        sample = level * 2 - 15;
+        if (sApuRegs[NR32] & 0x80)
+            sample = sample * 3 / 4;
+        else if (((sApuRegs[NR32] >> 5) & 3) == 0)
+            sample = 0;
+        else
+            sample >>= ((sApuRegs[NR32] >> 5) & 3) - 1;
+        break;
+    }
+    default:
+    {
+        uint8_t nr43 = sApuRegs[NR43];
+        uint32_t clock = ((uint64_t)524288 << 17) / ((nr43 & 7) ? (nr43 & 7) * 2 : 1) >> (nr43 >> 4);
+
+        // noiseClock counts LFSR steps in 1/65536ths
+        psg->noiseClock += (uint32_t)((uint64_t)clock / rate);
+        for (int steps = 0; psg->noiseClock >= 0x10000 && steps < 256; steps++)
+        {
+            uint16_t bit = (psg->lfsr ^ (psg->lfsr >> 1)) & 1;
+
+            psg->lfsr = (psg->lfsr >> 1) | (bit << 14);
+            if (nr43 & 8)
+                psg->lfsr = (psg->lfsr & ~0x40) | (bit << 6);
+            psg->noiseClock -= 0x10000;
+        }
+        psg->noiseClock &= 0xFFFF;
+        sample = (psg->lfsr & 1) ? -psg->volume : psg->volume;
+        break;
+    }
+    }
+
+    if (ch != 3 && (sApuRegs[nrx2[ch - 1]] & 7)
+     && (psg->envelopeCounter == 0 || --psg->envelopeCounter == 0))
+    {
+        psg->envelopeCounter = PsgSamples(sApuRegs[nrx2[ch - 1]] & 7, 64);
+        if ((sApuRegs[nrx2[ch - 1]] & 8) && psg->volume < 15)
+            psg->volume++;
+        else if (!(sApuRegs[nrx2[ch - 1]] & 8) && psg->volume > 0)
+            psg->volume--;
+    }
+    if ((sApuRegs[(ch - 1) * 8 + NR14] & 0x40) && psg->lengthCounter && --psg->lengthCounter == 0)
+        psg->on = false;
+
+    return sample;
+}
+
+// Channel chains
+
+static void ClearChain(struct SoundChannel *chan)
+{
+    struct MusicPlayerTrack *track = chan->track;
+
+    if (track == NULL)
+        return;
+    if (chan->next)
+        chan->next->prev = chan->prev;
+    if (chan->prev)
+        chan->prev->next = chan->next;
+    else
+        track->chan = chan->next;
+    chan->track = NULL;
+}
+
+static void CgbOscOff(uint8_t chanNum)
+{
+    switch (chanNum)
+    {
+    case 1:
+        ApuWrite(NR12, 8);
+        ApuWrite(NR14, 0x80);
+        break;
+    case 2:
+        ApuWrite(NR22, 8);
+        ApuWrite(NR24, 0x80);
+        break;
+    case 3:
+        ApuWrite(NR30, 0);
+        break;
+    default:
+        ApuWrite(NR42, 8);
+        ApuWrite(NR44, 0x80);
+        break;
+    }
+}
+
+static void TrackStop(struct MusicPlayerTrack *track)
+{
+    if (!(track->flags & MPT_FLG_EXIST))
+        return;
+
+    for (struct SoundChannel *chan = track->chan; chan != NULL; chan = chan->next)
+    {
+        if (chan->statusFlags)
+        {
+            if (chan->type & TONEDATA_TYPE_CGB)
+                CgbOscOff(chan->type & TONEDATA_TYPE_CGB);
+            chan->statusFlags = 0;
+        }
+        chan->track = NULL;
+    }
+    track->chan = NULL;
+}
+
+static void TrkVolPitSet(struct MusicPlayerTrack *track)
+{
+    if (track->flags & MPT_FLG_VOLSET)
+    {
+        int32_t x, y;
+
+        x = (uint32_t)(track->vol * track->volX) >> 5;
+        if (track->modT == 1)
+            x = (uint32_t)(x * (track->modM + 128)) >> 7;
+
+        y = 2 * track->pan + track->panX;
+        if (track->modT == 2)
+            y += track->modM;
+        if (y < -128)
+            y = -128;
+        else if (y > 127)
+            y = 127;
+
+        track->volMR = (uint32_t)((y + 128) * x) >> 8;
+        track->volML = (uint32_t)((127 - y) * x) >> 8;
+    }
+
+    if (track->flags & MPT_FLG_PITSET)
+    {
+        int32_t bend = track->bend * track->bendRange;
+        int32_t x = (track->tune + bend) * 4 + (track->keyShift << 8) + (track->keyShiftX << 8) + track->pitX;
+
+        if (track->modT == 0)
+            x += 16 * track->modM;
+
+        track->keyM = x >> 8;
+        track->pitM = x;
+    }
+
+    track->flags &= ~(MPT_FLG_PITSET | MPT_FLG_VOLSET);
+}
+
+static void ChnVolSet(struct SoundChannel *chan, struct MusicPlayerTrack *track)
+{
+    uint32_t right = ((0x80 + chan->rhythmPan) * chan->velocity * track->volMR) >> 14;
+    uint32_t left = ((0x7F - chan->rhythmPan) * chan->velocity * track->volML) >> 14;
+
+    chan->rightVolume = right > 0xFF ? 0xFF : right;
+    chan->leftVolume = left > 0xFF ? 0xFF : left;
+}
+
+// Tracks are compared by address when notes steal channels, with no track
+// coming first.
+static uintptr_t TrackOrder(struct MusicPlayerTrack *track)
+{
+    return track ? (uintptr_t)(track - sTracks) + 1 : 0;
+}
+
+// Track commands
+
+static void ClearModM(struct MusicPlayerTrack *track)
+{
+    track->lfoSpeedC = 0;
+    track->modM = 0;
+    if (track->modT == 0)
+        track->flags |= MPT_FLG_PITCHG;
+    else
+        track->flags |= MPT_FLG_VOLCHG;
+}
+
+static void ply_fine(struct MusicPlayerInfo *mplay, struct MusicPlayerTrack *track)
+{
+    struct SoundChannel *chan = track->chan;
+
+    (void)mplay;
+    while (chan != NULL)
+    {
+        struct SoundChannel *next = chan->next;
+
+        if (chan->statusFlags & SOUND_CHANNEL_SF_ON)
+            chan->statusFlags |= SOUND_CHANNEL_SF_STOP;
+        ClearChain(chan);
+        chan = next;
+    }
+    track->flags = 0;
+}
+
+static void ply_goto(struct MusicPlayerInfo *mplay, struct MusicPlayerTrack *track)
+{
+    (void)mplay;
+    track->cmdPtr = RomRead32(track->cmdPtr);
+}
+
+static void ply_patt(struct MusicPlayerInfo *mplay, struct MusicPlayerTrack *track)
+{
+    if (track->patternLevel < 3)
+    {
+        track->patternStack[track->patternLevel++] = track->cmdPtr + 4;
+        ply_goto(mplay, track);
+    }
+    else
+    {
+        ply_fine(mplay, track);
+    }
+}
+
+static void ply_pend(struct MusicPlayerInfo *mplay, struct MusicPlayerTrack *track)
+{
+    (void)mplay;
+    if (track->patternLevel)
+        track->cmdPtr = track->patternStack[--track->patternLevel];
+}
+
+static void ply_rept(struct MusicPlayerInfo *mplay, struct MusicPlayerTrack *track)
+{
+    uint8_t count = ReadCmdByte(track);
+
+    if (count == 0)
+    {
+        ply_goto(mplay, track);
+    }
+    else if (++track->repN < count)
+    {
+        ply_goto(mplay, track);
+    }
+    else
+    {
+        track->repN = 0;
+        track->cmdPtr += 4;
+    }
+}
+
+static void ply_memacc(struct MusicPlayerInfo *mplay, struct MusicPlayerTrack *track)
+{
+    uint8_t op = ReadCmdByte(track);
+    uint8_t *addr = &sMemAccArea[ReadCmdByte(track)];
+    uint8_t data = ReadCmdByte(track);
+    bool cond;
+
+    switch (op)
+    {
+    case 0:
+        *addr = data;
+        return;
+    case 1:
+        *addr += data;
+        return;
+    case 2:
+        *addr -= data;
+        return;
+    case 3:
+        *addr = sMemAccArea[data];
+        return;
+    case 4:
+        *addr += sMemAccArea[data];
+        return;
+    case 5:
+        *addr -= sMemAccArea[data];
+        return;
+    case 6:  cond = *addr == data; break;
+    case 7:  cond = *addr != data; break;
+    case 8:  cond = *addr > data; break;
+    case 9:  cond = *addr >= data; break;
+    case 10: cond = *addr <= data; break;
+    case 11: cond = *addr < data; break;
+    case 12: cond = *addr == sMemAccArea[data]; break;
+    case 13: cond = *addr != sMemAccArea[data]; break;
+    case 14: cond = *addr > sMemAccArea[data]; break;
+    case 15: cond = *addr >= sMemAccArea[data]; break;
+    case 16: cond = *addr <= sMemAccArea[data]; break;
+    case 17: cond = *addr < sMemAccArea[data]; break;
+    default:
+        return;
+    }
+
+    if (cond)
+        ply_goto(mplay, track);
+    else
+        track->cmdPtr += 4;
+}
+
+static void ply_prio(struct MusicPlayerInfo *mplay, struct MusicPlayerTrack *track)
+{
+    (void)mplay;
+    track->priority = ReadCmdByte(track);
+}
+
+static void ply_tempo(struct MusicPlayerInfo *mplay, struct MusicPlayerTrack *track)
+{
+    mplay->tempoD = ReadCmdByte(track) * 2;
+    mplay->tempoI = (mplay->tempoD * mplay->tempoU) >> 8;
+}
+
+static void ply_keysh(struct MusicPlayerInfo *mplay, struct MusicPlayerTrack *track)
+{
+    (void)mplay;
+    track->keyShift = ReadCmdByte(track);
+    track->flags |= MPT_FLG_PITCHG;
+}
+
+static void ply_voice(struct MusicPlayerInfo *mplay, struct MusicPlayerTrack *track)
+{
+    uint32_t tone = mplay->tone + ReadCmdByte(track) * 12;
+
+    track->tone.type = RomRead8(tone);
+    track->tone.key = RomRead8(tone + 1);
+    track->tone.length = RomRead8(tone + 2);
+    track->tone.pan_sweep = RomRead8(tone + 3);
+    track->tone.wav = RomRead32(tone + 4);
+    track->tone.attack = RomRead8(tone + 8);
+    track->tone.decay = RomRead8(tone + 9);
+    track->tone.sustain = RomRead8(tone + 10);
+    track->tone.release = RomRead8(tone + 11);
+}
+
+static void ply_vol(struct MusicPlayerInfo *mplay, struct MusicPlayerTrack *track)
+{
+    (void)mplay;
+    track->vol = ReadCmdByte(track);
+    track->flags |= MPT_FLG_VOLCHG;
+}
+
+static void ply_pan(struct MusicPlayerInfo *mplay, struct MusicPlayerTrack *track)
+{
+    (void)mplay;
+    track->pan = ReadCmdByte(track) - C_V;
+    track->flags |= MPT_FLG_VOLCHG;
+}
+
+static void ply_bend(struct MusicPlayerInfo *mplay, struct MusicPlayerTrack *track)
+{
+    (void)mplay;
+    track->bend = ReadCmdByte(track) - C_V;
+    track->flags |= MPT_FLG_PITCHG;
+}
+
+static void ply_bendr(struct MusicPlayerInfo *mplay, struct MusicPlayerTrack *track)
+{
+    (void)mplay;
+    track->bendRange = ReadCmdByte(track);
+    track->flags |= MPT_FLG_PITCHG;
+}
+
+static void ply_lfos(struct MusicPlayerInfo *mplay, struct MusicPlayerTrack *track)
+{
+    (void)mplay;
+    track->lfoSpeed = ReadCmdByte(track);
+    if (track->lfoSpeed == 0)
+        ClearModM(track);
+}
+
+static void ply_lfodl(struct MusicPlayerInfo *mplay, struct MusicPlayerTrack *track)
+{
+    (void)mplay;
+    track->lfoDelay = ReadCmdByte(track);
+}
+
+static void ply_mod(struct MusicPlayerInfo *mplay, struct MusicPlayerTrack *track)
+{
+    (void)mplay;
+    track->mod = ReadCmdByte(track);
+    if (track->mod == 0)
+        ClearModM(track);
+}
+
+static void ply_modt(struct MusicPlayerInfo *mplay, struct MusicPlayerTrack *track)
+{
+    uint8_t modT = ReadCmdByte(track);
+
+    (void)mplay;
+    if (track->modT != modT)
+    {
+        track->modT = modT;
+        track->flags |= MPT_FLG_VOLCHG | MPT_FLG_PITCHG;
+    }
+}
+
+static void ply_tune(struct MusicPlayerInfo *mplay, struct MusicPlayerTrack *track)
+{
+    (void)mplay;
+    track->tune = ReadCmdByte(track) - C_V;
+    track->flags |= MPT_FLG_PITCHG;
+}
+
+static void ply_port(struct MusicPlayerInfo *mplay, struct MusicPlayerTrack *track)
+{
+    uint8_t reg = ReadCmdByte(track);
+    uint8_t value = ReadCmdByte(track);
+
+    (void)mplay;
+    if (reg < NUM_APU_REGS)
+        ApuWrite(reg, value);
+}
+
+static void ply_xcmd(struct MusicPlayerInfo *mplay, struct MusicPlayerTrack *track)
+{
+    switch (ReadCmdByte(track))
+    {
+    case 1:
+        track->tone.wav = RomRead8(track->cmdPtr) | (RomRead8(track->cmdPtr + 1) << 8)
+                        | (RomRead8(track->cmdPtr + 2) << 16) | ((uint32_t)RomRead8(track->cmdPtr + 3) << 24);
+        track->cmdPtr += 4;
+        break;
+    case 2:
+        track->tone.type = ReadCmdByte(track);
+        break;
+    case 4:
+        track->tone.attack = ReadCmdByte(track);
+        break;
+    case 5:
+        track->tone.decay = ReadCmdByte(track);
+        break;
+    case 6:
+        track->tone.sustain = ReadCmdByte(track);
+        break;
+    case 7:
+        track->tone.release = ReadCmdByte(track);
+        break;
+    case 8:
+        track->pseudoEchoVolume = ReadCmdByte(track);
+        break;
+    case 9:
+        track->pseudoEchoLength = ReadCmdByte(track);
+        break;
+    case 10:
+        track->tone.length = ReadCmdByte(track);
+        break;
+    case 11:
+        track->tone.pan_sweep = ReadCmdByte(track);
+        break;
+    case 12:
+    {
+        uint16_t count = RomRead8(track->cmdPtr) | (RomRead8(track->cmdPtr + 1) << 8);
+
+        if (track->unk_3A < count)
+        {
+            track->unk_3A++;
+            track->cmdPtr -= 2;
+            track->wait = 1;
+        }
+        else
+        {
+            track->unk_3A = 0;
+            track->cmdPtr += 2;
+        }
+        break;
+    }
+    case 13:
+        track->unk_3C = RomRead8(track->cmdPtr) | (RomRead8(track->cmdPtr + 1) << 8)
+                      | (RomRead8(track->cmdPtr + 2) << 16) | ((uint32_t)RomRead8(track->cmdPtr + 3) << 24);
+        track->cmdPtr += 4;
+        break;
+    default:
+        ply_fine(mplay, track);
+        break;
+    }
+}
+
+static void ply_endtie(struct MusicPlayerInfo *mplay, struct MusicPlayerTrack *track)
+{
+    uint8_t key = RomRead8(track->cmdPtr);
+
+    (void)mplay;
+    if (key < 0x80)
+    {
+        track->key = key;
+        track->cmdPtr++;
+    }
+    else
+    {
+        key = track->key;
+    }
+
+    for (struct SoundChannel *chan = track->chan; chan != NULL; chan = chan->next)
+    {
+        if ((chan->statusFlags & (SOUND_CHANNEL_SF_START | SOUND_CHANNEL_SF_ENV))
+         && !(chan->statusFlags & SOUND_CHANNEL_SF_STOP)
+         && chan->midiKey == key)
+        {
+            chan->statusFlags |= SOUND_CHANNEL_SF_STOP;
+            return;
+        }
+    }
+}
+
+// gMPlayJumpTable after MPlayExtender, from FINE (0xB1) to EOT (0xCE)
+static const PlyFunc sPlyTable[] = {
+    ply_fine, ply_goto, ply_patt, ply_pend, ply_rept, ply_fine, ply_fine, ply_fine,
+    ply_memacc, ply_prio, ply_tempo, ply_keysh, ply_voice, ply_vol, ply_pan, ply_bend,
+    ply_bendr, ply_lfos, ply_lfodl, ply_mod, ply_modt, ply_fine, ply_fine, ply_tune,
+    ply_fine, ply_fine, ply_fine, ply_port, ply_xcmd, ply_endtie,
+};
+
+static void PlyNote(uint8_t clockIndex, struct MusicPlayerInfo *mplay, struct MusicPlayerTrack *track)
+{
+    struct SoundInfo *si = &gSoundInfo;
+    struct SoundChannel *chan = NULL;
+    struct ToneData tone = track->tone;
+    int8_t rhythmPan = 0;
+    uint8_t key, cgbType;
+    int priority, newKey;
+
+    track->gateTime = sClockTable[clockIndex];
+    if (RomRead8(track->cmdPtr) < 0x80)
+    {
+        track->key = ReadCmdByte(track);
+        if (RomRead8(track->cmdPtr) < 0x80)
+        {
+            track->velocity = ReadCmdByte(track);
+            if (RomRead8(track->cmdPtr) < 0x80)
+                track->gateTime += ReadCmdByte(track);
+        }
+    }
+
+    key = track->key;
+    if (tone.type & (TONEDATA_TYPE_RHY | TONEDATA_TYPE_SPL))
+    {
+        uint32_t index = key, addr;
+
+        if (tone.type & TONEDATA_TYPE_SPL)
+        {
+            uint32_t keySplitTable = tone.attack | (tone.decay << 8) | (tone.sustain << 16) | ((uint32_t)tone.release << 24);
+
+            index = RomRead8(keySplitTable + key);
+        }
+        addr = tone.wav + index * 12;
+        if (RomRead8(addr) & (TONEDATA_TYPE_RHY | TONEDATA_TYPE_SPL))
+            return;
+        if (tone.type & TONEDATA_TYPE_RHY)
+        {
+            uint8_t panSweep = RomRead8(addr + 3);
+
+            if (panSweep & 0x80)
+                rhythmPan = ((int)panSweep - 0xC0) * 2;
+            key = RomRead8(addr + 1);
+        }
+        tone.type = RomRead8(addr);
+        tone.key = RomRead8(addr + 1);
+        tone.length = RomRead8(addr + 2);
+        tone.pan_sweep = RomRead8(addr + 3);
+        tone.wav = RomRead32(addr + 4);
+        tone.attack = RomRead8(addr + 8);
+        tone.decay = RomRead8(addr + 9);
+        tone.sustain = RomRead8(addr + 10);
+        tone.release = RomRead8(addr + 11);
+    }
+
+    priority = mplay->priority + track->priority;
+    if (priority > 0xFF)
+        priority = 0xFF;
+
+    cgbType = tone.type & TONEDATA_TYPE_CGB;
+    if (cgbType)
+    {
+        chan = &si->cgbChans[cgbType - 1];
+        if ((chan->statusFlags & SOUND_CHANNEL_SF_ON) && !(chan->statusFlags & SOUND_CHANNEL_SF_STOP))
+        {
+            if (chan->priority > priority)
+                return;
+            if (chan->priority == priority && TrackOrder(chan->track) < TrackOrder(track))
+                return;
+        }
+    }
+    else
+    {
+        int bestPriority = priority;
+        uintptr_t bestTrack = TrackOrder(track);
+        bool stopping = false;
+
+        for (int i = 0; i < si->maxChans; i++)
+        {
+            struct SoundChannel *c = &si->chans[i];
+
+            if (!(c->statusFlags & SOUND_CHANNEL_SF_ON))
+            {
+                chan = c;
+                break;
+            }
+            if (c->statusFlags & SOUND_CHANNEL_SF_STOP)
+            {
+                if (!stopping)
+                {
+                    stopping = true;
+                    bestPriority = c->priority;
+                    bestTrack = TrackOrder(c->track);
+                    chan = c;
+                    continue;
+                }
+            }
+            else if (stopping)
+            {
+                continue;
+            }
+
+            if (c->priority < bestPriority)
+            {
+                bestPriority = c->priority;
+                bestTrack = TrackOrder(c->track);
+                chan = c;
+            }
+            else if (c->priority == bestPriority && TrackOrder(c->track) >= bestTrack)
+            {
+                bestTrack = TrackOrder(c->track);
+                chan = c;
+            }
+        }
+        if (chan == NULL)
+            return;
+    }
+
+    ClearChain(chan);
+    chan->prev = NULL;
+    chan->next = track->chan;
+    if (track->chan)
+        track->chan->prev = chan;
+    track->chan = chan;
+    chan->track = track;
+
+    track->lfoDelayC = track->lfoDelay;
+    if (track->lfoDelay)
+        ClearModM(track);
+    TrkVolPitSet(track);
+
+    chan->gateTime = track->gateTime;
+    chan->midiKey = track->key;
+    chan->velocity = track->velocity;
+    chan->priority = priority;
+    chan->key = key;
+    chan->rhythmPan = rhythmPan;
+    chan->type = tone.type;
+    chan->wav = tone.wav;
+    chan->attack = tone.attack;
+    chan->decay = tone.decay;
+    chan->sustain = tone.sustain;
+    chan->release = tone.release;
+    chan->pseudoEchoVolume = track->pseudoEchoVolume;
+    chan->pseudoEchoLength = track->pseudoEchoLength;
+    ChnVolSet(chan, track);
+
+    newKey = key + track->keyM;
+    if (newKey < 0)
+        newKey = 0;
+
+    if (cgbType)
+    {
+        chan->length = tone.length;
+        if ((tone.pan_sweep & 0x80) || !(tone.pan_sweep & 0x70))
+            chan->sweep = 8;
+        else
+            chan->sweep = tone.pan_sweep;
+        chan->frequency = MidiKeyToCgbFreq(cgbType, newKey, track->pitM);
+    }
+    else
+    {
+        chan->count = track->unk_3C;
+        chan->frequency = MidiKeyToFreq(chan->wav, newKey, track->pitM);
+    }
+
+    chan->statusFlags = SOUND_CHANNEL_SF_START;
+    track->flags &= 0xF0;
+}
+
+static void MPlayMain(struct MusicPlayerInfo *mplay)
+{
+    uint32_t tempoC;
+
+    if (mplay->status & MUSICPLAYER_STATUS_PAUSE)
+        return;
+
+    tempoC = mplay->tempoC + mplay->tempoI;
+    while (tempoC >= 150)
+    {
+        uint32_t active = 0;
+
+        for (int i = 0; i < mplay->trackCount; i++)
+        {
+            struct MusicPlayerTrack *track = &mplay->tracks[i];
+            struct SoundChannel *chan;
+
+            if (!(track->flags & MPT_FLG_EXIST))
+                continue;
+            active |= 1 << i;
+
+            chan = track->chan;
+            while (chan != NULL)
+            {
+                struct SoundChannel *next = chan->next;
+
+                if (chan->statusFlags & SOUND_CHANNEL_SF_ON)
+                {
+                    if (chan->gateTime && --chan->gateTime == 0)
+                        chan->statusFlags |= SOUND_CHANNEL_SF_STOP;
+                }
+                else
+                {
+                    ClearChain(chan);
+                }
+                chan = next;
+            }
+
+            if (track->flags & MPT_FLG_START)
+            {
+                // Clear64byte: everything before cmdPtr
+                memset(track, 0, offsetof(struct MusicPlayerTrack, cmdPtr));
+                track->flags = MPT_FLG_EXIST;
+                track->bendRange = 2;
+                track->volX = 64;
+                track->lfoSpeed = 22;
+                track->tone.type = 1;
+            }
+
+            while (track->wait == 0)
+            {
+                uint8_t cmd = RomRead8(track->cmdPtr);
+
+                if (cmd < 0x80)
+                {
+                    cmd = track->runningStatus;
+                }
+                else
+                {
+                    track->cmdPtr++;
+                    if (cmd >= 0xBD)
+                        track->runningStatus = cmd;
+                }
+
+                if (cmd >= TIE)
+                {
+                    PlyNote(cmd - TIE, mplay, track);
+                }
+                else if (cmd >= FINE)
+                {
+                    mplay->cmd = cmd - FINE;
+                    sPlyTable[cmd - FINE](mplay, track);
+                    if (track->flags == 0)
+                        goto next_track;
+                }
+                else
+                {
+                    track->wait = sClockTable[cmd - 0x80];
+                }
+            }
+
+            track->wait--;
+
+            if (track->lfoSpeed && track->mod)
+            {
+                if (track->lfoDelayC)
+                {
+                    track->lfoDelayC--;
+                }
+                else
+                {
+                    int32_t speedC = track->lfoSpeedC + track->lfoSpeed;
+                    int32_t modM;
+
+                    track->lfoSpeedC = speedC;
+                    if (((speedC - 0x40) & 0x80) == 0)
+                        modM = 0x80 - speedC;
+                    else
+                        modM = (int8_t)speedC;
+                    modM = (track->mod * modM) >> 6;
+                    if ((uint8_t)(track->modM ^ modM))
+                    {
+                        track->modM = modM;
+                        if (track->modT == 0)
+                            track->flags |= MPT_FLG_PITCHG;
+                        else
+                            track->flags |= MPT_FLG_VOLCHG;
+                    }
+                }
+            }
+        next_track:;
+        }
+
+        mplay->clock++;
+        if (active == 0)
+        {
+            mplay->status = MUSICPLAYER_STATUS_PAUSE;
+            return;
+        }
+        mplay->status = active;
+        tempoC -= 150;
+    }
+    mplay->tempoC = tempoC;
+
+    for (int i = 0; i < mplay->trackCount; i++)
+    {
+        struct MusicPlayerTrack *track = &mplay->tracks[i];
+        struct SoundChannel *chan;
+
+        if (!(track->flags & MPT_FLG_EXIST) || !(track->flags & (MPT_FLG_VOLCHG | MPT_FLG_PITCHG)))
+            continue;
+
+        TrkVolPitSet(track);
+        chan = track->chan;
+        while (chan != NULL)
+        {
+            struct SoundChannel *next = chan->next;
+
+            if (!(chan->statusFlags & SOUND_CHANNEL_SF_ON))
+            {
+                ClearChain(chan);
+            }
+            else
+            {
+                uint8_t cgbType = chan->type & TONEDATA_TYPE_CGB;
+
+                if (track->flags & MPT_FLG_VOLCHG)
+                {
+                    ChnVolSet(chan, track);
+                    if (cgbType)
+                        chan->modify |= CGB_CHANNEL_MO_VOL;
+                }
+                if (track->flags & MPT_FLG_PITCHG)
+                {
+                    int key = chan->key + track->keyM;
+
+                    if (key < 0)
+                        key = 0;
+                    if (cgbType)
+                    {
+                        chan->frequency = MidiKeyToCgbFreq(cgbType, key, track->pitM);
+                        chan->modify |= CGB_CHANNEL_MO_PIT;
+                    }
+                    else
+                    {
+                        chan->frequency = MidiKeyToFreq(chan->wav, key, track->pitM);
+                    }
+                }
+            }
+            chan = next;
+        }
+        track->flags &= 0xF0;
+    }
+}
+
+static void MPlayStart(struct MusicPlayerInfo *mplay, uint32_t header)
+{
+    int trackCount = RomRead8(header);
+    uint8_t reverb = RomRead8(header + 3);
+    int i;
+
+    mplay->status = 0;
+    mplay->songHeader = header;
+    mplay->tone = RomRead32(header + 4);
+    mplay->priority = RomRead8(header + 2);
+    mplay->clock = 0;
+    mplay->tempoD = 150;
+    mplay->tempoI = 150;
+    mplay->tempoU = 0x100;
+    mplay->tempoC = 0;
+
+    for (i = 0; i < trackCount && i < mplay->trackCount; i++)
+    {
+        struct MusicPlayerTrack *track = &mplay->tracks[i];
+
+        TrackStop(track);
+        track->flags = MPT_FLG_EXIST | MPT_FLG_START;
+        track->chan = NULL;
+        track->cmdPtr = RomRead32(header + 8 + 4 * i);
+    }
+    for (; i < mplay->trackCount; i++)
+    {
+        TrackStop(&mplay->tracks[i]);
+        mplay->tracks[i].flags = 0;
+    }
+
+    if (reverb & 0x80)
+        gSoundInfo.reverb = reverb & 0x7F;
+}
+
+static void MPlayVolumeControl(struct MusicPlayerInfo *mplay, uint16_t volume)
+{
+    for (int i = 0; i < mplay->trackCount; i++)
+    {
+        struct MusicPlayerTrack *track = &mplay->tracks[i];
+
+        if (track->flags & MPT_FLG_EXIST)
+        {
+            track->volX = volume / 4;
+            track->flags |= MPT_FLG_VOLCHG;
+        }
+    }
+}
+
+static bool IsCryPlaying(struct MusicPlayerInfo *mplay)
+{
+    struct MusicPlayerTrack *track = mplay->tracks;
+
+    return track->chan && track->chan->track == track;
+}
+
+// CGB channels
+
+static bool CgbPan(struct SoundChannel *chan)
+{
+    uint32_t rightVolume = chan->rightVolume;
+    uint32_t leftVolume = chan->leftVolume;
+
+    if (rightVolume >= leftVolume)
+    {
+        if (rightVolume / 2 >= leftVolume)
+        {
+            chan->pan = 0x0F;
+            return true;
+        }
+    }
+    else
+    {
+        if (leftVolume / 2 >= rightVolume)
+        {
+            chan->pan = 0xF0;
+            return true;
+        }
+    }
+    return false;
+}
+
+static void CgbModVol(struct SoundChannel *chan)
+{
+    if (!CgbPan(chan))
+    {
+        chan->pan = 0xFF;
+        chan->envelopeGoal = (uint32_t)(chan->leftVolume + chan->rightVolume) / 16;
+    }
+    else
+    {
+        chan->envelopeGoal = (uint32_t)(chan->leftVolume + chan->rightVolume) / 16;
+        if (chan->envelopeGoal > 15)
+            chan->envelopeGoal = 15;
+    }
+
+    chan->sustainGoal = (chan->envelopeGoal * chan->sustain + 15) >> 4;
+    chan->pan &= chan->panMask;
+}
+
+static void CgbSound(void)
+{
+    struct SoundInfo *si = &gSoundInfo;
+    int ch;
+    struct SoundChannel *channels;
+    int prevC15;
+    int nrx0, nrx1, nrx2, nrx3, nrx4;
+    int envelopeStepTimeAndDir;
+
+    if (si->c15)
+        si->c15--;
+    else
+        si->c15 = 14;
+
+    for (ch = 1, channels = si->cgbChans; ch <= 4; ch++, channels++)
+    {
+        if (!(channels->statusFlags & SOUND_CHANNEL_SF_ON))
+            continue;
+
+        nrx0 = (ch == 3) ? NR30 : (ch == 4) ? NR30 + 1 : NR10 + (ch - 1);
+        nrx1 = (ch - 1) * 8 + NR11;
+        nrx2 = (ch - 1) * 8 + NR12;
+        nrx3 = (ch - 1) * 8 + NR13;
+        nrx4 = (ch - 1) * 8 + NR14;
+
+        prevC15 = si->c15;
+        envelopeStepTimeAndDir = sApuRegs[nrx2];
+
+        if (channels->statusFlags & SOUND_CHANNEL_SF_START)
+        {
+            if (channels->statusFlags & SOUND_CHANNEL_SF_STOP)
+                goto oscillator_off;
+
+            channels->statusFlags = SOUND_CHANNEL_SF_ENV_ATTACK;
+            channels->modify = CGB_CHANNEL_MO_PIT | CGB_CHANNEL_MO_VOL;
+            CgbModVol(channels);
+            switch (ch)
+            {
+            case 1:
+                ApuWrite(nrx0, channels->sweep);
+                // fallthrough
+            case 2:
+                ApuWrite(nrx1, (channels->wav << 6) + channels->length);
+                goto init_env_step_time_dir;
+            case 3:
+                if (channels->wav != channels->currentPointer)
+                {
+                    for (int i = 0; i < 16; i++)
+                        sWaveRam[i] = RomRead8(channels->wav + i);
+                    channels->currentPointer = channels->wav;
+                }
+                ApuWrite(nrx0, 0);
+                ApuWrite(nrx1, channels->length);
+                channels->n4 = channels->length ? 0xC0 : 0x80;
+                break;
+            default:
+                ApuWrite(nrx1, channels->length);
+                ApuWrite(nrx3, channels->wav << 3);
+            init_env_step_time_dir:
+                envelopeStepTimeAndDir = channels->attack + 8;
+                channels->n4 = channels->length ? 0x40 : 0x00;
+                break;
+            }
+            channels->envelopeCounter = channels->attack;
+            if ((int8_t)channels->attack)
+            {
+                channels->envelopeVolume = 0;
+                goto envelope_step_complete;
+            }
+            goto envelope_decay_start;
+        }
+        else if (channels->statusFlags & SOUND_CHANNEL_SF_IEC)
+        {
+            channels->pseudoEchoLength--;
+            if ((int8_t)channels->pseudoEchoLength <= 0)
+            {
+            oscillator_off:
+                CgbOscOff(ch);
+                channels->statusFlags = 0;
+                goto channel_complete;
+            }
+            goto envelope_complete;
+        }
+        else if ((channels->statusFlags & SOUND_CHANNEL_SF_STOP) && (channels->statusFlags & SOUND_CHANNEL_SF_ENV))
+        {
+            channels->statusFlags &= ~SOUND_CHANNEL_SF_ENV;
+            channels->envelopeCounter = channels->release;
+            if ((int8_t)channels->release)
+            {
+                channels->modify |= CGB_CHANNEL_MO_VOL;
+                if (ch != 3)
+                    envelopeStepTimeAndDir = channels->release;
+                goto envelope_step_complete;
+            }
+            goto envelope_pseudoecho_start;
+        }
+        else
+        {
+        envelope_step_repeat:
+            if (channels->envelopeCounter == 0)
+            {
+                if (ch == 3)
+                    channels->modify |= CGB_CHANNEL_MO_VOL;
+
+                CgbModVol(channels);
+                if ((channels->statusFlags & SOUND_CHANNEL_SF_ENV) == SOUND_CHANNEL_SF_ENV_RELEASE)
+                {
+                    channels->envelopeVolume--;
+                    if ((int8_t)channels->envelopeVolume <= 0)
+                    {
+                    envelope_pseudoecho_start:
+                        channels->envelopeVolume = ((channels->envelopeGoal * channels->pseudoEchoVolume) + 0xFF) >> 8;
+                        if (channels->envelopeVolume)
+                        {
+                            channels->statusFlags |= SOUND_CHANNEL_SF_IEC;
+                            channels->modify |= CGB_CHANNEL_MO_VOL;
+                            if (ch != 3)
+                                envelopeStepTimeAndDir = 8;
+                            goto envelope_complete;
+                        }
+                        goto oscillator_off;
+                    }
+                    channels->envelopeCounter = channels->release;
+                }
+                else if ((channels->statusFlags & SOUND_CHANNEL_SF_ENV) == SOUND_CHANNEL_SF_ENV_SUSTAIN)
+                {
+                envelope_sustain:
+                    channels->envelopeVolume = channels->sustainGoal;
+                    channels->envelopeCounter = 7;
+                }
+                else if ((channels->statusFlags & SOUND_CHANNEL_SF_ENV) == SOUND_CHANNEL_SF_ENV_DECAY)
+                {
+                    channels->envelopeVolume--;
+                    if ((int8_t)channels->envelopeVolume <= (int8_t)channels->sustainGoal)
+                    {
+                    envelope_sustain_start:
+                        if (channels->sustain == 0)
+                        {
+                            channels->statusFlags &= ~SOUND_CHANNEL_SF_ENV;
+                            goto envelope_pseudoecho_start;
+                        }
+                        channels->statusFlags--;
+                        channels->modify |= CGB_CHANNEL_MO_VOL;
+                        if (ch != 3)
+                            envelopeStepTimeAndDir = 8;
+                        goto envelope_sustain;
+                    }
+                    channels->envelopeCounter = channels->decay;
+                }
+                else
+                {
+                    channels->envelopeVolume++;
+                    if (channels->envelopeVolume >= channels->envelopeGoal)
+                    {
+                    envelope_decay_start:
+                        channels->statusFlags--;
+                        channels->envelopeCounter = channels->decay;
+                        if (channels->envelopeCounter)
+                        {
+                            channels->modify |= CGB_CHANNEL_MO_VOL;
+                            channels->envelopeVolume = channels->envelopeGoal;
+                            if (ch != 3)
+                                envelopeStepTimeAndDir = channels->decay;
+                        }
+                        else
+                        {
+                            goto envelope_sustain_start;
+                        }
+                    }
+                    else
+                    {
+                        channels->envelopeCounter = channels->attack;
+                    }
+                }
+            }
+        }
+
+    envelope_step_complete:
+        // every 15 frames, envelope calculation has to be done twice
+        // to keep up with the hardware envelope rate (1/64 s)
+        channels->envelopeCounter--;
+        if (prevC15 == 0)
+        {
+            prevC15--;
+            goto envelope_step_repeat;
+        }
+
+    envelope_complete:
+        if (channels->modify & CGB_CHANNEL_MO_PIT)
+        {
+            // SOUNDBIAS is set for 8-bit DACs (65536 Hz PWM) by m4aSoundInit
+            if (ch < 4 && (channels->type & TONEDATA_TYPE_FIX))
+                channels->frequency = (channels->frequency + 1) & 0x7FE;
+
+            if (ch != 4)
+                ApuWrite(nrx3, channels->frequency);
+            else
+                ApuWrite(nrx3, (sApuRegs[nrx3] & 0x08) | channels->frequency);
+            channels->n4 = (channels->n4 & 0xC0) + ((channels->frequency >> 8) & 0xFF);
+            ApuWrite(nrx4, channels->n4);
+        }
+
+        if (channels->modify & CGB_CHANNEL_MO_VOL)
+        {
+            sApuRegs[NR51] = (sApuRegs[NR51] & ~channels->panMask) | channels->pan;
+            if (ch == 3)
+            {
+                ApuWrite(nrx2, sCgb3Vol[channels->envelopeVolume & 0xF]);
+                if (channels->n4 & 0x80)
+                {
+                    ApuWrite(nrx0, 0x80);
+                    ApuWrite(nrx4, channels->n4);
+                    channels->n4 &= 0x7F;
+                }
+            }
+            else
+            {
+                ApuWrite(nrx2, (envelopeStepTimeAndDir & 0xF) + (channels->envelopeVolume << 4));
+                ApuWrite(nrx4, channels->n4 | 0x80);
+                if (ch == 1 && !(sApuRegs[nrx0] & 0x08))
+                    ApuWrite(nrx4, channels->n4 | 0x80);
+            }
+        }
+
+    channel_complete:
+        channels->modify = 0;
+    }
+}
+
+// Setup and the frame loop
+
+void SoundInit(int freqIndex, int maxChans, int masterVolume, bool halfRateBand)
+{
+    struct SoundInfo *si = &gSoundInfo;
+    struct MusicPlayerTrack *tracks = sTracks;
+
+    memset(si, 0, sizeof(*si));
+    si->maxChans = maxChans;
+    si->masterVolume = masterVolume;
+    si->pcmSamplesPerVBlank = gPcmSamplesPerVBlankTable[freqIndex - 1];
+    si->pcmDmaPeriod = PCM_DMA_BUF_SIZE / si->pcmSamplesPerVBlank;
+    si->pcmFreq = (597275 * si->pcmSamplesPerVBlank + 5000) / 10000;
+    si->divFreq = (16777216 / si->pcmFreq + 1) >> 1;
+    // As SampleFreqSet, which only uses the band when half a frame is still
+    // a multiple of 8 samples for the mixing loops.
+    si->halfRateBand = halfRateBand && !(si->pcmSamplesPerVBlank & 15);
+
+    for (int i = 0; i < 4; i++)
+    {
+        si->cgbChans[i].type = i + 1;
+        si->cgbChans[i].panMask = 0x11 << i;
+    }
+
+    memset(sApuRegs, 0, sizeof(sApuRegs));
+    memset(sPsg, 0, sizeof(sPsg));
+    ApuWrite(NR12, 8);
+    ApuWrite(NR22, 8);
+    ApuWrite(NR42, 8);
+    ApuWrite(NR14, 0x80);
+    ApuWrite(NR24, 0x80);
+    ApuWrite(NR44, 0x80);
+    ApuWrite(NR30, 0);
+    ApuWrite(NR50, 0x77);
+
+    memset(sTracks, 0, sizeof(sTracks));
+    for (int i = 0; i < NUM_PLAYERS; i++)
+    {
+        memset(&sPlayers[i], 0, sizeof(sPlayers[i]));
+        sPlayers[i].tracks = tracks;
+        sPlayers[i].trackCount = sPlayerTrackCounts[i];
+        sPlayers[i].status = MUSICPLAYER_STATUS_PAUSE;
+        tracks += sPlayerTrackCounts[i];
+    }
+
+    for (int i = 0; i < 2; i++)
+    {
+        if (sCrySongs[i] == 0)
+            sCrySongs[i] = RomAlloc(0x34);
+    }
+    sBgmDucked = false;
+}
+
+void StartSong(uint32_t header, int player)
+{
+    MPlayStart(&sPlayers[player], header);
+}
+
+// Plays a cry the way PlayCry5 does: PlayCryInternal with mode 0, ducking the
+// BGM until it has finished.
+void StartCry(uint32_t tone)
+{
+    static const uint8_t sCrySongTemplate[0x34] = {
+        1, 0, CRY_PRIORITY, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, TUNE, C_V, GOTO, 0, 0, 0, 0,
+        TUNE, C_V + 16, VOICE, 0,
+        VOL, CRY_VOLUME, XCMD, 0x0D, 0, 0, 0, 0,
+        XCMD, xRELE, 0, PAN, C_V,
+        TIE, 60, 127, XCMD, 0x0C, CRY_LENGTH & 0xFF, CRY_LENGTH >> 8,
+        EOT, FINE,
+    };
+    uint32_t maxClock = 0;
+    int maxClockIndex = 0;
+    int i;
+    uint32_t song;
+    uint8_t *data;
+    int16_t pitch = CRY_PITCH + 0x80;
+
+    for (i = 0; i < 2; i++)
+    {
+        struct MusicPlayerTrack *track = sPlayers[PLAYER_CRY1 + i].tracks;
+
+        if (!track->flags && (!track->chan || track->chan->track != track))
+            break;
+        if (maxClock < sPlayers[PLAYER_CRY1 + i].clock)
+        {
+            maxClock = sPlayers[PLAYER_CRY1 + i].clock;
+            maxClockIndex = i;
+        }
+    }
+    if (i == 2)
+        i = maxClockIndex;
+
+    song = sCrySongs[i];
+    data = &gRom[song - ROM_BASE];
+    memcpy(data, sCrySongTemplate, sizeof(sCrySongTemplate));
+    data[0x2A] = (pitch >> 8) & 0x7F;
+    data[0x12] = (pitch >> 1) & 0x7F;
+    data[0x19] = (16 + data[0x12]) & 0x7F;
+    for (int j = 0; j < 4; j++)
+    {
+        data[0x04 + j] = tone >> (j * 8);
+        data[0x08 + j] = (song + 0x11) >> (j * 8);
+        data[0x0C + j] = (song + 0x18) >> (j * 8);
+        data[0x14 + j] = (song + 0x1A) >> (j * 8);
+    }
+
+    MPlayVolumeControl(&sPlayers[PLAYER_BGM], CRY_BGM_VOLUME);
+    sBgmDucked = true;
+    MPlayStart(&sPlayers[PLAYER_CRY1 + i], song);
+}
+
+bool SoundIsPlaying(void)
+{
+    for (int i = 0; i < NUM_PLAYERS; i++)
+    {
+        if (!(sPlayers[i].status & MUSICPLAYER_STATUS_PAUSE))
+            return true;
+    }
+    for (int i = 0; i < gSoundInfo.maxChans; i++)
+    {
+        if (gSoundInfo.chans[i].statusFlags & SOUND_CHANNEL_SF_ON)
+            return true;
+    }
+    for (int i = 0; i < 4; i++)
+    {
+        if (gSoundInfo.cgbChans[i].statusFlags & SOUND_CHANNEL_SF_ON)
+            return true;
+    }
+    return false;
+}
+
+// Runs one frame of SoundMain and writes its pcmSamplesPerVBlank stereo
+// samples to out. Levels are in the GBA mixer's 10-bit units scaled to 16
+// bits: DirectSound at 100% is the 8-bit sample times 4, and each GB channel
+// is its 4-bit volume times the NR50 master volume.
+void SoundFrame(int16_t *out)
+{
+    struct SoundInfo *si = &gSoundInfo;
+    int frameLength = si->pcmSamplesPerVBlank;
+    const int8_t *right = &si->pcmBuffer[si->pcmDmaSlot * frameLength];
+    const int8_t *left = right + PCM_DMA_BUF_SIZE;
+
+    for (int i = NUM_PLAYERS - 1; i >= 0; i--)
+        MPlayMain(&sPlayers[i]);
+    if (sBgmDucked && !IsCryPlaying(&sPlayers[PLAYER_CRY1]) && !IsCryPlaying(&sPlayers[PLAYER_CRY2]))
+    {
+        MPlayVolumeControl(&sPlayers[PLAYER_BGM], 256);
+        sBgmDucked = false;
+    }
+    CgbSound();
+    SoundMainRAM();
+
+    for (int i = 0; i < frameLength; i++)
+    {
+        int psgLeft = 0, psgRight = 0;
+        int sampleLeft, sampleRight;
+
+        for (int ch = 1; ch <= 4; ch++)
+        {
+            int sample = PsgSample(ch);
+
+            if (sApuRegs[NR51] & (0x10 << (ch - 1)))
+                psgLeft += sample;
+            if (sApuRegs[NR51] & (1 << (ch - 1)))
+                psgRight += sample;
+        }
+        psgLeft *= ((sApuRegs[NR50] >> 4) & 7) + 1;
+        psgRight *= (sApuRegs[NR50] & 7) + 1;
+
+        sampleLeft = (left[i] * 4 + psgLeft) * 32;
+        sampleRight = (right[i] * 4 + psgRight) * 32;
+        out[i * 2] = sampleLeft > 32767 ? 32767 : sampleLeft < -32768 ? -32768 : sampleLeft;
+        out[i * 2 + 1] = sampleRight > 32767 ? 32767 : sampleRight < -32768 ? -32768 : sampleRight;
+    }
+
+    if (++si->pcmDmaSlot >= si->pcmDmaPeriod)
+        si->pcmDmaSlot = 0;
+}
@@ -0,0 +1,1109 @@
+// Assembles the sound data the game links in (voicegroups, key split tables,
+// samples, cry tables and songs) into a ROM image, from the same sources the
+// build uses. It understands the part of GNU as syntax those files are
+// written in, and has the voice macros of asm/macros/music_voice.inc built in.
+// Samples are converted from .aif the way aif2pcm does when their .bin hasn't
+// been built.
+
+#include <stdarg.h>
+#include <string.h>
+#include <ctype.h>
+#include <math.h>
+#include "m4aplay.h"
+
+#define SYMBOL_HASH_SIZE 8192
+#define MAX_ARGS 16
+
+struct Symbol
+{
+    char *name;
+    bool defined;
+    bool resolving;
+    uint32_t value;
+    char *expr;         // for .equ/.set values that couldn't be evaluated yet
+    uint32_t dot;
+    struct Symbol *next;
+};
+
+struct Fixup
+{
+    uint32_t offset;
+    int size;
+    char *expr;
+    uint32_t dot;
+    char *file;
+    int line;
+};
+
+uint8_t *gRom;
+uint32_t gRomSize;
+
+static uint32_t sRomCapacity;
+static char *sRoot;
+static struct Symbol *sSymbols[SYMBOL_HASH_SIZE];
+static struct Fixup *sFixups;
+static int sNumFixups;
+static int sFixupCapacity;
+
+// Where in the sources we are, for error messages
+static const char *sFile;
+static int sLine;
+
+static void Error(const char *format, ...)
+{
+    va_list args;
+
+    fprintf(stderr, "%s:%d: ", sFile ? sFile : "m4aplay", sLine);
+    va_start(args, format);
+    vfprintf(stderr, format, args);
+    va_end(args);
+    fputc('\n', stderr);
+    exit(1);
+}
+
+static char *StrDup(const char *s, size_t length)
+{
+    char *copy = malloc(length + 1);
+
+    if (copy == NULL)
+        FATAL_ERROR("Out of memory.\n");
+    memcpy(copy, s, length);
+    copy[length] = 0;
+    return copy;
+}
+
+static char *ReadWholeFile(const char *path, long *size)
+{
+    FILE *fp = fopen(path, "rb");
+    char *buffer;
+
+    if (fp == NULL)
+        return NULL;
+    fseek(fp, 0, SEEK_END);
+    *size = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+    buffer = malloc(*size + 1);
+    if (buffer == NULL || fread(buffer, *size, 1, fp) != (size_t)(*size != 0))
+        FATAL_ERROR("Failed to read \"%s\".\n", path);
+    buffer[*size] = 0;
+    fclose(fp);
+    return buffer;
+}
+
+static char *JoinPath(const char *dir, const char *name)
+{
+    char *path = malloc(strlen(dir) + strlen(name) + 2);
+
+    if (path == NULL)
+        FATAL_ERROR("Out of memory.\n");
+    sprintf(path, "%s/%s", dir, name);
+    return path;
+}
+
+// ROM image
+
+static void RomReserve(uint32_t size)
+{
+    if (gRomSize + size > sRomCapacity)
+    {
+        while (gRomSize + size > sRomCapacity)
+            sRomCapacity = sRomCapacity ? sRomCapacity * 2 : 0x100000;
+        gRom = realloc(gRom, sRomCapacity);
+        if (gRom == NULL)
+            FATAL_ERROR("Out of memory.\n");
+    }
+}
+
+static void RomAlign(uint32_t alignment)
+{
+    RomReserve(alignment);
+    while (gRomSize % alignment)
+        gRom[gRomSize++] = 0;
+}
+
+static void Emit(uint32_t value, int size)
+{
+    RomReserve(size);
+    for (int i = 0; i < size; i++)
+        gRom[gRomSize++] = value >> (i * 8);
+}
+
+uint32_t RomAlloc(uint32_t size)
+{
+    uint32_t addr;
+
+    RomAlign(4);
+    addr = ROM_BASE + gRomSize;
+    RomReserve(size);
+    memset(&gRom[gRomSize], 0, size);
+    gRomSize += size;
+    return addr;
+}
+
+// Symbols
+
+static uint32_t HashName(const char *name)
+{
+    uint32_t hash = 5381;
+
+    while (*name)
+        hash = hash * 33 + (uint8_t)*name++;
+    return hash % SYMBOL_HASH_SIZE;
+}
+
+static struct Symbol *FindSymbol(const char *name, bool create)
+{
+    uint32_t hash = HashName(name);
+    struct Symbol *sym;
+
+    for (sym = sSymbols[hash]; sym != NULL; sym = sym->next)
+    {
+        if (strcmp(sym->name, name) == 0)
+            return sym;
+    }
+    if (!create)
+        return NULL;
+
+    sym = calloc(1, sizeof(*sym));
+    if (sym == NULL)
+        FATAL_ERROR("Out of memory.\n");
+    sym->name = StrDup(name, strlen(name));
+    sym->next = sSymbols[hash];
+    sSymbols[hash] = sym;
+    return sym;
+}
+
+// Samples
+
+static uint32_t ReadBigEndian(const uint8_t *data, int size)
+{
+    uint32_t value = 0;
+
+    for (int i = 0; i < size; i++)
+        value = (value << 8) | data[i];
+    return value;
+}
+
+static double ReadExtended(const uint8_t *data)
+{
+    int exponent = ((data[0] & 0x7F) << 8) | data[1];
+    double mantissa = (double)ReadBigEndian(data + 2, 4) * 4294967296.0 + ReadBigEndian(data + 6, 4);
+    double value = ldexp(mantissa, exponent - 16383 - 63);
+
+    return (data[0] & 0x80) ? -value : value;
+}
+
+static int GetDeltaIndex(uint8_t sample, uint8_t prevSample)
+{
+    static const int sDeltaEncodingTable[] = {
+        0, 1, 4, 9, 16, 25, 36, 49, -64, -49, -36, -25, -16, -9, -4, -1,
+    };
+    int bestError = 0x7FFFFFFF;
+    int bestIndex = -1;
+    int start = (int8_t)prevSample <= (int8_t)sample ? 0 : 8;
+
+    for (int i = start; i < start + 8; i++)
+    {
+        int error = abs((int8_t)(uint8_t)(prevSample + sDeltaEncodingTable[i]) - (int8_t)sample);
+
+        if (error < bestError)
+        {
+            bestError = error;
+            bestIndex = i;
+        }
+    }
+    return bestIndex;
+}
+
+// Appends the WaveData that aif2pcm would make from an .aif file.
+static void EmitAif(const char *path, bool compress)
+{
+    static const int sDeltaEncodingTable[] = {
+        0, 1, 4, 9, 16, 25, 36, 49, -64, -49, -36, -25, -16, -9, -4, -1,
+    };
+    long size;
+    uint8_t *aif = (uint8_t *)ReadWholeFile(path, &size);
+    long pos = 12;
+    double sampleRate = 0;
+    uint32_t numSamples = 0, loopOffset = 0;
+    bool hasLoop = false;
+    const uint8_t *samples = NULL;
+    uint32_t realNumSamples = 0;
+    uint16_t loopStartId = 0, loopEndId = 0;
+    const uint8_t *markers = NULL;
+    uint16_t numMarkers = 0;
+
+    if (aif == NULL)
+        Error("can't open \"%s\"", path);
+    if (size < 12 || memcmp(aif, "FORM", 4) != 0 || memcmp(aif + 8, "AIFF", 4) != 0)
+        Error("\"%s\" isn't an AIFF file", path);
+
+    while (pos + 8 < size)
+    {
+        const uint8_t *chunk = aif + pos + 8;
+        uint32_t chunkSize = ReadBigEndian(aif + pos + 4, 4);
+
+        if (pos + 8 + chunkSize > (uint32_t)size)
+            Error("\"%s\" is truncated", path);
+        if (memcmp(aif + pos, "COMM", 4) == 0)
+        {
+            if (numSamples == 0)
+                numSamples = ReadBigEndian(chunk + 2, 4);
+            sampleRate = ReadExtended(chunk + 8);
+        }
+        else if (memcmp(aif + pos, "MARK", 4) == 0)
+        {
+            numMarkers = ReadBigEndian(chunk, 2);
+            markers = chunk + 2;
+        }
+        else if (memcmp(aif + pos, "INST", 4) == 0)
+        {
+            if (ReadBigEndian(chunk + 8, 2))
+            {
+                loopStartId = ReadBigEndian(chunk + 10, 2);
+                loopEndId = ReadBigEndian(chunk + 12, 2);
+            }
+        }
+        else if (memcmp(aif + pos, "SSND", 4) == 0)
+        {
+            samples = chunk + 8;
+            realNumSamples = chunkSize - 8;
+        }
+        pos += 8 + chunkSize;
+    }
+
+    for (int pass = 0; pass < 2; pass++)
+    {
+        const uint8_t *marker = markers;
+
+        for (int i = 0; i < numMarkers; i++)
+        {
+            uint16_t id = ReadBigEndian(marker, 2);
+            uint32_t position = ReadBigEndian(marker + 2, 4);
+
+            if (pass == 0 && id == loopStartId)
+            {
+                loopOffset = position;
+                hasLoop = true;
+                break;
+            }
+            if (pass == 1 && id == loopEndId)
+            {
+                if (position < loopOffset)
+                {
+                    loopOffset = position;
+                    hasLoop = true;
+                }
+                numSamples = position;
+                break;
+            }
+            marker += 7 + marker[6] + !(marker[6] & 1);
+        }
+    }
+
+    RomAlign(4);
+    Emit((hasLoop ? 0x40000000 : 0) | (compress ? 1 : 0), 4);
+    Emit((uint32_t)(sampleRate * 1024), 4);
+    Emit(loopOffset, 4);
+    Emit(numSamples - 1, 4);
+    if (!compress)
+    {
+        RomReserve(realNumSamples);
+        memcpy(&gRom[gRomSize], samples, realNumSamples);
+        gRomSize += realNumSamples;
+    }
+    else
+    {
+        uint32_t i = 0;
+
+        // delta_compress in tools/aif2pcm
+        while (i < realNumSamples)
+        {
+            uint8_t base = samples[i++];
+            int index;
+
+            Emit(base, 1);
+            if (i >= realNumSamples)
+                break;
+            index = GetDeltaIndex(samples[i++], base);
+            base += sDeltaEncodingTable[index];
+            Emit(index, 1);
+            for (int k = 0; k < 31 && i < realNumSamples; k++)
+            {
+                uint8_t deltas;
+
+                index = GetDeltaIndex(samples[i++], base);
+                base += sDeltaEncodingTable[index];
+                deltas = index << 4;
+                if (i < realNumSamples)
+                {
+                    index = GetDeltaIndex(samples[i++], base);
+                    base += sDeltaEncodingTable[index];
+                    deltas |= index;
+                }
+                Emit(deltas, 1);
+            }
+        }
+    }
+    free(aif);
+}
+
+static void EmitIncbin(const char *name)
+{
+    char *path = JoinPath(sRoot, name);
+    long size;
+    char *data = ReadWholeFile(path, &size);
+    size_t length = strlen(path);
+
+    if (data == NULL && length > 4 && strcmp(path + length - 4, ".bin") == 0)
+    {
+        const char *base = strrchr(path, '/') + 1;
+        bool compress = strstr(path, "/cries/") != NULL && strncmp(base, "uncomp_", 7) != 0;
+
+        // Makefile: cries are compressed unless they're named uncomp_*
+        strcpy(path + length - 4, ".aif");
+        EmitAif(path, compress);
+    }
+    else if (data != NULL)
+    {
+        RomReserve(size);
+        memcpy(&gRom[gRomSize], data, size);
+        gRomSize += size;
+    }
+    else
+    {
+        Error("can't open \"%s\"", path);
+    }
+    free(data);
+    free(path);
+}
+
+// Expressions
+
+struct Parser
+{
+    const char *p;
+    uint32_t dot;
+    bool ok;        // false if a symbol wasn't defined yet
+};
+
+static uint32_t SymbolValue(const char *name, bool *ok);
+static int32_t ParseBinary(struct Parser *parser, int level);
+
+static void SkipSpace(struct Parser *parser)
+{
+    while (*parser->p == ' ' || *parser->p == '\t')
+        parser->p++;
+}
+
+static bool IsSymbolChar(char c, bool first)
+{
+    return isalpha((unsigned char)c) || c == '_' || c == '.' || c == '$' || (!first && isdigit((unsigned char)c));
+}
+
+static int32_t ParseUnary(struct Parser *parser)
+{
+    SkipSpace(parser);
+    if (*parser->p == '-')
+    {
+        parser->p++;
+        return -ParseUnary(parser);
+    }
+    if (*parser->p == '~')
+    {
+        parser->p++;
+        return ~ParseUnary(parser);
+    }
+    if (*parser->p == '+')
+    {
+        parser->p++;
+        return ParseUnary(parser);
+    }
+    if (*parser->p == '(')
+    {
+        int32_t value;
+
+        parser->p++;
+        value = ParseBinary(parser, 0);
+        SkipSpace(parser);
+        if (*parser->p != ')')
+            Error("missing ')'");
+        parser->p++;
+        return value;
+    }
+    if (isdigit((unsigned char)*parser->p))
+    {
+        char *end;
+        uint32_t value;
+
+        if (parser->p[0] == '0' && (parser->p[1] == 'b' || parser->p[1] == 'B'))
+            value = strtoul(parser->p + 2, &end, 2);
+        else
+            value = strtoul(parser->p, &end, 0);
+        parser->p = end;
+        return value;
+    }
+    if (*parser->p == '.' && !IsSymbolChar(parser->p[1], false))
+    {
+        parser->p++;
+        return parser->dot;
+    }
+    if (IsSymbolChar(*parser->p, true))
+    {
+        const char *start = parser->p;
+        char name[256];
+
+        while (IsSymbolChar(*parser->p, false))
+            parser->p++;
+        if (parser->p - start >= (long)sizeof(name))
+            Error("symbol name too long");
+        memcpy(name, start, parser->p - start);
+        name[parser->p - start] = 0;
+        return SymbolValue(name, &parser->ok);
+    }
+    Error("bad expression \"%s\"", parser->p);
+    return 0;
+}
+
+// Levels from loosest to tightest, as in GNU as: + -, then | & ^ !, then
+// * / % << >>.
+static int32_t ParseBinary(struct Parser *parser, int level)
+{
+    int32_t value;
+
+    if (level == 3)
+        return ParseUnary(parser);
+
+    value = ParseBinary(parser, level + 1);
+    for (;;)
+    {
+        const char *p;
+        int32_t rhs;
+        char op;
+
+        SkipSpace(parser);
+        p = parser->p;
+        op = *p;
+        if (level == 0 && (op == '+' || op == '-'))
+            parser->p++;
+        else if (level == 1 && (op == '|' || op == '&' || op == '^'))
+            parser->p++;
+        else if (level == 2 && (op == '*' || op == '/' || op == '%'))
+            parser->p++;
+        else if (level == 2 && (p[0] == '<' || p[0] == '>') && p[1] == p[0])
+            parser->p += 2;
+        else
+            return value;
+
+        rhs = ParseBinary(parser, level + 1);
+        switch (op)
+        {
+        case '+': value += rhs; break;
+        case '-': value -= rhs; break;
+        case '|': value |= rhs; break;
+        case '&': value &= rhs; break;
+        case '^': value ^= rhs; break;
+        case '*': value *= rhs; break;
+        case '<': value = (uint32_t)value << rhs; break;
+        case '>': value >>= rhs; break;
+        case '/':
+        case '%':
+            if (rhs == 0)
+            {
+                if (parser->ok)
+                    Error("division by zero");
+                rhs = 1;
+            }
+            value = op == '/' ? value / rhs : value % rhs;
+            break;
+        }
+    }
+}
+
+static uint32_t Evaluate(const char *expr, uint32_t dot, bool *ok)
+{
+    struct Parser parser = { expr, dot, true };
+    uint32_t value = ParseBinary(&parser, 0);
+
+    SkipSpace(&parser);
+    if (*parser.p != 0)
+        Error("bad expression \"%s\"", expr);
+    *ok = parser.ok;
+    return value;
+}
+
+static uint32_t SymbolValue(const char *name, bool *ok)
+{
+    struct Symbol *sym = FindSymbol(name, false);
+
+    if (sym == NULL)
+    {
+        *ok = false;
+        return 0;
+    }
+    if (sym->expr)
+    {
+        bool exprOk;
+        uint32_t value;
+
+        if (sym->resolving)
+            Error("\"%s\" is defined in terms of itself", name);
+        sym->resolving = true;
+        value = Evaluate(sym->expr, sym->dot, &exprOk);
+        sym->resolving = false;
+        if (!exprOk)
+        {
+            *ok = false;
+            return 0;
+        }
+        free(sym->expr);
+        sym->expr = NULL;
+        sym->value = value;
+        sym->defined = true;
+    }
+    if (!sym->defined)
+        *ok = false;
+    return sym->value;
+}
+
+uint32_t LookupSymbol(const char *name)
+{
+    bool ok = true;
+    uint32_t value = SymbolValue(name, &ok);
+
+    return ok ? value : 0;
+}
+
+static void AddFixup(const char *expr, int size)
+{
+    struct Fixup *fixup;
+
+    if (sNumFixups == sFixupCapacity)
+    {
+        sFixupCapacity = sFixupCapacity ? sFixupCapacity * 2 : 4096;
+        sFixups = realloc(sFixups, sFixupCapacity * sizeof(*sFixups));
+        if (sFixups == NULL)
+            FATAL_ERROR("Out of memory.\n");
+    }
+    fixup = &sFixups[sNumFixups++];
+    fixup->offset = gRomSize;
+    fixup->size = size;
+    fixup->expr = StrDup(expr, strlen(expr));
+    fixup->dot = ROM_BASE + gRomSize;
+    fixup->file = StrDup(sFile, strlen(sFile));
+    fixup->line = sLine;
+}
+
+static void ResolveFixups(void)
+{
+    for (int i = 0; i < sNumFixups; i++)
+    {
+        struct Fixup *fixup = &sFixups[i];
+        bool ok;
+        uint32_t value;
+
+        sFile = fixup->file;
+        sLine = fixup->line;
+        value = Evaluate(fixup->expr, fixup->dot, &ok);
+        if (!ok)
+            Error("undefined symbol in \"%s\"", fixup->expr);
+        for (int j = 0; j < fixup->size; j++)
+            gRom[fixup->offset + j] = value >> (j * 8);
+        free(fixup->expr);
+        free(fixup->file);
+    }
+    sNumFixups = 0;
+    sFile = NULL;
+}
+
+static void EmitExpr(const char *expr, int size)
+{
+    bool ok;
+    uint32_t value = Evaluate(expr, ROM_BASE + gRomSize, &ok);
+
+    if (!ok)
+    {
+        AddFixup(expr, size);
+        value = 0;
+    }
+    Emit(value, size);
+}
+
+// Statements
+
+static char *Trim(char *s)
+{
+    char *end;
+
+    while (*s == ' ' || *s == '\t')
+        s++;
+    end = s + strlen(s);
+    while (end > s && isspace((unsigned char)end[-1]))
+        end--;
+    *end = 0;
+    return s;
+}
+
+static int SplitArgs(char *s, char **args)
+{
+    int count = 0;
+    int depth = 0;
+
+    s = Trim(s);
+    if (*s == 0)
+        return 0;
+    args[count++] = s;
+    for (; *s; s++)
+    {
+        if (*s == '(')
+        {
+            depth++;
+        }
+        else if (*s == ')')
+        {
+            depth--;
+        }
+        else if (*s == ',' && depth == 0)
+        {
+            if (count == MAX_ARGS)
+                Error("too many arguments");
+            *s = 0;
+            args[count++] = s + 1;
+        }
+    }
+    for (int i = 0; i < count; i++)
+        args[i] = Trim(args[i]);
+    return count;
+}
+
+static char *ParseString(char *s)
+{
+    char *end;
+
+    s = Trim(s);
+    if (*s != '"' || (end = strchr(s + 1, '"')) == NULL)
+        Error("expected a string");
+    *end = 0;
+    return s + 1;
+}
+
+static void DefineEqu(const char *name, const char *expr)
+{
+    struct Symbol *sym = FindSymbol(name, true);
+    bool ok;
+    uint32_t value = Evaluate(expr, ROM_BASE + gRomSize, &ok);
+
+    free(sym->expr);
+    sym->expr = NULL;
+    if (ok)
+    {
+        sym->value = value;
+        sym->defined = true;
+    }
+    else
+    {
+        sym->expr = StrDup(expr, strlen(expr));
+        sym->dot = ROM_BASE + gRomSize;
+        sym->defined = false;
+    }
+}
+
+static void DefineLabel(const char *name)
+{
+    struct Symbol *sym = FindSymbol(name, true);
+
+    if (sym->defined)
+        Error("\"%s\" is already defined", name);
+    sym->value = ROM_BASE + gRomSize;
+    sym->defined = true;
+}
+
+static void EmitArgs(char *s, int size)
+{
+    char *args[MAX_ARGS];
+    int count = SplitArgs(s, args);
+
+    for (int i = 0; i < count; i++)
+        EmitExpr(args[i], size);
+}
+
+static void EmitPan(const char *pan)
+{
+    bool ok;
+    uint32_t value = Evaluate(pan, ROM_BASE + gRomSize, &ok);
+
+    if (!ok)
+        Error("undefined symbol in \"%s\"", pan);
+    Emit(value != 0 ? 0x80 | value : 0, 1);
+}
+
+static void EmitMasked(const char *arg, int mask)
+{
+    char expr[256];
+
+    snprintf(expr, sizeof(expr), "(%s) & %d", arg, mask);
+    EmitExpr(expr, 1);
+}
+
+// Must match asm/macros/music_voice.inc
+static bool AssembleMacro(const char *name, char *argString)
+{
+    static const struct
+    {
+        const char *name;
+        uint8_t type;
+        int numArgs;
+    } sVoiceMacros[] = {
+        { "voice_directsound", 0, 7 },
+        { "voice_directsound_no_resample", 8, 7 },
+        { "voice_directsound_alt", 16, 7 },
+        { "voice_square_1", 1, 8 },
+        { "voice_square_1_alt", 9, 8 },
+        { "voice_square_2", 2, 7 },
+        { "voice_square_2_alt", 10, 7 },
+        { "voice_programmable_wave", 3, 7 },
+        { "voice_programmable_wave_alt", 11, 7 },
+        { "voice_noise", 4, 7 },
+        { "voice_noise_alt", 12, 7 },
+        { "voice_keysplit", 0x40, 2 },
+        { "voice_keysplit_all", 0x80, 1 },
+        { "cry", 0x20, 1 },
+        { "cry2", 0x30, 1 },
+        { "cry_uncomp", 0x00, 1 },
+        { "cry2_uncomp", 0x10, 1 },
+    };
+    char *args[MAX_ARGS];
+    int count = SplitArgs(argString, args);
+    size_t i;
+
+    for (i = 0; i < sizeof(sVoiceMacros) / sizeof(sVoiceMacros[0]); i++)
+    {
+        if (strcmp(name, sVoiceMacros[i].name) == 0)
+            break;
+    }
+    if (i == sizeof(sVoiceMacros) / sizeof(sVoiceMacros[0]))
+        return false;
+    if (count != sVoiceMacros[i].numArgs)
+        Error("%s takes %d arguments", name, sVoiceMacros[i].numArgs);
+
+    Emit(sVoiceMacros[i].type, 1);
+    if (strncmp(name, "cry", 3) == 0)
+    {
+        Emit(60, 1);
+        Emit(0, 2);
+        EmitExpr(args[0], 4);
+        Emit(0x00FF00FF, 4);
+    }
+    else if (strcmp(name, "voice_keysplit") == 0 || strcmp(name, "voice_keysplit_all") == 0)
+    {
+        Emit(0, 3);
+        EmitExpr(args[0], 4);
+        if (count == 2)
+            EmitExpr(args[1], 4);
+        else
+            Emit(0, 4);
+    }
+    else if (strncmp(name, "voice_directsound", 17) == 0)
+    {
+        EmitExpr(args[0], 1);
+        Emit(0, 1);
+        EmitPan(args[1]);
+        EmitExpr(args[2], 4);
+        for (int j = 3; j < 7; j++)
+            EmitExpr(args[j], 1);
+    }
+    else if (strncmp(name, "voice_programmable_wave", 23) == 0)
+    {
+        EmitExpr(args[0], 1);
+        EmitPan(args[1]);
+        Emit(0, 1);
+        EmitExpr(args[2], 4);
+        EmitMasked(args[3], 7);
+        EmitMasked(args[4], 7);
+        EmitMasked(args[5], 15);
+        EmitMasked(args[6], 7);
+    }
+    else
+    {
+        // voice_square_1 has a sweep argument, the others don't
+        int arg = 3;
+
+        EmitExpr(args[0], 1);
+        EmitPan(args[1]);
+        if (strncmp(name, "voice_square_1", 14) == 0)
+        {
+            EmitExpr(args[2], 1);
+        }
+        else
+        {
+            Emit(0, 1);
+            arg = 2;
+        }
+        EmitMasked(args[arg], strncmp(name, "voice_noise", 11) == 0 ? 1 : 3);
+        Emit(0, 3);
+        EmitMasked(args[arg + 1], 7);
+        EmitMasked(args[arg + 2], 7);
+        EmitMasked(args[arg + 3], 15);
+        EmitMasked(args[arg + 4], 7);
+    }
+    return true;
+}
+
+static void AssembleFile(const char *path);
+
+static void AssembleInclude(const char *name)
+{
+    static const char *const sIncludeDirs[] = { "", "sound", "include" };
+
+    for (size_t i = 0; i < sizeof(sIncludeDirs) / sizeof(sIncludeDirs[0]); i++)
+    {
+        char *dir = JoinPath(sRoot, sIncludeDirs[i]);
+        char *path = JoinPath(dir, name);
+        FILE *fp = fopen(path, "rb");
+
+        free(dir);
+        if (fp != NULL)
+        {
+            fclose(fp);
+            AssembleFile(path);
+            free(path);
+            return;
+        }
+        free(path);
+    }
+    Error("can't find \"%s\"", name);
+}
+
+// Returns false at .end
+static bool AssembleDirective(char *directive, char *rest)
+{
+    if (strcmp(directive, ".byte") == 0)
+    {
+        EmitArgs(rest, 1);
+    }
+    else if (strcmp(directive, ".2byte") == 0 || strcmp(directive, ".hword") == 0 || strcmp(directive, ".short") == 0)
+    {
+        EmitArgs(rest, 2);
+    }
+    else if (strcmp(directive, ".4byte") == 0 || strcmp(directive, ".word") == 0 || strcmp(directive, ".long") == 0)
+    {
+        EmitArgs(rest, 4);
+    }
+    else if (strcmp(directive, ".align") == 0 || strcmp(directive, ".balign") == 0)
+    {
+        char *args[MAX_ARGS];
+        bool ok;
+        uint32_t value;
+
+        if (SplitArgs(rest, args) < 1)
+            Error("%s needs an argument", directive);
+        value = Evaluate(args[0], 0, &ok);
+        if (!ok)
+            Error("bad alignment");
+        RomAlign(strcmp(directive, ".align") == 0 ? 1u << value : value);
+    }
+    else if (strcmp(directive, ".space") == 0 || strcmp(directive, ".skip") == 0)
+    {
+        bool ok;
+        uint32_t size = Evaluate(Trim(rest), 0, &ok);
+
+        if (!ok)
+            Error("bad size");
+        while (size--)
+            Emit(0, 1);
+    }
+    else if (strcmp(directive, ".equ") == 0 || strcmp(directive, ".set") == 0 || strcmp(directive, ".equiv") == 0)
+    {
+        char *args[MAX_ARGS];
+
+        if (SplitArgs(rest, args) != 2)
+            Error("%s needs a name and a value", directive);
+        DefineEqu(args[0], args[1]);
+    }
+    else if (strcmp(directive, ".include") == 0)
+    {
+        const char *file = sFile;
+        int line = sLine;
+
+        AssembleInclude(ParseString(rest));
+        sFile = file;
+        sLine = line;
+    }
+    else if (strcmp(directive, ".incbin") == 0)
+    {
+        EmitIncbin(ParseString(rest));
+    }
+    else if (strcmp(directive, ".end") == 0)
+    {
+        return false;
+    }
+    else if (strcmp(directive, ".global") != 0 && strcmp(directive, ".globl") != 0
+          && strcmp(directive, ".section") != 0 && strcmp(directive, ".text") != 0
+          && strcmp(directive, ".data") != 0 && strcmp(directive, ".size") != 0
+          && strcmp(directive, ".type") != 0)
+    {
+        Error("unsupported directive %s", directive);
+    }
+    return true;
+}
+
+static void AssembleFile(const char *path)
+{
+    long size;
+    char *text = ReadWholeFile(path, &size);
+    char *line;
+    int lineNum = 0;
+
+    if (text == NULL)
+        FATAL_ERROR("Failed to open \"%s\".\n", path);
+    sFile = path;
+
+    for (line = text; line != NULL; )
+    {
+        char *next = strchr(line, '\n');
+        char *s, *comment, *word, *rest;
+        char saved;
+
+        if (next)
+            *next++ = 0;
+        sLine = ++lineNum;
+
+        comment = line;
+        while ((comment = strchr(comment, '@')) != NULL)
+        {
+            // '@' inside a string isn't a comment
+            int quotes = 0;
+
+            for (char *q = line; q < comment; q++)
+                quotes += *q == '"';
+            if (quotes % 2 == 0)
+            {
+                *comment = 0;
+                break;
+            }
+            comment++;
+        }
+
+        s = Trim(line);
+        for (;;)
+        {
+            char *colon = s;
+
+            while (IsSymbolChar(*colon, colon == s))
+                colon++;
+            if (colon == s || *colon != ':')
+                break;
+            *colon++ = 0;
+            DefineLabel(s);
+            if (*colon == ':')
+                colon++;
+            s = Trim(colon);
+        }
+        if (*s == 0)
+        {
+            line = next;
+            continue;
+        }
+
+        word = s;
+        while (*s && !isspace((unsigned char)*s) && *s != '=')
+            s++;
+        saved = *s;
+        *s = 0;
+        rest = saved == '=' ? s : Trim(saved ? s + 1 : s);
+        if (saved == '=' || (rest[0] == '=' && rest[1] != '='))
+        {
+            // name = value
+            DefineEqu(word, Trim(rest + 1));
+        }
+        else if (word[0] == '.')
+        {
+            if (!AssembleDirective(word, rest))
+                break;
+        }
+        else if (!AssembleMacro(word, rest))
+        {
+            Error("unknown instruction or macro \"%s\"", word);
+        }
+        line = next;
+    }
+    free(text);
+}
+
+// The sound data that every song can use, as data/sound_data.s includes it.
+// The music player and song tables are left out; the engine has its own.
+void LoadSoundData(const char *root)
+{
+    static const char *const sFiles[] = {
+        "sound/voice_groups.inc",
+        "sound/keysplit_tables.inc",
+        "sound/programmable_wave_data.inc",
+        "sound/direct_sound_data.inc",
+    };
+
+    sRoot = StrDup(root, strlen(root));
+    RomAlloc(0x100);
+    for (size_t i = 0; i < sizeof(sFiles) / sizeof(sFiles[0]); i++)
+    {
+        char *path = JoinPath(sRoot, sFiles[i]);
+
+        AssembleFile(path);
+        free(path);
+    }
+    ResolveFixups();
+}
+
+// Looks up which music player the song table gives a song.
+static int GetSongPlayer(const char *name)
+{
+    char *path = JoinPath(sRoot, "sound/song_table.inc");
+    long size;
+    char *text = ReadWholeFile(path, &size);
+    int player = 0;
+
+    if (text != NULL)
+    {
+        for (char *line = strstr(text, "song "); line != NULL; line = strstr(line + 1, "song "))
+        {
+            char *args[MAX_ARGS];
+            char *end = strchr(line, '\n');
+
+            if (end)
+                *end = 0;
+            if (SplitArgs(line + 5, args) >= 2 && strcmp(args[0], name) == 0)
+            {
+                player = strtol(args[1], NULL, 0);
+                break;
+            }
+            if (end)
+                line = end;
+            else
+                break;
+        }
+        free(text);
+    }
+    free(path);
+    return player;
+}
+
+// Assembles a song and returns its header's address. The header is the label
+// named after the file, as in the song table.
+uint32_t LoadSong(const char *path, int *player)
+{
+    const char *base = strrchr(path, '/') ? strrchr(path, '/') + 1 : path;
+    size_t length = strcspn(base, ".");
+    char *name = StrDup(base, length);
+    uint32_t header = LookupSymbol(name);
+
+    if (header == 0)
+    {
+        AssembleFile(path);
+        ResolveFixups();
+        header = LookupSymbol(name);
+        if (header == 0)
+            FATAL_ERROR("\"%s\" doesn't define the song header \"%s\".\n", path, name);
+    }
+    *player = GetSongPlayer(name);
+    free(name);
+    return header;
+}
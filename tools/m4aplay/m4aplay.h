@@ -0,0 +1,239 @@
+#ifndef M4APLAY_H
+#define M4APLAY_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef _MSC_VER
+
+#define FATAL_ERROR(format, ...)          \
+do                                        \
+{                                         \
+    fprintf(stderr, format, __VA_ARGS__); \
+    exit(1);                              \
+} while (0)
+
+#else
+
+#define FATAL_ERROR(format, ...)            \
+do                                          \
+{                                           \
+    fprintf(stderr, format, ##__VA_ARGS__); \
+    exit(1);                                \
+} while (0)
+
+#endif // _MSC_VER
+
+// The sound data is assembled into a ROM image at the addresses it would
+// have on the cartridge, so the pointers in songs and voicegroups work as is.
+#define ROM_BASE 0x08000000
+
+extern uint8_t *gRom;
+extern uint32_t gRomSize;
+
+static inline uint8_t RomRead8(uint32_t addr)
+{
+    uint32_t offset = addr - ROM_BASE;
+    return offset < gRomSize ? gRom[offset] : 0;
+}
+
+static inline uint16_t RomRead16(uint32_t addr)
+{
+    return RomRead8(addr) | (RomRead8(addr + 1) << 8);
+}
+
+static inline uint32_t RomRead32(uint32_t addr)
+{
+    return RomRead16(addr) | ((uint32_t)RomRead16(addr + 2) << 16);
+}
+
+// Must match include/gba/m4a_internal.h
+#define TONEDATA_TYPE_CGB    0x07
+#define TONEDATA_TYPE_FIX    0x08
+#define TONEDATA_TYPE_REV    0x10
+#define TONEDATA_TYPE_CMP    0x20
+#define TONEDATA_TYPE_SPL    0x40
+#define TONEDATA_TYPE_RHY    0x80
+
+#define SOUND_CHANNEL_SF_START       0x80
+#define SOUND_CHANNEL_SF_STOP        0x40
+#define SOUND_CHANNEL_SF_LOOP        0x10
+#define SOUND_CHANNEL_SF_IEC         0x04
+#define SOUND_CHANNEL_SF_ENV         0x03
+#define SOUND_CHANNEL_SF_ENV_ATTACK  0x03
+#define SOUND_CHANNEL_SF_ENV_DECAY   0x02
+#define SOUND_CHANNEL_SF_ENV_SUSTAIN 0x01
+#define SOUND_CHANNEL_SF_ENV_RELEASE 0x00
+#define SOUND_CHANNEL_SF_ON (SOUND_CHANNEL_SF_START | SOUND_CHANNEL_SF_STOP | SOUND_CHANNEL_SF_IEC | SOUND_CHANNEL_SF_ENV)
+
+#define CGB_CHANNEL_MO_PIT  0x02
+#define CGB_CHANNEL_MO_VOL  0x01
+
+#define MAX_DIRECTSOUND_CHANNELS 15
+#define PCM_DMA_BUF_SIZE 0x620
+#define MAX_FRAME_LENGTH 0x2C0
+
+// A playing note. The game has separate structs for DirectSound and CGB
+// channels that share a layout for the common fields; here one struct holds
+// the fields of both.
+struct SoundChannel
+{
+    uint8_t statusFlags;
+    uint8_t type;
+    uint8_t rightVolume;
+    uint8_t leftVolume;
+    uint8_t attack;
+    uint8_t decay;
+    uint8_t sustain;
+    uint8_t release;
+    uint8_t key;
+    uint8_t envelopeVolume;
+    uint8_t envelopeGoal;
+    uint8_t envelopeCounter;
+    uint8_t pseudoEchoVolume;
+    uint8_t pseudoEchoLength;
+    uint8_t gateTime;
+    uint8_t midiKey;
+    uint8_t velocity;
+    uint8_t priority;
+    int8_t rhythmPan;
+    uint8_t sustainGoal;
+    uint8_t n4;
+    uint8_t pan;
+    uint8_t panMask;
+    uint8_t modify;
+    uint8_t length;
+    uint8_t sweep;
+    int8_t sampleStor;
+    uint32_t count;
+    uint32_t fw;
+    uint32_t frequency;
+    uint32_t wav;               // WaveData, or the CGB wavePointer
+    uint32_t currentPointer;
+    struct MusicPlayerTrack *track;
+    struct SoundChannel *prev;
+    struct SoundChannel *next;
+};
+
+struct ToneData
+{
+    uint8_t type;
+    uint8_t key;
+    uint8_t length;
+    uint8_t pan_sweep;
+    uint32_t wav;
+    uint8_t attack;
+    uint8_t decay;
+    uint8_t sustain;
+    uint8_t release;
+};
+
+struct MusicPlayerTrack
+{
+    uint8_t flags;
+    uint8_t wait;
+    uint8_t patternLevel;
+    uint8_t repN;
+    uint8_t gateTime;
+    uint8_t key;
+    uint8_t velocity;
+    uint8_t runningStatus;
+    int8_t keyM;
+    uint8_t pitM;
+    int8_t keyShift;
+    int8_t keyShiftX;
+    int8_t tune;
+    uint8_t pitX;
+    int8_t bend;
+    uint8_t bendRange;
+    uint8_t volMR;
+    uint8_t volML;
+    uint8_t vol;
+    uint8_t volX;
+    int8_t pan;
+    int8_t panX;
+    int8_t modM;
+    uint8_t mod;
+    uint8_t modT;
+    uint8_t lfoSpeed;
+    uint8_t lfoSpeedC;
+    uint8_t lfoDelay;
+    uint8_t lfoDelayC;
+    uint8_t priority;
+    uint8_t pseudoEchoVolume;
+    uint8_t pseudoEchoLength;
+    uint16_t unk_3A;
+    uint32_t unk_3C;
+    struct SoundChannel *chan;
+    struct ToneData tone;
+    uint32_t cmdPtr;
+    uint32_t patternStack[3];
+};
+
+struct MusicPlayerInfo
+{
+    uint32_t songHeader;
+    uint32_t status;
+    uint8_t trackCount;
+    uint8_t priority;
+    uint8_t cmd;
+    uint32_t clock;
+    uint32_t tone;
+    uint16_t tempoD;
+    uint16_t tempoU;
+    uint16_t tempoI;
+    uint16_t tempoC;
+    struct MusicPlayerTrack *tracks;
+};
+
+// How much mixing work a frame took, in estimated GBA cycles.
+struct MixerCost
+{
+    uint32_t cycles;
+    uint8_t activeChannels;
+};
+
+struct SoundInfo
+{
+    uint8_t reverb;
+    uint8_t maxChans;
+    uint8_t masterVolume;
+    uint8_t c15;
+    uint8_t pcmDmaPeriod;
+    uint8_t pcmDmaSlot;
+    uint16_t pcmSamplesPerVBlank;
+    uint32_t pcmFreq;
+    uint32_t divFreq;
+    uint8_t halfRateBand;
+    uint8_t noiseShapeLeft;
+    uint8_t noiseShapeRight;
+    struct SoundChannel chans[MAX_DIRECTSOUND_CHANNELS];
+    struct SoundChannel cgbChans[4];
+    int8_t pcmBuffer[PCM_DMA_BUF_SIZE * 2];
+    uint32_t hqBuffer[MAX_FRAME_LENGTH];
+    uint32_t halfRateBuffer[MAX_FRAME_LENGTH / 2 + 2];
+    struct MixerCost cost;
+};
+
+extern struct SoundInfo gSoundInfo;
+extern const uint16_t gPcmSamplesPerVBlankTable[12];
+
+// loader.c
+void LoadSoundData(const char *root);
+uint32_t LoadSong(const char *path, int *player);
+uint32_t LookupSymbol(const char *name);
+uint32_t RomAlloc(uint32_t size);
+
+// engine.c
+void SoundInit(int freqIndex, int maxChans, int masterVolume, bool halfRateBand);
+void StartSong(uint32_t header, int player);
+void StartCry(uint32_t tone);
+bool SoundIsPlaying(void);
+void SoundFrame(int16_t *out);
+
+// mixer.c
+void SoundMainRAM(void);
+
+#endif // M4APLAY_H
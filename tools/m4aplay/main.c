@@ -0,0 +1,424 @@
+// m4aplay - plays the game's songs and cries through a C port of the m4a
+// sound engine and its mixer, to render them to WAV files or to estimate what
+// mixing them costs at each sample rate and channel count.
+//
+// Usage:
+//   m4aplay [options] render <out.wav> <sound>...
+//   m4aplay [options] bench <sound>...
+//   m4aplay diff <a.wav> <b.wav>
+//
+// A <sound> is a song's .s file, or cry:<Name> for the cry sample Cry_<Name>,
+// optionally followed by @<frame> to start it that many frames in. Songs
+// play on the music player the song table gives them and cries the way
+// PlayCry5 plays them, ducking the BGM. For example
+//   m4aplay bench sound/songs/midi/mus_vs_wild.s cry:Charizard@120
+// Songs that are made from MIDI files have to be built with mid2agb first;
+// "make songs" in tools/m4aplay does that for the battle songs.
+//
+// Options:
+//   -r <hz>       sample rate, one of the SOUND_MODE_FREQ_* rates
+//                 (default 13379, as m4aSoundInit sets)
+//   -c <n>        DirectSound channels, 1-15 (default 15)
+//   -v <n>        master volume, 1-15 (default 15)
+//   -t <seconds>  longest time to play (default 60). Rendering stops early
+//                 once everything has finished.
+//   -R <dir>      root of the repository (default .)
+//   -b            mix low pitched channels at half the rate, as the mixer
+//                 does with SOUND_MIXER_HALF_RATE_BAND set. Only rates whose
+//                 frames are a multiple of 16 samples use it.
+//
+// render writes 16-bit stereo at the sample rate. bench plays the sounds at
+// every sample rate with 4, 8, 12 and 15 channels and prints the mixer's
+// estimated cost per frame, the channels it mixed and the host's time per
+// frame. diff compares two renders, as a check that a change to the mixer
+// doesn't change its output; it exits with 1 if they differ. "make check"
+// compares a few renders to the checksums in check.sha256.
+
+#include <string.h>
+#include <time.h>
+#include <math.h>
+#include "m4aplay.h"
+
+#define FRAMES_PER_SECOND 60
+#define CYCLES_PER_FRAME 280896
+
+struct Sound
+{
+    const char *name;
+    uint32_t address;   // song header or cry ToneData
+    int player;         // -1 for cries
+    int frame;
+};
+
+static struct Sound *sSounds;
+static int sNumSounds;
+static int sMaxChans = MAX_DIRECTSOUND_CHANNELS;
+static int sMasterVolume = 15;
+static int sSeconds = 60;
+static bool sHalfRateBand;
+
+static void Usage(void)
+{
+    fprintf(stderr,
+            "Usage: m4aplay [options] render <out.wav> <sound>...\n"
+            "       m4aplay [options] bench <sound>...\n"
+            "       m4aplay diff <a.wav> <b.wav>\n"
+            "A sound is a song's .s file or cry:<Name>, with an optional @<frame>\n"
+            "Options: -r <hz>  -c <channels>  -v <master volume>  -t <seconds>  -R <root>  -b\n");
+    exit(1);
+}
+
+static int ParseInt(const char *string, int min, int max)
+{
+    char *end;
+    long value = strtol(string, &end, 0);
+
+    if (*string == '\0' || *end != '\0' || value < min || value > max)
+        FATAL_ERROR("Expected a number from %d to %d, got \"%s\"\n", min, max, string);
+    return value;
+}
+
+// The SOUND_MODE_FREQ_* index of a rate in Hz
+static int GetFreqIndex(int hz)
+{
+    for (int i = 1; i <= 12; i++)
+    {
+        if (hz == (597275 * gPcmSamplesPerVBlankTable[i - 1] + 5000) / 10000)
+            return i;
+    }
+    FATAL_ERROR("%d Hz isn't one of the SOUND_MODE_FREQ_* rates\n", hz);
+}
+
+// Finds the ToneData gCryTable has for a cry.
+static uint32_t FindCry(const char *name)
+{
+    char symbol[256];
+    uint32_t sample;
+    uint32_t table = LookupSymbol("gCryTable");
+    uint32_t end = LookupSymbol("gCryTable2");
+
+    snprintf(symbol, sizeof(symbol), "Cry_%s", name);
+    sample = LookupSymbol(symbol);
+    if (sample == 0)
+        FATAL_ERROR("There's no cry sample called %s\n", symbol);
+    for (uint32_t tone = table; tone < end; tone += 12)
+    {
+        if (RomRead32(tone + 4) == sample)
+            return tone;
+    }
+    FATAL_ERROR("%s isn't in gCryTable\n", symbol);
+}
+
+static void LoadSounds(char **args, int count)
+{
+    sSounds = calloc(count, sizeof(*sSounds));
+    if (sSounds == NULL)
+        FATAL_ERROR("Out of memory.\n");
+    sNumSounds = count;
+
+    for (int i = 0; i < count; i++)
+    {
+        struct Sound *sound = &sSounds[i];
+        char *at = strrchr(args[i], '@');
+
+        if (at != NULL)
+        {
+            *at = 0;
+            sound->frame = ParseInt(at + 1, 0, 0x7FFFFFFF);
+        }
+        sound->name = args[i];
+        if (strncmp(args[i], "cry:", 4) == 0)
+        {
+            sound->address = FindCry(args[i] + 4);
+            sound->player = -1;
+        }
+        else
+        {
+            sound->address = LoadSong(args[i], &sound->player);
+        }
+    }
+}
+
+// Plays the sounds from the start for at most maxFrames frames, calling
+// onFrame after each. Returns the number of frames played.
+static int Play(int freqIndex, void (*onFrame)(const int16_t *samples, int count, void *data), void *data)
+{
+    static int16_t samples[MAX_FRAME_LENGTH * 2];
+    int maxFrames = sSeconds * FRAMES_PER_SECOND;
+    int frame;
+
+    SoundInit(freqIndex, sMaxChans, sMasterVolume, sHalfRateBand);
+    for (frame = 0; frame < maxFrames; frame++)
+    {
+        bool pending = false;
+
+        for (int i = 0; i < sNumSounds; i++)
+        {
+            if (sSounds[i].frame == frame)
+            {
+                if (sSounds[i].player < 0)
+                    StartCry(sSounds[i].address);
+                else
+                    StartSong(sSounds[i].address, sSounds[i].player);
+            }
+            if (sSounds[i].frame > frame)
+                pending = true;
+        }
+        if (!pending && frame > 0 && !SoundIsPlaying())
+            break;
+        SoundFrame(samples);
+        onFrame(samples, gSoundInfo.pcmSamplesPerVBlank, data);
+    }
+    return frame;
+}
+
+// render
+
+static void WriteWavHeader(FILE *fp, uint32_t rate, uint32_t dataSize)
+{
+    uint8_t header[44];
+    uint32_t fields[][2] = {
+        { 4, 36 + dataSize }, { 16, 16 }, { 24, rate }, { 28, rate * 4 }, { 40, dataSize },
+    };
+
+    memcpy(header, "RIFF....WAVEfmt ", 16);
+    memcpy(header + 20, "\x01\x00\x02\x00", 4);   // PCM, stereo
+    memcpy(header + 32, "\x04\x00\x10\x00", 4);   // 4 bytes per frame, 16 bits
+    memcpy(header + 36, "data", 4);
+    for (size_t i = 0; i < sizeof(fields) / sizeof(fields[0]); i++)
+    {
+        for (int j = 0; j < 4; j++)
+            header[fields[i][0] + j] = fields[i][1] >> (j * 8);
+    }
+    fwrite(header, sizeof(header), 1, fp);
+}
+
+static void WriteFrame(const int16_t *samples, int count, void *data)
+{
+    FILE *fp = data;
+
+    for (int i = 0; i < count * 2; i++)
+    {
+        fputc(samples[i] & 0xFF, fp);
+        fputc((samples[i] >> 8) & 0xFF, fp);
+    }
+}
+
+static void Render(const char *path, int freqIndex)
+{
+    FILE *fp = fopen(path, "wb");
+    long size;
+    int frames;
+
+    if (fp == NULL)
+        FATAL_ERROR("Failed to open \"%s\" for writing.\n", path);
+    WriteWavHeader(fp, 0, 0);
+    frames = Play(freqIndex, WriteFrame, fp);
+    size = ftell(fp) - 44;
+    fseek(fp, 0, SEEK_SET);
+    WriteWavHeader(fp, gSoundInfo.pcmFreq, size);
+    fclose(fp);
+    printf("%s: %d frames, %lu Hz\n", path, frames, (unsigned long)gSoundInfo.pcmFreq);
+}
+
+// bench
+
+struct BenchStats
+{
+    uint64_t totalCycles;
+    uint32_t peakCycles;
+    uint64_t totalChannels;
+    int peakChannels;
+};
+
+static void CountFrame(const int16_t *samples, int count, void *data)
+{
+    struct BenchStats *stats = data;
+    const struct MixerCost *cost = &gSoundInfo.cost;
+
+    (void)samples;
+    (void)count;
+    stats->totalCycles += cost->cycles;
+    if (stats->peakCycles < cost->cycles)
+        stats->peakCycles = cost->cycles;
+    stats->totalChannels += cost->activeChannels;
+    if (stats->peakChannels < cost->activeChannels)
+        stats->peakChannels = cost->activeChannels;
+}
+
+static void Bench(void)
+{
+    static const int sChannelCounts[] = { 4, 8, 12, 15 };
+
+    printf("    rate  chans  avg cycles  peak cycles  peak %%frame  avg/peak mixed  host ns/frame\n");
+    for (int freqIndex = 1; freqIndex <= 12; freqIndex++)
+    {
+        for (size_t i = 0; i < sizeof(sChannelCounts) / sizeof(sChannelCounts[0]); i++)
+        {
+            struct BenchStats stats = { 0 };
+            clock_t start;
+            double seconds;
+            int frames;
+
+            sMaxChans = sChannelCounts[i];
+            start = clock();
+            frames = Play(freqIndex, CountFrame, &stats);
+            seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+            if (frames == 0)
+                FATAL_ERROR("Nothing played.\n");
+
+            printf("%8lu  %5d  %10.0f  %11lu  %10.1f%%  %6.1f / %-5d  %13.0f\n",
+                   (unsigned long)gSoundInfo.pcmFreq, sMaxChans,
+                   (double)stats.totalCycles / frames,
+                   (unsigned long)stats.peakCycles,
+                   100.0 * stats.peakCycles / CYCLES_PER_FRAME,
+                   (double)stats.totalChannels / frames, stats.peakChannels,
+                   seconds * 1e9 / frames);
+        }
+    }
+}
+
+// diff
+
+static int16_t *ReadWav(const char *path, uint32_t *count, uint32_t *rate)
+{
+    FILE *fp = fopen(path, "rb");
+    uint8_t header[44];
+    int16_t *samples;
+
+    if (fp == NULL)
+        FATAL_ERROR("Failed to open \"%s\" for reading.\n", path);
+    if (fread(header, sizeof(header), 1, fp) != 1 || memcmp(header, "RIFF", 4) != 0
+     || memcmp(header + 36, "data", 4) != 0 || header[22] != 2 || header[34] != 16)
+        FATAL_ERROR("\"%s\" isn't a render from m4aplay.\n", path);
+
+    *rate = header[24] | (header[25] << 8) | (header[26] << 16) | ((uint32_t)header[27] << 24);
+    *count = (header[40] | (header[41] << 8) | (header[42] << 16) | ((uint32_t)header[43] << 24)) / 2;
+    samples = malloc(*count * sizeof(int16_t) + 1);
+    if (samples == NULL)
+        FATAL_ERROR("Out of memory.\n");
+    for (uint32_t i = 0; i < *count; i++)
+    {
+        int lo = fgetc(fp);
+        int hi = fgetc(fp);
+
+        if (hi == EOF)
+            FATAL_ERROR("\"%s\" is truncated.\n", path);
+        samples[i] = (int16_t)(lo | (hi << 8));
+    }
+    fclose(fp);
+    return samples;
+}
+
+static int Diff(const char *pathA, const char *pathB)
+{
+    uint32_t countA, countB, rateA, rateB;
+    int16_t *a = ReadWav(pathA, &countA, &rateA);
+    int16_t *b = ReadWav(pathB, &countB, &rateB);
+    uint32_t count = countA < countB ? countA : countB;
+    int maxDiff = 0;
+    uint32_t firstDiff = count;
+    double sumSquares = 0;
+
+    if (rateA != rateB)
+    {
+        printf("Sample rates differ: %lu Hz and %lu Hz\n", (unsigned long)rateA, (unsigned long)rateB);
+        return 1;
+    }
+    for (uint32_t i = 0; i < count; i++)
+    {
+        int diff = abs(a[i] - b[i]);
+
+        if (diff != 0 && firstDiff == count)
+            firstDiff = i;
+        if (maxDiff < diff)
+            maxDiff = diff;
+        sumSquares += (double)diff * diff;
+    }
+    free(a);
+    free(b);
+
+    if (countA != countB)
+        printf("Lengths differ: %lu and %lu samples\n", (unsigned long)countA / 2, (unsigned long)countB / 2);
+    if (maxDiff == 0)
+    {
+        if (countA == countB)
+            printf("Identical\n");
+        return countA != countB;
+    }
+    printf("First difference at %.3f s, largest %d, RMS %.2f\n",
+           (double)(firstDiff / 2) / rateA, maxDiff, count ? sqrt(sumSquares / count) : 0.0);
+    return 1;
+}
+
+int main(int argc, char **argv)
+{
+    const char *root = ".";
+    int freqIndex = 4;
+    int arg;
+
+    arg = 1;
+    while (arg < argc && argv[arg][0] == '-')
+    {
+        const char *option = argv[arg++];
+
+        if (strcmp(option, "-b") == 0)
+        {
+            sHalfRateBand = true;
+            continue;
+        }
+        if (arg >= argc || option[2] != '\0')
+            Usage();
+        switch (option[1])
+        {
+        case 'r':
+            freqIndex = GetFreqIndex(ParseInt(argv[arg], 0, 100000));
+            break;
+        case 'c':
+            sMaxChans = ParseInt(argv[arg], 1, MAX_DIRECTSOUND_CHANNELS);
+            break;
+        case 'v':
+            sMasterVolume = ParseInt(argv[arg], 1, 15);
+            break;
+        case 't':
+            sSeconds = ParseInt(argv[arg], 1, 3600);
+            break;
+        case 'R':
+            root = argv[arg];
+            break;
+        default:
+            Usage();
+        }
+        arg++;
+    }
+    if (arg >= argc)
+        Usage();
+
+    if (strcmp(argv[arg], "diff") == 0)
+    {
+        if (argc - arg != 3)
+            Usage();
+        return Diff(argv[arg + 1], argv[arg + 2]);
+    }
+    if (strcmp(argv[arg], "render") == 0)
+    {
+        if (argc - arg < 3)
+            Usage();
+        LoadSoundData(root);
+        LoadSounds(&argv[arg + 2], argc - arg - 2);
+        Render(argv[arg + 1], freqIndex);
+    }
+    else if (strcmp(argv[arg], "bench") == 0)
+    {
+        if (argc - arg < 2)
+            Usage();
+        LoadSoundData(root);
+        LoadSounds(&argv[arg + 1], argc - arg - 1);
+        Bench();
+    }
+    else
+    {
+        Usage();
+    }
+    return 0;
+}
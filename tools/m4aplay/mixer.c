@@ -0,0 +1,598 @@
+// The DirectSound mixer of src/m4a_1.s (SoundMainRAM) in C. It mixes the way
+// the ARM code does, down to the rounding, and adds up what the ARM code
+// would spend on each channel to estimate the mixer's cost per frame.
+
+#include <string.h>
+#include "m4aplay.h"
+
+// Must match src/m4a_1.s
+#define SYNTH_TYPE           0x1
+#define SYNTH_BASE_WAVE_DUTY 0x2
+#define SYNTH_WIDTH_CHANGE_1 0x3
+#define SYNTH_MOD_AMOUNT     0x4
+#define SYNTH_WIDTH_CHANGE_2 0x5
+#define WAVE_DATA_FLAG_LOOP  0xC0
+#define BDPCM_BLK_SIZE       0x21
+#define BDPCM_BLK_SAMPLES    0x40
+
+// Approximate ARM7TDMI cycles for each part of SoundMainRAM. They are counted
+// from its instructions, with the mixer in IWRAM and the samples in ROM at the
+// game's 3/1 wait states, so they are good for comparing one setup against
+// another rather than as exact timings.
+#define CYCLES_FRAME          300  // SoundMain, the channel loop and downsampler setup
+#define CYCLES_CHANNEL_IDLE   12   // an empty slot in the channel loop
+#define CYCLES_CHANNEL        120  // envelope, volume and mixer setup of a playing channel
+#define CYCLES_DOWNSAMPLE     31   // downsampler and reverb, per output sample
+#define CYCLES_UPSAMPLE       27   // adding in the half rate band, per sample of it
+#define CYCLES_MIX_FIXED      11   // fixed pitch, per output sample
+#define CYCLES_MIX_SLOW       15   // pitch below 1.0, per output sample
+#define CYCLES_MIX_FAST       18   // pitch of 1.0 and above, per output sample
+#define CYCLES_MIX_UNBUFFERED 21   // a sample ending within the frame, per output sample
+#define CYCLES_MIX_PULSE      7
+#define CYCLES_MIX_SAW        12
+#define CYCLES_MIX_TRIANGLE   10
+#define CYCLES_STEP           2    // moving the interpolation on by one source sample
+#define CYCLES_STEP_UNBUFFERED 15
+#define CYCLES_FETCH          2    // DMA of a source sample from ROM
+#define CYCLES_FETCH_REVERSE  5
+#define CYCLES_FETCH_BDPCM    12
+
+static const int8_t sDeltaTable[] = {
+    0, 1, 4, 9, 16, 25, 36, 49, -64, -49, -36, -25, -16, -9, -4, -1,
+};
+
+static int8_t *sSampleBuffer;
+static uint32_t sSampleBufferSize;
+
+static int8_t *GetSampleBuffer(uint32_t size)
+{
+    if (size > sSampleBufferSize)
+    {
+        sSampleBufferSize = size * 2;
+        sSampleBuffer = realloc(sSampleBuffer, sSampleBufferSize);
+        if (sSampleBuffer == NULL)
+            FATAL_ERROR("Failed to allocate sample buffer.\n");
+    }
+    return sSampleBuffer;
+}
+
+static int8_t BdpcmSample(uint32_t data, uint32_t index)
+{
+    static uint32_t sBlockAddr;
+    static int8_t sBlock[BDPCM_BLK_SAMPLES];
+    uint32_t blockAddr = data + (index / BDPCM_BLK_SAMPLES) * BDPCM_BLK_SIZE;
+
+    if (blockAddr != sBlockAddr)
+    {
+        int8_t sample = RomRead8(blockAddr);
+
+        sBlock[0] = sample;
+        sample += sDeltaTable[RomRead8(blockAddr + 1) & 0xF];
+        sBlock[1] = sample;
+        for (int i = 2; i < BDPCM_BLK_SAMPLES; i += 2)
+        {
+            uint8_t deltas = RomRead8(blockAddr + 1 + i / 2);
+
+            sample += sDeltaTable[deltas >> 4];
+            sBlock[i] = sample;
+            sample += sDeltaTable[deltas & 0xF];
+            sBlock[i + 1] = sample;
+        }
+        sBlockAddr = blockAddr;
+    }
+    return sBlock[index % BDPCM_BLK_SAMPLES];
+}
+
+static void StartChannel(struct SoundChannel *chan)
+{
+    uint32_t wav = chan->wav;
+    uint32_t size = RomRead32(wav + 12);
+    uint32_t data = wav + 16;
+
+    chan->fw = 0;
+    if (size == 0)
+    {
+        chan->type = TONEDATA_TYPE_SPL;
+        chan->currentPointer = data;
+        chan->count = 0;
+        if (RomRead8(data + SYNTH_TYPE) == 2)
+            chan->fw = 0x40000000;
+    }
+    else if (RomRead8(wav) & 1)
+    {
+        chan->type |= TONEDATA_TYPE_CMP;
+        if (chan->type & TONEDATA_TYPE_REV)
+        {
+            chan->count = size - chan->count;
+            chan->currentPointer = chan->count;
+        }
+        else
+        {
+            chan->currentPointer = chan->count;
+            chan->count = size - chan->count;
+        }
+    }
+    else if (chan->type & TONEDATA_TYPE_REV)
+    {
+        chan->count = size - chan->count;
+        chan->currentPointer = data + chan->count;
+    }
+    else
+    {
+        chan->currentPointer = data + chan->count;
+        chan->count = size - chan->count;
+    }
+    chan->sampleStor = 0;
+}
+
+// Runs the envelope for one frame and returns the new envelope volume, or -1
+// if the channel has finished.
+static int UpdateEnvelope(struct SoundChannel *chan)
+{
+    uint8_t flags = chan->statusFlags;
+    int env;
+
+    if (flags & SOUND_CHANNEL_SF_START)
+    {
+        if (flags & SOUND_CHANNEL_SF_STOP)
+            return -1;
+        StartChannel(chan);
+        flags = SOUND_CHANNEL_SF_ENV_ATTACK;
+        if (RomRead8(chan->wav + 3) & WAVE_DATA_FLAG_LOOP)
+            flags |= SOUND_CHANNEL_SF_LOOP;
+        env = 0;
+        goto attack;
+    }
+
+    env = chan->envelopeVolume;
+    if (flags & SOUND_CHANNEL_SF_IEC)
+    {
+        if (chan->pseudoEchoLength-- <= 1)
+            return -1;
+        return env;
+    }
+    if (flags & SOUND_CHANNEL_SF_STOP)
+    {
+        env = (env * chan->release) >> 8;
+        if (env != 0 && env > chan->pseudoEchoVolume)
+            return env;
+        goto released;
+    }
+    switch (flags & SOUND_CHANNEL_SF_ENV)
+    {
+    case SOUND_CHANNEL_SF_ENV_DECAY:
+        env = (env * chan->decay) >> 8;
+        if (env > chan->sustain)
+            return env;
+        env = chan->sustain;
+        if (env == 0)
+            goto released;
+        flags--;
+        goto save;
+    case SOUND_CHANNEL_SF_ENV_ATTACK:
+        goto attack;
+    default:
+        return env;
+    }
+
+attack:
+    env += chan->attack;
+    if (env >= 0xFF)
+    {
+        env = 0xFF;
+        flags--;
+    }
+    goto save;
+released:
+    env = chan->pseudoEchoVolume;
+    if (env == 0)
+        return -1;
+    flags |= SOUND_CHANNEL_SF_IEC;
+save:
+    chan->statusFlags = flags;
+    return env;
+}
+
+// Linear interpolation between source samples. src[0] is the sample after
+// base. Returns the last base sample.
+static int MixInterpolated(uint32_t *hq, int n, const int8_t *src, int base, uint32_t *fwPtr, uint32_t step, uint32_t vol)
+{
+    uint32_t fw = *fwPtr;
+    int diff = src[0] - base;
+
+    if (step < 0x800000)
+    {
+        for (int i = 0; i < n; i++)
+        {
+            int sample = ((int32_t)(fw * diff) >> 22) + base * 2;
+
+            hq[i] += vol * (uint32_t)sample;
+            fw += step;
+            if (fw & 0x800000)
+            {
+                fw &= 0x7FFFFF;
+                base += diff;
+                src++;
+                diff = src[0] - base;
+            }
+        }
+    }
+    else
+    {
+        vol <<= 1;
+        for (int i = 0; i < n; i++)
+        {
+            int sample = ((int32_t)(fw * diff) >> 23) + base;
+
+            hq[i] += vol * (uint32_t)sample;
+            fw += step;
+            src += fw >> 23;
+            fw &= 0x7FFFFF;
+            base = src[-1];
+            diff = src[0] - base;
+        }
+    }
+    *fwPtr = fw;
+    return base;
+}
+
+// A sample that ends within this frame is read straight from ROM, checking
+// for its end at every step.
+static void MixUnbuffered(struct SoundChannel *chan, uint32_t *hq, int n, uint32_t step, uint32_t vol, uint32_t loopLength)
+{
+    uint32_t ptr = chan->currentPointer;
+    int32_t count = chan->count;
+    uint32_t fw = chan->fw;
+    int base = chan->sampleStor;
+    int diff = (int8_t)RomRead8(ptr) - base;
+
+    for (int i = 0; i < n; i++)
+    {
+        uint32_t advance;
+        int sample = ((int32_t)(fw * diff) >> 22) + base * 2;
+
+        hq[i] += vol * (uint32_t)sample;
+        fw += step;
+        advance = fw >> 23;
+        if (advance == 0)
+            continue;
+        gSoundInfo.cost.cycles += advance * CYCLES_STEP_UNBUFFERED;
+        count -= advance;
+        if (count <= 0)
+        {
+            if (loopLength == 0)
+            {
+                chan->statusFlags = 0;
+                return;
+            }
+            ptr -= loopLength;
+            count += loopLength;
+        }
+        if (--advance == 0)
+        {
+            base += diff;
+        }
+        else
+        {
+            ptr += advance;
+            base = (int8_t)RomRead8(ptr);
+        }
+        ptr++;
+        diff = (int8_t)RomRead8(ptr) - base;
+        fw &= ~0x3F800000;
+    }
+    chan->currentPointer = ptr;
+    chan->count = count;
+    chan->fw = fw;
+    chan->sampleStor = base;
+}
+
+static void MixFixed(struct SoundChannel *chan, uint32_t *hq, int n, uint32_t vol, uint32_t loopStartPos, uint32_t loopLength)
+{
+    uint32_t ptr = chan->currentPointer;
+    uint32_t count = chan->count;
+
+    for (int i = 0; i < n; i++)
+    {
+        hq[i] += vol * (uint32_t)(int8_t)RomRead8(ptr);
+        ptr++;
+        if (--count == 0)
+        {
+            if (loopLength == 0)
+            {
+                chan->statusFlags = 0;
+                return;
+            }
+            ptr = loopStartPos;
+            count = loopLength;
+        }
+    }
+    chan->currentPointer = ptr;
+    chan->count = count;
+}
+
+static void MixSynth(struct SoundChannel *chan, uint32_t *hq, int n, uint32_t step, uint32_t vol)
+{
+    uint32_t data = chan->currentPointer;
+    uint32_t fw = chan->fw;
+    uint32_t state = chan->count;
+
+    switch (RomRead8(data + SYNTH_TYPE))
+    {
+    case 0:
+    {
+        uint32_t width, duty;
+
+        state += (uint32_t)RomRead8(data + SYNTH_WIDTH_CHANGE_1) << 24;
+        width = state + ((uint32_t)RomRead8(data + SYNTH_WIDTH_CHANGE_2) << 24);
+        if ((int32_t)width < 0)
+            width = ~width;
+        duty = ((uint32_t)RomRead8(data + SYNTH_BASE_WAVE_DUTY) << 24) + (width >> 8) * RomRead8(data + SYNTH_MOD_AMOUNT);
+        for (int i = 0; i < n; i++)
+        {
+            if (fw < duty)
+                hq[i] += vol << 6;
+            else
+                hq[i] -= vol << 6;
+            fw += step << 3;
+        }
+        chan->count = state;
+        gSoundInfo.cost.cycles += n * CYCLES_MIX_PULSE;
+        break;
+    }
+    case 1:
+        vol = (vol >> 1) & ~0xFF00;
+        for (int i = 0; i < n; i++)
+        {
+            int32_t sample;
+
+            fw += step << 3;
+            sample = (int32_t)(fw >> 24) - 0x70 - (int32_t)((fw << 1) >> 27);
+            state = sample + ((int32_t)state >> 1);
+            hq[i] += vol * state;
+        }
+        chan->count = state;
+        gSoundInfo.cost.cycles += n * CYCLES_MIX_SAW;
+        break;
+    default:
+        for (int i = 0; i < n; i++)
+        {
+            int32_t sample;
+
+            fw += step << 3;
+            if ((int32_t)fw >= 0)
+                sample = ((int32_t)fw >> 23) - 0x80;
+            else
+                sample = 0x180 - (fw >> 23);
+            hq[i] += vol * (uint32_t)sample;
+        }
+        gSoundInfo.cost.cycles += n * CYCLES_MIX_TRIANGLE;
+        break;
+    }
+    chan->fw = fw;
+}
+
+static void MixChannel(struct SoundChannel *chan, int frameLength)
+{
+    struct SoundInfo *si = &gSoundInfo;
+    uint32_t *hq = si->hqBuffer;
+    uint32_t loopStartPos = 0, loopLength = 0;
+    uint32_t left, right, vol, step, needed;
+    uint8_t type;
+    int env;
+
+    if (!(chan->statusFlags & SOUND_CHANNEL_SF_ON))
+    {
+        si->cost.cycles += CYCLES_CHANNEL_IDLE;
+        return;
+    }
+    si->cost.cycles += CYCLES_CHANNEL;
+
+    env = UpdateEnvelope(chan);
+    if (env < 0)
+    {
+        chan->statusFlags = 0;
+        return;
+    }
+    chan->envelopeVolume = env;
+
+    left = (env * (si->masterVolume + 1) * chan->leftVolume) >> 13;
+    right = (env * (si->masterVolume + 1) * chan->rightVolume) >> 13;
+    vol = (left << 16) | right;
+    if (vol == 0)
+        return;
+    si->cost.activeChannels++;
+
+    type = chan->type;
+    if (chan->statusFlags & SOUND_CHANNEL_SF_LOOP)
+    {
+        uint32_t loopStart = RomRead32(chan->wav + 8);
+
+        loopLength = RomRead32(chan->wav + 12) - loopStart;
+        loopStartPos = (type & TONEDATA_TYPE_CMP) ? loopStart : chan->wav + 16 + loopStart;
+    }
+
+    if (!(type & (TONEDATA_TYPE_CMP | TONEDATA_TYPE_REV)) && (type & TONEDATA_TYPE_FIX))
+    {
+        MixFixed(chan, hq, frameLength, vol, loopStartPos, loopLength);
+        si->cost.cycles += frameLength * CYCLES_MIX_FIXED;
+        return;
+    }
+
+    step = chan->frequency * si->divFreq;
+    if (type & TONEDATA_TYPE_SPL)
+    {
+        MixSynth(chan, hq, frameLength, step, vol);
+        return;
+    }
+
+    vol = (((left + 1) >> 1) << 16) | ((right + 1) >> 1);
+    if (type & TONEDATA_TYPE_FIX)
+    {
+        step = 0x800000;
+    }
+    else if (si->halfRateBand && step < 0x400000)
+    {
+        // Nothing above a quarter of the sample rate is lost mixing this
+        // channel at half the rate, into the buffer Upsample adds in.
+        hq = si->halfRateBuffer + 2;
+        frameLength >>= 1;
+        step <<= 1;
+    }
+    needed = (uint32_t)(((uint64_t)step * frameLength + chan->fw) >> 23);
+    si->cost.cycles += frameLength * (step < 0x800000 ? CYCLES_MIX_SLOW : CYCLES_MIX_FAST);
+
+    if (!(type & (TONEDATA_TYPE_CMP | TONEDATA_TYPE_REV)))
+    {
+        const int8_t *src;
+
+        if ((int32_t)chan->count <= (int32_t)needed)
+        {
+            si->cost.cycles += frameLength * (CYCLES_MIX_UNBUFFERED - CYCLES_MIX_SLOW);
+            MixUnbuffered(chan, hq, frameLength, step, vol, loopLength);
+            return;
+        }
+        if (chan->currentPointer - ROM_BASE + needed + 1 <= gRomSize)
+        {
+            src = (const int8_t *)&gRom[chan->currentPointer - ROM_BASE];
+        }
+        else
+        {
+            int8_t *buffer = GetSampleBuffer(needed + 1);
+
+            for (uint32_t i = 0; i <= needed; i++)
+                buffer[i] = RomRead8(chan->currentPointer + i);
+            src = buffer;
+        }
+        chan->sampleStor = MixInterpolated(hq, frameLength, src, chan->sampleStor, &chan->fw, step, vol);
+        chan->count -= needed;
+        chan->currentPointer += needed;
+        si->cost.cycles += needed * CYCLES_STEP + (needed + 1) * CYCLES_FETCH;
+    }
+    else
+    {
+        // Reversed and compressed samples are first copied or decoded into a
+        // buffer in playback order, with silence past either end.
+        int8_t *buffer = GetSampleBuffer(needed + 1);
+        uint32_t ptr = chan->currentPointer;
+
+        if (!(type & TONEDATA_TYPE_CMP))
+        {
+            uint32_t data = chan->wav + 16;
+
+            for (uint32_t i = 0; i <= needed; i++)
+                buffer[i] = (ptr - 1 - i >= data && ptr - 1 - i < ptr) ? (int8_t)RomRead8(ptr - 1 - i) : 0;
+            ptr -= needed;
+            si->cost.cycles += (needed + 1) * CYCLES_FETCH_REVERSE;
+        }
+        else
+        {
+            uint32_t data = chan->wav + 16;
+            uint32_t end = (RomRead32(chan->wav + 12) + BDPCM_BLK_SAMPLES - 1) & ~(BDPCM_BLK_SAMPLES - 1);
+
+            for (uint32_t i = 0; i <= needed; i++)
+            {
+                uint32_t index = (type & TONEDATA_TYPE_REV) ? ptr - 1 - i : ptr + i;
+
+                buffer[i] = (int32_t)index >= 0 && index < end ? BdpcmSample(data, index) : 0;
+            }
+            if (type & TONEDATA_TYPE_REV)
+                ptr -= needed;
+            else
+                ptr += needed;
+            si->cost.cycles += (needed + 1) * CYCLES_FETCH_BDPCM;
+        }
+        chan->sampleStor = MixInterpolated(hq, frameLength, buffer, chan->sampleStor, &chan->fw, step, vol);
+        chan->currentPointer = ptr;
+        chan->count -= needed;
+        if ((int32_t)chan->count <= 0)
+            chan->statusFlags = 0;
+        si->cost.cycles += needed * CYCLES_STEP;
+    }
+}
+
+static int8_t DownsampleLane(uint32_t lane, uint32_t *noiseShape)
+{
+    uint32_t value = *noiseShape + lane;
+
+    if ((int32_t)value >= 0x40000000)
+        value = 0x3FFFFFFF;
+    else if ((int32_t)value < -0x40000000)
+        value = 0xC0000000;
+    *noiseShape = value & 0x7F0000;
+    return (int8_t)(value >> 23);
+}
+
+// Adds the half rate band to the mix, with a sample between each two of its
+// own that is their average. The left and right lanes are averaged apart so
+// the right one doesn't carry into the left. The last sample of the band is
+// kept in front of it for the next frame, which puts the band a sample behind
+// where it was mixed. The rest of the mix is moved a sample later to match,
+// with its last sample kept in front of that, so a channel doesn't skip when
+// its step crosses into or out of the band.
+static void Upsample(int frameLength)
+{
+    struct SoundInfo *si = &gSoundInfo;
+    uint32_t *low = si->halfRateBuffer + 1;
+    uint32_t carry = low[-1];
+    uint32_t prev = low[0];
+
+    for (int i = 0; i < frameLength / 2; i++)
+    {
+        uint32_t next = low[i + 1];
+        uint32_t avg = ((int32_t)prev >> 1) + ((int32_t)next >> 1);
+        uint32_t avgRight = ((int32_t)(prev << 16) >> 1) + ((int32_t)(next << 16) >> 1);
+        uint32_t first = si->hqBuffer[i * 2];
+
+        si->hqBuffer[i * 2] = carry + ((avg & 0xFFFF0000) | (avgRight >> 16));
+        carry = si->hqBuffer[i * 2 + 1];
+        si->hqBuffer[i * 2 + 1] = first + next;
+        low[i + 1] = 0;
+        prev = next;
+    }
+    low[-1] = carry;
+    low[0] = prev;
+}
+
+// Converts the 16-bit mix to the 8-bit DMA buffers, and starts the next
+// frame's mix with the reverb of what was played a DMA period ago.
+static void Downsample(int frameLength)
+{
+    struct SoundInfo *si = &gSoundInfo;
+    int8_t *right = si->pcmBuffer;
+    int8_t *left = si->pcmBuffer + PCM_DMA_BUF_SIZE;
+    uint32_t pos = si->pcmDmaSlot * frameLength;
+    uint32_t next = si->pcmDmaSlot + 1 < si->pcmDmaPeriod ? pos + frameLength : 0;
+    uint32_t noiseShapeLeft = si->noiseShapeLeft << 16;
+    uint32_t noiseShapeRight = si->noiseShapeRight << 16;
+    int reverb = si->reverb >> 2;
+
+    for (int i = 0; i < frameLength; i++)
+    {
+        uint32_t acc = si->hqBuffer[i];
+        int echo = left[next + i] + right[next + i] + left[pos + i] + right[pos + i];
+
+        left[pos + i] = DownsampleLane(acc, &noiseShapeLeft);
+        right[pos + i] = DownsampleLane(acc << 16, &noiseShapeRight);
+        si->hqBuffer[i] = (uint32_t)(echo * reverb) * 0x10001;
+    }
+    si->noiseShapeLeft = noiseShapeLeft >> 16;
+    si->noiseShapeRight = noiseShapeRight >> 16;
+}
+
+void SoundMainRAM(void)
+{
+    struct SoundInfo *si = &gSoundInfo;
+    int frameLength = si->pcmSamplesPerVBlank;
+
+    si->cost.cycles = CYCLES_FRAME + frameLength * CYCLES_DOWNSAMPLE;
+    si->cost.activeChannels = 0;
+    for (int i = 0; i < si->maxChans; i++)
+        MixChannel(&si->chans[i], frameLength);
+    if (si->halfRateBand)
+    {
+        Upsample(frameLength);
+        si->cost.cycles += (frameLength / 2) * CYCLES_UPSAMPLE;
+    }
+    Downsample(frameLength);
+}
@@ -0,0 +1,1092 @@
+// savetool - inspects, validates, patches and migrates 128 KiB flash saves
+// written by src/save.c.
+//
+// Usage:
+//   savetool info <save>
+//   savetool boxes <save>
+//   savetool extract <save> <block> <out.bin>
+//   savetool inject <save> <block> <in.bin> <out save>
+//   savetool patch <save> <block> <offset> <hex bytes> <out save>
+//   savetool migrate <save> <rules> <out save>
+//   savetool bench <iterations> <save>...
+//
+// <block> is one of sb2, sb1 or storage. Writing commands always operate on the
+// newest valid slot and rewrite the checksums of every section they touch.
+// Storage saved with P_COMPRESSED_PC_STORAGE is unpacked when read and packed
+// again when written.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <ctype.h>
+#include <time.h>
+
+#ifdef _MSC_VER
+
+#define FATAL_ERROR(format, ...)          \
+do                                        \
+{                                         \
+    fprintf(stderr, format, __VA_ARGS__); \
+    exit(1);                              \
+} while (0)
+
+#else
+
+#define FATAL_ERROR(format, ...)            \
+do                                          \
+{                                           \
+    fprintf(stderr, format, ##__VA_ARGS__); \
+    exit(1);                                \
+} while (0)
+
+#endif // _MSC_VER
+
+// Must match include/save.h
+#define SECTOR_SIZE 0x1000
+#define NUM_SECTORS 32
+#define SECTOR_DATA_SIZE 3968
+#define SECTOR_ID_OFFSET 0xFF4
+#define SECTOR_CHECKSUM_OFFSET 0xFF6
+#define SECTOR_SECURITY_OFFSET 0xFF8
+#define SECTOR_COUNTER_OFFSET 0xFFC
+#define UNKNOWN_CHECK_VALUE 0x8012025
+#define SPECIAL_SECTION_SENTINEL 0xB39D
+#define NUM_SECTORS_PER_SAVE_SLOT 14
+#define NUM_SAVE_SLOTS 2
+#define SAVE_SIZE (SECTOR_SIZE * NUM_SECTORS)
+
+#define SECTOR_ID_HOF_1 28
+#define SECTOR_ID_HOF_2 29
+#define SECTOR_ID_TRAINER_HILL 30
+#define SECTOR_ID_RECORDED_BATTLE 31
+
+// Must match include/global.h and include/pokemon.h
+#define IN_BOX_COUNT 30
+#define BOX_MON_SIZE 80
+#define BOX_NAME_SIZE 9
+#define BOX_MON_ALIGN 4
+
+// struct PokemonStorage starts with the u8 currentBox. struct BoxPokemon holds
+// u32 fields, so the compiler pads the boxes after it to a 4-byte boundary.
+#define STORAGE_BOXES_OFFSET ((1 + BOX_MON_ALIGN - 1) & ~(BOX_MON_ALIGN - 1))
+
+// Cycle model of PackStorageData and UnpackStorageData on the GBA, used by
+// bench. The game runs them as Thumb code from ROM (about 2 cycles per
+// instruction with the prefetch buffer) on PokemonStorage in EWRAM (3 cycles
+// per byte access). Scanning a run byte is about 8 instructions and a load.
+// A literal byte is about 12 instructions and 2 loads to scan, plus a byte
+// memcpy of about 6 instructions, a load and a store. Unpacking is the
+// memset or memcpy alone. Each token adds a control byte and a call. These
+// are estimates from reading the code, not measurements.
+#define GBA_CYCLES_PER_FRAME 280896
+#define PACK_CYCLES_PER_RUN_BYTE 20
+#define PACK_CYCLES_PER_LITERAL_BYTE 52
+#define PACK_CYCLES_PER_TOKEN 60
+#define UNPACK_CYCLES_PER_RUN_BYTE 11
+#define UNPACK_CYCLES_PER_LITERAL_BYTE 18
+#define UNPACK_CYCLES_PER_TOKEN 40
+
+// Must match struct PackedStorageSection in include/save.h and
+// PackStorageData in src/save.c
+#define PACKED_STORAGE_SIGNATURE 0x5043
+#define PACKED_HEADER_SIZE 8
+#define PACKED_RUN_MIN 3
+#define PACKED_RUN_MAX (0x7F + PACKED_RUN_MIN)
+#define PACKED_LITERAL_MAX 0x80
+
+enum
+{
+    SLOT_EMPTY,
+    SLOT_OK,
+    SLOT_ERROR,
+};
+
+struct Block
+{
+    const char *name;
+    int firstId;
+    int numSections;
+};
+
+static const struct Block sBlocks[] =
+{
+    {"sb2",     0, 1},
+    {"sb1",     1, 4},
+    {"storage", 5, 9},
+};
+
+struct SlotInfo
+{
+    int status;
+    uint32_t counter;
+    int rotation;
+    int sectorById[NUM_SECTORS_PER_SAVE_SLOT];
+};
+
+// Substruct positions for each personality % 24, indexed by substruct type.
+// Must match the SUBSTRUCT_CASE table in src/pokemon.c.
+static const uint8_t sSubstructPositions[24][4] =
+{
+    {0, 1, 2, 3}, {0, 1, 3, 2}, {0, 2, 1, 3}, {0, 3, 1, 2},
+    {0, 2, 3, 1}, {0, 3, 2, 1}, {1, 0, 2, 3}, {1, 0, 3, 2},
+    {2, 0, 1, 3}, {3, 0, 1, 2}, {2, 0, 3, 1}, {3, 0, 2, 1},
+    {1, 2, 0, 3}, {1, 3, 0, 2}, {2, 1, 0, 3}, {3, 1, 0, 2},
+    {2, 3, 0, 1}, {3, 2, 0, 1}, {1, 2, 3, 0}, {1, 3, 2, 0},
+    {2, 1, 3, 0}, {3, 1, 2, 0}, {2, 3, 1, 0}, {3, 2, 1, 0},
+};
+
+static uint16_t ReadU16(const unsigned char *p)
+{
+    return p[0] | (p[1] << 8);
+}
+
+static uint32_t ReadU32(const unsigned char *p)
+{
+    return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static void WriteU16(unsigned char *p, uint16_t value)
+{
+    p[0] = value;
+    p[1] = value >> 8;
+}
+
+static void WriteU32(unsigned char *p, uint32_t value)
+{
+    WriteU16(p, value);
+    WriteU16(p + 2, value >> 16);
+}
+
+static unsigned char *ReadWholeFile(const char *path, long *size)
+{
+    FILE *fp = fopen(path, "rb");
+
+    if (fp == NULL)
+        FATAL_ERROR("Failed to open \"%s\" for reading.\n", path);
+
+    fseek(fp, 0, SEEK_END);
+    *size = ftell(fp);
+    rewind(fp);
+
+    unsigned char *buffer = malloc(*size > 0 ? *size : 1);
+
+    if (buffer == NULL)
+        FATAL_ERROR("Failed to allocate memory for reading \"%s\".\n", path);
+
+    if (fread(buffer, *size, 1, fp) != 1 && *size != 0)
+        FATAL_ERROR("Failed to read \"%s\".\n", path);
+
+    fclose(fp);
+    return buffer;
+}
+
+static void WriteWholeFile(const char *path, const unsigned char *buffer, long size)
+{
+    FILE *fp = fopen(path, "wb");
+
+    if (fp == NULL)
+        FATAL_ERROR("Failed to open \"%s\" for writing.\n", path);
+
+    if (fwrite(buffer, size, 1, fp) != 1)
+        FATAL_ERROR("Failed to write \"%s\".\n", path);
+
+    fclose(fp);
+}
+
+static unsigned char *ReadSave(const char *path)
+{
+    long size;
+    unsigned char *save = ReadWholeFile(path, &size);
+
+    // Emulators commonly append an RTC footer; only the flash image matters.
+    if (size < SAVE_SIZE)
+        FATAL_ERROR("\"%s\" is %ld bytes, expected at least %d.\n", path, size, SAVE_SIZE);
+
+    return save;
+}
+
+// Same as CalculateChecksum in src/save.c. The bytes of a section past its
+// struct's size are always zero, so summing the whole data area is equivalent.
+static uint16_t CalculateChecksum(const unsigned char *data, int size)
+{
+    uint32_t checksum = 0;
+
+    for (int i = 0; i < size / 4; i++)
+        checksum += ReadU32(data + i * 4);
+
+    return ((checksum >> 16) + checksum);
+}
+
+static bool IsSectorValid(const unsigned char *sector)
+{
+    return ReadU32(sector + SECTOR_SECURITY_OFFSET) == UNKNOWN_CHECK_VALUE
+        && ReadU16(sector + SECTOR_CHECKSUM_OFFSET) == CalculateChecksum(sector, SECTOR_DATA_SIZE);
+}
+
+// Hall of Fame sectors are written by HandleWriteSectorNBytes, which stores
+// the checksum in the id field and leaves the checksum field zero.
+static bool IsHofSectorValid(const unsigned char *sector)
+{
+    return ReadU32(sector + SECTOR_SECURITY_OFFSET) == UNKNOWN_CHECK_VALUE
+        && ReadU16(sector + SECTOR_ID_OFFSET) == CalculateChecksum(sector, SECTOR_DATA_SIZE);
+}
+
+static void ReadSlotInfo(const unsigned char *save, int slot, struct SlotInfo *info)
+{
+    const unsigned char *base = save + slot * NUM_SECTORS_PER_SAVE_SLOT * SECTOR_SIZE;
+    int numSecure = 0;
+    bool valid = true;
+
+    info->counter = 0;
+    info->rotation = -1;
+    for (int i = 0; i < NUM_SECTORS_PER_SAVE_SLOT; i++)
+        info->sectorById[i] = -1;
+
+    for (int i = 0; i < NUM_SECTORS_PER_SAVE_SLOT; i++)
+    {
+        const unsigned char *sector = base + i * SECTOR_SIZE;
+        uint16_t id = ReadU16(sector + SECTOR_ID_OFFSET);
+
+        if (ReadU32(sector + SECTOR_SECURITY_OFFSET) != UNKNOWN_CHECK_VALUE)
+            continue;
+        numSecure++;
+        if (id >= NUM_SECTORS_PER_SAVE_SLOT || info->sectorById[id] != -1 || !IsSectorValid(sector))
+        {
+            valid = false;
+            continue;
+        }
+        info->sectorById[id] = slot * NUM_SECTORS_PER_SAVE_SLOT + i;
+        // Section 0 is written last, so its counter is the one that marks the
+        // slot as complete. See GetSaveValidStatus.
+        if (id == 0)
+        {
+            info->counter = ReadU32(sector + SECTOR_COUNTER_OFFSET);
+            info->rotation = i;
+        }
+    }
+
+    if (numSecure == 0)
+        info->status = SLOT_EMPTY;
+    else if (!valid || numSecure != NUM_SECTORS_PER_SAVE_SLOT || info->rotation < 0)
+        info->status = SLOT_ERROR;
+    else
+        info->status = SLOT_OK;
+}
+
+// Same comparison as GetSaveValidStatus, including the counter wrapping from
+// 0xFFFFFFFF back to 0.
+static bool IsCounterNewer(uint32_t a, uint32_t b)
+{
+    if ((a == 0xFFFFFFFF && b == 0) || (a == 0 && b == 0xFFFFFFFF))
+        return (uint32_t)(a + 1) > (uint32_t)(b + 1);
+    return a > b;
+}
+
+static int GetNewestSlot(const unsigned char *save, struct SlotInfo *info)
+{
+    struct SlotInfo slots[NUM_SAVE_SLOTS];
+    int newest = -1;
+
+    for (int i = 0; i < NUM_SAVE_SLOTS; i++)
+    {
+        ReadSlotInfo(save, i, &slots[i]);
+        if (slots[i].status != SLOT_OK)
+            continue;
+        if (newest < 0 || IsCounterNewer(slots[i].counter, slots[newest].counter))
+            newest = i;
+    }
+
+    if (newest >= 0 && info != NULL)
+        *info = slots[newest];
+    return newest;
+}
+
+static const struct Block *GetBlock(const char *name)
+{
+    for (size_t i = 0; i < sizeof(sBlocks) / sizeof(sBlocks[0]); i++)
+    {
+        if (strcmp(sBlocks[i].name, name) == 0)
+            return &sBlocks[i];
+    }
+    FATAL_ERROR("Unknown block \"%s\". Expected sb2, sb1 or storage.\n", name);
+}
+
+// Must match PackStorageData in src/save.c
+static int PackStorageData(unsigned char *dest, int destSize, const unsigned char *src, int srcSize)
+{
+    int in = 0;
+    int out = 0;
+
+    while (in < srcSize)
+    {
+        unsigned char value = src[in];
+        int run = 1;
+
+        while (run < PACKED_RUN_MAX && in + run < srcSize && src[in + run] == value)
+            run++;
+
+        if (run >= PACKED_RUN_MIN)
+        {
+            if (out + 2 > destSize)
+                break;
+            dest[out++] = 0x80 | (run - PACKED_RUN_MIN);
+            dest[out++] = value;
+            in += run;
+            continue;
+        }
+
+        int literal = run;
+
+        while (literal < PACKED_LITERAL_MAX && in + literal < srcSize)
+        {
+            if (in + literal + 2 < srcSize
+             && src[in + literal] == src[in + literal + 1]
+             && src[in + literal] == src[in + literal + 2])
+                break;
+            literal++;
+        }
+
+        if (out + 1 + literal > destSize)
+        {
+            if (out + 2 > destSize)
+                break;
+            literal = destSize - out - 1;
+        }
+        dest[out++] = literal - 1;
+        memcpy(dest + out, src + in, literal);
+        out += literal;
+        in += literal;
+    }
+
+    return in;
+}
+
+static bool UnpackStorageData(unsigned char *dest, int destSize, const unsigned char *src, int srcSize)
+{
+    int in = 0;
+    int out = 0;
+
+    while (out < destSize)
+    {
+        if (in >= srcSize)
+            return false;
+
+        unsigned char control = src[in++];
+        int count;
+
+        if (control & 0x80)
+        {
+            count = (control & 0x7F) + PACKED_RUN_MIN;
+            if (in >= srcSize || out + count > destSize)
+                return false;
+            memset(dest + out, src[in++], count);
+        }
+        else
+        {
+            count = control + 1;
+            if (in + count > srcSize || out + count > destSize)
+                return false;
+            memcpy(dest + out, src + in, count);
+            in += count;
+        }
+        out += count;
+    }
+
+    return true;
+}
+
+// Adds up the modeled GBA cycles to pack and unpack one packed section.
+static void ModelPackedSection(const unsigned char *section, double *packCycles, double *unpackCycles)
+{
+    const unsigned char *src = section + PACKED_HEADER_SIZE;
+    int size = ReadU16(section + 2);
+    int in = 0;
+    int out = 0;
+
+    while (out < size && in < SECTOR_DATA_SIZE - PACKED_HEADER_SIZE)
+    {
+        unsigned char control = src[in++];
+        int count;
+
+        if (control & 0x80)
+        {
+            count = (control & 0x7F) + PACKED_RUN_MIN;
+            in++;
+            *packCycles += PACK_CYCLES_PER_TOKEN + count * PACK_CYCLES_PER_RUN_BYTE;
+            *unpackCycles += UNPACK_CYCLES_PER_TOKEN + count * UNPACK_CYCLES_PER_RUN_BYTE;
+        }
+        else
+        {
+            count = control + 1;
+            in += count;
+            *packCycles += PACK_CYCLES_PER_TOKEN + count * PACK_CYCLES_PER_LITERAL_BYTE;
+            *unpackCycles += UNPACK_CYCLES_PER_TOKEN + count * UNPACK_CYCLES_PER_LITERAL_BYTE;
+        }
+        out += count;
+    }
+}
+
+// Packs storage into consecutive section data areas the way the game splits
+// it, and returns how many bytes fit. sections may be NULL to only measure.
+static int PackStorage(unsigned char *sections, int numSections, const unsigned char *storage, int size)
+{
+    static unsigned char scratch[SECTOR_DATA_SIZE];
+    int offset = 0;
+
+    for (int i = 0; i < numSections; i++)
+    {
+        unsigned char *section = sections != NULL ? sections + i * SECTOR_DATA_SIZE : scratch;
+        int count = size - offset < 0xFFFF ? size - offset : 0xFFFF;
+
+        memset(section, 0, SECTOR_DATA_SIZE);
+        count = PackStorageData(section + PACKED_HEADER_SIZE, SECTOR_DATA_SIZE - PACKED_HEADER_SIZE, storage + offset, count);
+        WriteU16(section, PACKED_STORAGE_SIGNATURE);
+        WriteU16(section + 2, count);
+        WriteU32(section + 4, offset);
+        offset += count;
+    }
+
+    return offset;
+}
+
+static bool IsStoragePacked(const unsigned char *save, const struct SlotInfo *info)
+{
+    const struct Block *block = GetBlock("storage");
+
+    return ReadU16(save + info->sectorById[block->firstId] * SECTOR_SIZE) == PACKED_STORAGE_SIGNATURE;
+}
+
+static int GetBlockCapacity(const struct Block *block)
+{
+    return block->numSections * SECTOR_DATA_SIZE;
+}
+
+// Returns the block's contents, unpacked if needed, and stores their size.
+static unsigned char *ReadBlock(const unsigned char *save, const struct SlotInfo *info, const struct Block *block, int *size)
+{
+    unsigned char *data;
+
+    if (strcmp(block->name, "storage") == 0 && IsStoragePacked(save, info))
+    {
+        *size = 0;
+        for (int i = 0; i < block->numSections; i++)
+        {
+            const unsigned char *section = save + info->sectorById[block->firstId + i] * SECTOR_SIZE;
+            int end = ReadU32(section + 4) + ReadU16(section + 2);
+
+            if (end > *size)
+                *size = end;
+        }
+
+        data = calloc(*size > 0 ? *size : 1, 1);
+        if (data == NULL)
+            FATAL_ERROR("Failed to allocate memory for the %s block.\n", block->name);
+
+        for (int i = 0; i < block->numSections; i++)
+        {
+            const unsigned char *section = save + info->sectorById[block->firstId + i] * SECTOR_SIZE;
+
+            if (ReadU16(section) != PACKED_STORAGE_SIGNATURE
+             || !UnpackStorageData(data + ReadU32(section + 4), ReadU16(section + 2),
+                                   section + PACKED_HEADER_SIZE, SECTOR_DATA_SIZE - PACKED_HEADER_SIZE))
+                FATAL_ERROR("Storage section %d is not packed correctly.\n", i);
+        }
+        return data;
+    }
+
+    *size = GetBlockCapacity(block);
+    data = malloc(*size);
+    if (data == NULL)
+        FATAL_ERROR("Failed to allocate memory for the %s block.\n", block->name);
+
+    for (int i = 0; i < block->numSections; i++)
+        memcpy(data + i * SECTOR_DATA_SIZE, save + info->sectorById[block->firstId + i] * SECTOR_SIZE, SECTOR_DATA_SIZE);
+    return data;
+}
+
+// Writes a block back, packing it if the save's storage is packed.
+static void WriteBlock(unsigned char *save, const struct SlotInfo *info, const struct Block *block, const unsigned char *src, int size)
+{
+    unsigned char *sections = calloc(GetBlockCapacity(block), 1);
+
+    if (sections == NULL)
+        FATAL_ERROR("Failed to allocate memory for the %s block.\n", block->name);
+
+    if (strcmp(block->name, "storage") == 0 && IsStoragePacked(save, info))
+    {
+        if (PackStorage(sections, block->numSections, src, size) != size)
+            FATAL_ERROR("The %d byte storage block doesn't pack into %d sectors.\n", size, block->numSections);
+    }
+    else
+    {
+        if (size > GetBlockCapacity(block))
+            FATAL_ERROR("%s is %d bytes, but holds at most %d.\n", block->name, size, GetBlockCapacity(block));
+        memcpy(sections, src, size);
+    }
+
+    for (int i = 0; i < block->numSections; i++)
+    {
+        unsigned char *sector = save + info->sectorById[block->firstId + i] * SECTOR_SIZE;
+
+        memcpy(sector, sections + i * SECTOR_DATA_SIZE, SECTOR_DATA_SIZE);
+        WriteU16(sector + SECTOR_CHECKSUM_OFFSET, CalculateChecksum(sector, SECTOR_DATA_SIZE));
+    }
+
+    free(sections);
+}
+
+static void RequireNewestSlot(const unsigned char *save, const char *path, struct SlotInfo *info)
+{
+    if (GetNewestSlot(save, info) < 0)
+        FATAL_ERROR("\"%s\" has no valid save slot.\n", path);
+}
+
+static const char *GetSlotStatusName(int status)
+{
+    switch (status)
+    {
+    case SLOT_EMPTY:
+        return "empty";
+    case SLOT_OK:
+        return "ok";
+    default:
+        return "corrupt";
+    }
+}
+
+enum
+{
+    SECTOR_SLOT,
+    SECTOR_HOF,
+    SECTOR_SPECIAL,
+};
+
+// Returns whether the sector is in use and fails its check.
+static bool PrintSector(const unsigned char *save, int sectorId, const char *label, int type)
+{
+    const unsigned char *sector = save + sectorId * SECTOR_SIZE;
+
+    printf("  sector %2d  %-8s", sectorId, label);
+
+    // The Trainer Hill and recorded battle sectors are raw structs written by
+    // TryWriteSpecialSaveSection, with only a sentinel and no checksum.
+    if (type == SECTOR_SPECIAL)
+    {
+        printf(" %s\n", ReadU32(sector) == SPECIAL_SECTION_SENTINEL ? "raw" : "unused");
+        return false;
+    }
+
+    if (ReadU32(sector + SECTOR_SECURITY_OFFSET) != UNKNOWN_CHECK_VALUE)
+    {
+        printf(" unused\n");
+        return false;
+    }
+
+    bool valid;
+
+    if (type == SECTOR_HOF)
+    {
+        valid = IsHofSectorValid(sector);
+        printf(" checksum %04X %s\n", ReadU16(sector + SECTOR_ID_OFFSET), valid ? "ok" : "BAD");
+    }
+    else
+    {
+        valid = IsSectorValid(sector);
+        printf(" id %2u  counter %08X  checksum %04X %s\n",
+               ReadU16(sector + SECTOR_ID_OFFSET),
+               ReadU32(sector + SECTOR_COUNTER_OFFSET),
+               ReadU16(sector + SECTOR_CHECKSUM_OFFSET),
+               valid ? "ok" : "BAD");
+    }
+    return !valid;
+}
+
+// Returns the number of problems found, so CI can fail on a nonzero exit code.
+static int DoInfo(const char *path)
+{
+    unsigned char *save = ReadSave(path);
+    int newest = GetNewestSlot(save, NULL);
+    int problems = 0;
+
+    for (int slot = 0; slot < NUM_SAVE_SLOTS; slot++)
+    {
+        struct SlotInfo info;
+
+        ReadSlotInfo(save, slot, &info);
+        printf("slot %d: %s", slot + 1, GetSlotStatusName(info.status));
+        if (info.status == SLOT_OK)
+            printf(", counter %u, rotation %d%s", info.counter, info.rotation, slot == newest ? ", newest" : "");
+        printf("\n");
+        if (info.status == SLOT_ERROR)
+            problems++;
+        for (int i = 0; i < NUM_SECTORS_PER_SAVE_SLOT; i++)
+            PrintSector(save, slot * NUM_SECTORS_PER_SAVE_SLOT + i, "", SECTOR_SLOT);
+    }
+
+    printf("extra sectors:\n");
+    problems += PrintSector(save, SECTOR_ID_HOF_1, "hof", SECTOR_HOF);
+    problems += PrintSector(save, SECTOR_ID_HOF_2, "hof", SECTOR_HOF);
+    PrintSector(save, SECTOR_ID_TRAINER_HILL, "hill", SECTOR_SPECIAL);
+    PrintSector(save, SECTOR_ID_RECORDED_BATTLE, "battle", SECTOR_SPECIAL);
+
+    if (newest < 0)
+    {
+        printf("no valid slot\n");
+        problems++;
+    }
+
+    free(save);
+    return problems;
+}
+
+// Decrypts a BoxPokemon in place and returns whether its checksum matches.
+static bool DecryptBoxMon(unsigned char *mon)
+{
+    uint32_t key = ReadU32(mon) ^ ReadU32(mon + 4);
+    unsigned char *secure = mon + 32;
+    uint16_t checksum = 0;
+
+    for (int i = 0; i < 48; i += 4)
+    {
+        uint32_t value = ReadU32(secure + i) ^ key;
+
+        secure[i + 0] = value;
+        secure[i + 1] = value >> 8;
+        secure[i + 2] = value >> 16;
+        secure[i + 3] = value >> 24;
+    }
+
+    for (int i = 0; i < 48; i += 2)
+        checksum += ReadU16(secure + i);
+
+    return checksum == ReadU16(mon + 28);
+}
+
+static const unsigned char *GetBoxMonSubstruct(const unsigned char *mon, int type)
+{
+    return mon + 32 + sSubstructPositions[ReadU32(mon) % 24][type] * 12;
+}
+
+static int GetStorageBoxCount(int size)
+{
+    // currentBox, then per box its mons, name and wallpaper
+    return (size - STORAGE_BOXES_OFFSET) / (IN_BOX_COUNT * BOX_MON_SIZE + BOX_NAME_SIZE + 1);
+}
+
+// Returns the number of mons that failed their checksum.
+static int ScanBoxes(const unsigned char *storage, int size, bool print)
+{
+    unsigned char mon[BOX_MON_SIZE];
+    int numBoxes = GetStorageBoxCount(size);
+    int badMons = 0;
+
+    for (int box = 0; box < numBoxes; box++)
+    {
+        for (int pos = 0; pos < IN_BOX_COUNT; pos++)
+        {
+            memcpy(mon, storage + STORAGE_BOXES_OFFSET + (box * IN_BOX_COUNT + pos) * BOX_MON_SIZE, BOX_MON_SIZE);
+
+            // hasSpecies
+            if (!(mon[19] & 2))
+                continue;
+
+            bool ok = DecryptBoxMon(mon);
+            if (!ok)
+                badMons++;
+            if (!print)
+                continue;
+
+            const unsigned char *growth = GetBoxMonSubstruct(mon, 0);
+            const unsigned char *attacks = GetBoxMonSubstruct(mon, 1);
+
+            printf("box %2d slot %2d  pid %08X  otid %08X  species %4u  item %4u  exp %7u  moves %u/%u/%u/%u%s%s\n",
+                   box + 1, pos + 1,
+                   ReadU32(mon), ReadU32(mon + 4),
+                   ReadU16(growth), ReadU16(growth + 2), ReadU32(growth + 4),
+                   ReadU16(attacks), ReadU16(attacks + 2), ReadU16(attacks + 4), ReadU16(attacks + 6),
+                   (mon[19] & 4) ? "  egg" : "",
+                   ok ? "" : "  BAD CHECKSUM");
+        }
+    }
+
+    return badMons;
+}
+
+static int DoBoxes(const char *path)
+{
+    unsigned char *save = ReadSave(path);
+    struct SlotInfo info;
+    int size;
+
+    RequireNewestSlot(save, path, &info);
+
+    unsigned char *storage = ReadBlock(save, &info, GetBlock("storage"), &size);
+
+    printf("%d boxes%s\n", GetStorageBoxCount(size), IsStoragePacked(save, &info) ? ", packed" : "");
+
+    int badMons = ScanBoxes(storage, size, true);
+
+    free(storage);
+    free(save);
+    return badMons;
+}
+
+static int DoExtract(const char *path, const char *blockName, const char *outPath)
+{
+    unsigned char *save = ReadSave(path);
+    struct SlotInfo info;
+    int size;
+
+    RequireNewestSlot(save, path, &info);
+
+    unsigned char *data = ReadBlock(save, &info, GetBlock(blockName), &size);
+
+    WriteWholeFile(outPath, data, size);
+
+    free(data);
+    free(save);
+    return 0;
+}
+
+static int DoInject(const char *path, const char *blockName, const char *inPath, const char *outPath)
+{
+    unsigned char *save = ReadSave(path);
+    struct SlotInfo info;
+    long size;
+
+    RequireNewestSlot(save, path, &info);
+
+    unsigned char *input = ReadWholeFile(inPath, &size);
+
+    WriteBlock(save, &info, GetBlock(blockName), input, size);
+    WriteWholeFile(outPath, save, SAVE_SIZE);
+
+    free(input);
+    free(save);
+    return 0;
+}
+
+static unsigned long ParseNumber(const char *string)
+{
+    char *end;
+    unsigned long value = strtoul(string, &end, 0);
+
+    if (*string == '\0' || *end != '\0')
+        FATAL_ERROR("\"%s\" is not a number.\n", string);
+
+    return value;
+}
+
+static int ParseHexDigit(char c)
+{
+    if (c >= '0' && c <= '9')
+        return c - '0';
+    c = tolower((unsigned char)c);
+    if (c >= 'a' && c <= 'f')
+        return c - 'a' + 10;
+    return -1;
+}
+
+static int DoPatch(const char *path, const char *blockName, const char *offsetString, const char *hex, const char *outPath)
+{
+    unsigned char *save = ReadSave(path);
+    const struct Block *block = GetBlock(blockName);
+    unsigned long offset = ParseNumber(offsetString);
+    size_t length = strlen(hex);
+    struct SlotInfo info;
+    int size;
+
+    if (length == 0 || length % 2 != 0)
+        FATAL_ERROR("Patch bytes must be a nonempty, even-length hex string.\n");
+
+    RequireNewestSlot(save, path, &info);
+
+    unsigned char *data = ReadBlock(save, &info, block, &size);
+
+    if (offset + length / 2 > (unsigned long)size)
+        FATAL_ERROR("Patch runs past the end of %s.\n", blockName);
+
+    for (size_t i = 0; i < length; i += 2)
+    {
+        int high = ParseHexDigit(hex[i]);
+        int low = ParseHexDigit(hex[i + 1]);
+
+        if (high < 0 || low < 0)
+            FATAL_ERROR("\"%s\" is not a hex string.\n", hex);
+        data[offset + i / 2] = (high << 4) | low;
+    }
+
+    WriteBlock(save, &info, block, data, size);
+    WriteWholeFile(outPath, save, SAVE_SIZE);
+
+    free(data);
+    free(save);
+    return 0;
+}
+
+// Rules describe how to rebuild a block after its struct layout changed. Each
+// non-comment line is either "<block> <old offset> <new offset> <length>" or
+// "<block> size <new size>". The new block starts zeroed, at the old block's
+// size unless one is given, and only the listed ranges are carried over.
+// Blocks with no rules are left untouched.
+static int DoMigrate(const char *path, const char *rulesPath, const char *outPath)
+{
+    enum { NUM_BLOCKS = sizeof(sBlocks) / sizeof(sBlocks[0]) };
+    unsigned char *save = ReadSave(path);
+    unsigned char *oldData[NUM_BLOCKS];
+    unsigned char *newData[NUM_BLOCKS];
+    int oldSize[NUM_BLOCKS];
+    int newSize[NUM_BLOCKS];
+    bool touched[NUM_BLOCKS] = {false};
+    struct SlotInfo info;
+    char line[256];
+    int lineNum = 0;
+    FILE *fp = fopen(rulesPath, "r");
+
+    if (fp == NULL)
+        FATAL_ERROR("Failed to open \"%s\" for reading.\n", rulesPath);
+
+    RequireNewestSlot(save, path, &info);
+
+    for (int i = 0; i < NUM_BLOCKS; i++)
+    {
+        oldData[i] = ReadBlock(save, &info, &sBlocks[i], &oldSize[i]);
+        newSize[i] = oldSize[i];
+        newData[i] = NULL;
+    }
+
+    while (fgets(line, sizeof(line), fp) != NULL)
+    {
+        char blockName[16];
+        long oldOffset, newOffset, length;
+        char *comment = strchr(line, '#');
+
+        lineNum++;
+        if (comment != NULL)
+            *comment = '\0';
+        if (sscanf(line, " %15s", blockName) != 1)
+            continue;
+
+        const struct Block *block = GetBlock(blockName);
+        int index = block - sBlocks;
+
+        if (sscanf(line, " %*s size %li", &length) == 1)
+        {
+            if (newData[index] != NULL || length <= 0)
+                FATAL_ERROR("%s:%d: the size must be positive and come before any range.\n", rulesPath, lineNum);
+            newSize[index] = length;
+            continue;
+        }
+
+        if (sscanf(line, " %*s %li %li %li", &oldOffset, &newOffset, &length) != 3
+         || oldOffset < 0 || newOffset < 0 || length < 0)
+            FATAL_ERROR("%s:%d: expected \"<block> <old offset> <new offset> <length>\" or \"<block> size <size>\".\n", rulesPath, lineNum);
+
+        if (oldOffset + length > oldSize[index] || newOffset + length > newSize[index])
+            FATAL_ERROR("%s:%d: range runs past the end of %s.\n", rulesPath, lineNum, blockName);
+
+        if (newData[index] == NULL)
+        {
+            newData[index] = calloc(newSize[index], 1);
+            if (newData[index] == NULL)
+                FATAL_ERROR("Failed to allocate memory for the %s block.\n", blockName);
+        }
+        memcpy(newData[index] + newOffset, oldData[index] + oldOffset, length);
+        touched[index] = true;
+    }
+    fclose(fp);
+
+    for (int i = 0; i < NUM_BLOCKS; i++)
+    {
+        if (touched[i])
+            WriteBlock(save, &info, &sBlocks[i], newData[i], newSize[i]);
+        free(oldData[i]);
+        free(newData[i]);
+    }
+
+    WriteWholeFile(outPath, save, SAVE_SIZE);
+    free(save);
+    return 0;
+}
+
+// Runs the same work as "info" and "boxes" without printing, to measure how
+// fast a corpus of saves can be checked. It also packs and unpacks each
+// storage block the way P_COMPRESSED_PC_STORAGE does, to measure how well
+// that format does on them.
+static int DoBench(int iterations, int numPaths, char **paths)
+{
+    const struct Block *block = GetBlock("storage");
+    unsigned char *sections = malloc(GetBlockCapacity(block));
+    unsigned char **saves = malloc(numPaths * sizeof(*saves));
+    double checkTime = 0, packTime = 0, unpackTime = 0;
+    double rawBytes = 0, packedBytes = 0;
+    double packCycles = 0, unpackCycles = 0, maxPackCycles = 0, maxSectionPackCycles = 0;
+    int packedCount = 0;
+    int problems = 0;
+    int tooLarge = 0;
+
+    if (sections == NULL || saves == NULL)
+        FATAL_ERROR("Failed to allocate memory for the benchmark.\n");
+
+    for (int i = 0; i < numPaths; i++)
+        saves[i] = ReadSave(paths[i]);
+
+    for (int i = 0; i < numPaths; i++)
+    {
+        struct SlotInfo info;
+        unsigned char *storage;
+        int size;
+        clock_t start;
+
+        if (GetNewestSlot(saves[i], &info) < 0)
+        {
+            problems++;
+            continue;
+        }
+
+        start = clock();
+        for (int iter = 0; iter < iterations; iter++)
+        {
+            GetNewestSlot(saves[i], &info);
+            storage = ReadBlock(saves[i], &info, block, &size);
+            problems += ScanBoxes(storage, size, false) != 0;
+            free(storage);
+        }
+        checkTime += clock() - start;
+
+        storage = ReadBlock(saves[i], &info, block, &size);
+
+        // Blank out the unused bytes past the struct, as the game would.
+        if (!IsStoragePacked(saves[i], &info))
+            size = STORAGE_BOXES_OFFSET + GetStorageBoxCount(size) * (IN_BOX_COUNT * BOX_MON_SIZE + BOX_NAME_SIZE + 1);
+
+        start = clock();
+        for (int iter = 0; iter < iterations; iter++)
+            PackStorage(sections, block->numSections, storage, size);
+        packTime += clock() - start;
+
+        if (PackStorage(sections, block->numSections, storage, size) != size)
+        {
+            tooLarge++;
+            free(storage);
+            continue;
+        }
+
+        int packedSize = 0;
+        double savePackCycles = 0;
+
+        for (int j = 0; j < block->numSections; j++)
+        {
+            const unsigned char *section = sections + j * SECTOR_DATA_SIZE;
+            int used = SECTOR_DATA_SIZE;
+            double sectionPackCycles = 0;
+
+            while (used > PACKED_HEADER_SIZE && section[used - 1] == 0)
+                used--;
+            packedSize += used;
+            ModelPackedSection(section, &sectionPackCycles, &unpackCycles);
+            savePackCycles += sectionPackCycles;
+            if (sectionPackCycles > maxSectionPackCycles)
+                maxSectionPackCycles = sectionPackCycles;
+        }
+        packCycles += savePackCycles;
+        if (savePackCycles > maxPackCycles)
+            maxPackCycles = savePackCycles;
+        packedCount++;
+
+        start = clock();
+        for (int iter = 0; iter < iterations; iter++)
+        {
+            for (int j = 0; j < block->numSections; j++)
+            {
+                const unsigned char *section = sections + j * SECTOR_DATA_SIZE;
+
+                UnpackStorageData(storage + ReadU32(section + 4), ReadU16(section + 2),
+                                  section + PACKED_HEADER_SIZE, SECTOR_DATA_SIZE - PACKED_HEADER_SIZE);
+            }
+        }
+        unpackTime += clock() - start;
+
+        rawBytes += size;
+        packedBytes += packedSize;
+        free(storage);
+    }
+
+    double saveCount = (double)iterations * numPaths;
+
+    checkTime /= CLOCKS_PER_SEC;
+    packTime /= CLOCKS_PER_SEC;
+    unpackTime /= CLOCKS_PER_SEC;
+
+    printf("check:  %.0f saves in %.3f s", saveCount, checkTime);
+    if (checkTime > 0)
+        printf(", %.1f saves/s", saveCount / checkTime);
+    printf("\n");
+
+    if (rawBytes > 0)
+    {
+        printf("pack:   %.3f s", packTime);
+        if (packTime > 0)
+            printf(", %.1f MiB/s", rawBytes * iterations / packTime / (1024 * 1024));
+        printf("\nunpack: %.3f s", unpackTime);
+        if (unpackTime > 0)
+            printf(", %.1f MiB/s", rawBytes * iterations / unpackTime / (1024 * 1024));
+        printf("\nratio:  %.1f%% (%.0f of %.0f bytes)\n", packedBytes * 100 / rawBytes, packedBytes, rawBytes);
+
+        // Saving packs the whole storage once to plan it, then each section
+        // again as it's written. Loading unpacks it once.
+        printf("gba:    pack %.2f frames (max %.2f, max section %.2f), unpack %.2f frames per save, modeled\n",
+               packCycles / packedCount / GBA_CYCLES_PER_FRAME, maxPackCycles / GBA_CYCLES_PER_FRAME,
+               maxSectionPackCycles / GBA_CYCLES_PER_FRAME, unpackCycles / packedCount / GBA_CYCLES_PER_FRAME);
+    }
+    if (tooLarge != 0)
+        printf("%d of %d storage blocks don't fit when packed\n", tooLarge, numPaths);
+
+    for (int i = 0; i < numPaths; i++)
+        free(saves[i]);
+    free(saves);
+    free(sections);
+    return problems != 0;
+}
+
+static void Usage(void)
+{
+    fprintf(stderr,
+            "Usage: savetool info <save>\n"
+            "       savetool boxes <save>\n"
+            "       savetool extract <save> <block> <out.bin>\n"
+            "       savetool inject <save> <block> <in.bin> <out save>\n"
+            "       savetool patch <save> <block> <offset> <hex bytes> <out save>\n"
+            "       savetool migrate <save> <rules> <out save>\n"
+            "       savetool bench <iterations> <save>...\n"
+            "<block> is sb2, sb1 or storage.\n");
+    exit(1);
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 3)
+        Usage();
+
+    const char *command = argv[1];
+
+    if (strcmp(command, "info") == 0 && argc == 3)
+        return DoInfo(argv[2]) != 0;
+    if (strcmp(command, "boxes") == 0 && argc == 3)
+        return DoBoxes(argv[2]) != 0;
+    if (strcmp(command, "extract") == 0 && argc == 5)
+        return DoExtract(argv[2], argv[3], argv[4]);
+    if (strcmp(command, "inject") == 0 && argc == 6)
+        return DoInject(argv[2], argv[3], argv[4], argv[5]);
+    if (strcmp(command, "patch") == 0 && argc == 7)
+        return DoPatch(argv[2], argv[3], argv[4], argv[5], argv[6]);
+    if (strcmp(command, "migrate") == 0 && argc == 5)
+        return DoMigrate(argv[2], argv[3], argv[4]);
+    if (strcmp(command, "bench") == 0 && argc >= 4)
+        return DoBench(ParseNumber(argv[2]), argc - 3, argv + 3);
+
+    Usage();
+    return 1;
+}